@@ -140,6 +140,9 @@ macro(write_configtable)
   string(APPEND out "Emulation FdNetDevice         : ")
   check_on_or_off("${ENABLE_EMU}" "${ENABLE_EMUNETDEV}")
 
+  string(APPEND out "Event object pool             : ")
+  check_on_or_off("${NS3_EVENT_POOL}" "${NS3_EVENT_POOL}")
+
   string(APPEND out "Examples                      : ")
   check_on_or_off("${ENABLE_EXAMPLES}" "${ENABLE_EXAMPLES}")
 
@@ -158,6 +161,9 @@ macro(write_configtable)
   string(APPEND out "MPI Support                   : ")
   check_on_or_off("${NS3_MPI}" "${MPI_FOUND}")
 
+  string(APPEND out "Multithreaded simulation      : ")
+  check_on_or_off("${NS3_MTP}" "${NS3_MTP}")
+
   string(APPEND out "ns-3 Click Integration        : ")
   check_on_or_off("ON" "${NS3_CLICK}")
 
@@ -627,6 +627,11 @@ macro(process_options)
     add_definitions(-DENABLE_DES_METRICS)
   endif()
 
+  # Pooled events would hide use-after-free errors from the sanitizers
+  if(${NS3_EVENT_POOL} AND NOT ${NS3_SANITIZE})
+    add_definitions(-DENABLE_EVENT_POOL)
+  endif()
+
   if(${NS3_SANITIZE} AND ${NS3_SANITIZE_MEMORY})
     message(
       FATAL_ERROR
@@ -1049,6 +1054,12 @@ macro(process_options)
     endif()
   endif()
 
+  # Multithreaded simulation shares objects between threads, which needs
+  # atomic reference counts and per-thread packet allocators
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+  endif()
+
   mark_as_advanced(Boost_INCLUDE_DIR)
   find_package(Boost)
   if(${Boost_FOUND})
@@ -1375,6 +1386,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${NS3_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
@@ -0,0 +1,435 @@
+// 多次重复运行 topo_figure_flowmon_cfg_integrated 并合并统计结果。
+//
+// 参数网格文件每行为 "参数名 = 取值1 取值2 ..."（取值以空白分隔，# 开头为注释），
+// 参数名即仿真程序的命令行参数。网格的每个取值组合（参数点）各运行 --runs 次，
+// 第 i 次使用 RngRun=firstRun+i（各参数点使用相同的 run 序号），同时最多运行
+// --jobs 个子进程。每次运行的输出和汇总写到 --outDir，最后按参数点给出每个指标的
+// 均值和 95% 置信区间，并写出 CSV。
+//
+// ./ns3 run "dsw_batch --grid=scratch/ns3-dsw/data/grid.txt --runs=10"
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace ns3;
+
+/// 网格中的一个参数及其取值
+struct GridParam
+{
+    std::string name;
+    std::vector<std::string> values;
+};
+
+/// 一次运行（子进程）
+struct Job
+{
+    uint32_t point = 0; //!< 参数点下标
+    uint32_t run = 0;   //!< RngRun
+    std::string log;    //!< 标准输出/错误
+    std::string summary;
+    bool ok = false;
+};
+
+static std::string
+Trim(const std::string& s)
+{
+    size_t b = 0, e = s.size();
+    while (b < e && std::isspace(static_cast<unsigned char>(s[b])))
+        ++b;
+    while (e > b && std::isspace(static_cast<unsigned char>(s[e - 1])))
+        --e;
+    return s.substr(b, e - b);
+}
+
+/**
+ * 读取参数网格文件
+ * @param path 网格文件
+ * @param params 输出的参数（文件顺序）
+ * @return 是否成功
+ */
+static bool
+ReadGrid(const std::string& path, std::vector<GridParam>& params)
+{
+    std::ifstream fin(path.c_str());
+    if (!fin.is_open())
+    {
+        std::cerr << "Cannot open grid file " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    uint32_t lineNo = 0;
+    while (std::getline(fin, line))
+    {
+        ++lineNo;
+        line = Trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::size_t eq = line.find('=');
+        if (eq == std::string::npos)
+        {
+            std::cerr << path << ":" << lineNo << ": expected 'name = value ...'" << std::endl;
+            return false;
+        }
+        GridParam param;
+        param.name = Trim(line.substr(0, eq));
+        std::istringstream values(line.substr(eq + 1));
+        std::string v;
+        while (values >> v)
+        {
+            param.values.push_back(v);
+        }
+        if (param.name.empty() || param.values.empty())
+        {
+            std::cerr << path << ":" << lineNo << ": empty name or value list" << std::endl;
+            return false;
+        }
+        params.push_back(param);
+    }
+    return true;
+}
+
+/**
+ * 参数点 point 在各参数上的取值下标（最后一个参数变化最快）
+ */
+static std::vector<uint32_t>
+PointIndices(const std::vector<GridParam>& params, uint32_t point)
+{
+    std::vector<uint32_t> idx(params.size());
+    for (std::size_t i = params.size(); i-- > 0;)
+    {
+        idx[i] = point % params[i].values.size();
+        point /= params[i].values.size();
+    }
+    return idx;
+}
+
+/**
+ * 读取一次运行的汇总文件（每行 key=value），保持指标首次出现的顺序
+ */
+static bool
+ReadSummary(const std::string& path,
+            std::map<std::string, double>& values,
+            std::vector<std::string>& order)
+{
+    std::ifstream fin(path.c_str());
+    if (!fin.is_open())
+        return false;
+    std::string line;
+    while (std::getline(fin, line))
+    {
+        std::size_t eq = line.find('=');
+        if (eq == std::string::npos)
+            continue;
+        std::string key = Trim(line.substr(0, eq));
+        if (key == "run")
+            continue;
+        if (values.emplace(key, std::atof(line.c_str() + eq + 1)).second &&
+            std::find(order.begin(), order.end(), key) == order.end())
+        {
+            order.push_back(key);
+        }
+    }
+    return true;
+}
+
+/// 双侧 95% 置信区间的 t 分布分位数
+static double
+StudentT95(uint32_t df)
+{
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                   2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                   2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                   2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+    if (df == 0)
+        return 0.0;
+    if (df <= 30)
+        return table[df - 1];
+    if (df <= 40)
+        return 2.021;
+    if (df <= 60)
+        return 2.000;
+    if (df <= 120)
+        return 1.980;
+    return 1.960;
+}
+
+/**
+ * 启动一个子进程运行仿真程序，输出重定向到 job.log
+ * @return 子进程 pid，失败时 -1
+ */
+static pid_t
+Launch(const std::string& program, const std::vector<std::string>& args, const Job& job)
+{
+    pid_t pid = fork();
+    if (pid != 0)
+        return pid;
+
+    int fd = ::open(job.log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+    {
+        ::dup2(fd, STDOUT_FILENO);
+        ::dup2(fd, STDERR_FILENO);
+        ::close(fd);
+    }
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(program.c_str()));
+    for (const auto& a : args)
+    {
+        argv.push_back(const_cast<char*>(a.c_str()));
+    }
+    argv.push_back(nullptr);
+    ::execv(program.c_str(), argv.data());
+    std::cerr << "exec " << program << " failed: " << std::strerror(errno) << std::endl;
+    ::_exit(127);
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string gridFile = "scratch/ns3-dsw/data/grid.txt";
+    std::string program = "";
+    std::string outDir = "scratch/ns3-dsw/out/batch";
+    std::string csvFile = "";
+    uint32_t runs = 10;
+    uint32_t firstRun = 1;
+    uint32_t jobs = std::thread::hardware_concurrency();
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("grid", "Parameter grid file: 'name = value1 value2 ...' per line", gridFile);
+    cmd.AddValue("runs", "Replications (RngRun values) per parameter point", runs);
+    cmd.AddValue("firstRun", "RngRun of the first replication", firstRun);
+    cmd.AddValue("jobs", "Number of simulations run at the same time (0 = one per core)", jobs);
+    cmd.AddValue("program",
+                 "Simulation executable (default: the topo_figure_flowmon_cfg_integrated "
+                 "built next to this program)",
+                 program);
+    cmd.AddValue("outDir", "Directory for per-run logs and summaries", outDir);
+    cmd.AddValue("csv", "Merged summary CSV (default: <outDir>/summary.csv)", csvFile);
+    cmd.Parse(argc, argv);
+
+    if (jobs == 0)
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    if (runs == 0)
+    {
+        std::cerr << "--runs must be positive" << std::endl;
+        return 1;
+    }
+    if (program.empty())
+    {
+        // build/scratch/ns3-dsw/batch/ns3.39-dsw_batch-default
+        //  -> build/scratch/ns3-dsw/src/ns3.39-topo_figure_flowmon_cfg_integrated-default
+        std::filesystem::path self(argv[0]);
+        std::string name = self.filename().string();
+        std::size_t pos = name.find("dsw_batch");
+        if (pos != std::string::npos)
+            name.replace(pos, std::strlen("dsw_batch"), "topo_figure_flowmon_cfg_integrated");
+        program = (self.parent_path().parent_path() / "src" / name).string();
+    }
+    if (::access(program.c_str(), X_OK) != 0)
+    {
+        std::cerr << "Simulation program not found: " << program << " (use --program)"
+                  << std::endl;
+        return 1;
+    }
+    if (csvFile.empty())
+        csvFile = outDir + "/summary.csv";
+
+    std::vector<GridParam> params;
+    if (!ReadGrid(gridFile, params))
+        return 1;
+    uint32_t nPoints = 1;
+    for (const auto& p : params)
+    {
+        nPoints *= p.values.size();
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(outDir, ec);
+    if (ec)
+    {
+        std::cerr << "Cannot create " << outDir << ": " << ec.message() << std::endl;
+        return 1;
+    }
+
+    // 所有运行：参数点优先，同一参数点的各 run 相邻
+    std::vector<Job> allJobs;
+    for (uint32_t point = 0; point < nPoints; ++point)
+    {
+        for (uint32_t r = 0; r < runs; ++r)
+        {
+            Job job;
+            job.point = point;
+            job.run = firstRun + r;
+            std::ostringstream base;
+            base << outDir << "/p" << point << "-r" << job.run;
+            job.log = base.str() + ".log";
+            job.summary = base.str() + ".summary";
+            allJobs.push_back(job);
+        }
+    }
+    std::cout << "[batch] " << nPoints << " parameter points x " << runs << " runs, " << jobs
+              << " parallel jobs: " << program << std::endl;
+
+    // 调度：保持最多 jobs 个子进程在运行
+    std::map<pid_t, std::size_t> running;
+    std::size_t next = 0;
+    std::size_t done = 0;
+    uint32_t failed = 0;
+    while (next < allJobs.size() || !running.empty())
+    {
+        while (next < allJobs.size() && running.size() < jobs)
+        {
+            Job& job = allJobs[next];
+            std::vector<uint32_t> idx = PointIndices(params, job.point);
+            std::vector<std::string> args;
+            for (std::size_t i = 0; i < params.size(); ++i)
+            {
+                args.push_back("--" + params[i].name + "=" + params[i].values[idx[i]]);
+            }
+            // 批量运行只需要汇总，关闭其他输出（网格中可以再打开）
+            args.insert(args.begin(),
+                        {"--anim=0",
+                         "--log=warn",
+                         "--flowXml=none",
+                         "--proSinkXml=none",
+                         "--RngRun=" + std::to_string(job.run),
+                         "--summary=" + job.summary});
+            std::remove(job.summary.c_str());
+            pid_t pid = Launch(program, args, job);
+            if (pid < 0)
+            {
+                std::cerr << "fork failed: " << std::strerror(errno) << std::endl;
+                return 1;
+            }
+            running[pid] = next++;
+        }
+
+        int status = 0;
+        pid_t pid = ::waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "waitpid failed: " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+        auto it = running.find(pid);
+        if (it == running.end())
+            continue;
+        Job& job = allJobs[it->second];
+        running.erase(it);
+        ++done;
+        job.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (!job.ok)
+        {
+            ++failed;
+            std::cerr << "[batch] point " << job.point << " run " << job.run
+                      << " failed, see " << job.log << std::endl;
+        }
+        std::cout << "\r[batch] " << done << "/" << allJobs.size() << " runs finished"
+                  << std::flush;
+    }
+    std::cout << std::endl;
+
+    // 合并：每个参数点、每个指标的均值与 95% 置信区间
+    std::ofstream csv(csvFile.c_str());
+    if (!csv.is_open())
+    {
+        std::cerr << "Cannot open " << csvFile << " for writing" << std::endl;
+        return 1;
+    }
+    csv << "point";
+    for (const auto& p : params)
+    {
+        csv << "," << p.name;
+    }
+    csv << ",metric,n,mean,stddev,ci95\n";
+    csv << std::setprecision(9);
+
+    for (uint32_t point = 0; point < nPoints; ++point)
+    {
+        std::vector<uint32_t> idx = PointIndices(params, point);
+        std::vector<std::string> order;
+        std::map<std::string, std::vector<double>> samples;
+        for (const auto& job : allJobs)
+        {
+            std::map<std::string, double> values;
+            if (job.point != point || !job.ok || !ReadSummary(job.summary, values, order))
+                continue;
+            for (const auto& kv : values)
+            {
+                samples[kv.first].push_back(kv.second);
+            }
+        }
+
+        std::cout << "\n=== Point " << point << ":";
+        for (std::size_t i = 0; i < params.size(); ++i)
+        {
+            if (params[i].values.size() > 1)
+                std::cout << " " << params[i].name << "=" << params[i].values[idx[i]];
+        }
+        std::cout << " ===\n";
+
+        for (const auto& metric : order)
+        {
+            const std::vector<double>& x = samples[metric];
+            uint32_t n = x.size();
+            double mean = 0.0;
+            for (double v : x)
+            {
+                mean += v;
+            }
+            mean = n > 0 ? mean / n : 0.0;
+            double var = 0.0;
+            for (double v : x)
+            {
+                var += (v - mean) * (v - mean);
+            }
+            double sd = n > 1 ? std::sqrt(var / (n - 1)) : 0.0;
+            double ci = n > 1 ? StudentT95(n - 1) * sd / std::sqrt(n) : 0.0;
+
+            std::cout << "  " << std::left << std::setw(18) << metric << std::right
+                      << " n=" << std::setw(3) << n << "  mean=" << std::fixed
+                      << std::setprecision(3) << std::setw(12) << mean << "  95% CI=+-"
+                      << std::setw(10) << ci << std::defaultfloat << "\n";
+
+            csv << point;
+            for (std::size_t i = 0; i < params.size(); ++i)
+            {
+                const std::string& v = params[i].values[idx[i]];
+                if (v.find(',') != std::string::npos)
+                    csv << ",\"" << v << "\"";
+                else
+                    csv << "," << v;
+            }
+            csv << "," << metric << "," << n << "," << mean << "," << sd << "," << ci << "\n";
+        }
+    }
+    csv.close();
+    std::cout << "\n[batch] summary written: " << csvFile << std::endl;
+    if (failed > 0)
+    {
+        std::cerr << "[batch] " << failed << " runs failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include "ns3/applications-module.h"
 #include "ns3/config.h" // 用于 Config::SetDefault
 #include "ns3/core-module.h"
+#include "ns3/dsw-topology-helper.h"
 #include "ns3/flow-monitor-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/ipv4-global-routing-helper.h"
@@ -13,16 +14,14 @@
 #include "ns3/network-module.h"
 #include "ns3/point-to-point-module.h"
 #include "ns3/pro-sink-app.h"
+#include "ns3/task-event-log.h"
 #include "ns3/string.h" // 用于 StringValue
 
 #include <algorithm>
 #include <cctype>
-#include <cmath> // hypot
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <map>
-#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -32,205 +31,7 @@ using namespace ns3;
 NS_LOG_COMPONENT_DEFINE("TopoFigureFlowmonCfg");
 
 static std::ofstream g_xmlFile;
-
-// ----------------------------- 配置结构 -----------------------------
-enum class NodeType
-{
-    UNKNOWN,
-    PRODUCER, // 生产者 (edge)
-    CONSUMER  // 消费者 (core)
-};
-
-struct NodeSpec
-{
-    uint32_t id = 0;
-    bool hasPos = false;
-    double x = 0.0, y = 0.0;
-    std::string name;
-    NodeType type = NodeType::UNKNOWN; // Producer or Consumer
-    double appRate = 0.0;              // lambda or consumerRate
-};
-
-struct LinkSpec
-{
-    uint32_t a = 0, b = 0; // 原始方向（用于确定 IP 顺序）
-    std::string rate;      // e.g., "100Mbps"
-    uint32_t id = 0;       // 标识符（可从 CSV 读取，若缺省则自动分配）
-};
-
-// nodes.csv: id,x,y,name,rate
-static std::vector<NodeSpec>
-LoadCsvNodes(const std::string& path)
-{
-    std::vector<NodeSpec> out;
-    std::ifstream fin(path.c_str());
-    if (!fin.is_open())
-    {
-        NS_FATAL_ERROR("Cannot open nodes file: " << path);
-    }
-    std::string line;
-    uint32_t ln = 0;
-    while (std::getline(fin, line))
-    {
-        ++ln;
-        std::string s = DswUtils::Trim(line);
-        if (s.empty() || s[0] == '#')
-            continue;
-
-        std::stringstream ss(s);
-        std::string fid, fx, fy, fname, frate;
-        std::getline(ss, fid, ',');
-        std::getline(ss, fx, ',');
-        std::getline(ss, fy, ',');
-        std::getline(ss, fname, ',');
-        std::getline(ss, frate);
-
-        fid = DswUtils::Trim(fid);
-        fx = DswUtils::Trim(fx);
-        fy = DswUtils::Trim(fy);
-        fname = DswUtils::Trim(fname);
-        frate = DswUtils::Trim(frate);
-
-        if (!std::all_of(fid.begin(), fid.end(), ::isdigit))
-        {
-            if (ln == 1)
-            {
-                NS_LOG_WARN("Skip header in nodes.csv: " << s);
-                continue;
-            }
-            NS_LOG_WARN("Skip invalid node line " << ln << ": " << s);
-            continue;
-        }
-
-        NodeSpec ns;
-        ns.id = static_cast<uint32_t>(std::stoul(fid));
-        if (!fx.empty() && !fy.empty())
-        {
-            ns.hasPos = true;
-            ns.x = std::stod(fx);
-            ns.y = std::stod(fy);
-        }
-        ns.name = fname;
-
-        // 解析类型和速率
-        try
-        {
-            if (fname.rfind("edge-", 0) == 0)
-            {
-                ns.type = NodeType::PRODUCER;
-            }
-            else if (fname.rfind("core-", 0) == 0)
-            {
-                ns.type = NodeType::CONSUMER;
-            }
-            else
-            {
-                NS_LOG_WARN("Skip node line " << ln << ": Invalid name '" << fname
-                                              << "'. Must start with 'edge-' or 'core-'.");
-                continue;
-            }
-
-            if (frate.empty())
-            {
-                NS_LOG_WARN("Skip node line " << ln << ": Rate column is empty for node " << fid);
-                continue;
-            }
-            ns.appRate = std::stod(frate); // 解析速率
-            if (ns.appRate <= 0.0)
-            {
-                NS_LOG_WARN("Skip node line " << ln << ": Rate must be positive, got "
-                                              << ns.appRate);
-                continue;
-            }
-        }
-        catch (const std::exception& e)
-        {
-            NS_LOG_WARN("Skip node line " << ln << ": Invalid rate value '" << frate << "' ("
-                                          << e.what() << ")");
-            continue;
-        }
-
-        if (ns.id == 0)
-        {
-            NS_LOG_WARN("Node id 0 is reserved. Skip line " << ln);
-            continue;
-        }
-        out.push_back(ns);
-    }
-    return out;
-}
-
-// links.csv: a,b,rate[,id]
-static std::vector<LinkSpec>
-LoadCsvLinks(const std::string& path)
-{
-    std::vector<LinkSpec> links;
-    std::ifstream fin(path.c_str());
-    if (!fin.is_open())
-    {
-        NS_FATAL_ERROR("Cannot open links file: " << path);
-    }
-    std::string line;
-    uint32_t ln = 0;
-    while (std::getline(fin, line))
-    {
-        ++ln;
-        std::string s = DswUtils::Trim(line);
-        if (s.empty() || s[0] == '#')
-            continue;
-
-        std::stringstream ss(s);
-        std::vector<std::string> cols;
-        std::string tok;
-        while (std::getline(ss, tok, ','))
-        {
-            cols.push_back(DswUtils::Trim(tok));
-        }
-        if (cols.size() < 3)
-        {
-            NS_LOG_WARN("Skip invalid link line " << ln << ": " << s);
-            continue;
-        }
-
-        std::string fa = cols[0], fb = cols[1], fr = cols[2];
-
-        if (!std::all_of(fa.begin(), fa.end(), ::isdigit) ||
-            !std::all_of(fb.begin(), fb.end(), ::isdigit))
-        {
-            if (ln == 1)
-            {
-                NS_LOG_WARN("Skip header in links.csv: " << s);
-                continue;
-            }
-            NS_LOG_WARN("Skip invalid link line " << ln << ": " << s);
-            continue;
-        }
-
-        LinkSpec ls;
-        ls.a = static_cast<uint32_t>(std::stoul(fa));
-        ls.b = static_cast<uint32_t>(std::stoul(fb));
-        ls.rate = fr;
-
-        // optional id column (now at index 3)
-        if (cols.size() >= 4 && !cols[3].empty() &&
-            std::all_of(cols[3].begin(), cols[3].end(), ::isdigit))
-        {
-            ls.id = static_cast<uint32_t>(std::stoul(cols[3]));
-        }
-        else
-        {
-            ls.id = static_cast<uint32_t>(links.size() + 1);
-        }
-
-        if (ls.a == 0 || ls.b == 0 || ls.a == ls.b)
-        {
-            NS_LOG_WARN("Skip invalid/self-loop link at line " << ln << ": " << s);
-            continue;
-        }
-        links.push_back(ls);
-    }
-    return links;
-}
+static TaskEventLog g_eventLog; // 打开时事件写入二进制日志，不再逐条格式化 XML
 
 static void
 SetupLogging(const std::string& levelStr)
@@ -249,30 +50,16 @@ SetupLogging(const std::string& levelStr)
     if (s == "all")
         lv = LOG_LEVEL_ALL;
     LogComponentEnable("TopoFigureFlowmonCfg", lv);
+    LogComponentEnable("DswTopologyHelper", lv);
     LogComponentEnable("ProSinkApp", lv); // 启用新 App 的日志
     NS_LOG_INFO("Logging level set to: " << s);
 }
 
-// 记录每条链路的接口与“原始方向 a->b”
-
-struct IfRecord
-{
-    uint32_t a = 0;
-    uint32_t b = 0; // 与 CSV 中一致的原始次序
-    std::string rate;
-    std::string delay; // 标签展示（可能是计算值）
-    double distanceUnits = 0.0;
-    double distanceMeters = 0.0;
-    uint32_t id = 0; // link id
-    Ipv4InterfaceContainer ifc;
-};
-
 // ----------------------------- Graphviz 导出 -----------------------------
 static void
 WriteGraphvizDot(const std::string& path,
-                 const std::set<uint32_t>& nodeIds,
-                 const std::vector<Vector>& pos,
-                 const std::map<std::pair<uint32_t, uint32_t>, IfRecord>& ifMap,
+                 const DswTopologyHelper& topo,
+                 bool delayByDist,
                  double scale)
 {
     std::ofstream dot(path.c_str());
@@ -285,10 +72,11 @@ WriteGraphvizDot(const std::string& path,
     dot << "  layout=neato;\n  overlap=false;\n  splines=true;\n";
     dot << "  node [shape=circle, style=filled, fontname=\"Helvetica\"];\n\n";
 
-    for (uint32_t id : nodeIds)
+    for (uint32_t id : topo.GetNodeIds())
     {
-        double X = pos[id].x * scale;
-        double Y = pos[id].y * scale;
+        Vector pos = topo.GetPosition(id);
+        double X = pos.x * scale;
+        double Y = pos.y * scale;
         std::ostringstream label;
         label << id;
         std::string color = "#1f77b4"; // 默认蓝
@@ -296,20 +84,113 @@ WriteGraphvizDot(const std::string& path,
             << "!\", pin=true, fillcolor=\"" << color << "\"];\n";
     }
     dot << "\n";
-    for (const auto& kv : ifMap)
+    // 按无向节点对排序输出
+    std::vector<std::pair<std::pair<uint32_t, uint32_t>, const DswTopologyHelper::LinkRecord*>>
+        edges;
+    for (const auto& rec : topo.GetLinks())
     {
-        const auto& undirected = kv.first;
-        const auto& rec = kv.second;
-        dot << "  n" << undirected.first << " -- n" << undirected.second << " [label=\"" << rec.rate
-            << " / " << rec.delay << "\", id=\"link" << rec.id << "\", penwidth=2];\n";
+        edges.emplace_back(DswUtils::Key(rec.a, rec.b), &rec);
+    }
+    std::sort(edges.begin(), edges.end(), [](const auto& x, const auto& y) {
+        return x.first < y.first;
+    });
+    for (const auto& edge : edges)
+    {
+        const auto& rec = *edge.second;
+        std::string delay =
+            delayByDist ? DswUtils::FormatTime(rec.delay.GetSeconds()) : std::string("1ms");
+        dot << "  n" << edge.first.first << " -- n" << edge.first.second << " [label=\""
+            << rec.rate << " / " << delay << "\", id=\"link" << rec.id << "\", penwidth=2];\n";
     }
     dot << "}\n";
     dot.close();
     std::cout << "[viz] Graphviz .dot written: " << path << std::endl;
 }
 
+// ----------------------------- 运行汇总 -----------------------------
+
+/**
+ * @brief 写出本次运行的汇总指标（每行 key=value），供 dsw_batch 合并多次运行
+ * @param path 输出文件
+ * @param duration Pro-Sink 应用运行时长 (s)
+ * @param latency 任务时延统计
+ * @param sinks 所有消费者
+ * @param rxFlows 收到过包的流数
+ * @param sumThr 这些流的吞吐量之和 (Mbps)
+ * @param sumDelay 这些流的平均时延之和 (ms)
+ * @param lostPackets 所有流的丢包总数
+ */
+static void
+WriteRunSummary(const std::string& path,
+                double duration,
+                const TaskLatencyMonitor& latency,
+                const std::vector<Ptr<MySink>>& sinks,
+                uint32_t rxFlows,
+                double sumThr,
+                double sumDelay,
+                uint64_t lostPackets)
+{
+    std::ofstream out(path.c_str());
+    if (!out.is_open())
+    {
+        NS_LOG_ERROR("Failed to open " << path << " for writing.");
+        return;
+    }
+    uint64_t dropped = 0;
+    uint64_t evicted = 0;
+    for (const auto& sink : sinks)
+    {
+        dropped += sink->GetTasksDropped();
+        evicted += sink->GetTasksEvicted();
+    }
+    const LogLinearHistogram& total = latency.GetOverall().component[TaskLatencyMonitor::TOTAL];
+    const LogLinearHistogram& queueing =
+        latency.GetOverall().component[TaskLatencyMonitor::QUEUEING];
+
+    out << std::setprecision(9);
+    out << "run=" << RngSeedManager::GetRun() << "\n";
+    out << "tasksCompleted=" << total.GetCount() << "\n";
+    out << "tasksDropped=" << dropped << "\n";
+    out << "tasksEvicted=" << evicted << "\n";
+    out << "taskThroughput=" << (duration > 0.0 ? total.GetCount() / duration : 0.0) << "\n";
+    out << "latencyMeanMs=" << total.GetMean() * 1000.0 << "\n";
+    out << "latencyP50Ms=" << total.GetQuantile(0.5) * 1000.0 << "\n";
+    out << "latencyP99Ms=" << total.GetQuantile(0.99) * 1000.0 << "\n";
+    out << "queueingMeanMs=" << queueing.GetMean() * 1000.0 << "\n";
+    out << "flowMeanThrMbps=" << (rxFlows > 0 ? sumThr / rxFlows : 0.0) << "\n";
+    out << "flowMeanDelayMs=" << (rxFlows > 0 ? sumDelay / rxFlows : 0.0) << "\n";
+    out << "flowLostPackets=" << lostPackets << "\n";
+}
+
 // ----------------------------- XML Trace 回调 --------------------------------
 
+/**
+ * @brief 记录一个 Pro-Sink 事件：写入二进制日志，或直接按 XML 格式写出
+ */
+static void
+RecordEvent(TaskEventLog::EventType type,
+            uint32_t nodeId,
+            uint32_t producerId,
+            uint32_t taskId,
+            uint32_t value)
+{
+    if (g_eventLog.IsOpen())
+    {
+        g_eventLog.Append(type, Simulator::Now(), nodeId, producerId, taskId, value);
+    }
+    else if (g_xmlFile.is_open())
+    {
+        TaskEventLog::Record record{Simulator::Now().GetTimeStep(),
+                                    nodeId,
+                                    producerId,
+                                    taskId,
+                                    value,
+                                    static_cast<uint8_t>(type),
+                                    {}};
+        TaskEventLog::WriteXml(g_xmlFile, record);
+    }
+}
+
 /**
  * @brief 当 Sink 完成一个任务时（Trace 回调）
  * @param nodeId 消费者的节点 ID (用于 "Core-Id")
@@ -320,18 +201,34 @@ WriteGraphvizDot(const std::string& path,
 void
 OnSinkTaskCompleted(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t totalCompleted)
 {
-    if (g_xmlFile.is_open())
-    {
-        g_xmlFile << "  <Event type=\"CoreComp\""
-                  << " Time=\"" << Simulator::Now().GetSeconds() << "\""
-                  << " Core-Id=\"Core-" << nodeId << "\""
-                  << " Edge-Id=\"Edge-" << producerId << "\""
-                  << " Task-Id=\"" << producerId << "-" << taskId << "\""
-                  << " TotalCompleted=\"" << totalCompleted << "\"/>"
-                  << std::endl;
-    }
+    RecordEvent(TaskEventLog::CORE_COMPLETE, nodeId, producerId, taskId, totalCompleted);
 }
 
+/**
+ * @brief 当 Sink 淘汰一个未收全的任务时（Trace 回调）
+ * @param nodeId 消费者的节点 ID
+ * @param producerId 任务来源的生产者 ID
+ * @param taskId 任务的 ID
+ * @param rxBytes 被淘汰时已收到的字节数
+ */
+void
+OnSinkTaskEvicted(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t rxBytes)
+{
+    RecordEvent(TaskEventLog::CORE_EVICT, nodeId, producerId, taskId, rxBytes);
+}
+
+/**
+ * @brief 当 Sink 因队列已满丢弃一个任务时（Trace 回调）
+ * @param nodeId 消费者的节点 ID
+ * @param producerId 任务来源的生产者 ID
+ * @param taskId 任务的 ID
+ * @param queueLength 丢弃时的等待队列长度
+ */
+void
+OnSinkTaskDropped(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t queueLength)
+{
+    RecordEvent(TaskEventLog::CORE_DROP, nodeId, producerId, taskId, queueLength);
+}
 
 /**
  * @brief 当 Producer 发送一个新任务时（Trace 回调）
@@ -342,15 +239,11 @@ OnSinkTaskCompleted(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint3
 void
 OnProducerTaskSent(uint32_t nodeId, uint32_t taskId, Address target)
 {
-    if (g_xmlFile.is_open())
-    {
-        g_xmlFile << "  <Event type=\"EdgeSend\""
-                  << " Time=\"" << Simulator::Now().GetSeconds() << "\""
-                  << " Edge-Id=\"Edge-" << nodeId << "\""
-                  << " Task-Id=\"" << nodeId << "-" << taskId << "\""
-                  << " TargetIp=\"" << InetSocketAddress::ConvertFrom(target).GetIpv4() << "\"/>"
-                  << std::endl;
-    }
+    RecordEvent(TaskEventLog::EDGE_SEND,
+                nodeId,
+                nodeId,
+                taskId,
+                InetSocketAddress::ConvertFrom(target).GetIpv4().Get());
 }
 
 // ----------------------------- 主程序 -----------------------------
@@ -368,6 +261,7 @@ main(int argc, char* argv[])
     double proAppStartTime = 0.0; // Pro-Sink App 的启动时间 (s)
     bool enablePcap = false;
     bool enableAnim = true;
+    bool enableFlowmon = true;
 
     // 距离->时延控制（默认启用）
     bool delayByDist = true;       // 1=按距离计算，0=用 CSV delay
@@ -379,6 +273,23 @@ main(int argc, char* argv[])
     double simulationStepMs = 1.0;                             // 默认步长 1ms
     double proAppDuration = 0.5;                               // 默认运行 0.5s
     std::string proSinkXmlFile = "scratch/pro_sink_stats.xml"; // 默认 XML 输出文件名
+    std::string eventLogFile = "";                             // 若非空，事件写入二进制日志
+    std::string sendMode = "Burst";                            // Burst|Paced|Writable
+    uint32_t pacingBurst = 1;                                  // Paced 模式下每事件发送包数
+    std::string serviceModel = "Exact";                        // Stepped|Exact
+    std::string arrivalModel = "Exact";                        // Stepped|Exact
+    std::string arrivalProcess = "ns3::PoissonArrivalProcess"; // Exact 模型下的到达过程
+    uint32_t sinkServers = 1;                                  // 每个消费者的服务台数
+    bool expService = false;                                   // 指数服务时间 (M/M/c)
+    uint32_t sinkQueueCap = 0;                                 // 消费者等待队列容量，0=不限
+    std::string dispatch = "ns3::UniformDispatchPolicy";       // 分发策略，逗号分隔时轮流分配
+    double latencyReportMs = 0.0;                              // 周期性时延分位数报告间隔，0=仅结束时
+    double lambdaOverride = 0.0;                               // >0 时覆盖所有生产者的到达率
+    double sinkRateOverride = 0.0;                             // >0 时覆盖所有消费者的处理速率
+    std::string summaryFile = "";                              // 若非空，写出本次运行的汇总指标
+    uint32_t partitions = 0;                                   // 分布式仿真的分区数，0=MPI 进程数
+    std::string partitionWeight = "degree";                    // 分区负载：degree|rate
+    std::string partitionCsv = "";                             // 若非空，写出节点到进程的映射
 
     CommandLine cmd;
     cmd.AddValue("nodes", "CSV of nodes: id[,x,y[,name]]", nodesCsv);
@@ -387,8 +298,11 @@ main(int argc, char* argv[])
     cmd.AddValue("pcap", "Enable pcap on all links (0/1)", enablePcap);
     cmd.AddValue("anim", "Enable NetAnim output (0/1)", enableAnim);
     cmd.AddValue("log", "Log level: off|warn|info|debug|all", logLevel);
-    cmd.AddValue("flowXml", "FlowMonitor XML output", flowmonXml);
-    cmd.AddValue("statsCsv", "Write per-flow stats to CSV (path)", statsCsv);
+    cmd.AddValue("flowmon",
+                 "Install FlowMonitor on all nodes (0/1; 0 on ns3::MultithreadedSimulatorImpl)",
+                 enableFlowmon);
+    cmd.AddValue("flowXml", "FlowMonitor XML output (none to disable)", flowmonXml);
+    cmd.AddValue("statsCsv", "Write per-flow FlowMonitor stats to CSV (path)", statsCsv);
     cmd.AddValue("animXml", "NetAnim XML output", animXml);
     cmd.AddValue("dot", "Write Graphviz .dot to this path (empty to disable)", dotPath);
     cmd.AddValue("dotScale", "Scale factor for coordinates in .dot", dotScale);
@@ -402,13 +316,85 @@ main(int argc, char* argv[])
     // --- Pro-Sink App 命令行参数 ---
     cmd.AddValue("simulationStep", "Simulation step for Pro-Sink App (ms)", simulationStepMs);
     cmd.AddValue("proAppDuration", "Duration for Pro-Sink App (s)", proAppDuration);
-    cmd.AddValue("proSinkXml", "Pro-Sink App XML output file", proSinkXmlFile);
+    cmd.AddValue("proSinkXml", "Pro-Sink App XML output file (none to disable)", proSinkXmlFile);
+    cmd.AddValue("eventLog",
+                 "Write Pro-Sink events to this binary log instead of proSinkXml "
+                 "(convert with dsw_evlog2xml)",
+                 eventLogFile);
+    cmd.AddValue("sendMode", "Producer send mode: Burst|Paced|Writable", sendMode);
+    cmd.AddValue("pacingBurst", "Packets per pacing event in Paced mode", pacingBurst);
+    cmd.AddValue("arrivalModel", "Producer arrival model: Stepped|Exact", arrivalModel);
+    cmd.AddValue("arrivalProcess",
+                 "Arrival process for the Exact model, e.g. ns3::PoissonArrivalProcess, "
+                 "ns3::DeterministicArrivalProcess, ns3::MmppArrivalProcess, "
+                 "ns3::TraceArrivalProcess[FileName=arrivals.txt]",
+                 arrivalProcess);
+    cmd.AddValue("serviceModel", "Consumer service model: Stepped|Exact", serviceModel);
+    cmd.AddValue("servers", "Number of servers per consumer (Exact model)", sinkServers);
+    cmd.AddValue("expService", "Exponential service times (Exact model, 0/1)", expService);
+    cmd.AddValue("queueCap", "Consumer waiting queue capacity (0 = unlimited)", sinkQueueCap);
+    cmd.AddValue("dispatch",
+                 "Sink selection policy: ns3::UniformDispatchPolicy, "
+                 "ns3::RoundRobinDispatchPolicy, ns3::WeightedDispatchPolicy, "
+                 "ns3::PowerOfTwoDispatchPolicy, ns3::NearestDispatchPolicy[Metric=Latency]. "
+                 "A comma-separated list is assigned to producers by node id (id % count) "
+                 "for comparison; PowerOfTwoDispatchPolicy needs an unpartitioned, "
+                 "single-threaded run",
+                 dispatch);
+    cmd.AddValue("latencyReportMs",
+                 "Print task latency percentiles every N ms (0 = only at the end)",
+                 latencyReportMs);
+    cmd.AddValue("lambda",
+                 "Override every producer's task arrival rate (0 = use nodes.csv)",
+                 lambdaOverride);
+    cmd.AddValue("sinkRate",
+                 "Override every consumer's processing rate (0 = use nodes.csv)",
+                 sinkRateOverride);
+    cmd.AddValue("summary",
+                 "Write this run's summary statistics (key=value lines) to this path, "
+                 "as read by dsw_batch",
+                 summaryFile);
+
+    cmd.AddValue("partitions",
+                 "Number of systems to partition the nodes into (0 = MPI size, if enabled)",
+                 partitions);
+    cmd.AddValue("partitionWeight", "Partition load per node: degree|rate", partitionWeight);
+    cmd.AddValue("partitionCsv", "Write the node -> system id map to this CSV", partitionCsv);
 
     cmd.Parse(argc, argv);
+    if (flowmonXml == "none")
+        flowmonXml.clear();
+    if (proSinkXmlFile == "none")
+        proSinkXmlFile.clear();
     SetupLogging(logLevel);
 
-    // 确保 XML 输出在 scratch 目录下
-    if (proSinkXmlFile.rfind("scratch/ns3-dsw/out/", 0) != 0)
+    // 多线程仿真器的各分区并行执行：FlowMonitor、NetAnim 与 Pro-Sink XML/事件日志由所有
+    // 节点共享且未加锁，必须关闭（时延统计在 NS3_MTP 构建中加锁，可以保留）
+    StringValue simulatorImpl;
+    GlobalValue::GetValueByName("SimulatorImplementationType", simulatorImpl);
+    bool multithreaded = simulatorImpl.Get() == "ns3::MultithreadedSimulatorImpl";
+    if (multithreaded && (enableFlowmon || enableAnim || !proSinkXmlFile.empty() ||
+                          !eventLogFile.empty()))
+    {
+        NS_FATAL_ERROR("FlowMonitor, NetAnim, the Pro-Sink XML and the event log share state "
+                       "between nodes and cannot be used on ns3::MultithreadedSimulatorImpl: "
+                       "run with --flowmon=0 --anim=0 --proSinkXml=none and without --eventLog");
+    }
+
+    // 生产者发送节奏
+    Config::SetDefault("ns3::MyProducer::SendMode", StringValue(sendMode));
+    Config::SetDefault("ns3::MyProducer::PacingBurst", UintegerValue(pacingBurst));
+    // 生产者到达过程
+    Config::SetDefault("ns3::MyProducer::ArrivalModel", StringValue(arrivalModel));
+    Config::SetDefault("ns3::MyProducer::ArrivalProcess", StringValue(arrivalProcess));
+    // 消费者服务模型
+    Config::SetDefault("ns3::MySink::ServiceModel", StringValue(serviceModel));
+    Config::SetDefault("ns3::MySink::Servers", UintegerValue(sinkServers));
+    Config::SetDefault("ns3::MySink::ExponentialService", BooleanValue(expService));
+    Config::SetDefault("ns3::MySink::QueueCapacity", UintegerValue(sinkQueueCap));
+
+    // 确保 XML 输出在 scratch 目录下（为空时不输出）
+    if (!proSinkXmlFile.empty() && proSinkXmlFile.rfind("scratch/ns3-dsw/out/", 0) != 0)
     {
         proSinkXmlFile = "scratch/ns3-dsw/out/" + proSinkXmlFile;
     }
@@ -419,226 +405,67 @@ main(int argc, char* argv[])
     NS_LOG_INFO("Pro-Sink simulation step: " << simulationStep);
     NS_LOG_INFO("Pro-Sink duration: " << proAppDuration << "s");
 
-    // 读取配置
-    auto nodeSpecs = LoadCsvNodes(nodesCsv);
-    auto linkSpecs = LoadCsvLinks(linksCsv);
-    if (nodeSpecs.empty())
+    // 读取配置并构建拓扑（节点、协议栈、坐标、链路与地址）
+    DswTopologyHelper topo;
+    topo.SetDelayByDistance(delayByDist, meterPerUnit, propSpeed, delayFactor);
+    topo.SetPartitioning(partitions,
+                         partitionWeight == "rate" ? DswTopologyHelper::WEIGHT_APP_RATE
+                                                   : DswTopologyHelper::WEIGHT_DEGREE);
+    if (topo.LoadNodes(nodesCsv) == 0)
         NS_FATAL_ERROR("No nodes parsed from " << nodesCsv);
-    if (linkSpecs.empty())
+    if (topo.LoadLinks(linksCsv) == 0)
         NS_FATAL_ERROR("No links parsed from " << linksCsv);
-
-    // --- 构建 NodeSpec 映射表 ---
-    std::map<uint32_t, NodeSpec> nodeSpecMap;
-    for (const auto& ns : nodeSpecs)
-    {
-        nodeSpecMap[ns.id] = ns;
-    }
-
-    // 节点集合与最大 ID
-    std::set<uint32_t> nodeIds;
-    uint32_t maxId = 0;
-    for (const auto& n : nodeSpecs)
+    topo.Build();
+    if (topo.GetLinks().empty())
     {
-        nodeIds.insert(n.id);
-        maxId = std::max(maxId, n.id);
-    }
-    for (const auto& l : linkSpecs)
-    {
-        nodeIds.insert(l.a);
-        nodeIds.insert(l.b);
-        maxId = std::max(maxId, std::max(l.a, l.b));
-    }
-
-    NS_LOG_INFO("Nodes in config: " << nodeIds.size() << " (max id=" << maxId << ")");
-    NS_LOG_INFO("Links in config: " << linkSpecs.size());
-
-    // 创建节点：索引 0..maxId（0 占位）
-    NodeContainer nodes;
-    nodes.Create(maxId + 1);
-
-    // 名称与坐标
-    std::vector<bool> hasPos(maxId + 1, false);
-    std::vector<Vector> pos(maxId + 1, Vector(0, 0, 0));
-    for (const auto& n : nodeSpecs)
-    {
-        if (!n.name.empty())
-        {
-            Names::Add(n.name, nodes.Get(n.id));
-            NS_LOG_INFO("Name node " << n.id << " as '" << n.name << "'");
-        }
-        if (n.hasPos)
-        {
-            hasPos[n.id] = true;
-            pos[n.id] = Vector(n.x, n.y, 0.0);
-            NS_LOG_INFO("Preset position for node " << n.id << ": (" << n.x << "," << n.y << ")");
-        }
-    }
-    // 自动布局未给坐标的节点
-    const double dx = 2.0, dy = 2.0;
-    uint32_t col = 0, row = 0;
-    for (uint32_t id = 1; id <= maxId; ++id)
-    {
-        if (nodeIds.count(id) == 0)
-            continue;
-        if (!hasPos[id])
-        {
-            pos[id] = Vector(col * dx, row * dy, 0.0);
-            hasPos[id] = true;
-            ++col;
-            if (col >= 8)
-            {
-                col = 0;
-                ++row;
-            }
-            NS_LOG_DEBUG("Auto position for node " << id << ": (" << pos[id].x << "," << pos[id].y
-                                                   << ")");
-        }
-    }
-
-    // 协议栈
-    InternetStackHelper internet;
-    internet.Install(nodes);
-
-    // 安装 Mobility（为索引 0..maxId 都放置一个坐标，未使用的放远处）
-    MobilityHelper mob;
-    Ptr<ListPositionAllocator> allocator = CreateObject<ListPositionAllocator>();
-    allocator->Add(Vector(-10, -10, 0)); // 0 占位
-    for (uint32_t id = 1; id <= maxId; ++id)
-    {
-        if (nodeIds.count(id) == 0)
-        {
-            allocator->Add(Vector(-50, -50, 0));
-            continue;
-        }
-        allocator->Add(pos[id]);
+        NS_FATAL_ERROR("No valid links created.");
     }
-    mob.SetPositionAllocator(allocator);
-    mob.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-    mob.Install(nodes);
-
-    // 每条链路一个
-    Ipv4AddressHelper address;
-    address.SetBase("10.0.0.0", "255.255.255.0");
-
-    // 链路安装（保留原始方向 a->b）
-    std::set<std::pair<uint32_t, uint32_t>> seen; // 去重（无向）
-    std::map<std::pair<uint32_t, uint32_t>, IfRecord> ifMap;
-
-    for (const auto& l : linkSpecs)
+    if (enablePcap)
     {
-        auto undirected = DswUtils::Key(l.a, l.b);
-        if (seen.count(undirected))
-        {
-            NS_LOG_WARN("Duplicate link spec " << l.a << "<->" << l.b << " ignored");
-            continue;
-        }
-        seen.insert(undirected);
-
-        if (nodeIds.count(l.a) == 0 || nodeIds.count(l.b) == 0)
-        {
-            NS_LOG_WARN("Link " << l.a << "<->" << l.b << " references undefined node id; skip");
-            continue;
-        }
-
-        // 计算距离与时延（若启用）
-        double du =
-            std::hypot(pos[l.a].x - pos[l.b].x, pos[l.a].y - pos[l.b].y); // 坐标距离（单位）
-        double meters = du * meterPerUnit;
-        double delaySecComputed = (meters / propSpeed) * delayFactor;
-
-        PointToPointHelper p2p;
-        p2p.SetDeviceAttribute("DataRate", StringValue(l.rate));
-        if (delayByDist)
-        {
-            p2p.SetChannelAttribute("Delay", TimeValue(Seconds(delaySecComputed)));
-        }
-        else
-        {
-            // delay CSV column removed — use a sensible default when not computing by distance
-            p2p.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1)));
-        }
-        p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("100p"));
-
-        // 原始方向：a 在前、b 在后 -> IP 地址 index 0 属于 a，index 1 属于 b
-        NetDeviceContainer dev = p2p.Install(nodes.Get(l.a), nodes.Get(l.b));
-        Ipv4InterfaceContainer ifc = address.Assign(dev);
-        address.NewNetwork();
-
-        std::string delayLabel =
-            delayByDist ? DswUtils::FormatTime(delaySecComputed) : std::string("1ms");
-        std::cout << "[link] " << l.a << "<->" << l.b << "  id=" << l.id << "  rate=" << l.rate
-                  << "  delay=" << delayLabel;
-        if (delayByDist)
-        {
-            std::cout << "  dist=" << std::fixed << std::setprecision(3) << du << " units ("
-                      << std::setprecision(1) << meters << " m)";
-        }
-        std::cout << "  " << ifc.GetAddress(0) << " <-> " << ifc.GetAddress(1) << std::endl;
-
-        if (enablePcap)
-        {
-            std::ostringstream os;
-            os << "pcap-" << l.a << "-" << l.b;
-            p2p.EnablePcapAll(os.str(), true);
-        }
-
-        IfRecord rec;
-        rec.a = l.a;
-        rec.b = l.b;
-        rec.ifc = ifc;
-        rec.rate = l.rate;
-        rec.delay = delayLabel;
-        rec.distanceUnits = du;
-        rec.distanceMeters = meters;
-        rec.id = l.id;
-        ifMap[undirected] = rec;
+        topo.EnablePcap("pcap");
     }
-
-    if (ifMap.empty())
+    if (!partitionCsv.empty() && !topo.WritePartition(partitionCsv))
     {
-        NS_FATAL_ERROR("No valid links created.");
+        NS_LOG_WARN("Cannot write partition to " << partitionCsv);
     }
 
-    // --- 构建节点 ID 到 IP 的映射，并收集消费者地址 ---
-    // Pro-Sink App 需要知道目标 IP 地址
-std::map<uint32_t, Ipv4Address> nodeIpMap;
-for (uint32_t nodeId : nodeIds)
-{
-    if (nodeId == 0) continue; 
+    NodeContainer nodes = topo.GetNodes();
+    const auto& nodeIds = topo.GetNodeIds();
+    const auto& nodeSpecs = topo.GetNodeSpecs();
 
-    Ptr<Ipv4> ipv4 = nodes.Get(nodeId)->GetObject<Ipv4>();
-    if (ipv4->GetNInterfaces() <= 1)
-    {
-        NS_LOG_WARN("Node " << nodeId << " has no P2P interfaces, cannot be reached.");
-        continue;
-    }
-    // 使用接口1 (0是loopback) 上的第一个 IP 地址
-    Ipv4Address ip = ipv4->GetAddress(1, 0).GetLocal();
-    nodeIpMap[nodeId] = ip;
-    NS_LOG_DEBUG("Node " << nodeId << " mapped to routable IP: " << ip);
-}
+    // 节点的到达率/处理速率，命令行覆盖优先于 nodes.csv
+    auto appRate = [&](const DswTopologyHelper::NodeSpec& ns) {
+        if (ns.role == DswTopologyHelper::PRODUCER && lambdaOverride > 0.0)
+            return lambdaOverride;
+        if (ns.role == DswTopologyHelper::CONSUMER && sinkRateOverride > 0.0)
+            return sinkRateOverride;
+        return ns.appRate;
+    };
 
     uint16_t proPort = 8080;            // Pro-Sink App 使用的端口 (必须与 MySink::m_port 匹配)
     std::vector<Address> sinkAddresses; // 存储所有消费者的地址
+    std::vector<double> sinkRates;      // 与 sinkAddresses 对应的消费者处理速率
     bool hasProducers = false;
 
     // --- 遍历 nodeSpecs 收集消费者地址 ---
     for (const auto& ns : nodeSpecs)
     {
-        if (ns.type == NodeType::CONSUMER)
+        if (ns.role == DswTopologyHelper::CONSUMER)
         {
-            if (nodeIpMap.count(ns.id))
+            Ipv4Address ip = topo.GetNodeAddress(ns.id);
+            if (ip.IsInitialized())
             {
-                sinkAddresses.push_back(InetSocketAddress(nodeIpMap[ns.id], proPort));
-                NS_LOG_INFO("Consumer " << ns.id << " (core) identified at IP: " << nodeIpMap[ns.id]
-                                        << " with rate " << ns.appRate << " Tasks/s ");
+                sinkAddresses.push_back(InetSocketAddress(ip, proPort));
+                sinkRates.push_back(appRate(ns));
+                NS_LOG_INFO("Consumer " << ns.id << " (core) identified at IP: " << ip
+                                        << " with rate " << appRate(ns) << " Tasks/s ");
             }
             else
             {
                 NS_LOG_WARN("Specified consumer node " << ns.id << " not found or has no IP.");
             }
         }
-        else if (ns.type == NodeType::PRODUCER)
+        else if (ns.role == DswTopologyHelper::PRODUCER)
         {
             hasProducers = true;
         }
@@ -661,15 +488,55 @@ for (uint32_t nodeId : nodeIds)
     uint32_t proTaskSize = 256 * 1024; // (Bytes)
     uint32_t proPacketSize = 1024;     // (Bytes)
 
+    // 分发策略列表，按节点 ID 取模分配给各生产者
+    std::vector<std::string> dispatchPolicies;
+    {
+        std::stringstream ss(dispatch);
+        std::string tok;
+        while (std::getline(ss, tok, ','))
+        {
+            tok = DswUtils::Trim(tok);
+            if (!tok.empty())
+            {
+                dispatchPolicies.push_back(tok);
+            }
+        }
+        if (dispatchPolicies.empty())
+        {
+            dispatchPolicies.push_back("ns3::UniformDispatchPolicy");
+        }
+    }
+    // 二选一策略读取消费者的即时队列长度：分区后其他 system 的消费者不在本进程，
+    // 多线程仿真器上则由其他线程同时修改，都无法读取
+    bool partitioned = multithreaded;
+    for (uint32_t nodeId : nodeIds)
+    {
+        partitioned = partitioned || topo.GetSystemId(nodeId) != 0;
+    }
+    for (const auto& policyName : dispatchPolicies)
+    {
+        if (partitioned && policyName.rfind("ns3::PowerOfTwoDispatchPolicy", 0) == 0)
+        {
+            NS_FATAL_ERROR("ns3::PowerOfTwoDispatchPolicy reads the queue of every consumer and "
+                           "cannot be used when the nodes are partitioned or run on "
+                           "ns3::MultithreadedSimulatorImpl");
+        }
+    }
+
     ApplicationContainer proApps;
     std::vector<Ptr<MyProducer>> producers;
+    std::vector<std::string> producerPolicies; // 与 producers 对应的策略名
     std::vector<Ptr<MySink>> sinks;
+    // 应用的随机流按节点 ID 分配，与安装顺序和分区方式无关
+    const int64_t appStreamBase = 1000;
+    const int64_t appStreamsPerNode = 16;
 
     // 遍历所有节点，安装 Producer 或 Sink
     for (uint32_t nodeId : nodeIds)
     {
         // 检查该节点是否在 nodes.csv 中定义过
-        if (nodeSpecMap.count(nodeId) == 0)
+        const DswTopologyHelper::NodeSpec* spec = topo.GetNodeSpec(nodeId);
+        if (spec == nullptr)
         {
             NS_LOG_DEBUG(
                 "Node "
@@ -677,22 +544,27 @@ for (uint32_t nodeId : nodeIds)
                 << " is router-only (in links.csv but not nodes.csv). Skipping Pro-Sink app.");
             continue;
         }
+        if (!topo.IsLocal(nodeId))
+        {
+            continue; // 由其他进程安装
+        }
 
-        const NodeSpec& ns = nodeSpecMap.at(nodeId);
+        const DswTopologyHelper::NodeSpec& ns = *spec;
         Ptr<Node> node = nodes.Get(nodeId);
 
-        if (ns.type == NodeType::CONSUMER)
+        if (ns.role == DswTopologyHelper::CONSUMER)
         {
             // 这是消费者 (Sink)
             Ptr<MySink> sinkApp = CreateObject<MySink>();
-            sinkApp->Setup(ns.appRate, simulationStep);
+            sinkApp->Setup(appRate(ns), simulationStep);
+            sinkApp->AssignStreams(appStreamBase + nodeId * appStreamsPerNode);
             node->AddApplication(sinkApp);
             sinkApp->SetStartTime(Seconds(proAppStartTime));
             sinkApp->SetStopTime(Seconds(proAppStopTime));
             proApps.Add(sinkApp);
             sinks.push_back(sinkApp);
         }
-        else if (ns.type == NodeType::PRODUCER)
+        else if (ns.role == DswTopologyHelper::PRODUCER)
         {
             // 这是生产者 (Producer)
             if (sinkAddresses.empty())
@@ -703,46 +575,99 @@ for (uint32_t nodeId : nodeIds)
                 continue;
             }
             Ptr<MyProducer> producerApp = CreateObject<MyProducer>();
+            // 按节点 ID 分配策略，与安装顺序和分区方式无关
+            const std::string& policyName = dispatchPolicies[nodeId % dispatchPolicies.size()];
+            producerApp->SetAttribute("DispatchPolicy", StringValue(policyName));
             producerApp->Setup(sinkAddresses,
-                               ns.appRate,
+                               appRate(ns),
                                proTaskSize,
                                proPacketSize,
                                simulationStep); 
+            producerApp->AssignStreams(appStreamBase + nodeId * appStreamsPerNode);
             node->AddApplication(producerApp);
             producerApp->SetStartTime(Seconds(proAppStartTime));
             producerApp->SetStopTime(Seconds(proAppStopTime));
             proApps.Add(producerApp);
             producers.push_back(producerApp);
+            producerPolicies.push_back(policyName);
         }
-        // (ns.type == UNKNOWN 的节点会被自动跳过)
+        // (ns.role == UNKNOWN 的节点会被自动跳过)
     }
     NS_LOG_INFO("Installed " << sinks.size() << " consumers and " << producers.size()
                              << " producers.");
+
+    // 需要额外输入的分发策略：加权策略用消费者处理速率，二选一用消费者的即时队列长度
+    for (auto& producer : producers)
+    {
+        Ptr<TaskDispatchPolicy> policy = producer->GetDispatchPolicy();
+        if (Ptr<WeightedDispatchPolicy> weighted = DynamicCast<WeightedDispatchPolicy>(policy))
+        {
+            weighted->SetWeights(sinkRates);
+        }
+        else if (Ptr<PowerOfTwoDispatchPolicy> p2c = DynamicCast<PowerOfTwoDispatchPolicy>(policy))
+        {
+            p2c->SetSinkApplications(sinks);
+        }
+    }
     NS_LOG_INFO("Pro-Sink Apps will run from " << proAppStartTime << "s to " << proAppStopTime
                                                << "s.");
 
-    // --- 打开 XML 文件并连接 Traces ---
-    g_xmlFile.open(proSinkXmlFile);
-    if (!g_xmlFile.is_open())
+    // 任务时延分位数（按消费者/生产者，内存与任务数无关）
+    Ptr<TaskLatencyMonitor> latencyMonitor = CreateObjectWithAttributes<TaskLatencyMonitor>(
+        "ReportInterval",
+        TimeValue(MilliSeconds(latencyReportMs)));
+    for (auto& sink : sinks)
+    {
+        latencyMonitor->AddSink(sink);
+    }
+
+    // --- 打开 XML 文件（或二进制事件日志）并连接 Traces ---
+    if (!eventLogFile.empty())
     {
-        NS_LOG_ERROR("Failed to open " << proSinkXmlFile << " for writing.");
+        if (!g_eventLog.Open(eventLogFile))
+        {
+            NS_FATAL_ERROR("Failed to open " << eventLogFile << " for writing.");
+        }
+    }
+    else if (!proSinkXmlFile.empty())
+    {
+        g_xmlFile.open(proSinkXmlFile);
+        if (!g_xmlFile.is_open())
+        {
+            NS_LOG_ERROR("Failed to open " << proSinkXmlFile << " for writing.");
+        }
     }
-    else
+    if (g_eventLog.IsOpen() || g_xmlFile.is_open())
     {
-        g_xmlFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
-        g_xmlFile << "<ProSinkStats simulationStep=\"" << simulationStep << "\" duration=\""
-                  << proAppDuration << "\">" << std::endl;
+        // XML 开头：直接写出，或作为二进制日志的前言在转换时还原
+        std::ostringstream xmlHead;
+        xmlHead << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+        xmlHead << "<ProSinkStats simulationStep=\"" << simulationStep << "\" duration=\""
+                << proAppDuration << "\">" << std::endl;
 
         // 连接 Sink Traces
         for (auto& sink : sinks)
         {
             sink->TraceConnectWithoutContext("TaskCompleted", MakeCallback(&OnSinkTaskCompleted));
+            sink->TraceConnectWithoutContext("TaskEvicted", MakeCallback(&OnSinkTaskEvicted));
+            sink->TraceConnectWithoutContext("TaskDropped", MakeCallback(&OnSinkTaskDropped));
         }
         // 连接 Producer Traces
-        for (auto& producer : producers)
+        for (std::size_t i = 0; i < producers.size(); ++i)
         {
+            Ptr<MyProducer> producer = producers[i];
+            xmlHead << "  <Producer Edge-Id=\"" << producer->GetNode()->GetId()
+                    << "\" Policy=\"" << producerPolicies[i] << "\" />" << std::endl;
             producer->TraceConnectWithoutContext("TaskSent", MakeCallback(&OnProducerTaskSent));
         }
+        if (g_eventLog.IsOpen())
+        {
+            g_eventLog.SetPrologue(xmlHead.str());
+        }
+        else
+        {
+            g_xmlFile << xmlHead.str();
+        }
     }
 
     // NetAnim：高亮 server/client
@@ -766,7 +691,11 @@ for (uint32_t nodeId : nodeIds)
 
     // FlowMonitor
     FlowMonitorHelper fmh;
-    Ptr<FlowMonitor> monitor = fmh.InstallAll();
+    Ptr<FlowMonitor> monitor;
+    if (enableFlowmon)
+    {
+        monitor = fmh.InstallAll();
+    }
 
     // --- 设置总仿真停止时间 ---
     Simulator::Stop(Seconds(proAppStopTime)); // 停止时间取决于 Pro-Sink App
@@ -774,9 +703,13 @@ for (uint32_t nodeId : nodeIds)
 
     Simulator::Run();
 
-    monitor->CheckForLostPackets();
+    FlowMonitor::FlowStatsContainer stats;
+    if (monitor)
+    {
+        monitor->CheckForLostPackets();
+        stats = monitor->GetFlowStats();
+    }
     Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier>(fmh.GetClassifier());
-    auto stats = monitor->GetFlowStats();
 
     std::ofstream csv;
     if (!statsCsv.empty())
@@ -786,9 +719,13 @@ for (uint32_t nodeId : nodeIds)
                "ms\n";
     }
 
-    std::cout << "\n========== FlowMonitor per-flow statistics ==========\n";
+    if (monitor)
+    {
+        std::cout << "\n========== FlowMonitor per-flow statistics ==========\n";
+    }
     double sumThr = 0.0, sumDelay = 0.0, sumJit = 0.0;
     uint32_t rxFlows = 0;
+    uint64_t lostPackets = 0;
 
     for (const auto& kv : stats)
     {
@@ -820,6 +757,7 @@ for (uint32_t nodeId : nodeIds)
                 << st.txPackets << "," << st.rxPackets << "," << st.lostPackets << "," << std::fixed
                 << std::setprecision(6) << thr << "," << dly << "," << jit << "\n";
         }
+        lostPackets += st.lostPackets;
         if (st.rxPackets > 0)
         {
             ++rxFlows;
@@ -839,24 +777,65 @@ for (uint32_t nodeId : nodeIds)
                   << "MeanJitter=" << (sumJit / rxFlows) << " ms\n";
     }
 
-    monitor->SerializeToXmlFile(flowmonXml, true, true);
-    NS_LOG_INFO("FlowMonitor XML written: " << flowmonXml);
+    if (monitor && !flowmonXml.empty())
+    {
+        monitor->SerializeToXmlFile(flowmonXml, true, true);
+        NS_LOG_INFO("FlowMonitor XML written: " << flowmonXml);
+    }
 
     // Graphviz 可视化导出
     if (!dotPath.empty())
     {
-        WriteGraphvizDot(dotPath, nodeIds, pos, ifMap, dotScale);
+        WriteGraphvizDot(dotPath, topo, delayByDist, dotScale);
+    }
+
+    latencyMonitor->Report(std::cout);
+    if (!summaryFile.empty())
+    {
+        WriteRunSummary(summaryFile,
+                        proAppDuration,
+                        *latencyMonitor,
+                        sinks,
+                        rxFlows,
+                        sumThr,
+                        sumDelay,
+                        lostPackets);
     }
 
-    // --- 关闭 XML 文件 ---
-    if (g_xmlFile.is_open())
+    // --- 关闭 XML 文件（或二进制事件日志）---
+    std::ostringstream xmlTail;
+    latencyMonitor->SerializeToXmlStream(xmlTail, 2);
+    xmlTail << "</ProSinkStats>" << std::endl;
+    bool eventLogOk = true;
+    if (g_eventLog.IsOpen())
     {
-        g_xmlFile << "</ProSinkStats>" << std::endl;
+        uint64_t events = g_eventLog.GetNRecords();
+        g_eventLog.SetEpilogue(xmlTail.str());
+        eventLogOk = g_eventLog.Close();
+        if (eventLogOk)
+        {
+            std::cout << "[stats] Pro-Sink event log written: " << eventLogFile << " (" << events
+                      << " events)" << std::endl;
+        }
+        else
+        {
+            std::cerr << "[stats] Error while writing the Pro-Sink event log " << eventLogFile
+                      << ": the file is incomplete (" << events << " events recorded)"
+                      << std::endl;
+        }
+    }
+    else if (g_xmlFile.is_open())
+    {
+        g_xmlFile << xmlTail.str();
         g_xmlFile.close();
         std::cout << "[stats] Pro-Sink XML written: " << proSinkXmlFile << std::endl;
     }
 
     Simulator::Destroy();
+    if (!eventLogOk)
+    {
+        return 1;
+    }
     std::cout << "\nDone.\n";
     return 0;
 }
\ No newline at end of file
@@ -26,6 +26,8 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <memory>
 #include <sstream>
 
 /**
@@ -197,6 +199,9 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, by the constructor, into a list of
+ * index ranges.
  */
 class ArrayMatcher
 {
@@ -214,8 +219,22 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the index matched by a Config path specification of a single
+     * index.
+     *
+     * \param [out] i The index.
+     * \returns \c true if the specification matches a single index.
+     */
+    bool GetSingleIndex(std::size_t* i) const;
 
   private:
+    /**
+     * Parse a Config path specification, or a part of it, into m_ranges.
+     *
+     * \param [in] element The Config path specification.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -226,77 +245,96 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** \c true if the Config path element is '*'. */
+    bool m_all;
+    /** The ranges of matching indexes, with their bounds. */
+    std::vector<std::pair<uint32_t, uint32_t>> m_ranges;
 
 }; // class ArrayMatcher
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_all(false)
 {
     NS_LOG_FUNCTION(this << element);
+    Parse(element);
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        m_all = true;
+        return;
     }
     std::string::size_type tmp;
-    tmp = m_element.find('|');
+    tmp = element.find('|');
     if (tmp != std::string::npos)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        std::string left = element.substr(0, tmp - 0);
+        std::string right = element.substr(tmp + 1, element.size() - (tmp + 1));
+        Parse(left);
+        Parse(right);
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
-        {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_all)
+    {
+        NS_LOG_DEBUG("Array " << i << " matches *");
         return true;
     }
+    for (const auto& range : m_ranges)
+    {
+        if (i >= range.first && i <= range.second)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
+    }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+bool
+ArrayMatcher::GetSingleIndex(std::size_t* i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_all || m_ranges.size() != 1 || m_ranges[0].first != m_ranges[0].second)
+    {
+        return false;
+    }
+    *i = m_ranges[0].first;
+    return true;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -307,24 +345,138 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * A set of Config paths, parsed into a tree of path elements.
+ *
+ * The paths which share a prefix share the nodes of that prefix, so a
+ * Resolver visits the objects matching the prefix once for all of them.
+ */
+class PathTree
+{
+  public:
+    /** A node of the tree: the path elements up to it are resolved. */
+    struct Node
+    {
+        /** The next path elements, with their subtree. */
+        std::vector<std::pair<std::string, std::unique_ptr<Node>>> children;
+        /** The indexes of the paths which end at this node. */
+        std::vector<std::size_t> paths;
+    };
+
+    PathTree();
+
+    /**
+     * Add a Config path.
+     *
+     * \param [in] path The Config path.
+     * \returns The index of the path.
+     */
+    std::size_t Add(std::string path);
+    /**
+     * Get the number of paths.
+     *
+     * \returns The number of paths.
+     */
+    std::size_t GetN() const;
+    /**
+     * Get the root of the tree.
+     *
+     * \returns The root node.
+     */
+    const Node& GetRoot() const;
+
+  private:
+    /** The root node. */
+    Node m_root;
+    /** The number of paths. */
+    std::size_t m_n;
+
+}; // class PathTree
+
+PathTree::PathTree()
+    : m_n(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::size_t
+PathTree::Add(std::string path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    // ensure that we start and end with a '/'
+    std::string::size_type tmp = path.find('/');
+    if (tmp != 0)
+    {
+        // no slash at start
+        path = "/" + path;
+    }
+    tmp = path.find_last_of('/');
+    if (tmp != (path.size() - 1))
+    {
+        // no slash at end
+        path = path + "/";
+    }
+
+    Node* node = &m_root;
+    std::string::size_type start = 1;
+    std::string::size_type next;
+    while ((next = path.find('/', start)) != std::string::npos)
+    {
+        std::string item = path.substr(start, next - start);
+        start = next + 1;
+        auto child = std::find_if(node->children.begin(),
+                                  node->children.end(),
+                                  [&item](const std::pair<std::string, std::unique_ptr<Node>>& c) {
+                                      return c.first == item;
+                                  });
+        if (child == node->children.end())
+        {
+            node->children.emplace_back(item, std::make_unique<Node>());
+            child = node->children.end() - 1;
+        }
+        node = child->second.get();
+    }
+    node->paths.push_back(m_n);
+    return m_n++;
+}
+
+std::size_t
+PathTree::GetN() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_n;
+}
+
+const PathTree::Node&
+PathTree::GetRoot() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_root;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * All the paths of a PathTree are resolved together: the objects matching
+ * a prefix shared by several paths are found once.
  */
 class Resolver
 {
   public:
     /**
-     * Construct from a base Config path.
+     * Construct from a set of Config paths.
      *
-     * \param [in] path The Config path.
+     * \param [in] tree The Config paths.
      */
-    Resolver(std::string path);
+    Resolver(const PathTree& tree);
     /** Destructor. */
     virtual ~Resolver();
 
     /**
-     * Parse the stored Config path into an object reference,
+     * Parse the stored Config paths into object references,
      * beginning at the indicated root object.
      *
      * \param [in] root The object corresponding to the current position in
@@ -333,29 +485,44 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
     /**
-     * Parse the next element in the Config path.
+     * Parse the next elements of the Config paths.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] node The node of the remaining Config paths.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(const PathTree::Node& node, Ptr<Object> root);
     /**
-     * Parse an index on the Config path.
+     * Parse one element of the Config paths.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] item The path element.
+     * \param [in] node The node of the Config paths after \pname{item}.
+     * \param [in] root The object corresponding to the current position
+     *                  in the Config path.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoResolveItem(const std::string& item, const PathTree::Node& node, Ptr<Object> root);
     /**
-     * Handle one object found on the path.
+     * Parse an attribute element of the Config paths.
      *
-     * \param [in] object The current object on the Config path.
+     * \param [in] info The attribute matching the path element.
+     * \param [in] item The path element.
+     * \param [in] node The node of the Config paths after \pname{item}.
+     * \param [in] root The object corresponding to the current position
+     *                  in the Config path.
+     * \returns \c true if the attribute is an object or a container.
      */
-    void DoResolveOne(Ptr<Object> object);
+    bool DoResolveAttribute(const TypeId::AttributeInformation& info,
+                            const std::string& item,
+                            const PathTree::Node& node,
+                            Ptr<Object> root);
+    /**
+     * Parse an index on the Config paths.
+     *
+     * \param [in] node The node of the remaining Config paths.
+     * \param [in,out] vector The resulting list of matching objects.
+     */
+    void DoArrayResolve(const PathTree::Node& node, const ObjectPtrContainerValue& vector);
     /**
      * Get the current Config path.
      *
@@ -365,23 +532,23 @@ class Resolver
     /**
      * Handle one found object.
      *
+     * \param [in] path The index of the matching Config path.
      * \param [in] object The found object.
-     * \param [in] path The matching Config path context.
+     * \param [in] context The matching Config path context.
      */
-    virtual void DoOne(Ptr<Object> object, std::string path) = 0;
+    virtual void DoOne(std::size_t path, Ptr<Object> object, const std::string& context) = 0;
 
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
-    /** The Config path. */
-    std::string m_path;
+    /** The Config paths. */
+    const PathTree& m_tree;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
-    : m_path(path)
+Resolver::Resolver(const PathTree& tree)
+    : m_tree(tree)
 {
-    NS_LOG_FUNCTION(this << path);
-    Canonicalize();
+    NS_LOG_FUNCTION(this << &tree);
 }
 
 Resolver::~Resolver()
@@ -389,32 +556,12 @@ Resolver::~Resolver()
     NS_LOG_FUNCTION(this);
 }
 
-void
-Resolver::Canonicalize()
-{
-    NS_LOG_FUNCTION(this);
-
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
-    {
-        // no slash at start
-        m_path = "/" + m_path;
-    }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
-    {
-        // no slash at end
-        m_path = m_path + "/";
-    }
-}
-
 void
 Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(m_tree.GetRoot(), root);
 }
 
 std::string
@@ -432,39 +579,37 @@ Resolver::GetResolvedPath() const
 }
 
 void
-Resolver::DoResolveOne(Ptr<Object> object)
+Resolver::DoResolve(const PathTree::Node& node, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << object);
-
-    NS_LOG_DEBUG("resolved=" << GetResolvedPath());
-    DoOne(object, GetResolvedPath());
-}
+    NS_LOG_FUNCTION(this << &node << root);
 
-void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
-{
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-
-    if (next == std::string::npos)
+    //
+    // If root is zero, we're beginning to see if we can use the object name
+    // service to resolve this path.  It is impossible to have a object name
+    // associated with the root of the object name service since that root
+    // is not an object.  This path must be referring to something in another
+    // namespace and it will have been found already since the name service
+    // is always consulted last.
+    //
+    if (root && !node.paths.empty())
     {
-        //
-        // If root is zero, we're beginning to see if we can use the object name
-        // service to resolve this path.  It is impossible to have a object name
-        // associated with the root of the object name service since that root
-        // is not an object.  This path must be referring to something in another
-        // namespace and it will have been found already since the name service
-        // is always consulted last.
-        //
-        if (root)
+        std::string resolved = GetResolvedPath();
+        NS_LOG_DEBUG("resolved=" << resolved);
+        for (std::size_t path : node.paths)
         {
-            DoResolveOne(root);
+            DoOne(path, root, resolved);
         }
-        return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    for (const auto& child : node.children)
+    {
+        DoResolveItem(child.first, *child.second, root);
+    }
+}
+
+void
+Resolver::DoResolveItem(const std::string& item, const PathTree::Node& node, Ptr<Object> root)
+{
+    NS_LOG_FUNCTION(this << item << &node << root);
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -475,11 +620,10 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
+        if (item.compare(0, 5, "Names") == 0)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(node, root);
             m_workStack.pop_back();
             return;
         }
@@ -496,7 +640,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(node, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -526,71 +670,36 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(node, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
         bool foundMatch = false;
-
-        do
+        if (item == "*")
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            TypeId tid;
+            TypeId nextTid = root->GetInstanceTypeId();
+            do
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
-                {
-                    continue;
-                }
-                // attempt to cast to a pointer checker.
-                const PointerChecker* pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const ObjectPtrContainerChecker* vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
+                tid = nextTid;
+                for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
                 {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
+                    foundMatch |= DoResolveAttribute(tid.GetAttribute(i), item, node, root);
                 }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                nextTid = tid.GetParent();
+            } while (nextTid != tid);
+        }
+        else
+        {
+            // look the attribute up in the by-name index of its TypeId
+            TypeId::AttributeInformation info;
+            if (root->GetInstanceTypeId().LookupAttributeByName(item, &info))
+            {
+                foundMatch = DoResolveAttribute(info, item, node, root);
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+        }
 
         if (!foundMatch)
         {
@@ -601,31 +710,83 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     }
 }
 
-void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+bool
+Resolver::DoResolveAttribute(const TypeId::AttributeInformation& info,
+                             const std::string& item,
+                             const PathTree::Node& node,
+                             Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << info.name << item << &node << root);
+    bool foundMatch = false;
+    // attempt to cast to a pointer checker.
+    const PointerChecker* pChecker = dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
+    if (pChecker != nullptr)
     {
-        return;
+        NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name << " on path=" << GetResolvedPath());
+        PointerValue pValue;
+        root->GetAttribute(info.name, pValue);
+        Ptr<Object> object = pValue.Get<Object>();
+        if (!object)
+        {
+            NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                    << GetResolvedPath()
+                                                    << "\""
+                                                       " but is null.");
+            return false;
+        }
+        foundMatch = true;
+        m_workStack.push_back(info.name);
+        DoResolve(node, object);
+        m_workStack.pop_back();
+    }
+    // attempt to cast to an object vector.
+    const ObjectPtrContainerChecker* vectorChecker =
+        dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
+    if (vectorChecker != nullptr)
+    {
+        NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath());
+        foundMatch = true;
+        ObjectPtrContainerValue vector;
+        root->GetAttribute(info.name, vector);
+        m_workStack.push_back(info.name);
+        DoArrayResolve(node, vector);
+        m_workStack.pop_back();
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    // this could be anything else and we don't know what to do with it.
+    // So, we just ignore it.
+    return foundMatch;
+}
+
+void
+Resolver::DoArrayResolve(const PathTree::Node& node, const ObjectPtrContainerValue& container)
+{
+    NS_LOG_FUNCTION(this << &node << &container);
 
-    ArrayMatcher matcher = ArrayMatcher(item);
-    ObjectPtrContainerValue::Iterator it;
-    for (it = container.Begin(); it != container.End(); ++it)
+    for (const auto& child : node.children)
     {
-        if (matcher.Matches((*it).first))
+        ArrayMatcher matcher = ArrayMatcher(child.first);
+        std::size_t index;
+        if (matcher.GetSingleIndex(&index))
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
+            // no need to go through the whole container
+            Ptr<Object> object = container.Get(index);
+            if (object)
+            {
+                m_workStack.push_back(std::to_string(index));
+                DoResolve(*child.second, object);
+                m_workStack.pop_back();
+            }
+            continue;
+        }
+        ObjectPtrContainerValue::Iterator it;
+        for (it = container.Begin(); it != container.End(); ++it)
+        {
+            if (matcher.Matches((*it).first))
+            {
+                m_workStack.push_back(std::to_string((*it).first));
+                DoResolve(*child.second, (*it).second);
+                m_workStack.pop_back();
+            }
         }
     }
 }
@@ -664,7 +825,12 @@ class ConfigImpl : public Singleton<ConfigImpl>
     /** \copydoc ns3::Config::GetRootNamespaceObject() */
     Ptr<Object> GetRootNamespaceObject(std::size_t i) const;
 
-  private:
+    /**
+     * Resolve Config paths from all the roots.
+     * \param [in] resolver The Resolver of the Config paths.
+     */
+    void Resolve(Resolver& resolver) const;
+
     /**
      * Break a Config path into the leading path and the last leaf token.
      * \param [in] path The Config path.
@@ -674,6 +840,8 @@ class ConfigImpl : public Singleton<ConfigImpl>
      */
     void ParsePath(std::string path, std::string* root, std::string* leaf) const;
 
+  private:
+
     /** Container type to hold the root Config path tokens. */
     typedef std::vector<Ptr<Object>> Roots;
 
@@ -786,20 +954,35 @@ ConfigImpl::LookupMatches(std::string path)
     class LookupMatchesResolver : public Resolver
     {
       public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
+        LookupMatchesResolver(const PathTree& tree)
+            : Resolver(tree)
         {
         }
 
-        void DoOne(Ptr<Object> object, std::string path) override
+        void DoOne(std::size_t path [[maybe_unused]],
+                   Ptr<Object> object,
+                   const std::string& context) override
         {
             m_objects.push_back(object);
-            m_contexts.push_back(path);
+            m_contexts.push_back(context);
         }
 
         std::vector<Ptr<Object>> m_objects;
         std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+    };
+
+    PathTree tree;
+    tree.Add(path);
+    LookupMatchesResolver resolver(tree);
+    Resolve(resolver);
+
+    return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
+}
+
+void
+ConfigImpl::Resolve(Resolver& resolver) const
+{
+    NS_LOG_FUNCTION(this << &resolver);
 
     for (Roots::const_iterator i = m_roots.begin(); i != m_roots.end(); i++)
     {
@@ -812,8 +995,6 @@ ConfigImpl::LookupMatches(std::string path)
     // looking at the root of the "/Names" namespace during this go.
     //
     resolver.Resolve(nullptr);
-
-    return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
 }
 
 void
@@ -852,6 +1033,152 @@ ConfigImpl::GetRootNamespaceObject(std::size_t i) const
     return m_roots[i];
 }
 
+/** The operation of a Config path of a PathBatch. */
+struct PathBatch::Operation
+{
+    /** The kinds of operations. */
+    enum Kind
+    {
+        SET,                    //!< Set an attribute
+        CONNECT,                //!< Connect a trace source
+        CONNECT_WITHOUT_CONTEXT //!< Connect a trace source without context
+    };
+
+    Kind kind;                 //!< The kind of operation
+    std::string path;          //!< The Config path
+    std::string leaf;          //!< The name of the attribute or trace source
+    Ptr<AttributeValue> value; //!< The value of the attribute
+    CallbackBase cb;           //!< The callback of the trace source
+};
+
+PathBatch::PathBatch()
+    : m_tree(std::make_unique<PathTree>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PathBatch::~PathBatch()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PathBatch::Add(std::string path, Operation operation)
+{
+    NS_LOG_FUNCTION(this << path);
+    std::string root;
+    ConfigImpl::Get()->ParsePath(path, &root, &operation.leaf);
+    operation.path = path;
+    std::size_t i = m_tree->Add(root);
+    NS_ASSERT(i == m_operations.size());
+    m_operations.push_back(operation);
+}
+
+void
+PathBatch::Set(std::string path, const AttributeValue& value)
+{
+    NS_LOG_FUNCTION(this << path << &value);
+    Operation operation;
+    operation.kind = Operation::SET;
+    operation.value = value.Copy();
+    Add(path, operation);
+}
+
+void
+PathBatch::Connect(std::string path, const CallbackBase& cb)
+{
+    NS_LOG_FUNCTION(this << path << &cb);
+    Operation operation;
+    operation.kind = Operation::CONNECT;
+    operation.cb = cb;
+    Add(path, operation);
+}
+
+void
+PathBatch::ConnectWithoutContext(std::string path, const CallbackBase& cb)
+{
+    NS_LOG_FUNCTION(this << path << &cb);
+    Operation operation;
+    operation.kind = Operation::CONNECT_WITHOUT_CONTEXT;
+    operation.cb = cb;
+    Add(path, operation);
+}
+
+std::size_t
+PathBatch::GetN() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_operations.size();
+}
+
+void
+PathBatch::Apply()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<bool> done = DoApply();
+    for (std::size_t i = 0; i < done.size(); ++i)
+    {
+        if (!done[i])
+        {
+            NS_FATAL_ERROR("Could not apply " << m_operations[i].path);
+        }
+    }
+}
+
+bool
+PathBatch::ApplyFailSafe()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<bool> done = DoApply();
+    return std::find(done.begin(), done.end(), false) == done.end();
+}
+
+std::vector<bool>
+PathBatch::DoApply()
+{
+    NS_LOG_FUNCTION(this);
+
+    class PathBatchResolver : public Resolver
+    {
+      public:
+        PathBatchResolver(const PathTree& tree, const std::vector<Operation>& operations)
+            : Resolver(tree),
+              m_operations(operations),
+              m_done(operations.size(), false)
+        {
+        }
+
+        void DoOne(std::size_t path, Ptr<Object> object, const std::string& context) override
+        {
+            const Operation& operation = m_operations[path];
+            bool ok = false;
+            switch (operation.kind)
+            {
+            case Operation::SET:
+                ok = object->SetAttributeFailSafe(operation.leaf, *operation.value);
+                break;
+            case Operation::CONNECT:
+                ok = object->TraceConnect(operation.leaf, context + operation.leaf, operation.cb);
+                break;
+            case Operation::CONNECT_WITHOUT_CONTEXT:
+                ok = object->TraceConnectWithoutContext(operation.leaf, operation.cb);
+                break;
+            }
+            if (ok)
+            {
+                m_done[path] = true;
+            }
+        }
+
+        const std::vector<Operation>& m_operations;
+        std::vector<bool> m_done;
+    };
+
+    PathBatchResolver resolver(*m_tree, m_operations);
+    ConfigImpl::Get()->Resolve(resolver);
+    return resolver.m_done;
+}
+
 void
 Reset()
 {
@@ -21,6 +21,7 @@
 
 #include "ptr.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -361,6 +362,99 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+class PathTree;
+
+/**
+ * \ingroup config
+ * \brief A set of Config::Set and Config::Connect operations, done
+ * together.
+ *
+ * The paths are parsed once, when they are added, into a tree of path
+ * elements, and Apply() resolves all of them in a single visit of the
+ * objects: the objects matching a prefix shared by several paths, like
+ * all the devices of all the nodes, are found once for all the paths, and
+ * a path element with a single index, like "/NodeList/12", looks the index
+ * up instead of going through the whole list.  Setting or connecting many
+ * paths on a large topology is much faster this way than with a call to
+ * Config::Set or Config::Connect per path.
+ *
+ * The operations are done in the order of the matched objects, not in the
+ * order in which they were added.  A PathBatch can be applied again
+ * without parsing its paths again, but each Apply() does every operation
+ * on every matching object: the objects already connected by a previous
+ * Apply() are connected again, and their trace sources then call the
+ * callback once per Apply().  To connect only the objects created since,
+ * use another PathBatch whose paths match only those objects.
+ */
+class PathBatch
+{
+  public:
+    PathBatch();
+    ~PathBatch();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PathBatch(const PathBatch&) = delete;
+    PathBatch& operator=(const PathBatch&) = delete;
+
+    /**
+     * \param [in] path A path to match attributes.
+     * \param [in] value The value to set in all matching attributes.
+     *
+     * Add a Config::Set operation.
+     */
+    void Set(std::string path, const AttributeValue& value);
+    /**
+     * \param [in] path A path to match trace sources.
+     * \param [in] cb The callback to connect to the matching trace sources.
+     *
+     * Add a Config::Connect operation.
+     */
+    void Connect(std::string path, const CallbackBase& cb);
+    /**
+     * \param [in] path A path to match trace sources.
+     * \param [in] cb The callback to connect to the matching trace sources.
+     *
+     * Add a Config::ConnectWithoutContext operation.
+     */
+    void ConnectWithoutContext(std::string path, const CallbackBase& cb);
+    /**
+     * \returns The number of operations.
+     */
+    std::size_t GetN() const;
+    /**
+     * Do all the operations.  If an operation could not be done on any
+     * object, this method will throw a fatal error; use ApplyFailSafe if
+     * this is to be permitted.
+     */
+    void Apply();
+    /**
+     * Do all the operations.
+     * \returns \c true if each operation could be done on at least one
+     *          object.
+     */
+    bool ApplyFailSafe();
+
+  private:
+    struct Operation;
+
+    /**
+     * Add an operation.
+     * \param [in] path The Config path of the operation.
+     * \param [in] operation The operation.
+     */
+    void Add(std::string path, Operation operation);
+    /**
+     * Do all the operations.
+     * \returns For each operation, \c true if it could be done.
+     */
+    std::vector<bool> DoApply();
+
+    /** The paths of the operations. */
+    std::unique_ptr<PathTree> m_tree;
+    /** The operations, in the order of their path in m_tree. */
+    std::vector<Operation> m_operations;
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
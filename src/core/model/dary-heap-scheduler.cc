@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dary-heap-scheduler.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "uinteger.h"
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::DaryHeapScheduler class.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("DaryHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(DaryHeapScheduler);
+
+TypeId
+DaryHeapScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::DaryHeapScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<DaryHeapScheduler>()
+            .AddAttribute("Arity",
+                          "Number of children of each heap node, a power of 2.",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(&DaryHeapScheduler::SetArity,
+                                               &DaryHeapScheduler::GetArity),
+                          MakeUintegerChecker<uint32_t>(2, 64));
+    return tid;
+}
+
+DaryHeapScheduler::DaryHeapScheduler()
+    : m_log2Arity(0),
+      m_root(0)
+{
+    NS_LOG_FUNCTION(this);
+    SetArity(4);
+}
+
+DaryHeapScheduler::~DaryHeapScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+DaryHeapScheduler::SetArity(uint32_t arity)
+{
+    NS_LOG_FUNCTION(this << arity);
+    NS_ABORT_MSG_IF(arity < 2 || (arity & (arity - 1)) != 0,
+                    "DaryHeapScheduler arity must be a power of 2, not " << arity);
+    NS_ABORT_MSG_IF(m_ts.size() > m_root, "Cannot change the arity of a non-empty heap");
+    m_log2Arity = 0;
+    while ((1U << m_log2Arity) < arity)
+    {
+        ++m_log2Arity;
+    }
+    // Pad the start of the arrays so that the root is at slot arity - 1
+    // and every group of siblings starts at a multiple of the arity.
+    m_root = arity - 1;
+    m_ts.assign(m_root, 0);
+    m_items.assign(m_root, Item{0, 0, nullptr});
+}
+
+uint32_t
+DaryHeapScheduler::GetArity() const
+{
+    return 1U << m_log2Arity;
+}
+
+std::size_t
+DaryHeapScheduler::Parent(std::size_t slot) const
+{
+    return ((slot - m_root - 1) >> m_log2Arity) + m_root;
+}
+
+std::size_t
+DaryHeapScheduler::FirstChild(std::size_t slot) const
+{
+    return ((slot - m_root) << m_log2Arity) + 1 + m_root;
+}
+
+bool
+DaryHeapScheduler::IsLess(std::size_t a, std::size_t b) const
+{
+    return m_ts[a] < m_ts[b] || (m_ts[a] == m_ts[b] && m_items[a].uid < m_items[b].uid);
+}
+
+bool
+DaryHeapScheduler::IsLess(const Scheduler::Event& ev, std::size_t slot) const
+{
+    return ev.key.m_ts < m_ts[slot] ||
+           (ev.key.m_ts == m_ts[slot] && ev.key.m_uid < m_items[slot].uid);
+}
+
+void
+DaryHeapScheduler::Move(std::size_t to, std::size_t from)
+{
+    m_ts[to] = m_ts[from];
+    m_items[to] = m_items[from];
+}
+
+void
+DaryHeapScheduler::Store(std::size_t slot, const Scheduler::Event& ev)
+{
+    m_ts[slot] = ev.key.m_ts;
+    m_items[slot] = Item{ev.key.m_uid, ev.key.m_context, ev.impl};
+}
+
+Scheduler::Event
+DaryHeapScheduler::Get(std::size_t slot) const
+{
+    const Item& item = m_items[slot];
+    return Event{item.impl, {m_ts[slot], item.uid, item.context}};
+}
+
+void
+DaryHeapScheduler::Grow()
+{
+    m_ts.emplace_back();
+    m_items.emplace_back();
+}
+
+void
+DaryHeapScheduler::Shrink()
+{
+    m_ts.pop_back();
+    m_items.pop_back();
+}
+
+void
+DaryHeapScheduler::SiftUp(std::size_t slot, const Scheduler::Event& ev)
+{
+    while (slot > m_root)
+    {
+        std::size_t parent = Parent(slot);
+        if (!IsLess(ev, parent))
+        {
+            break;
+        }
+        Move(slot, parent);
+        slot = parent;
+    }
+    Store(slot, ev);
+}
+
+std::size_t
+DaryHeapScheduler::SmallestChild(std::size_t slot) const
+{
+    const std::size_t size = m_ts.size();
+    const std::size_t first = FirstChild(slot);
+    if (first >= size)
+    {
+        return size;
+    }
+    const std::size_t last = std::min(first + GetArity(), size);
+    std::size_t best = first;
+    for (std::size_t child = first + 1; child < last; ++child)
+    {
+        if (IsLess(child, best))
+        {
+            best = child;
+        }
+    }
+    return best;
+}
+
+void
+DaryHeapScheduler::SiftDown(std::size_t slot, const Scheduler::Event& ev)
+{
+    const std::size_t size = m_ts.size();
+    for (std::size_t child = SmallestChild(slot); child < size; child = SmallestChild(slot))
+    {
+        if (IsLess(ev, child))
+        {
+            break;
+        }
+        Move(slot, child);
+        slot = child;
+    }
+    Store(slot, ev);
+}
+
+void
+DaryHeapScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    Grow();
+    SiftUp(m_ts.size() - 1, ev);
+}
+
+bool
+DaryHeapScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_ts.size() == m_root;
+}
+
+Scheduler::Event
+DaryHeapScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return Get(m_root);
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Event next = Get(m_root);
+    Event last = Get(m_ts.size() - 1);
+    Shrink();
+    if (IsEmpty())
+    {
+        return next;
+    }
+    // Move the hole at the root down to a leaf before placing the last
+    // event: it nearly always belongs near the leaves, so this saves
+    // comparing it with the smallest child at every level.
+    const std::size_t size = m_ts.size();
+    std::size_t slot = m_root;
+    for (std::size_t child = SmallestChild(slot); child < size; child = SmallestChild(slot))
+    {
+        Move(slot, child);
+        slot = child;
+    }
+    SiftUp(slot, last);
+    return next;
+}
+
+void
+DaryHeapScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    const std::size_t size = m_ts.size();
+    for (std::size_t slot = m_root; slot < size; ++slot)
+    {
+        if (m_items[slot].uid != ev.key.m_uid)
+        {
+            continue;
+        }
+        NS_ASSERT(m_items[slot].impl == ev.impl);
+        Event last = Get(size - 1);
+        Shrink();
+        if (slot == size - 1)
+        {
+            return;
+        }
+        // Put the last event in the hole, towards the root or the leaves
+        if (slot > m_root && IsLess(last, Parent(slot)))
+        {
+            SiftUp(slot, last);
+        }
+        else
+        {
+            SiftDown(slot, last);
+        }
+        return;
+    }
+    NS_ASSERT(false);
+}
+
+} // namespace ns3
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DARY_HEAP_SCHEDULER_H
+#define DARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::DaryHeapScheduler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a d-ary heap event scheduler with a structure-of-arrays layout
+ *
+ * This is an implicit heap like HeapScheduler, but each node has
+ * \c Arity children (4 by default, any power of 2 up to 64) and the
+ * time stamps are kept in an array of their own, apart from the uids,
+ * contexts and EventImpl pointers.  Finding the smallest child only
+ * reads time stamps, which are contiguous, so with 8-byte time stamps
+ * the four children of a 4-ary node share half a cache line and the
+ * eight children of an 8-ary node a whole one; uids are only read to
+ * break ties.  The arrays are offset so that every sibling group starts
+ * at a multiple of \c Arity.
+ *
+ * Compared with the binary heap the tree is half (4-ary) or a third
+ * (8-ary) as deep, so an insertion touches fewer cache lines, and a
+ * removal trades more comparisons per level for fewer, more local levels.
+ * This pays off once the pending event set no longer fits in cache.
+ *
+ * Elements are moved into a hole rather than swapped pairwise, and
+ * RemoveNext() moves the hole left at the root all the way down to a
+ * leaf before sifting the last event up into it (Wegener's bottom-up
+ * heuristic).
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time  | Reason
+ * :----------- | :--------------- | :-----
+ * Insert()     | Logarithmic      | Sift up, \f$ \log_d n \f$ levels
+ * IsEmpty()    | Constant         | Explicit queue size
+ * PeekNext()   | Constant         | Root of the heap
+ * Remove()     | Linear           | Search for the uid, then sift
+ * RemoveNext() | Logarithmic      | Sift down, \f$ d \log_d n \f$ comparisons
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 2 x `sizeof (std::vector)`<br/>(48 bytes) | Two arrays
+ * Per Event | 24 bytes                         | Time stamp, uid, context, pointer
+ *
+ */
+class DaryHeapScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    DaryHeapScheduler();
+    /** Destructor. */
+    ~DaryHeapScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /**
+     * Set the number of children of each node; only allowed while empty.
+     *
+     * \param [in] arity The arity, a power of 2.
+     */
+    void SetArity(uint32_t arity);
+    /**
+     * Get the number of children of each node.
+     *
+     * \returns The arity.
+     */
+    uint32_t GetArity() const;
+
+    /**
+     * Get the slot of the parent of a given slot.
+     *
+     * \param [in] slot The child slot.
+     * \returns The parent slot.
+     */
+    inline std::size_t Parent(std::size_t slot) const;
+    /**
+     * Get the slot of the first child of a given slot.
+     *
+     * \param [in] slot The parent slot.
+     * \returns The first child slot.
+     */
+    inline std::size_t FirstChild(std::size_t slot) const;
+    /**
+     * Compare (less than) the events in two slots.
+     *
+     * \param [in] a The first slot.
+     * \param [in] b The second slot.
+     * \returns \c true if the event in \c a comes before the one in \c b.
+     */
+    inline bool IsLess(std::size_t a, std::size_t b) const;
+    /**
+     * Compare (less than) an event with the event in a slot.
+     *
+     * \param [in] ev The event.
+     * \param [in] slot The slot.
+     * \returns \c true if \c ev comes before the event in \c slot.
+     */
+    inline bool IsLess(const Scheduler::Event& ev, std::size_t slot) const;
+    /**
+     * Move the event in a slot to another slot.
+     *
+     * \param [in] to The destination slot.
+     * \param [in] from The source slot.
+     */
+    inline void Move(std::size_t to, std::size_t from);
+    /**
+     * Store an event in a slot.
+     *
+     * \param [in] slot The slot.
+     * \param [in] ev The event.
+     */
+    inline void Store(std::size_t slot, const Scheduler::Event& ev);
+    /**
+     * Get the event in a slot.
+     *
+     * \param [in] slot The slot.
+     * \returns The event.
+     */
+    inline Scheduler::Event Get(std::size_t slot) const;
+    /** Append an empty slot at the end of the arrays. */
+    void Grow();
+    /** Remove the last slot of the arrays. */
+    void Shrink();
+    /**
+     * Move the hole at a slot up until an event fits in it, and store
+     * the event there.
+     *
+     * \param [in] slot The slot of the hole.
+     * \param [in] ev The event to place.
+     */
+    void SiftUp(std::size_t slot, const Scheduler::Event& ev);
+    /**
+     * Get the child of a slot holding the earliest event.
+     *
+     * \param [in] slot The parent slot.
+     * \returns The child slot, or the heap size if \c slot is a leaf.
+     */
+    std::size_t SmallestChild(std::size_t slot) const;
+    /**
+     * Move the hole at a slot down until an event fits in it, and store
+     * the event there.
+     *
+     * \param [in] slot The slot of the hole.
+     * \param [in] ev The event to place.
+     */
+    void SiftDown(std::size_t slot, const Scheduler::Event& ev);
+
+    /** The fields of an event other than its time stamp. */
+    struct Item
+    {
+        uint32_t uid;     //!< Event uid
+        uint32_t context; //!< Event context
+        EventImpl* impl;  //!< Event
+    };
+
+    std::vector<uint64_t> m_ts; //!< Event time stamps
+    std::vector<Item> m_items;  //!< Other event fields, same slots
+    uint32_t m_log2Arity;       //!< Base 2 logarithm of the arity
+    std::size_t m_root;         //!< Slot of the root (arity - 1)
+};
+
+} // namespace ns3
+
+#endif /* DARY_HEAP_SCHEDULER_H */
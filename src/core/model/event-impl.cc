@@ -21,6 +21,13 @@
 
 #include "log.h"
 
+#ifdef ENABLE_EVENT_POOL
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#endif
+
 /**
  * \file
  * \ingroup events
@@ -32,6 +39,454 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+#ifdef ENABLE_EVENT_POOL
+
+namespace
+{
+
+/**
+ * \ingroup events
+ * Event storage pool.
+ *
+ * Blocks are grouped in size classes of EVENT_POOL_ALIGN bytes, and carved
+ * from slabs of EVENT_POOL_SLAB bytes which each hold blocks of a single
+ * size class. Each thread keeps a free list per size class, so allocation
+ * and release are a list pop and push without locking. A thread whose free
+ * list runs empty takes a batch of EVENT_POOL_BATCH blocks from the shared
+ * depot (or carves a new slab), and a thread whose free list grows beyond
+ * twice that hands a batch back, so events scheduled from one thread and
+ * released in another do not accumulate. When a thread exits, its free
+ * lists go back to the depot.
+ *
+ * Whenever the free blocks of a size class in the depot have doubled since
+ * it was last trimmed, the slabs whose blocks are all free are returned to
+ * the system. The depot itself is never destroyed, since an event may be
+ * released after it would have been (e.g. by a static Timer).
+ */
+constexpr std::size_t EVENT_POOL_ALIGN = 16;  //!< Size class granularity (bytes)
+constexpr std::size_t EVENT_POOL_CLASSES = 16; //!< Number of size classes
+constexpr std::size_t EVENT_POOL_MAX = EVENT_POOL_ALIGN * EVENT_POOL_CLASSES; //!< Largest pooled size
+constexpr std::size_t EVENT_POOL_BATCH = 64;     //!< Blocks moved to or from the depot at once
+constexpr std::size_t EVENT_POOL_SLAB = 1 << 16; //!< Slab size and alignment (bytes)
+constexpr std::size_t EVENT_POOL_HEADER = 2 * EVENT_POOL_ALIGN; //!< Offset of the first block of a slab
+
+/** A free block, linked through its first word. */
+struct EventPoolBlock
+{
+    EventPoolBlock* next; //!< Next free block
+};
+
+/** The header at the start of each slab. */
+struct EventPoolSlab
+{
+    std::size_t nBlocks; //!< Number of blocks in the slab
+    std::size_t nFree;   //!< Number of its blocks free in the depot, while trimming
+};
+
+static_assert(sizeof(EventPoolSlab) <= EVENT_POOL_HEADER, "The slab header overlaps the blocks");
+
+/** State of the free lists of a thread. */
+enum EventPoolState
+{
+    EVENT_POOL_UNUSED, //!< The thread has not used the pool yet
+    EVENT_POOL_ACTIVE, //!< The thread keeps free lists
+    EVENT_POOL_EXITED  //!< The thread is exiting and uses the depot directly
+};
+
+/**
+ * Per-thread free lists. Constant-initialized and trivially destructible,
+ * so accessing it needs no thread-local initialization guard, and it can
+ * still be used while the other thread-local objects of the thread are
+ * destroyed.
+ *
+ * Unless the thread is active, each count is 2 * EVENT_POOL_BATCH too
+ * large, so that the fast paths of both allocation and release fall through to
+ * the slow paths, which check the state.
+ */
+struct EventPoolCache
+{
+    EventPoolBlock* head[EVENT_POOL_CLASSES]; //!< Free list per size class
+    std::size_t count[EVENT_POOL_CLASSES];    //!< Length of each free list
+    EventPoolState state;                     //!< State of the free lists
+};
+
+/** Free blocks shared between threads, and every slab they belong to. */
+struct EventPoolDepot
+{
+    std::mutex mutex;                                      //!< Protects the depot
+    EventPoolBlock* head[EVENT_POOL_CLASSES]{};            //!< Free list per size class
+    std::size_t count[EVENT_POOL_CLASSES]{};               //!< Length of each free list
+    std::size_t trimAt[EVENT_POOL_CLASSES]{};              //!< Length which triggers a trim
+    std::vector<EventPoolSlab*> slabs[EVENT_POOL_CLASSES]; //!< Slabs of each size class
+};
+
+/**
+ * \returns The initial free lists of a thread.
+ */
+constexpr EventPoolCache
+MakeEventPoolCache()
+{
+    EventPoolCache cache{};
+    for (auto& count : cache.count)
+    {
+        count = 2 * EVENT_POOL_BATCH;
+    }
+    cache.state = EVENT_POOL_UNUSED;
+    return cache;
+}
+
+thread_local EventPoolCache g_eventPoolCache = MakeEventPoolCache();
+
+/**
+ * Hands the free lists of a thread back to the depot when the thread exits.
+ */
+struct EventPoolReaper
+{
+    /** Destructor. */
+    ~EventPoolReaper();
+    bool used{false}; //!< Set by the first use, which constructs the object
+};
+
+thread_local EventPoolReaper g_eventPoolReaper;
+
+/**
+ * \returns The depot; intentionally never destroyed.
+ */
+EventPoolDepot&
+GetEventPoolDepot()
+{
+    static EventPoolDepot* depot = new EventPoolDepot;
+    return *depot;
+}
+
+/**
+ * \param [in] sizeClass The size class.
+ * \returns The number of blocks in a slab of the size class.
+ */
+std::size_t
+EventPoolBlocksPerSlab(std::size_t sizeClass)
+{
+    return (EVENT_POOL_SLAB - EVENT_POOL_HEADER) / ((sizeClass + 1) * EVENT_POOL_ALIGN);
+}
+
+/**
+ * \param [in] block A block.
+ * \returns The slab of the block.
+ */
+EventPoolSlab*
+EventPoolGetSlab(EventPoolBlock* block)
+{
+    return reinterpret_cast<EventPoolSlab*>(reinterpret_cast<std::uintptr_t>(block) &
+                                            ~(EVENT_POOL_SLAB - 1));
+}
+
+/**
+ * Return to the system the slabs of a size class whose blocks are all
+ * free in the depot. The depot mutex must be held.
+ * \param [in] depot The depot.
+ * \param [in] sizeClass The size class.
+ */
+void
+EventPoolTrim(EventPoolDepot& depot, std::size_t sizeClass)
+{
+    std::vector<EventPoolSlab*>& slabs = depot.slabs[sizeClass];
+    for (auto slab : slabs)
+    {
+        slab->nFree = 0;
+    }
+    for (EventPoolBlock* block = depot.head[sizeClass]; block != nullptr; block = block->next)
+    {
+        ++EventPoolGetSlab(block)->nFree;
+    }
+
+    // Unlink the blocks of the free slabs before releasing them
+    EventPoolBlock** link = &depot.head[sizeClass];
+    while (*link != nullptr)
+    {
+        EventPoolSlab* slab = EventPoolGetSlab(*link);
+        if (slab->nFree == slab->nBlocks)
+        {
+            *link = (*link)->next;
+            --depot.count[sizeClass];
+        }
+        else
+        {
+            link = &(*link)->next;
+        }
+    }
+    std::size_t kept = 0;
+    for (auto slab : slabs)
+    {
+        if (slab->nFree == slab->nBlocks)
+        {
+            ::operator delete(slab, std::align_val_t(EVENT_POOL_SLAB));
+        }
+        else
+        {
+            slabs[kept++] = slab;
+        }
+    }
+    slabs.resize(kept);
+    depot.trimAt[sizeClass] =
+        std::max(2 * depot.count[sizeClass], 2 * EventPoolBlocksPerSlab(sizeClass));
+}
+
+/**
+ * Add a list of free blocks to the depot, and trim the depot if its free
+ * list has grown enough. The depot mutex must be held.
+ * \param [in] depot The depot.
+ * \param [in] sizeClass The size class.
+ * \param [in] first The first block of the list.
+ * \param [in] n The number of blocks of the list.
+ */
+void
+EventPoolPush(EventPoolDepot& depot, std::size_t sizeClass, EventPoolBlock* first, std::size_t n)
+{
+    EventPoolBlock* last = first;
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        last = last->next;
+    }
+    last->next = depot.head[sizeClass];
+    depot.head[sizeClass] = first;
+    depot.count[sizeClass] += n;
+    if (depot.count[sizeClass] >= depot.trimAt[sizeClass])
+    {
+        EventPoolTrim(depot, sizeClass);
+    }
+}
+
+/**
+ * Take free blocks from the depot, carving a new slab if it has none. The
+ * depot mutex must be held.
+ * \param [in] depot The depot.
+ * \param [in] sizeClass The size class.
+ * \param [in,out] n The number of blocks wanted, and then taken.
+ * \returns The first block of the list taken.
+ */
+EventPoolBlock*
+EventPoolTake(EventPoolDepot& depot, std::size_t sizeClass, std::size_t& n)
+{
+    const std::size_t blocksPerSlab = EventPoolBlocksPerSlab(sizeClass);
+    if (depot.head[sizeClass] == nullptr)
+    {
+        const std::size_t blockSize = (sizeClass + 1) * EVENT_POOL_ALIGN;
+        auto slab = static_cast<EventPoolSlab*>(
+            ::operator new(EVENT_POOL_SLAB, std::align_val_t(EVENT_POOL_SLAB)));
+        slab->nBlocks = blocksPerSlab;
+        depot.slabs[sizeClass].push_back(slab);
+        char* blocks = reinterpret_cast<char*>(slab) + EVENT_POOL_HEADER;
+        EventPoolBlock* next = nullptr;
+        for (std::size_t i = blocksPerSlab; i-- > 0;)
+        {
+            auto block = reinterpret_cast<EventPoolBlock*>(blocks + i * blockSize);
+            block->next = next;
+            next = block;
+        }
+        depot.head[sizeClass] = next;
+        depot.count[sizeClass] = blocksPerSlab;
+    }
+
+    EventPoolBlock* first = depot.head[sizeClass];
+    EventPoolBlock* last = first;
+    std::size_t taken = 1;
+    while (taken < n && last->next != nullptr)
+    {
+        last = last->next;
+        ++taken;
+    }
+    depot.head[sizeClass] = last->next;
+    depot.count[sizeClass] -= taken;
+    last->next = nullptr;
+    n = taken;
+
+    // Once the depot has shrunk, trim it again sooner, so that the slabs
+    // freed when the number of events goes down again are returned
+    if (4 * depot.count[sizeClass] < depot.trimAt[sizeClass])
+    {
+        depot.trimAt[sizeClass] = std::max(2 * depot.count[sizeClass], 2 * blocksPerSlab);
+    }
+    return first;
+}
+
+/**
+ * Start keeping free lists in the calling thread.
+ * \param [in,out] cache The free lists of the thread.
+ */
+void
+EventPoolActivate(EventPoolCache& cache)
+{
+    g_eventPoolReaper.used = true;
+    for (auto& count : cache.count)
+    {
+        count -= 2 * EVENT_POOL_BATCH;
+    }
+    cache.state = EVENT_POOL_ACTIVE;
+}
+
+/**
+ * Allocate a block when the calling thread's free list of a size class is
+ * empty.
+ * \param [in] sizeClass The size class.
+ * \returns The block.
+ */
+EventPoolBlock*
+EventPoolAllocate(std::size_t sizeClass)
+{
+    EventPoolCache& cache = g_eventPoolCache;
+    if (cache.state == EVENT_POOL_UNUSED)
+    {
+        EventPoolActivate(cache);
+    }
+    EventPoolDepot& depot = GetEventPoolDepot();
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    if (cache.state == EVENT_POOL_EXITED)
+    {
+        std::size_t n = 1;
+        return EventPoolTake(depot, sizeClass, n);
+    }
+    std::size_t n = EVENT_POOL_BATCH;
+    EventPoolBlock* block = EventPoolTake(depot, sizeClass, n);
+    cache.head[sizeClass] = block->next;
+    cache.count[sizeClass] = n - 1;
+    return block;
+}
+
+/**
+ * Hand blocks of the calling thread's free list of a size class back to
+ * the depot when that list has grown too long: one batch if the thread
+ * is active, or all of them if it is exiting.
+ * \param [in] sizeClass The size class.
+ */
+void
+EventPoolRelease(std::size_t sizeClass)
+{
+    EventPoolCache& cache = g_eventPoolCache;
+    if (cache.state == EVENT_POOL_UNUSED)
+    {
+        EventPoolActivate(cache);
+        return;
+    }
+    EventPoolBlock* first = cache.head[sizeClass];
+    std::size_t n = EVENT_POOL_BATCH;
+    if (cache.state == EVENT_POOL_EXITED)
+    {
+        n = cache.count[sizeClass] - 2 * EVENT_POOL_BATCH;
+        cache.head[sizeClass] = nullptr;
+        cache.count[sizeClass] = 2 * EVENT_POOL_BATCH;
+    }
+    else
+    {
+        EventPoolBlock* last = first;
+        for (std::size_t i = 1; i < n; ++i)
+        {
+            last = last->next;
+        }
+        cache.head[sizeClass] = last->next;
+        cache.count[sizeClass] -= n;
+        last->next = nullptr;
+    }
+
+    EventPoolDepot& depot = GetEventPoolDepot();
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    EventPoolPush(depot, sizeClass, first, n);
+}
+
+EventPoolReaper::~EventPoolReaper()
+{
+    EventPoolCache& cache = g_eventPoolCache;
+    EventPoolDepot& depot = GetEventPoolDepot();
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    for (std::size_t sizeClass = 0; sizeClass < EVENT_POOL_CLASSES; ++sizeClass)
+    {
+        if (cache.head[sizeClass] != nullptr)
+        {
+            EventPoolPush(depot, sizeClass, cache.head[sizeClass], cache.count[sizeClass]);
+        }
+        cache.head[sizeClass] = nullptr;
+        cache.count[sizeClass] = 2 * EVENT_POOL_BATCH;
+        EventPoolTrim(depot, sizeClass);
+    }
+    cache.state = EVENT_POOL_EXITED;
+}
+
+} // unnamed namespace
+
+#endif /* ENABLE_EVENT_POOL */
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+#ifdef ENABLE_EVENT_POOL
+    if (size <= EVENT_POOL_MAX)
+    {
+        const std::size_t sizeClass = (size - 1) / EVENT_POOL_ALIGN;
+        EventPoolCache& cache = g_eventPoolCache;
+        if (cache.head[sizeClass] == nullptr)
+        {
+            return EventPoolAllocate(sizeClass);
+        }
+        EventPoolBlock* block = cache.head[sizeClass];
+        cache.head[sizeClass] = block->next;
+        --cache.count[sizeClass];
+        return block;
+    }
+#endif
+    return ::operator new(size);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+#ifdef ENABLE_EVENT_POOL
+    if (size <= EVENT_POOL_MAX)
+    {
+        const std::size_t sizeClass = (size - 1) / EVENT_POOL_ALIGN;
+        EventPoolCache& cache = g_eventPoolCache;
+        auto block = static_cast<EventPoolBlock*>(p);
+        block->next = cache.head[sizeClass];
+        cache.head[sizeClass] = block;
+        if (++cache.count[sizeClass] > 2 * EVENT_POOL_BATCH)
+        {
+            EventPoolRelease(sizeClass);
+        }
+        return;
+    }
+#endif
+    ::operator delete(p);
+}
+
+std::size_t
+EventImpl::GetPoolSlabCount()
+{
+#ifdef ENABLE_EVENT_POOL
+    EventPoolDepot& depot = GetEventPoolDepot();
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    std::size_t n = 0;
+    for (const auto& slabs : depot.slabs)
+    {
+        n += slabs.size();
+    }
+    return n;
+#else
+    return 0;
+#endif
+}
+
+void*
+EventImpl::operator new(std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void
+EventImpl::operator delete(void* p,
+                           [[maybe_unused]] std::size_t size,
+                           std::align_val_t alignment)
+{
+    ::operator delete(p, alignment);
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
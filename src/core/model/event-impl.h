@@ -21,6 +21,8 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
+#include <new>
 #include <stdint.h>
 
 /**
@@ -67,6 +69,54 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Allocate storage for an event.
+     *
+     * When ns-3 is built with \c NS3_EVENT_POOL, events of
+     * up to 256 bytes are taken from per-thread free lists of fixed-size
+     * blocks which are carved from larger slabs and recycled when the
+     * last reference to an event goes away, so scheduling an event does
+     * not go through the global heap in steady state. The free lists of a
+     * thread are handed back when it exits, and the slabs whose blocks
+     * are all free are returned to the system. Larger events use the
+     * global operator new.
+     *
+     * \param [in] size The size of the concrete event type.
+     * \returns The storage.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release storage allocated by operator new(std::size_t).
+     *
+     * \param [in] p The storage.
+     * \param [in] size The size of the concrete event type.
+     */
+    static void operator delete(void* p, std::size_t size);
+    /**
+     * Allocate storage for an over-aligned event type (never pooled).
+     *
+     * \param [in] size The size of the concrete event type.
+     * \param [in] alignment The alignment of the concrete event type.
+     * \returns The storage.
+     */
+    static void* operator new(std::size_t size, std::align_val_t alignment);
+    /**
+     * Release storage allocated by operator new(std::size_t,std::align_val_t).
+     *
+     * \param [in] p The storage.
+     * \param [in] size The size of the concrete event type.
+     * \param [in] alignment The alignment of the concrete event type.
+     */
+    static void operator delete(void* p, std::size_t size, std::align_val_t alignment);
+
+    /**
+     * Get the number of slabs held by the event pool.
+     *
+     * \returns The number of slabs, or 0 when ns-3 is built without
+     * \c NS3_EVENT_POOL.
+     */
+    static std::size_t GetPoolSlabCount();
+
   protected:
     /**
      * Implementation for Invoke().
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace
+{
+
+/** Number of events in a bucket above which it spawns a new rung. */
+constexpr std::size_t LADDER_THRESHOLD = 50;
+/** Maximum number of rungs. */
+constexpr std::size_t LADDER_MAX_RUNGS = 8;
+
+} // unnamed namespace
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+std::size_t
+LadderScheduler::Rung::Index(uint64_t ts) const
+{
+    return (ts - start) / width;
+}
+
+uint64_t
+LadderScheduler::Rung::CurrentStart() const
+{
+    return start + current * width;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_topStart(0),
+      m_nRungs(0),
+      m_bottomHead(0),
+      m_size(0)
+{
+    NS_LOG_FUNCTION(this);
+    // Never reallocated, so buckets can be referenced while spawning rungs
+    m_rungs.resize(LADDER_MAX_RUNGS);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+int
+LadderScheduler::FindTier(uint64_t ts) const
+{
+    if (ts >= m_topStart)
+    {
+        return -1;
+    }
+    for (std::size_t i = 0; i < m_nRungs; ++i)
+    {
+        if (ts >= m_rungs[i].CurrentStart())
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return static_cast<int>(m_nRungs);
+}
+
+void
+LadderScheduler::InsertBottom(const Scheduler::Event& ev)
+{
+    auto pos = std::upper_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev);
+    m_bottom.insert(pos, ev);
+}
+
+void
+LadderScheduler::SpawnRung(Bucket& events, uint64_t start, uint64_t span)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << span);
+    NS_ASSERT(m_nRungs < LADDER_MAX_RUNGS);
+    Rung& rung = m_rungs[m_nRungs];
+    rung.start = start;
+    rung.width = std::max<uint64_t>(1, (span + events.size() - 1) / events.size());
+    rung.nBuckets = (span + rung.width - 1) / rung.width;
+    rung.current = 0;
+    rung.count = events.size();
+    if (rung.buckets.size() < rung.nBuckets)
+    {
+        rung.buckets.resize(rung.nBuckets);
+    }
+    for (const auto& ev : events)
+    {
+        NS_ASSERT(rung.Index(ev.key.m_ts) < rung.nBuckets);
+        rung.buckets[rung.Index(ev.key.m_ts)].push_back(ev);
+    }
+    events.clear();
+    ++m_nRungs;
+}
+
+void
+LadderScheduler::TransferTop()
+{
+    NS_LOG_FUNCTION(this << m_top.size());
+    NS_ASSERT(m_nRungs == 0 && m_bottomHead == m_bottom.size() && !m_top.empty());
+    if (m_top.size() <= LADDER_THRESHOLD || m_topMin == m_topMax)
+    {
+        m_topStart = m_topMax + 1;
+        m_bottom.clear();
+        m_bottomHead = 0;
+        m_bottom.swap(m_top);
+        std::sort(m_bottom.begin(), m_bottom.end());
+    }
+    else
+    {
+        SpawnRung(m_top, m_topMin, m_topMax - m_topMin + 1);
+        const Rung& rung = m_rungs[0];
+        m_topStart = rung.start + rung.nBuckets * rung.width;
+    }
+    m_topMin = std::numeric_limits<uint64_t>::max();
+    m_topMax = 0;
+}
+
+void
+LadderScheduler::FillBottom()
+{
+    if (m_bottomHead < m_bottom.size())
+    {
+        return;
+    }
+    m_bottom.clear();
+    m_bottomHead = 0;
+    while (true)
+    {
+        if (m_nRungs == 0)
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            TransferTop();
+            if (!m_bottom.empty())
+            {
+                return;
+            }
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.count == 0)
+        {
+            --m_nRungs;
+            continue;
+        }
+        while (rung.buckets[rung.current].empty())
+        {
+            ++rung.current;
+        }
+        Bucket& bucket = rung.buckets[rung.current];
+        const uint64_t start = rung.CurrentStart();
+        ++rung.current;
+        rung.count -= bucket.size();
+
+        if (bucket.size() > LADDER_THRESHOLD && m_nRungs < LADDER_MAX_RUNGS && rung.width > 1)
+        {
+            auto [minIt, maxIt] = std::minmax_element(bucket.begin(), bucket.end());
+            if (minIt->key.m_ts != maxIt->key.m_ts)
+            {
+                SpawnRung(bucket, start, rung.width);
+                continue;
+            }
+        }
+        m_bottom.swap(bucket);
+        std::sort(m_bottom.begin(), m_bottom.end());
+        return;
+    }
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    int tier = FindTier(ev.key.m_ts);
+    if (tier < 0)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ev.key.m_ts);
+        m_topMax = std::max(m_topMax, ev.key.m_ts);
+    }
+    else if (static_cast<std::size_t>(tier) < m_nRungs)
+    {
+        Rung& rung = m_rungs[tier];
+        rung.buckets[rung.Index(ev.key.m_ts)].push_back(ev);
+        ++rung.count;
+    }
+    else
+    {
+        InsertBottom(ev);
+    }
+    ++m_size;
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    // Refilling Bottom does not change the set of events
+    const_cast<LadderScheduler*>(this)->FillBottom();
+    return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    FillBottom();
+    Event ev = m_bottom[m_bottomHead++];
+    --m_size;
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    int tier = FindTier(ev.key.m_ts);
+    if (static_cast<std::size_t>(tier) == m_nRungs)
+    {
+        auto pos = std::lower_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev);
+        NS_ASSERT(pos != m_bottom.end() && pos->key.m_uid == ev.key.m_uid);
+        m_bottom.erase(pos);
+        --m_size;
+        return;
+    }
+
+    Bucket* bucket = &m_top;
+    if (tier >= 0)
+    {
+        Rung& rung = m_rungs[tier];
+        bucket = &rung.buckets[rung.Index(ev.key.m_ts)];
+        --rung.count;
+    }
+    auto pos = std::find_if(bucket->begin(), bucket->end(), [&ev](const Event& other) {
+        return other.key.m_uid == ev.key.m_uid;
+    });
+    NS_ASSERT(pos != bucket->end());
+    *pos = bucket->back();
+    bucket->pop_back();
+    --m_size;
+}
+
+} // namespace ns3
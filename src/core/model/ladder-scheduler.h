@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the Ladder Queue described in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are kept in three tiers which cover disjoint, increasing time
+ * ranges:
+ *
+ * - \b Bottom: a short sorted list of the earliest events, from which
+ *   events are dequeued;
+ * - \b Ladder: up to 8 rungs of unsorted buckets, each rung
+ *   refining one bucket of the rung above it;
+ * - \b Top: an unsorted list of the events beyond the ladder.
+ *
+ * New events are appended to Top, or to the bucket of the rung covering
+ * their time stamp, in constant time.  Only the events whose time stamp
+ * falls within Bottom are inserted in order, which moves the later events
+ * of Bottom.  When Bottom runs empty the next non-empty bucket of the
+ * lowest rung is sorted into it; a bucket holding more than 50 events is
+ * first spread over a new, finer rung ("rung spawning"), and when the
+ * ladder is empty Top becomes its first rung.  Bucket widths adapt to
+ * the events actually present, so bursts of events at the same or at
+ * nearly the same time do not degrade the structure: a bucket whose
+ * events all share one time stamp is simply sorted into Bottom.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time            | Reason
+ * :----------- | :------------------------- | :-----
+ * Insert()     | Constant, Linear in Bottom | Append to Top or a bucket, or insert into sorted Bottom
+ * IsEmpty()    | Constant                   | Explicit queue size
+ * PeekNext()   | ~Constant                  | Refill Bottom if it is empty
+ * Remove()     | Linear                     | Search Top or a bucket, or erase from Bottom
+ * RemoveNext() | ~Constant                  | Refill Bottom if it is empty
+ *
+ * Sorting a bucket into Bottom is \f$ O(b \log b) \f$ for at most 50
+ * events, except for buckets of identical time stamps or once all 8
+ * rungs are in use, so Bottom can hold a large burst of events.  Bottom
+ * is kept in time order; an event scheduled at the current time goes
+ * behind the other events with the same time stamp, which is the end of
+ * Bottom when it holds a burst, so it moves no other event.  Inserting
+ * an earlier event into Bottom, or removing an event from it, moves the
+ * later events of Bottom, and removing an event from Top or a bucket
+ * searches it, so Insert() and Remove() are linear in the size of that
+ * tier or bucket.
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | ~ 1 KB                           | Rungs and tier bookkeeping
+ * Per Event | 0                                | Events stored in `std::vector`
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Event container used by every tier. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** One rung of the ladder. */
+    struct Rung
+    {
+        uint64_t start;              //!< Time stamp at the start of bucket 0
+        uint64_t width;              //!< Time span of each bucket
+        std::size_t nBuckets;        //!< Number of buckets in use
+        std::size_t current;         //!< First bucket not yet moved down
+        std::size_t count;           //!< Number of events in the rung
+        std::vector<Bucket> buckets; //!< The buckets
+
+        /**
+         * Get the bucket covering a time stamp.
+         *
+         * \param [in] ts The time stamp.
+         * \returns The bucket index.
+         */
+        std::size_t Index(uint64_t ts) const;
+        /**
+         * Get the first time stamp not yet moved down the ladder.
+         *
+         * \returns The start of the current bucket.
+         */
+        uint64_t CurrentStart() const;
+    };
+
+    /**
+     * Find the tier an event belongs to.
+     *
+     * \param [in] ts The time stamp of the event.
+     * \returns The rung index, \c m_nRungs for Bottom, or \c -1 for Top.
+     */
+    int FindTier(uint64_t ts) const;
+    /**
+     * Insert an event in Bottom, keeping it sorted.
+     *
+     * \param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+    /**
+     * Spread a set of events over a new rung.
+     *
+     * \param [in,out] events The events; emptied on return.
+     * \param [in] start The start of the time range of the rung.
+     * \param [in] span The length of the time range of the rung.
+     */
+    void SpawnRung(Bucket& events, uint64_t start, uint64_t span);
+    /** Move the events of Top to a new first rung or, if few, to Bottom. */
+    void TransferTop();
+    /** Move the earliest events into Bottom, if it is empty. */
+    void FillBottom();
+
+    Bucket m_top;              //!< Top tier, unsorted
+    uint64_t m_topMin;         //!< Smallest time stamp in Top
+    uint64_t m_topMax;         //!< Largest time stamp in Top
+    uint64_t m_topStart;       //!< First time stamp belonging to Top
+    std::vector<Rung> m_rungs; //!< Rungs, including spare ones
+    std::size_t m_nRungs;      //!< Number of rungs in use
+    Bucket m_bottom;           //!< Bottom tier, in time order
+    std::size_t m_bottomHead;  //!< First event of Bottom not yet removed
+    std::size_t m_size;        //!< Total number of events
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
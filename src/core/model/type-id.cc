@@ -23,9 +23,11 @@
 #include "singleton.h"
 #include "trace-source-accessor.h"
 
+#include <functional>
 #include <iomanip>
 #include <map>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -263,6 +265,30 @@ class IidManager : public Singleton<IidManager>
      * \returns Detailed information about the requested trace source.
      */
     TypeId::TraceSourceInformation GetTraceSource(uint16_t uid, std::size_t i) const;
+    /**
+     * Find an Attribute of a type id or of its parents.
+     * \param [in] uid The id.
+     * \param [in] name The Attribute name.
+     * \param [out] owner The id which registered the Attribute.
+     * \param [out] i The index of the Attribute in \pname{owner}.
+     * \returns \c true if the Attribute was found.
+     */
+    bool FindAttribute(uint16_t uid,
+                       const std::string& name,
+                       uint16_t* owner,
+                       std::size_t* i) const;
+    /**
+     * Find a TraceSource of a type id or of its parents.
+     * \param [in] uid The id.
+     * \param [in] name The TraceSource name.
+     * \param [out] owner The id which registered the TraceSource.
+     * \param [out] i The index of the TraceSource in \pname{owner}.
+     * \returns \c true if the TraceSource was found.
+     */
+    bool FindTraceSource(uint16_t uid,
+                         const std::string& name,
+                         uint16_t* owner,
+                         std::size_t* i) const;
     /**
      * Check if this TypeId should not be listed in documentation.
      * \param [in] uid The id.
@@ -292,6 +318,12 @@ class IidManager : public Singleton<IidManager>
      */
     static TypeId::hash_t Hasher(const std::string name);
 
+    /**
+     * Type of the by-name indexes of the Attributes and TraceSources of a
+     * type id: the hash of the name to the indexes with that hash.
+     */
+    typedef std::unordered_multimap<std::size_t, std::size_t> nameindex_t;
+
     /** The information record about a single type id. */
     struct IidInformation
     {
@@ -315,6 +347,10 @@ class IidManager : public Singleton<IidManager>
         std::vector<TypeId::AttributeInformation> attributes;
         /** The container of TraceSources. */
         std::vector<TypeId::TraceSourceInformation> traceSources;
+        /** The by-name index of the Attributes. */
+        nameindex_t attributeIndex;
+        /** The by-name index of the TraceSources. */
+        nameindex_t traceSourceIndex;
         /** Support level/deprecation. */
         TypeId::SupportLevel supportLevel;
         /** Support message. */
@@ -331,6 +367,25 @@ class IidManager : public Singleton<IidManager>
      */
     IidManager::IidInformation* LookupInformation(uint16_t uid) const;
 
+    /**
+     * Find a name in the by-name indexes of a type id and of its parents.
+     * \tparam T \deduced The Attribute or TraceSource information type.
+     * \param [in] uid The id.
+     * \param [in] name The name.
+     * \param [in] index The index of the IidInformation to search.
+     * \param [in] items The items of the IidInformation to search.
+     * \param [out] owner The id which registered the name.
+     * \param [out] i The index of the item in \pname{owner}.
+     * \returns \c true if the name was found.
+     */
+    template <typename T>
+    bool FindByName(uint16_t uid,
+                    const std::string& name,
+                    nameindex_t IidInformation::*index,
+                    std::vector<T> IidInformation::*items,
+                    uint16_t* owner,
+                    std::size_t* i) const;
+
     /** The container of all type id records. */
     std::vector<IidInformation> m_information;
 
@@ -624,32 +679,11 @@ bool
 IidManager::HasAttribute(uint16_t uid, std::string name)
 {
     NS_LOG_FUNCTION(IID << uid << name);
-    IidInformation* information = LookupInformation(uid);
-    while (true)
-    {
-        for (std::vector<TypeId::AttributeInformation>::const_iterator i =
-                 information->attributes.begin();
-             i != information->attributes.end();
-             ++i)
-        {
-            if (i->name == name)
-            {
-                NS_LOG_LOGIC(IIDL << true);
-                return true;
-            }
-        }
-        IidInformation* parent = LookupInformation(information->parent);
-        if (parent == information)
-        {
-            // top of inheritance tree
-            NS_LOG_LOGIC(IIDL << false);
-            return false;
-        }
-        // check parent
-        information = parent;
-    }
-    NS_LOG_LOGIC(IIDL << false);
-    return false;
+    uint16_t owner;
+    std::size_t i;
+    bool found = FindAttribute(uid, name, &owner, &i);
+    NS_LOG_LOGIC(IIDL << found);
+    return found;
 }
 
 void
@@ -687,6 +721,8 @@ IidManager::AddAttribute(uint16_t uid,
     info.checker = checker;
     info.supportLevel = supportLevel;
     info.supportMsg = supportMsg;
+    information->attributeIndex.emplace(std::hash<std::string>()(name),
+                                        information->attributes.size());
     information->attributes.push_back(info);
     NS_LOG_LOGIC(IIDL << information->attributes.size() - 1);
 }
@@ -726,32 +762,11 @@ bool
 IidManager::HasTraceSource(uint16_t uid, std::string name)
 {
     NS_LOG_FUNCTION(IID << uid << name);
-    IidInformation* information = LookupInformation(uid);
-    while (true)
-    {
-        for (std::vector<TypeId::TraceSourceInformation>::const_iterator i =
-                 information->traceSources.begin();
-             i != information->traceSources.end();
-             ++i)
-        {
-            if (i->name == name)
-            {
-                NS_LOG_LOGIC(IIDL << true);
-                return true;
-            }
-        }
-        IidInformation* parent = LookupInformation(information->parent);
-        if (parent == information)
-        {
-            // top of inheritance tree
-            NS_LOG_LOGIC(IIDL << false);
-            return false;
-        }
-        // check parent
-        information = parent;
-    }
-    NS_LOG_LOGIC(IIDL << false);
-    return false;
+    uint16_t owner;
+    std::size_t i;
+    bool found = FindTraceSource(uid, name, &owner, &i);
+    NS_LOG_LOGIC(IIDL << found);
+    return found;
 }
 
 void
@@ -778,6 +793,8 @@ IidManager::AddTraceSource(uint16_t uid,
     source.callback = callback;
     source.supportLevel = supportLevel;
     source.supportMsg = supportMsg;
+    information->traceSourceIndex.emplace(std::hash<std::string>()(name),
+                                          information->traceSources.size());
     information->traceSources.push_back(source);
     NS_LOG_LOGIC(IIDL << information->traceSources.size() - 1);
 }
@@ -802,6 +819,70 @@ IidManager::GetTraceSource(uint16_t uid, std::size_t i) const
     return information->traceSources[i];
 }
 
+template <typename T>
+bool
+IidManager::FindByName(uint16_t uid,
+                       const std::string& name,
+                       nameindex_t IidInformation::*index,
+                       std::vector<T> IidInformation::*items,
+                       uint16_t* owner,
+                       std::size_t* i) const
+{
+    // The hash is computed once for the whole inheritance tree
+    std::size_t hash = std::hash<std::string>()(name);
+    while (true)
+    {
+        IidInformation* information = LookupInformation(uid);
+        auto range = (information->*index).equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if ((information->*items)[it->second].name == name)
+            {
+                *owner = uid;
+                *i = it->second;
+                return true;
+            }
+        }
+        if (information->parent == uid)
+        {
+            // top of inheritance tree
+            return false;
+        }
+        // check parent
+        uid = information->parent;
+    }
+}
+
+bool
+IidManager::FindAttribute(uint16_t uid,
+                          const std::string& name,
+                          uint16_t* owner,
+                          std::size_t* i) const
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+    return FindByName(uid,
+                      name,
+                      &IidInformation::attributeIndex,
+                      &IidInformation::attributes,
+                      owner,
+                      i);
+}
+
+bool
+IidManager::FindTraceSource(uint16_t uid,
+                            const std::string& name,
+                            uint16_t* owner,
+                            std::size_t* i) const
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+    return FindByName(uid,
+                      name,
+                      &IidInformation::traceSourceIndex,
+                      &IidInformation::traceSources,
+                      owner,
+                      i);
+}
+
 bool
 IidManager::MustHideFromDocumentation(uint16_t uid) const
 {
@@ -898,37 +979,29 @@ bool
 TypeId::LookupAttributeByName(std::string name, TypeId::AttributeInformation* info) const
 {
     NS_LOG_FUNCTION(this << name << info);
-    TypeId tid;
-    TypeId nextTid = *this;
-    do
+    uint16_t owner;
+    std::size_t i;
+    if (!IidManager::Get()->FindAttribute(m_tid, name, &owner, &i))
     {
-        tid = nextTid;
-        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
-        {
-            TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-            if (tmp.name == name)
-            {
-                if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                    *info = tmp;
-                    return true;
-                }
-                else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                    std::cerr << "Attribute '" << name << "' is deprecated: " << tmp.supportMsg
-                              << std::endl;
-                    *info = tmp;
-                    return true;
-                }
-                else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                    NS_FATAL_ERROR("Attribute '" << name << "' is obsolete, with no fallback: "
-                                                 << tmp.supportMsg);
-                }
-            }
-        }
-        nextTid = tid.GetParent();
-    } while (nextTid != tid);
+        return false;
+    }
+    TypeId::AttributeInformation tmp = IidManager::Get()->GetAttribute(owner, i);
+    if (tmp.supportLevel == TypeId::SUPPORTED)
+    {
+        *info = tmp;
+        return true;
+    }
+    else if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+        std::cerr << "Attribute '" << name << "' is deprecated: " << tmp.supportMsg << std::endl;
+        *info = tmp;
+        return true;
+    }
+    else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+        NS_FATAL_ERROR("Attribute '" << name
+                                     << "' is obsolete, with no fallback: " << tmp.supportMsg);
+    }
     return false;
 }
 
@@ -1164,38 +1237,29 @@ Ptr<const TraceSourceAccessor>
 TypeId::LookupTraceSourceByName(std::string name, TraceSourceInformation* info) const
 {
     NS_LOG_FUNCTION(this << name);
-    TypeId tid;
-    TypeId nextTid = *this;
-    TypeId::TraceSourceInformation tmp;
-    do
+    uint16_t owner;
+    std::size_t i;
+    if (!IidManager::Get()->FindTraceSource(m_tid, name, &owner, &i))
     {
-        tid = nextTid;
-        for (std::size_t i = 0; i < tid.GetTraceSourceN(); i++)
-        {
-            tmp = tid.GetTraceSource(i);
-            if (tmp.name == name)
-            {
-                if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                    *info = tmp;
-                    return tmp.accessor;
-                }
-                else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                    std::cerr << "TraceSource '" << name << "' is deprecated: " << tmp.supportMsg
-                              << std::endl;
-                    *info = tmp;
-                    return tmp.accessor;
-                }
-                else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                    NS_FATAL_ERROR("TraceSource '" << name << "' is obsolete, with no fallback: "
-                                                   << tmp.supportMsg);
-                }
-            }
-        }
-        nextTid = tid.GetParent();
-    } while (nextTid != tid);
+        return nullptr;
+    }
+    TypeId::TraceSourceInformation tmp = IidManager::Get()->GetTraceSource(owner, i);
+    if (tmp.supportLevel == TypeId::SUPPORTED)
+    {
+        *info = tmp;
+        return tmp.accessor;
+    }
+    else if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+        std::cerr << "TraceSource '" << name << "' is deprecated: " << tmp.supportMsg << std::endl;
+        *info = tmp;
+        return tmp.accessor;
+    }
+    else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+        NS_FATAL_ERROR("TraceSource '" << name
+                                       << "' is obsolete, with no fallback: " << tmp.supportMsg);
+    }
     return nullptr;
 }
 
@@ -807,6 +807,126 @@ ObjectVectorTraceConfigTestCase::DoRun()
                           "Trace 1 did not provide expected context");
 }
 
+/**
+ * \ingroup config-tests
+ * Test for the ability to set and connect many paths with a PathBatch.
+ */
+class PathBatchConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    PathBatchConfigTestCase();
+
+    /** Destructor. */
+    ~PathBatchConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback without context.
+     * \param oldValue The old value.
+     * \param newValue The new value.
+     */
+    void Trace(int16_t oldValue [[maybe_unused]], int16_t newValue [[maybe_unused]])
+    {
+        m_count++;
+    }
+
+    /**
+     * Trace callback with context path.
+     * \param path The context path.
+     * \param old The old value.
+     * \param newValue The new value.
+     */
+    void TraceWithPath(std::string path, int16_t old [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+        m_path = path;
+    }
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_count{0};   //!< Number of calls of the trace without context.
+    int16_t m_newValue{0}; //!< Flag to detect tracing result.
+    std::string m_path;    //!< The context path.
+};
+
+PathBatchConfigTestCase::PathBatchConfigTestCase()
+    : TestCase("Check ability to set and connect many paths with a PathBatch")
+{
+}
+
+void
+PathBatchConfigTestCase::DoRun()
+{
+    IntegerValue iv;
+
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+    root->SetNodeA(a);
+    std::vector<Ptr<ConfigTestObject>> objects;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        objects.push_back(CreateObject<ConfigTestObject>());
+        a->AddNodeB(objects.back());
+    }
+
+    //
+    // The paths share the "/NodeA/NodesB" prefix, with single indexes,
+    // ranges and regular expressions after it.
+    //
+    Config::PathBatch batch;
+    batch.Connect("/NodeA/NodesB/1/Source",
+                  MakeCallback(&PathBatchConfigTestCase::TraceWithPath, this));
+    batch.Connect("/NodeA/NodesB/[2-3]/Source",
+                  MakeCallback(&PathBatchConfigTestCase::TraceWithPath, this));
+    batch.ConnectWithoutContext("/NodeA/NodesB/*/Source",
+                                MakeCallback(&PathBatchConfigTestCase::Trace, this));
+    batch.Set("/NodeA/NodesB/0|3/A", IntegerValue(3));
+    NS_TEST_ASSERT_MSG_EQ(batch.GetN(), 4, "Unexpected number of operations");
+    NS_TEST_ASSERT_MSG_EQ(batch.ApplyFailSafe(), true, "Could not apply the batch");
+
+    objects[0]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), 3, "Object Attribute \"A\" not set correctly");
+    objects[1]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), 10, "Object Attribute \"A\" set unexpectedly");
+    objects[3]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), 3, "Object Attribute \"A\" not set correctly");
+
+    objects[0]->SetAttribute("Source", IntegerValue(-5));
+    NS_TEST_ASSERT_MSG_EQ(m_count, 1, "Trace 0 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, 0, "Trace 0 fired with context unexpectedly");
+
+    objects[1]->SetAttribute("Source", IntegerValue(-2));
+    NS_TEST_ASSERT_MSG_EQ(m_count, 2, "Trace 1 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, -2, "Trace 1 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_path,
+                          "/NodeA/NodesB/1/Source",
+                          "Trace 1 did not provide expected context");
+
+    objects[3]->SetAttribute("Source", IntegerValue(-4));
+    NS_TEST_ASSERT_MSG_EQ(m_count, 3, "Trace 3 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, -4, "Trace 3 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_path,
+                          "/NodeA/NodesB/3/Source",
+                          "Trace 3 did not provide expected context");
+
+    //
+    // An operation without any match makes the batch fail.
+    //
+    Config::PathBatch missing;
+    missing.Set("/NodeA/NodesB/1/A", IntegerValue(5));
+    missing.ConnectWithoutContext("/NodeA/NodesB/7/Source",
+                                  MakeCallback(&PathBatchConfigTestCase::Trace, this));
+    NS_TEST_ASSERT_MSG_EQ(missing.ApplyFailSafe(), false, "Applied a batch without match");
+    objects[1]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), 5, "Object Attribute \"A\" not set correctly");
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * Test for the ability to search attributes of parent classes
@@ -882,6 +1002,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new PathBatchConfigTestCase);
 }
 
 /**
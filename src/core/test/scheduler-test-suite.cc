@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/dary-heap-scheduler.h"
+#include "ns3/double.h"
+#include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup scheduler-tests
+ * Scheduler ordering test suite
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup scheduler-tests Scheduler ordering tests
+ */
+
+/**
+ * \ingroup scheduler-tests
+ *
+ * \brief Check that a scheduler dequeues the same events in the same
+ * order as HeapScheduler.
+ *
+ * Both schedulers are driven directly with the same trace: an initial
+ * population, then repeatedly the next event is removed and new events
+ * are scheduled relative to its time stamp, and now and then a pending
+ * event is cancelled with Scheduler::Remove.
+ */
+class SchedulerOrderingTestCase : public TestCase
+{
+  public:
+    /** The time stamp distribution of the trace. */
+    enum Trace
+    {
+        RANDOM, //!< Exponential and uniform delays
+        BURSTY  //!< Bursts at the current time and periodic ticks
+    };
+
+    /**
+     * Constructor.
+     * \param [in] factory Factory of the scheduler under test.
+     * \param [in] trace The trace to replay.
+     */
+    SchedulerOrderingTestCase(ObjectFactory factory, Trace trace);
+
+  private:
+    void DoRun() override;
+    /**
+     * Insert a new event in both schedulers.
+     * \param [in] ts The time stamp.
+     * \param [in] periodic Whether the event is a periodic tick.
+     */
+    void Insert(uint64_t ts, bool periodic = false);
+    /**
+     * Schedule the events which follow the execution of an event.
+     * \param [in] ev The event executed.
+     */
+    void ScheduleFollowers(const Scheduler::Event& ev);
+
+    ObjectFactory m_factory;              //!< Scheduler factory
+    Trace m_trace;                        //!< Trace to replay
+    Ptr<Scheduler> m_reference;           //!< HeapScheduler
+    Ptr<Scheduler> m_scheduler;           //!< Scheduler under test
+    std::vector<Scheduler::Event> m_live; //!< Events which may be removed
+    uint32_t m_uid;                       //!< Next uid
+    Ptr<UniformRandomVariable> m_uniform; //!< Random choices
+    Ptr<ExponentialRandomVariable> m_exp; //!< Random delays
+};
+
+SchedulerOrderingTestCase::SchedulerOrderingTestCase(ObjectFactory factory, Trace trace)
+    : TestCase("Check " + factory.GetTypeId().GetName() + " against HeapScheduler, " +
+               (trace == RANDOM ? "random" : "bursty") + " trace"),
+      m_factory(factory),
+      m_trace(trace),
+      m_uid(0)
+{
+}
+
+void
+SchedulerOrderingTestCase::Insert(uint64_t ts, bool periodic)
+{
+    Scheduler::Event ev;
+    ev.impl = nullptr;
+    ev.key.m_ts = ts;
+    ev.key.m_uid = m_uid++;
+    ev.key.m_context = periodic ? 1 : 0;
+    m_reference->Insert(ev);
+    m_scheduler->Insert(ev);
+    if (m_uniform->GetValue() < 0.05)
+    {
+        m_live.push_back(ev);
+    }
+}
+
+void
+SchedulerOrderingTestCase::ScheduleFollowers(const Scheduler::Event& ev)
+{
+    uint64_t now = ev.key.m_ts;
+    if (m_trace == RANDOM)
+    {
+        // Keep the population roughly constant
+        uint32_t n = m_uniform->GetInteger(0, 2);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            uint64_t delay = m_uniform->GetValue() < 0.5
+                                 ? static_cast<uint64_t>(m_exp->GetValue())
+                                 : m_uniform->GetInteger(0, 1000000);
+            Insert(now + delay);
+        }
+        return;
+    }
+
+    // Bursty: each tick schedules the next tick of its node and,
+    // sometimes, a burst of events at the current time or 1 ns later.
+    if (ev.key.m_context == 0)
+    {
+        return;
+    }
+    Insert(now + 1000000, true);
+    double u = m_uniform->GetValue();
+    if (u < 0.02)
+    {
+        uint32_t burst = m_uniform->GetInteger(50, 500);
+        for (uint32_t i = 0; i < burst; ++i)
+        {
+            Insert(now + (i % 3 == 0 ? 1 : 0));
+        }
+    }
+    else if (u < 0.1)
+    {
+        Insert(now + m_uniform->GetInteger(0, 10));
+    }
+}
+
+void
+SchedulerOrderingTestCase::DoRun()
+{
+    m_reference = CreateObject<HeapScheduler>();
+    m_scheduler = m_factory.Create<Scheduler>();
+    m_uniform = CreateObject<UniformRandomVariable>();
+    m_uniform->SetStream(1);
+    m_exp = CreateObject<ExponentialRandomVariable>();
+    m_exp->SetAttribute("Mean", DoubleValue(10000));
+    m_exp->SetStream(2);
+
+    // Initial population: one periodic tick per node for the bursty
+    // trace, random time stamps otherwise
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        if (m_trace == RANDOM)
+        {
+            Insert(m_uniform->GetInteger(0, 1000000));
+        }
+        else
+        {
+            Insert((i % 200) * 5000, true);
+        }
+    }
+
+    uint32_t executed = 0;
+    uint32_t removed = 0;
+    uint64_t now = 0;
+    while (!m_reference->IsEmpty() && executed < 100000)
+    {
+        if (!m_live.empty() && m_uniform->GetValue() < 0.02)
+        {
+            // Cancel an event, unless it has already been executed
+            uint32_t i = m_uniform->GetInteger(0, m_live.size() - 1);
+            Scheduler::Event ev = m_live[i];
+            m_live[i] = m_live.back();
+            m_live.pop_back();
+            if (ev.key.m_ts > now)
+            {
+                m_reference->Remove(ev);
+                m_scheduler->Remove(ev);
+                ++removed;
+            }
+            continue;
+        }
+
+        NS_TEST_ASSERT_MSG_EQ(m_scheduler->IsEmpty(), false, "Scheduler empty too early");
+        Scheduler::Event peek = m_scheduler->PeekNext();
+        Scheduler::Event expected = m_reference->RemoveNext();
+        Scheduler::Event next = m_scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(peek.key.m_uid, next.key.m_uid, "PeekNext and RemoveNext differ");
+        NS_TEST_ASSERT_MSG_EQ(next.key.m_uid,
+                              expected.key.m_uid,
+                              "Wrong event after " << executed << " events");
+        NS_TEST_ASSERT_MSG_EQ(next.key.m_ts, expected.key.m_ts, "Wrong time stamp");
+        now = next.key.m_ts;
+        ++executed;
+        if (now < 200000000)
+        {
+            ScheduleFollowers(next);
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(removed, 0, "The trace did not exercise Remove");
+    NS_TEST_EXPECT_MSG_EQ(m_scheduler->IsEmpty(),
+                          m_reference->IsEmpty(),
+                          "Schedulers do not end with the same events");
+    while (!m_reference->IsEmpty())
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_scheduler->RemoveNext().key.m_uid,
+                              m_reference->RemoveNext().key.m_uid,
+                              "Wrong event while draining");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_scheduler->IsEmpty(), true, "Scheduler not drained");
+}
+
+/**
+ * \ingroup scheduler-tests
+ *
+ * \brief The scheduler ordering Test Suite.
+ */
+class SchedulerTestSuite : public TestSuite
+{
+  public:
+    SchedulerTestSuite()
+        : TestSuite("scheduler")
+    {
+        ObjectFactory factory;
+        for (auto trace : {SchedulerOrderingTestCase::RANDOM, SchedulerOrderingTestCase::BURSTY})
+        {
+            factory.SetTypeId(LadderScheduler::GetTypeId());
+            AddTestCase(new SchedulerOrderingTestCase(factory, trace), TestCase::QUICK);
+            factory.SetTypeId(DaryHeapScheduler::GetTypeId());
+            AddTestCase(new SchedulerOrderingTestCase(factory, trace), TestCase::QUICK);
+        }
+    }
+};
+
+static SchedulerTestSuite g_schedulerTestSuite; //!< Static variable for test initialization
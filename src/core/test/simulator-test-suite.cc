@@ -17,12 +17,20 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/dary-heap-scheduler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
 
 using namespace ns3;
 
@@ -707,6 +715,117 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that event storage is reused correctly.
+ *
+ * Events of several closure sizes, on both sides of the largest pooled
+ * size, are scheduled, cancelled and run, events created in another
+ * thread are released in this one, and the slabs of the pool are
+ * returned once their events are released or their thread exits.
+ */
+class SimulatorEventStorageTestCase : public TestCase
+{
+  public:
+    SimulatorEventStorageTestCase();
+    void DoRun() override;
+};
+
+SimulatorEventStorageTestCase::SimulatorEventStorageTestCase()
+    : TestCase("Check reuse of event storage")
+{
+}
+
+void
+SimulatorEventStorageTestCase::DoRun()
+{
+    auto owner = std::make_shared<int>(0); // counts the closures still alive
+    uint64_t sum = 0;
+    uint64_t expected = 0;
+    std::array<uint8_t, 200> medium;
+    std::array<uint8_t, 600> large;
+
+    for (uint32_t round = 0; round < 3; ++round)
+    {
+        for (uint32_t i = 0; i < 1000; ++i)
+        {
+            medium.fill(i % 251);
+            large.fill(i % 241);
+            EventId small = Simulator::Schedule(NanoSeconds(i), [owner, &sum, i]() { sum += i; });
+            EventId mid = Simulator::Schedule(NanoSeconds(i), [owner, &sum, medium]() {
+                sum += medium.front() + medium.back();
+            });
+            EventId big = Simulator::Schedule(NanoSeconds(i), [owner, &sum, large]() {
+                sum += large.front() + large.back();
+            });
+            switch (i % 3)
+            {
+            case 0:
+                small.Cancel();
+                expected += 2 * (i % 251) + 2 * (i % 241);
+                break;
+            case 1:
+                mid.Cancel();
+                expected += i + 2 * (i % 241);
+                break;
+            default:
+                Simulator::Remove(big);
+                expected += i + 2 * (i % 251);
+            }
+        }
+        Simulator::Run();
+    }
+    NS_TEST_EXPECT_MSG_EQ(sum, expected, "Events ran with corrupted closures");
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(owner.use_count(), 1, "Not all event closures were destroyed");
+
+    // Events created in one thread and released in another
+    std::vector<EventImpl*> events(1000);
+    std::thread creator([&events, owner]() {
+        for (auto& ev : events)
+        {
+            ev = MakeEvent([owner]() {});
+        }
+    });
+    creator.join();
+    for (auto ev : events)
+    {
+        ev->Unref();
+    }
+    NS_TEST_EXPECT_MSG_EQ(owner.use_count(), 1, "Not all event closures were destroyed");
+
+    // The slabs of released events are returned, and so are those kept by
+    // a thread once it exits
+    const std::size_t slabs = EventImpl::GetPoolSlabCount();
+    std::size_t peakSlabs = 0;
+    std::size_t releasedSlabs = 0;
+    std::thread worker([&peakSlabs, &releasedSlabs, owner]() {
+        std::vector<EventImpl*> held(100000);
+        for (auto& ev : held)
+        {
+            ev = MakeEvent([owner]() {});
+        }
+        peakSlabs = EventImpl::GetPoolSlabCount();
+        for (auto ev : held)
+        {
+            ev->Unref();
+        }
+        releasedSlabs = EventImpl::GetPoolSlabCount();
+    });
+    worker.join();
+    NS_TEST_EXPECT_MSG_EQ(owner.use_count(), 1, "Not all event closures were destroyed");
+#ifdef ENABLE_EVENT_POOL
+    NS_TEST_EXPECT_MSG_GT(peakSlabs, slabs, "The events were not pooled");
+#endif
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(4 * releasedSlabs,
+                                peakSlabs + 3 * slabs,
+                                "Most slabs were kept after their events were released");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(EventImpl::GetPoolSlabCount(),
+                                slabs,
+                                "The slabs kept by an exited thread were not returned");
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -730,6 +849,15 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(DaryHeapScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        factory.Set("Arity", UintegerValue(2));
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        factory.Set("Arity", UintegerValue(8));
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        AddTestCase(new SimulatorEventStorageTestCase(), TestCase::QUICK);
     }
 };
 
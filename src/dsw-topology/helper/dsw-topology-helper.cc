@@ -0,0 +1,629 @@
+#include "dsw-topology-helper.h"
+
+#include "ns3/dsw-csv-reader.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/log.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/names.h"
+#include "ns3/position-allocator.h"
+#include "ns3/string.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DswTopologyHelper");
+
+DswTopologyHelper::DswTopologyHelper()
+    : m_delayByDist(true),
+      m_meterPerUnit(50000.0),
+      m_propSpeed(2e8),
+      m_delayFactor(1.0),
+      m_defaultDelay(MilliSeconds(1)),
+      m_queueSize("100p"),
+      m_network("10.0.0.0"),
+      m_mask("255.255.255.252"),
+      m_partitions(0),
+      m_partitionWeight(WEIGHT_DEGREE),
+      m_built(false),
+      m_maxId(0)
+{
+}
+
+uint32_t
+DswTopologyHelper::LoadNodes(const std::string& path)
+{
+    DswCsvReader reader;
+    if (!reader.Open(path))
+    {
+        NS_FATAL_ERROR("Cannot open nodes file: " << path);
+    }
+    return ReadNodes(reader);
+}
+
+uint32_t
+DswTopologyHelper::LoadLinks(const std::string& path)
+{
+    DswCsvReader reader;
+    if (!reader.Open(path))
+    {
+        NS_FATAL_ERROR("Cannot open links file: " << path);
+    }
+    return ReadLinks(reader);
+}
+
+uint32_t
+DswTopologyHelper::ReadNodes(DswCsvReader& reader)
+{
+    NS_ASSERT_MSG(!m_built, "Nodes must be read before Build()");
+    uint32_t added = 0;
+    while (reader.Next())
+    {
+        const uint32_t ln = reader.GetLineNumber();
+        NodeSpec ns;
+        if (!DswCsvReader::ParseUint(reader.GetField(0), ns.id))
+        {
+            if (ln == 1)
+            {
+                NS_LOG_WARN("Skip header in nodes.csv: " << reader.GetLine());
+                continue;
+            }
+            NS_LOG_WARN("Skip invalid node line " << ln << ": " << reader.GetLine());
+            continue;
+        }
+
+        std::string_view fx = reader.GetField(1);
+        std::string_view fy = reader.GetField(2);
+        if (!fx.empty() && !fy.empty())
+        {
+            if (!DswCsvReader::ParseDouble(fx, ns.x) || !DswCsvReader::ParseDouble(fy, ns.y))
+            {
+                NS_LOG_WARN("Skip node line " << ln << ": Invalid position '" << fx << "," << fy
+                                              << "'");
+                continue;
+            }
+            ns.hasPos = true;
+        }
+
+        std::string_view fname = reader.GetField(3);
+        if (fname.substr(0, 5) == "edge-")
+        {
+            ns.role = PRODUCER;
+        }
+        else if (fname.substr(0, 5) == "core-")
+        {
+            ns.role = CONSUMER;
+        }
+        else
+        {
+            NS_LOG_WARN("Skip node line " << ln << ": Invalid name '" << fname
+                                          << "'. Must start with 'edge-' or 'core-'.");
+            continue;
+        }
+
+        std::string_view frate = reader.GetField(4);
+        if (frate.empty())
+        {
+            NS_LOG_WARN("Skip node line " << ln << ": Rate column is empty for node " << ns.id);
+            continue;
+        }
+        if (!DswCsvReader::ParseDouble(frate, ns.appRate))
+        {
+            NS_LOG_WARN("Skip node line " << ln << ": Invalid rate value '" << frate << "'");
+            continue;
+        }
+        if (ns.appRate <= 0.0)
+        {
+            NS_LOG_WARN("Skip node line " << ln << ": Rate must be positive, got " << ns.appRate);
+            continue;
+        }
+
+        if (ns.id == 0)
+        {
+            NS_LOG_WARN("Node id 0 is reserved. Skip line " << ln);
+            continue;
+        }
+        if (ns.id < m_specIndex.size() && m_specIndex[ns.id] >= 0)
+        {
+            NS_LOG_WARN("Duplicate node id " << ns.id << " at line " << ln << "; skip");
+            continue;
+        }
+
+        ns.name.assign(fname.data(), fname.size());
+        if (ns.id >= m_specIndex.size())
+        {
+            m_specIndex.resize(std::max<std::size_t>(ns.id + 1, m_specIndex.size() * 2), -1);
+        }
+        m_specIndex[ns.id] = static_cast<int32_t>(m_nodeSpecs.size());
+        m_nodeSpecs.push_back(std::move(ns));
+        ++added;
+    }
+    return added;
+}
+
+uint32_t
+DswTopologyHelper::ReadLinks(DswCsvReader& reader)
+{
+    NS_ASSERT_MSG(!m_built, "Links must be read before Build()");
+    // 不同的速率字符串通常只有几种，解析一次后复用
+    std::vector<std::pair<std::string, DataRate>> rateCache;
+    uint32_t added = 0;
+    while (reader.Next())
+    {
+        const uint32_t ln = reader.GetLineNumber();
+        if (reader.GetNFields() < 3)
+        {
+            NS_LOG_WARN("Skip invalid link line " << ln << ": " << reader.GetLine());
+            continue;
+        }
+
+        LinkSpec ls;
+        if (!DswCsvReader::ParseUint(reader.GetField(0), ls.a) ||
+            !DswCsvReader::ParseUint(reader.GetField(1), ls.b))
+        {
+            if (ln == 1)
+            {
+                NS_LOG_WARN("Skip header in links.csv: " << reader.GetLine());
+                continue;
+            }
+            NS_LOG_WARN("Skip invalid link line " << ln << ": " << reader.GetLine());
+            continue;
+        }
+        if (ls.a == 0 || ls.b == 0 || ls.a == ls.b)
+        {
+            NS_LOG_WARN("Skip invalid/self-loop link at line " << ln << ": " << reader.GetLine());
+            continue;
+        }
+
+        std::string_view frate = reader.GetField(2);
+        auto cached = std::find_if(rateCache.begin(), rateCache.end(), [frate](const auto& entry) {
+            return entry.first == frate;
+        });
+        if (cached == rateCache.end())
+        {
+            DataRateValue value;
+            if (!value.DeserializeFromString(std::string(frate), nullptr))
+            {
+                NS_LOG_WARN("Skip link line " << ln << ": Invalid rate '" << frate << "'");
+                continue;
+            }
+            cached = rateCache.emplace(rateCache.end(), std::string(frate), value.Get());
+        }
+        ls.rate = cached->first;
+        ls.dataRate = cached->second;
+
+        // 可选的 id 列
+        if (!DswCsvReader::ParseUint(reader.GetField(3), ls.id))
+        {
+            ls.id = static_cast<uint32_t>(m_linkSpecs.size() + 1);
+        }
+        m_linkSpecs.push_back(std::move(ls));
+        ++added;
+    }
+    return added;
+}
+
+void
+DswTopologyHelper::SetDelayByDistance(bool enable,
+                                      double meterPerUnit,
+                                      double propSpeed,
+                                      double factor)
+{
+    m_delayByDist = enable;
+    m_meterPerUnit = meterPerUnit;
+    m_propSpeed = propSpeed;
+    m_delayFactor = factor;
+}
+
+void
+DswTopologyHelper::SetDefaultDelay(Time delay)
+{
+    m_defaultDelay = delay;
+}
+
+void
+DswTopologyHelper::SetQueueSize(const std::string& size)
+{
+    m_queueSize = size;
+}
+
+void
+DswTopologyHelper::SetAddressBase(Ipv4Address network, Ipv4Mask mask)
+{
+    m_network = network;
+    m_mask = mask;
+}
+
+void
+DswTopologyHelper::SetPartitioning(uint32_t parts, PartitionWeight weight)
+{
+    m_partitions = parts;
+    m_partitionWeight = weight;
+}
+
+void
+DswTopologyHelper::CollectNodeIds()
+{
+    m_maxId = 0;
+    for (const auto& n : m_nodeSpecs)
+    {
+        m_maxId = std::max(m_maxId, n.id);
+    }
+    for (const auto& l : m_linkSpecs)
+    {
+        m_maxId = std::max(m_maxId, std::max(l.a, l.b));
+    }
+
+    std::vector<bool> used(m_maxId + 1, false);
+    for (const auto& n : m_nodeSpecs)
+    {
+        used[n.id] = true;
+    }
+    for (const auto& l : m_linkSpecs)
+    {
+        used[l.a] = true;
+        used[l.b] = true;
+    }
+    m_nodeIds.clear();
+    for (uint32_t id = 1; id <= m_maxId; ++id)
+    {
+        if (used[id])
+        {
+            m_nodeIds.push_back(id);
+        }
+    }
+    m_specIndex.resize(m_maxId + 1, -1);
+}
+
+void
+DswTopologyHelper::LayoutNodes()
+{
+    m_positions.assign(m_maxId + 1, Vector(0, 0, 0));
+    std::vector<bool> hasPos(m_maxId + 1, false);
+    for (const auto& n : m_nodeSpecs)
+    {
+        if (n.hasPos)
+        {
+            hasPos[n.id] = true;
+            m_positions[n.id] = Vector(n.x, n.y, 0.0);
+        }
+    }
+    // 自动布局未给坐标的节点：每行 8 个，间距 2
+    const double dx = 2.0;
+    const double dy = 2.0;
+    uint32_t col = 0;
+    uint32_t row = 0;
+    for (uint32_t id : m_nodeIds)
+    {
+        if (hasPos[id])
+        {
+            continue;
+        }
+        m_positions[id] = Vector(col * dx, row * dy, 0.0);
+        NS_LOG_DEBUG("Auto position for node " << id << ": (" << m_positions[id].x << ","
+                                               << m_positions[id].y << ")");
+        if (++col >= 8)
+        {
+            col = 0;
+            ++row;
+        }
+    }
+}
+
+void
+DswTopologyHelper::PartitionNodes()
+{
+    uint32_t parts = m_partitions;
+#ifdef NS3_MPI
+    if (parts == 0 && MpiInterface::IsEnabled())
+    {
+        parts = MpiInterface::GetSize();
+    }
+#endif
+    m_systemIds.assign(m_maxId + 1, 0);
+    if (parts <= 1)
+    {
+        return;
+    }
+
+    // 顶点 i 对应 m_nodeIds[i]
+    std::vector<uint32_t> vertexOf(m_maxId + 1, 0);
+    for (uint32_t i = 0; i < m_nodeIds.size(); ++i)
+    {
+        vertexOf[m_nodeIds[i]] = i;
+    }
+    std::vector<double> degree(m_nodeIds.size(), 0.0);
+    for (const auto& link : m_links)
+    {
+        degree[vertexOf[link.a]] += 1.0;
+        degree[vertexOf[link.b]] += 1.0;
+    }
+    // 应用速率按总量折算到与度数相同的量级，两种负载各占一半
+    double rateScale = 0.0;
+    if (m_partitionWeight == WEIGHT_APP_RATE)
+    {
+        double totalRate = 0.0;
+        for (const auto& n : m_nodeSpecs)
+        {
+            totalRate += n.appRate;
+        }
+        if (totalRate > 0.0)
+        {
+            rateScale = 2.0 * m_links.size() / totalRate;
+        }
+    }
+
+    m_partitioner = DswPartitioner();
+    m_partitioner.SetPartCount(parts);
+    for (uint32_t i = 0; i < m_nodeIds.size(); ++i)
+    {
+        const NodeSpec* spec = GetNodeSpec(m_nodeIds[i]);
+        const double rate = spec != nullptr ? spec->appRate : 0.0;
+        m_partitioner.AddVertex(std::max(degree[i], 1.0) + rate * rateScale);
+    }
+    for (const auto& link : m_links)
+    {
+        m_partitioner.AddEdge(vertexOf[link.a], vertexOf[link.b], link.delay);
+    }
+    m_partitioner.Run();
+    for (uint32_t i = 0; i < m_nodeIds.size(); ++i)
+    {
+        m_systemIds[m_nodeIds[i]] = m_partitioner.GetPart(i);
+    }
+
+    std::ostringstream loads;
+    for (double w : m_partitioner.GetPartWeights())
+    {
+        loads << " " << w;
+    }
+    NS_LOG_INFO("Partitioned into " << parts << " systems: " << m_partitioner.GetCutEdges()
+                                    << " remote links, lookahead "
+                                    << m_partitioner.GetLookahead().As(Time::US)
+                                    << ", loads" << loads.str());
+}
+
+void
+DswTopologyHelper::Build()
+{
+    NS_ASSERT_MSG(!m_built, "Build() can only be called once");
+    m_built = true;
+
+    CollectNodeIds();
+    NS_LOG_INFO("Nodes in config: " << m_nodeIds.size() << " (max id=" << m_maxId << ")");
+    NS_LOG_INFO("Links in config: " << m_linkSpecs.size());
+    LayoutNodes();
+
+    // 先去重并计算每条链路的参数（划分需要时延），再创建节点、设备和地址
+    std::unordered_set<uint64_t> seen; // 去重（无向）
+    seen.reserve(m_linkSpecs.size());
+    m_links.reserve(m_linkSpecs.size());
+    std::vector<DataRate> rates;
+    rates.reserve(m_linkSpecs.size());
+    for (const auto& l : m_linkSpecs)
+    {
+        const auto undirected = std::minmax(l.a, l.b);
+        if (!seen.insert((uint64_t(undirected.first) << 32) | undirected.second).second)
+        {
+            NS_LOG_WARN("Duplicate link spec " << l.a << "<->" << l.b << " ignored");
+            continue;
+        }
+
+        LinkRecord rec;
+        rec.a = l.a;
+        rec.b = l.b;
+        rec.id = l.id;
+        rec.rate = l.rate;
+        rec.distanceUnits = std::hypot(m_positions[l.a].x - m_positions[l.b].x,
+                                       m_positions[l.a].y - m_positions[l.b].y);
+        rec.distanceMeters = rec.distanceUnits * m_meterPerUnit;
+        rec.delay = m_delayByDist ? Seconds(rec.distanceMeters / m_propSpeed * m_delayFactor)
+                                  : m_defaultDelay;
+        rates.push_back(l.dataRate);
+        m_links.push_back(std::move(rec));
+    }
+    PartitionNodes();
+
+    // 节点索引 0..maxId（0 占位），system id 在创建时确定
+    for (uint32_t id = 0; id <= m_maxId; ++id)
+    {
+        m_nodes.Create(1, m_systemIds[id]);
+    }
+    for (const auto& n : m_nodeSpecs)
+    {
+        if (!n.name.empty())
+        {
+            Names::Add(n.name, m_nodes.Get(n.id));
+        }
+    }
+
+    InternetStackHelper internet;
+    internet.Install(m_nodes);
+
+    // 未使用的索引放在远处
+    Ptr<ListPositionAllocator> allocator = CreateObject<ListPositionAllocator>();
+    allocator->Add(Vector(-10, -10, 0));
+    std::vector<bool> used(m_maxId + 1, false);
+    for (uint32_t id : m_nodeIds)
+    {
+        used[id] = true;
+    }
+    for (uint32_t id = 1; id <= m_maxId; ++id)
+    {
+        allocator->Add(used[id] ? m_positions[id] : Vector(-50, -50, 0));
+    }
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator(allocator);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(m_nodes);
+
+    // 批量创建设备和分配地址；跨进程的链路由 PointToPointHelper 建成远程信道
+    std::vector<PointToPointHelper::Link> p2pLinks;
+    p2pLinks.reserve(m_links.size());
+    for (std::size_t i = 0; i < m_links.size(); ++i)
+    {
+        const LinkRecord& rec = m_links[i];
+        // 原始方向：a 在前、b 在后 -> 地址 index 0 属于 a，index 1 属于 b
+        p2pLinks.push_back({m_nodes.Get(rec.a), m_nodes.Get(rec.b), rates[i], rec.delay});
+    }
+
+    m_p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue(m_queueSize));
+    NetDeviceContainer devices = m_p2p.InstallMany(p2pLinks);
+    Ipv4AddressHelper address(m_network, m_mask);
+    Ipv4InterfaceContainer interfaces = address.AssignPointToPoint(devices);
+
+    m_nodeAddresses.assign(m_maxId + 1, Ipv4Address());
+    for (std::size_t i = 0; i < m_links.size(); ++i)
+    {
+        LinkRecord& rec = m_links[i];
+        rec.devices.Add(devices.Get(2 * i));
+        rec.devices.Add(devices.Get(2 * i + 1));
+        rec.interfaces.Add(interfaces.Get(2 * i));
+        rec.interfaces.Add(interfaces.Get(2 * i + 1));
+
+        // 节点的第一条链路即其接口 1
+        if (!m_nodeAddresses[rec.a].IsInitialized())
+        {
+            m_nodeAddresses[rec.a] = rec.interfaces.GetAddress(0);
+        }
+        if (!m_nodeAddresses[rec.b].IsInitialized())
+        {
+            m_nodeAddresses[rec.b] = rec.interfaces.GetAddress(1);
+        }
+
+        NS_LOG_INFO("[link] " << rec.a << "<->" << rec.b << "  id=" << rec.id
+                              << "  rate=" << rec.rate << "  delay=" << rec.delay.As(Time::US)
+                              << "  dist=" << rec.distanceUnits << " units ("
+                              << rec.distanceMeters << " m)  " << rec.interfaces.GetAddress(0)
+                              << " <-> " << rec.interfaces.GetAddress(1));
+    }
+}
+
+void
+DswTopologyHelper::EnablePcap(const std::string& prefix)
+{
+    NS_ASSERT_MSG(m_built, "EnablePcap() requires Build()");
+    for (const auto& link : m_links)
+    {
+        std::ostringstream os;
+        os << prefix << "-" << link.a << "-" << link.b;
+        m_p2p.EnablePcap(os.str(), link.devices, true);
+    }
+}
+
+NodeContainer
+DswTopologyHelper::GetNodes() const
+{
+    return m_nodes;
+}
+
+const std::vector<DswTopologyHelper::NodeSpec>&
+DswTopologyHelper::GetNodeSpecs() const
+{
+    return m_nodeSpecs;
+}
+
+const std::vector<DswTopologyHelper::LinkSpec>&
+DswTopologyHelper::GetLinkSpecs() const
+{
+    return m_linkSpecs;
+}
+
+const DswTopologyHelper::NodeSpec*
+DswTopologyHelper::GetNodeSpec(uint32_t id) const
+{
+    if (id >= m_specIndex.size() || m_specIndex[id] < 0)
+    {
+        return nullptr;
+    }
+    return &m_nodeSpecs[m_specIndex[id]];
+}
+
+const std::vector<uint32_t>&
+DswTopologyHelper::GetNodeIds() const
+{
+    return m_nodeIds;
+}
+
+uint32_t
+DswTopologyHelper::GetMaxId() const
+{
+    return m_maxId;
+}
+
+Vector
+DswTopologyHelper::GetPosition(uint32_t id) const
+{
+    NS_ASSERT_MSG(id < m_positions.size(), "Unknown node id " << id);
+    return m_positions[id];
+}
+
+const std::vector<DswTopologyHelper::LinkRecord>&
+DswTopologyHelper::GetLinks() const
+{
+    return m_links;
+}
+
+Ipv4Address
+DswTopologyHelper::GetNodeAddress(uint32_t id) const
+{
+    if (id >= m_nodeAddresses.size())
+    {
+        return Ipv4Address();
+    }
+    return m_nodeAddresses[id];
+}
+
+uint32_t
+DswTopologyHelper::GetSystemId(uint32_t id) const
+{
+    NS_ASSERT_MSG(m_built, "GetSystemId() requires Build()");
+    NS_ASSERT_MSG(id < m_systemIds.size(), "Unknown node id " << id);
+    return m_systemIds[id];
+}
+
+bool
+DswTopologyHelper::IsLocal(uint32_t id) const
+{
+#ifdef NS3_MPI
+    if (MpiInterface::IsEnabled())
+    {
+        return GetSystemId(id) == MpiInterface::GetSystemId();
+    }
+#endif
+    return true;
+}
+
+const DswPartitioner&
+DswTopologyHelper::GetPartitioner() const
+{
+    return m_partitioner;
+}
+
+bool
+DswTopologyHelper::WritePartition(const std::string& path) const
+{
+    NS_ASSERT_MSG(m_built, "WritePartition() requires Build()");
+    std::ofstream out(path.c_str());
+    if (!out.is_open())
+    {
+        return false;
+    }
+    out << "id,systemId\n";
+    for (uint32_t id : m_nodeIds)
+    {
+        out << id << "," << m_systemIds[id] << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace ns3
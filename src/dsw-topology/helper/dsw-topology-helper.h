@@ -0,0 +1,221 @@
+#ifndef DSW_TOPOLOGY_HELPER_H
+#define DSW_TOPOLOGY_HELPER_H
+
+#include "ns3/data-rate.h"
+#include "ns3/dsw-partitioner.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/vector.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class DswCsvReader;
+
+/**
+ * 从 nodes.csv / links.csv 构建 DSW 拓扑。
+ *
+ * nodes.csv: id,x,y,name,rate —— name 以 "edge-" 开头为生产者、"core-" 开头为消费者，
+ * rate 为任务到达率或处理速率；x,y 可留空（自动布局）。
+ * links.csv: a,b,rate[,id] —— id 缺省时取行序号。
+ *
+ * 两个文件都用 DswCsvReader 流式解析并在读取时完成校验；Build() 一次性创建
+ * 节点 0..maxId（0 占位）、协议栈、坐标、点对点链路与地址，节点 ID 即节点索引。
+ * 链路用 PointToPointHelper::InstallMany 批量创建，地址用
+ * Ipv4AddressHelper::AssignPointToPoint 批量分配（默认从 10.0.0.0/30 开始）。
+ *
+ * 分布式仿真时，Build() 先用 DswPartitioner 把节点划分给各进程，再以
+ * 对应的 system id 创建节点；启用 MPI 时 PointToPointHelper 会在跨进程的
+ * 链路上自动创建 PointToPointRemoteChannel。
+ */
+class DswTopologyHelper
+{
+public:
+    /// 节点在 Pro-Sink 应用中的角色
+    enum NodeRole
+    {
+        UNKNOWN = 0,
+        PRODUCER, //!< 生产者 (edge)
+        CONSUMER  //!< 消费者 (core)
+    };
+
+    /// 划分节点时的负载估计
+    enum PartitionWeight
+    {
+        WEIGHT_DEGREE = 0, //!< 节点度数（转发负载）
+        WEIGHT_APP_RATE    //!< 度数加上按总量折算的应用速率
+    };
+
+    /// nodes.csv 的一行
+    struct NodeSpec
+    {
+        uint32_t id = 0;
+        bool hasPos = false;
+        double x = 0.0;
+        double y = 0.0;
+        std::string name;
+        NodeRole role = UNKNOWN;
+        double appRate = 0.0; //!< 到达率或处理速率 (任务/秒)
+    };
+
+    /// links.csv 的一行
+    struct LinkSpec
+    {
+        uint32_t a = 0; //!< 原始方向（决定地址顺序）
+        uint32_t b = 0;
+        uint32_t id = 0;
+        std::string rate; //!< 原始速率字符串，如 "100Mbps"
+        DataRate dataRate;
+    };
+
+    /// Build() 创建的一条链路
+    struct LinkRecord
+    {
+        uint32_t a = 0;
+        uint32_t b = 0;
+        uint32_t id = 0;
+        std::string rate;
+        Time delay;
+        double distanceUnits = 0.0;  //!< 坐标距离
+        double distanceMeters = 0.0; //!< 换算后的距离 (m)
+        NetDeviceContainer devices;  //!< index 0 属于 a，index 1 属于 b
+        Ipv4InterfaceContainer interfaces;
+    };
+
+    DswTopologyHelper();
+
+    /**
+     * 读取节点文件（无法打开时报致命错误）
+     * @param path nodes.csv
+     * @return 有效节点数
+     */
+    uint32_t LoadNodes(const std::string& path);
+    /**
+     * 读取链路文件（无法打开时报致命错误）
+     * @param path links.csv
+     * @return 有效链路数
+     */
+    uint32_t LoadLinks(const std::string& path);
+    /**
+     * 从已打开的读取器解析节点，无效行给出警告后跳过
+     * @param reader 读取器
+     * @return 本次新增的有效节点数
+     */
+    uint32_t ReadNodes(DswCsvReader& reader);
+    /**
+     * 从已打开的读取器解析链路，无效行给出警告后跳过
+     * @param reader 读取器
+     * @return 本次新增的有效链路数
+     */
+    uint32_t ReadLinks(DswCsvReader& reader);
+
+    /**
+     * 按节点坐标距离计算链路时延：distance * meterPerUnit / propSpeed * factor
+     * @param enable false 时所有链路使用 SetDefaultDelay 的时延
+     * @param meterPerUnit 1 坐标单位对应的米数
+     * @param propSpeed 传播速度 (m/s)
+     * @param factor 额外缩放系数
+     */
+    void SetDelayByDistance(bool enable, double meterPerUnit, double propSpeed, double factor);
+    void SetDefaultDelay(Time delay);
+    /// @param size 每个设备 DropTail 队列的容量，如 "100p"
+    void SetQueueSize(const std::string& size);
+    /**
+     * 链路地址从此网段开始，每条链路一个网段（默认 10.0.0.0/30）
+     */
+    void SetAddressBase(Ipv4Address network, Ipv4Mask mask);
+    /**
+     * 在 Build() 时把节点划分给多个进程（system id）
+     * @param parts 进程数；0 表示启用 MPI 时取 MPI 进程数，否则不划分
+     * @param weight 负载估计方式
+     */
+    void SetPartitioning(uint32_t parts, PartitionWeight weight = WEIGHT_DEGREE);
+
+    /**
+     * 创建节点、协议栈、坐标、链路与地址；只能调用一次
+     */
+    void Build(void);
+    /**
+     * 为每条链路的两端开启 pcap，文件名为 prefix-a-b-节点-设备.pcap
+     * @param prefix 文件名前缀
+     */
+    void EnablePcap(const std::string& prefix);
+
+    NodeContainer GetNodes(void) const;
+    /// @return nodes.csv 中的节点（文件顺序）
+    const std::vector<NodeSpec>& GetNodeSpecs(void) const;
+    /// @return links.csv 中的链路（文件顺序）
+    const std::vector<LinkSpec>& GetLinkSpecs(void) const;
+    /// @return 仅在 nodes.csv 中定义过的节点才有，否则为 nullptr
+    const NodeSpec* GetNodeSpec(uint32_t id) const;
+    /// @return 出现在任一文件中的节点 ID（升序）
+    const std::vector<uint32_t>& GetNodeIds(void) const;
+    uint32_t GetMaxId(void) const;
+    /// @return 节点坐标（自动布局后）
+    Vector GetPosition(uint32_t id) const;
+    /// @return 已创建的链路（去重后，按文件顺序）
+    const std::vector<LinkRecord>& GetLinks(void) const;
+    /**
+     * @param id 节点 ID
+     * @return 节点第一条链路上的地址；没有链路时为未初始化的地址
+     */
+    Ipv4Address GetNodeAddress(uint32_t id) const;
+
+    /// @return 节点的 system id；未划分时为 0
+    uint32_t GetSystemId(uint32_t id) const;
+    /**
+     * @param id 节点 ID
+     * @return 节点是否由本进程仿真（未启用 MPI 时总为 true），
+     *         应用只应安装在本进程的节点上
+     */
+    bool IsLocal(uint32_t id) const;
+    /// @return Build() 使用的划分器（未划分时没有顶点）
+    const DswPartitioner& GetPartitioner(void) const;
+    /**
+     * 写出划分结果，每行 id,systemId
+     * @param path 输出文件
+     * @return 是否成功
+     */
+    bool WritePartition(const std::string& path) const;
+
+private:
+    void CollectNodeIds(void);
+    void LayoutNodes(void);
+    void PartitionNodes(void);
+
+    std::vector<NodeSpec> m_nodeSpecs;
+    std::vector<LinkSpec> m_linkSpecs;
+    std::vector<int32_t> m_specIndex; //!< 节点 ID -> m_nodeSpecs 下标，-1 表示未定义
+
+    bool m_delayByDist;
+    double m_meterPerUnit;
+    double m_propSpeed;
+    double m_delayFactor;
+    Time m_defaultDelay;
+    std::string m_queueSize;
+    Ipv4Address m_network;
+    Ipv4Mask m_mask;
+    uint32_t m_partitions;
+    PartitionWeight m_partitionWeight;
+
+    bool m_built;
+    NodeContainer m_nodes;
+    std::vector<uint32_t> m_nodeIds;
+    uint32_t m_maxId;
+    std::vector<Vector> m_positions;
+    std::vector<LinkRecord> m_links;
+    std::vector<Ipv4Address> m_nodeAddresses;
+    std::vector<uint32_t> m_systemIds; //!< 节点 ID -> system id
+    DswPartitioner m_partitioner;
+    PointToPointHelper m_p2p;
+};
+
+} // namespace ns3
+
+#endif // DSW_TOPOLOGY_HELPER_H
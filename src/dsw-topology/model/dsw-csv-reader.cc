@@ -0,0 +1,222 @@
+#include "dsw-csv-reader.h"
+
+#include "ns3/log.h"
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DSW_CSV_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DswCsvReader");
+
+DswCsvReader::DswCsvReader()
+    : m_data(nullptr),
+      m_size(0),
+      m_pos(0),
+      m_lineNo(0),
+      m_nFields(0),
+      m_map(nullptr),
+      m_mapSize(0)
+{
+}
+
+DswCsvReader::~DswCsvReader()
+{
+    Close();
+}
+
+bool
+DswCsvReader::Open(const std::string& path)
+{
+    Close();
+#ifdef DSW_CSV_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0)
+    {
+        ::close(fd);
+        SetData("", 0);
+        return true;
+    }
+    void* map = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+    {
+        NS_LOG_WARN("mmap failed for " << path << ", reading it instead");
+    }
+    else
+    {
+        // 顺序扫描
+        ::madvise(map, st.st_size, MADV_SEQUENTIAL);
+        m_map = map;
+        m_mapSize = st.st_size;
+        SetData(static_cast<const char*>(map), st.st_size);
+        return true;
+    }
+#endif
+    std::ifstream fin(path.c_str(), std::ios::binary);
+    if (!fin.is_open())
+    {
+        return false;
+    }
+    m_copy.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+    SetData(m_copy.data(), m_copy.size());
+    return true;
+}
+
+void
+DswCsvReader::SetData(const char* data, std::size_t size)
+{
+    m_data = data;
+    m_size = size;
+    m_pos = 0;
+    m_lineNo = 0;
+    m_line = std::string_view();
+    m_nFields = 0;
+}
+
+void
+DswCsvReader::Close()
+{
+#ifdef DSW_CSV_HAVE_MMAP
+    if (m_map != nullptr)
+    {
+        ::munmap(m_map, m_mapSize);
+    }
+#endif
+    m_map = nullptr;
+    m_mapSize = 0;
+    m_copy.clear();
+    SetData(nullptr, 0);
+}
+
+std::string_view
+DswCsvReader::Trim(std::string_view s)
+{
+    std::size_t b = 0;
+    std::size_t e = s.size();
+    while (b < e && (s[b] == ' ' || s[b] == '\t' || s[b] == '\r'))
+    {
+        ++b;
+    }
+    while (e > b && (s[e - 1] == ' ' || s[e - 1] == '\t' || s[e - 1] == '\r'))
+    {
+        --e;
+    }
+    return s.substr(b, e - b);
+}
+
+bool
+DswCsvReader::Next()
+{
+    while (m_pos < m_size)
+    {
+        const char* start = m_data + m_pos;
+        std::size_t left = m_size - m_pos;
+        const char* nl = static_cast<const char*>(std::memchr(start, '\n', left));
+        std::size_t len = nl ? static_cast<std::size_t>(nl - start) : left;
+        m_pos += len + (nl ? 1 : 0);
+        ++m_lineNo;
+
+        std::string_view line = Trim(std::string_view(start, len));
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        m_line = line;
+
+        // 切分字段
+        m_nFields = 0;
+        std::size_t b = 0;
+        while (m_nFields < MAX_FIELDS)
+        {
+            std::size_t comma = line.find(',', b);
+            std::size_t e = comma == std::string_view::npos ? line.size() : comma;
+            m_fields[m_nFields++] = Trim(line.substr(b, e - b));
+            if (comma == std::string_view::npos)
+            {
+                break;
+            }
+            b = comma + 1;
+        }
+        return true;
+    }
+    m_line = std::string_view();
+    m_nFields = 0;
+    return false;
+}
+
+uint32_t
+DswCsvReader::GetLineNumber() const
+{
+    return m_lineNo;
+}
+
+std::string_view
+DswCsvReader::GetLine() const
+{
+    return m_line;
+}
+
+std::size_t
+DswCsvReader::GetNFields() const
+{
+    return m_nFields;
+}
+
+std::string_view
+DswCsvReader::GetField(std::size_t i) const
+{
+    return i < m_nFields ? m_fields[i] : std::string_view();
+}
+
+std::size_t
+DswCsvReader::GetSize() const
+{
+    return m_size;
+}
+
+bool
+DswCsvReader::ParseUint(std::string_view s, uint32_t& value)
+{
+    if (s.empty() || s[0] < '0' || s[0] > '9')
+    {
+        return false;
+    }
+    auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size();
+}
+
+bool
+DswCsvReader::ParseDouble(std::string_view s, double& value)
+{
+    if (s.empty())
+    {
+        return false;
+    }
+    // from_chars 不接受前导 '+'
+    const char* first = s.data() + (s[0] == '+' ? 1 : 0);
+    auto result = std::from_chars(first, s.data() + s.size(), value);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size();
+}
+
+} // namespace ns3
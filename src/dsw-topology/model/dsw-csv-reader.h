@@ -0,0 +1,92 @@
+#ifndef DSW_CSV_READER_H
+#define DSW_CSV_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ns3 {
+
+/**
+ * 零拷贝 CSV 读取器。
+ *
+ * 文件整体映射到内存（不支持 mmap 的平台上一次性读入），按行扫描；
+ * 字段以指向原始数据的 string_view 返回，已去掉首尾空白，不分配内存。
+ * 空行和以 '#' 开头的行被跳过，支持 \n 与 \r\n 换行。
+ */
+class DswCsvReader
+{
+public:
+    /// 每行最多保留的字段数，多余字段被忽略
+    static const std::size_t MAX_FIELDS = 16;
+
+    DswCsvReader();
+    ~DswCsvReader();
+
+    DswCsvReader(const DswCsvReader&) = delete;
+    DswCsvReader& operator=(const DswCsvReader&) = delete;
+
+    /**
+     * 映射文件
+     * @param path 文件路径
+     * @return 是否成功
+     */
+    bool Open(const std::string& path);
+    /**
+     * 直接读取内存中的数据（不拷贝，调用者保证其生命周期）
+     * @param data 数据
+     * @param size 字节数
+     */
+    void SetData(const char* data, std::size_t size);
+    void Close(void);
+
+    /**
+     * 前进到下一个有效行并切分字段
+     * @return false 表示已到文件末尾
+     */
+    bool Next(void);
+
+    /// @return 当前行的行号（从 1 开始）
+    uint32_t GetLineNumber(void) const;
+    /// @return 当前行（已去掉首尾空白）
+    std::string_view GetLine(void) const;
+    std::size_t GetNFields(void) const;
+    /// @return 第 i 个字段；不存在时为空
+    std::string_view GetField(std::size_t i) const;
+    /// @return 数据总字节数
+    std::size_t GetSize(void) const;
+
+    /**
+     * 解析非空、全数字的无符号整数
+     * @param s 字段
+     * @param value 输出
+     * @return 是否成功
+     */
+    static bool ParseUint(std::string_view s, uint32_t& value);
+    /**
+     * 解析完整的浮点数字段
+     * @param s 字段
+     * @param value 输出
+     * @return 是否成功
+     */
+    static bool ParseDouble(std::string_view s, double& value);
+    static std::string_view Trim(std::string_view s);
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_pos;  //!< 下一行的起始位置
+    uint32_t m_lineNo;
+    std::string_view m_line;
+    std::string_view m_fields[MAX_FIELDS];
+    std::size_t m_nFields;
+
+    void* m_map;           //!< mmap 映射的地址
+    std::size_t m_mapSize; //!< 映射的字节数
+    std::string m_copy;    //!< 无 mmap 时读入的文件内容
+};
+
+} // namespace ns3
+
+#endif // DSW_CSV_READER_H
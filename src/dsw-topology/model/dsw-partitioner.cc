@@ -0,0 +1,362 @@
+#include "dsw-partitioner.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DswPartitioner");
+
+namespace {
+
+const uint32_t UNASSIGNED = std::numeric_limits<uint32_t>::max();
+/// 边界优化的最大轮数
+const uint32_t MAX_REFINE_PASSES = 16;
+
+/// 生长分区时的候选顶点：连接度大者优先，相同时下标小者优先
+struct Candidate
+{
+    double conn;
+    uint32_t v;
+
+    bool operator<(const Candidate& o) const
+    {
+        return conn < o.conn || (conn == o.conn && v > o.v);
+    }
+};
+
+} // namespace
+
+DswPartitioner::DswPartitioner()
+    : m_parts(1),
+      m_imbalance(0.05),
+      m_cutEdges(0),
+      m_cutWeight(0.0),
+      m_lookahead(Time::Max())
+{
+}
+
+void
+DswPartitioner::SetPartCount(uint32_t parts)
+{
+    NS_ASSERT_MSG(parts > 0, "At least one part");
+    m_parts = parts;
+}
+
+uint32_t
+DswPartitioner::GetPartCount() const
+{
+    return m_parts;
+}
+
+void
+DswPartitioner::SetImbalance(double imbalance)
+{
+    NS_ASSERT_MSG(imbalance >= 0.0, "Imbalance must not be negative");
+    m_imbalance = imbalance;
+}
+
+uint32_t
+DswPartitioner::AddVertex(double weight)
+{
+    NS_ASSERT_MSG(weight >= 0.0, "Vertex weight must not be negative");
+    m_weights.push_back(weight);
+    return static_cast<uint32_t>(m_weights.size() - 1);
+}
+
+void
+DswPartitioner::AddEdge(uint32_t a, uint32_t b, Time delay)
+{
+    NS_ASSERT_MSG(a < m_weights.size() && b < m_weights.size(),
+                  "Unknown vertex in edge " << a << "-" << b);
+    if (a != b)
+    {
+        m_edges.push_back({a, b, delay});
+    }
+}
+
+uint32_t
+DswPartitioner::GetNVertices() const
+{
+    return static_cast<uint32_t>(m_weights.size());
+}
+
+double
+DswPartitioner::EdgeWeight(Time delay)
+{
+    // 零时延的链路几乎不可切断
+    return 1.0 / std::max(delay.GetSeconds(), 1e-9);
+}
+
+void
+DswPartitioner::BuildAdjacency()
+{
+    const std::size_t n = m_weights.size();
+    m_adjStart.assign(n + 1, 0);
+    for (const auto& e : m_edges)
+    {
+        ++m_adjStart[e.a + 1];
+        ++m_adjStart[e.b + 1];
+    }
+    std::partial_sum(m_adjStart.begin(), m_adjStart.end(), m_adjStart.begin());
+    m_adjVertex.resize(m_adjStart[n]);
+    m_adjWeight.resize(m_adjStart[n]);
+    std::vector<uint32_t> fill(m_adjStart.begin(), m_adjStart.end() - 1);
+    for (const auto& e : m_edges)
+    {
+        const double w = EdgeWeight(e.delay);
+        m_adjVertex[fill[e.a]] = e.b;
+        m_adjWeight[fill[e.a]++] = w;
+        m_adjVertex[fill[e.b]] = e.a;
+        m_adjWeight[fill[e.b]++] = w;
+    }
+}
+
+void
+DswPartitioner::Grow()
+{
+    const uint32_t n = GetNVertices();
+    m_part.assign(n, UNASSIGNED);
+    double remaining = std::accumulate(m_weights.begin(), m_weights.end(), 0.0);
+    std::vector<double> conn(n, 0.0);
+    std::vector<uint32_t> touched;
+    uint32_t nextSeed = 0;
+
+    for (uint32_t p = 0; p + 1 < m_parts; ++p)
+    {
+        const double target = remaining / (m_parts - p);
+        double weight = 0.0;
+        std::priority_queue<Candidate> heap;
+        while (weight < target)
+        {
+            uint32_t v = UNASSIGNED;
+            while (!heap.empty())
+            {
+                Candidate c = heap.top();
+                heap.pop();
+                if (m_part[c.v] == UNASSIGNED && c.conn == conn[c.v])
+                {
+                    v = c.v;
+                    break;
+                }
+            }
+            if (v == UNASSIGNED)
+            {
+                // 当前连通块已用完（或刚开始），从编号最小的未分配顶点重新生长
+                while (nextSeed < n && m_part[nextSeed] != UNASSIGNED)
+                {
+                    ++nextSeed;
+                }
+                if (nextSeed == n)
+                {
+                    break;
+                }
+                v = nextSeed;
+            }
+            // 加入后离目标更远时停止，留给后面的分区
+            if (weight > 0.0 && weight + m_weights[v] - target > target - weight)
+            {
+                break;
+            }
+            m_part[v] = p;
+            weight += m_weights[v];
+            for (uint32_t i = m_adjStart[v]; i < m_adjStart[v + 1]; ++i)
+            {
+                const uint32_t u = m_adjVertex[i];
+                if (m_part[u] == UNASSIGNED)
+                {
+                    if (conn[u] == 0.0)
+                    {
+                        touched.push_back(u);
+                    }
+                    conn[u] += m_adjWeight[i];
+                    heap.push({conn[u], u});
+                }
+            }
+        }
+        remaining -= weight;
+        for (uint32_t u : touched)
+        {
+            conn[u] = 0.0;
+        }
+        touched.clear();
+    }
+    for (auto& part : m_part)
+    {
+        if (part == UNASSIGNED)
+        {
+            part = m_parts - 1;
+        }
+    }
+}
+
+void
+DswPartitioner::Refine()
+{
+    const uint32_t n = GetNVertices();
+    const double total = std::accumulate(m_weights.begin(), m_weights.end(), 0.0);
+    const double maxWeight = total / m_parts * (1.0 + m_imbalance);
+    m_partWeights.assign(m_parts, 0.0);
+    std::vector<uint32_t> partSize(m_parts, 0);
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        m_partWeights[m_part[v]] += m_weights[v];
+        ++partSize[m_part[v]];
+    }
+
+    std::vector<double> conn(m_parts, 0.0);
+    std::vector<uint32_t> touched;
+    for (uint32_t pass = 0; pass < MAX_REFINE_PASSES; ++pass)
+    {
+        uint32_t moved = 0;
+        for (uint32_t v = 0; v < n; ++v)
+        {
+            const uint32_t a = m_part[v];
+            if (partSize[a] == 1)
+            {
+                continue; // 不清空分区
+            }
+            for (uint32_t i = m_adjStart[v]; i < m_adjStart[v + 1]; ++i)
+            {
+                const uint32_t b = m_part[m_adjVertex[i]];
+                if (conn[b] == 0.0)
+                {
+                    touched.push_back(b);
+                }
+                conn[b] += m_adjWeight[i];
+            }
+
+            // 正收益移动；超重分区的顶点也可以负收益移出
+            const bool overweight = m_partWeights[a] > maxWeight;
+            const double internal = conn[a];
+            double bestGain = overweight ? -std::numeric_limits<double>::infinity()
+                                         : 1e-9 * std::max(1.0, internal);
+            uint32_t best = a;
+            for (uint32_t b : touched)
+            {
+                if (b == a || m_partWeights[b] + m_weights[v] > maxWeight)
+                {
+                    continue;
+                }
+                const double gain = conn[b] - internal;
+                if (gain > bestGain || (gain == bestGain && b < best))
+                {
+                    bestGain = gain;
+                    best = b;
+                }
+            }
+            if (best == a && overweight && m_adjStart[v] == m_adjStart[v + 1])
+            {
+                // 孤立顶点放到最轻的分区
+                best = static_cast<uint32_t>(
+                    std::min_element(m_partWeights.begin(), m_partWeights.end()) -
+                    m_partWeights.begin());
+                if (m_partWeights[best] + m_weights[v] > maxWeight)
+                {
+                    best = a;
+                }
+            }
+            for (uint32_t b : touched)
+            {
+                conn[b] = 0.0;
+            }
+            touched.clear();
+
+            if (best != a)
+            {
+                m_part[v] = best;
+                m_partWeights[a] -= m_weights[v];
+                m_partWeights[best] += m_weights[v];
+                --partSize[a];
+                ++partSize[best];
+                ++moved;
+            }
+        }
+        NS_LOG_DEBUG("Refine pass " << pass << ": " << moved << " moves");
+        if (moved == 0)
+        {
+            break;
+        }
+    }
+}
+
+void
+DswPartitioner::ComputeMetrics()
+{
+    m_partWeights.assign(m_parts, 0.0);
+    for (uint32_t v = 0; v < GetNVertices(); ++v)
+    {
+        m_partWeights[m_part[v]] += m_weights[v];
+    }
+    m_cutEdges = 0;
+    m_cutWeight = 0.0;
+    m_lookahead = Time::Max();
+    for (const auto& e : m_edges)
+    {
+        if (m_part[e.a] != m_part[e.b])
+        {
+            ++m_cutEdges;
+            m_cutWeight += EdgeWeight(e.delay);
+            m_lookahead = std::min(m_lookahead, e.delay);
+        }
+    }
+}
+
+void
+DswPartitioner::Run()
+{
+    BuildAdjacency();
+    Grow();
+    if (m_parts > 1)
+    {
+        Refine();
+    }
+    ComputeMetrics();
+    NS_LOG_INFO("Partitioned " << GetNVertices() << " vertices into " << m_parts
+                               << " parts: " << m_cutEdges << " cut edges, lookahead "
+                               << m_lookahead.As(Time::US));
+}
+
+uint32_t
+DswPartitioner::GetPart(uint32_t v) const
+{
+    NS_ASSERT_MSG(v < m_part.size(), "Unknown vertex " << v << " (Run() not called?)");
+    return m_part[v];
+}
+
+const std::vector<uint32_t>&
+DswPartitioner::GetParts() const
+{
+    return m_part;
+}
+
+const std::vector<double>&
+DswPartitioner::GetPartWeights() const
+{
+    return m_partWeights;
+}
+
+uint32_t
+DswPartitioner::GetCutEdges() const
+{
+    return m_cutEdges;
+}
+
+double
+DswPartitioner::GetCutWeight() const
+{
+    return m_cutWeight;
+}
+
+Time
+DswPartitioner::GetLookahead() const
+{
+    return m_lookahead;
+}
+
+} // namespace ns3
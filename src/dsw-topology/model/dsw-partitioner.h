@@ -0,0 +1,104 @@
+#ifndef DSW_PARTITIONER_H
+#define DSW_PARTITIONER_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * 把链路图划分给分布式仿真的各个进程 (MPI rank)。
+ *
+ * 顶点带负载权重（如度数或应用速率），边带链路时延。目标是各分区负载
+ * 均衡（不超过平均值的 1+imbalance 倍），同时使被切断的边的权重之和
+ * 最小，边权取时延的倒数：时延越短的链路越不应跨进程，跨进程链路的
+ * 最小时延就是分布式仿真的 lookahead。
+ *
+ * 先按连接度贪心地逐个生长分区（图生长法），再做若干轮边界顶点的
+ * 单点移动（Fiduccia-Mattheyses 式的正收益移动）以减小切边权重并修正
+ * 超重分区。结果只取决于输入顺序，可重复。
+ */
+class DswPartitioner
+{
+public:
+    DswPartitioner();
+
+    /**
+     * @param parts 分区数（至少 1）
+     */
+    void SetPartCount(uint32_t parts);
+    uint32_t GetPartCount(void) const;
+    /**
+     * @param imbalance 允许的分区负载超出平均值的比例，默认 0.05
+     */
+    void SetImbalance(double imbalance);
+
+    /**
+     * 添加顶点
+     * @param weight 负载权重（非负）
+     * @return 顶点下标，从 0 开始连续编号
+     */
+    uint32_t AddVertex(double weight);
+    /**
+     * 添加无向边，两端须已添加；自环被忽略
+     * @param a 顶点
+     * @param b 顶点
+     * @param delay 链路时延
+     */
+    void AddEdge(uint32_t a, uint32_t b, Time delay);
+    uint32_t GetNVertices(void) const;
+
+    /// 计算划分；可在修改输入后重复调用
+    void Run(void);
+
+    /// @return 顶点所在分区
+    uint32_t GetPart(uint32_t v) const;
+    /// @return 每个顶点所在分区
+    const std::vector<uint32_t>& GetParts(void) const;
+    /// @return 各分区的负载
+    const std::vector<double>& GetPartWeights(void) const;
+    /// @return 跨分区的边数
+    uint32_t GetCutEdges(void) const;
+    /// @return 跨分区边的权重（时延倒数，单位 1/s）之和
+    double GetCutWeight(void) const;
+    /// @return 跨分区边的最小时延；没有跨分区边时为 Time::Max()
+    Time GetLookahead(void) const;
+
+private:
+    /// 时延对应的切边权重
+    static double EdgeWeight(Time delay);
+    void BuildAdjacency(void);
+    void Grow(void);
+    void Refine(void);
+    void ComputeMetrics(void);
+
+    /// 一条输入边
+    struct Edge
+    {
+        uint32_t a;
+        uint32_t b;
+        Time delay;
+    };
+
+    uint32_t m_parts;
+    double m_imbalance;
+    std::vector<double> m_weights;
+    std::vector<Edge> m_edges;
+
+    // 压缩邻接表 (CSR)
+    std::vector<uint32_t> m_adjStart;
+    std::vector<uint32_t> m_adjVertex;
+    std::vector<double> m_adjWeight;
+
+    std::vector<uint32_t> m_part;
+    std::vector<double> m_partWeights;
+    uint32_t m_cutEdges;
+    double m_cutWeight;
+    Time m_lookahead;
+};
+
+} // namespace ns3
+
+#endif // DSW_PARTITIONER_H
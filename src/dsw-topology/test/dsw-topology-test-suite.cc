@@ -0,0 +1,460 @@
+#include "ns3/dsw-csv-reader.h"
+#include "ns3/dsw-partitioner.h"
+#include "ns3/dsw-topology-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/names.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * @defgroup dsw-topology-tests Tests for dsw-topology
+ * @ingroup dsw-topology
+ * @ingroup tests
+ */
+
+/**
+ * @ingroup dsw-topology-tests
+ * DswCsvReader 的切分与数值解析：注释、空行、CRLF、首尾空白、缺少末尾换行
+ */
+class DswCsvReaderTestCase : public TestCase
+{
+  public:
+    DswCsvReaderTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+DswCsvReaderTestCase::DswCsvReaderTestCase()
+    : TestCase("DswCsvReader splits trimmed fields without copying")
+{
+}
+
+void
+DswCsvReaderTestCase::DoRun()
+{
+    const std::string data = "id,x,y\r\n"
+                             "# comment\n"
+                             "\n"
+                             "  1 , 2.5 ,,  edge-a  \r\n"
+                             "   \t\n"
+                             "7,-1e3";
+    DswCsvReader reader;
+    reader.SetData(data.data(), data.size());
+
+    NS_TEST_ASSERT_MSG_EQ(reader.Next(), true, "Header line expected");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetLineNumber(), 1, "Header is line 1");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetNFields(), 3, "Three header fields");
+    NS_TEST_ASSERT_MSG_EQ(std::string(reader.GetField(2)), "y", "CR must be stripped");
+
+    NS_TEST_ASSERT_MSG_EQ(reader.Next(), true, "Data line expected");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetLineNumber(), 4, "Comment and empty lines are counted");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetNFields(), 4, "Empty fields are kept");
+    NS_TEST_ASSERT_MSG_EQ(std::string(reader.GetField(0)), "1", "Field 0 trimmed");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetField(2).empty(), true, "Field 2 empty");
+    NS_TEST_ASSERT_MSG_EQ(std::string(reader.GetField(3)), "edge-a", "Field 3 trimmed");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetField(9).empty(), true, "Missing field is empty");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetField(0).data(),
+                          data.data() + data.find('1'),
+                          "Fields point into the input");
+    double x = 0;
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseDouble(reader.GetField(1), x), true, "Parse x");
+    NS_TEST_ASSERT_MSG_EQ_TOL(x, 2.5, 1e-12, "x value");
+
+    NS_TEST_ASSERT_MSG_EQ(reader.Next(), true, "Last line without newline expected");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetLineNumber(), 6, "Whitespace-only line skipped");
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseDouble(reader.GetField(1), x), true, "Parse -1e3");
+    NS_TEST_ASSERT_MSG_EQ_TOL(x, -1000.0, 1e-9, "Exponent value");
+    NS_TEST_ASSERT_MSG_EQ(reader.Next(), false, "End of data");
+
+    uint32_t u = 0;
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseUint("42", u), true, "Plain integer");
+    NS_TEST_ASSERT_MSG_EQ(u, 42, "Integer value");
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseUint("", u), false, "Empty is not a number");
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseUint("-1", u), false, "Sign rejected");
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseUint("12a", u), false, "Trailing garbage rejected");
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseUint("99999999999", u), false, "Overflow rejected");
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseDouble("1.5x", x), false, "Trailing garbage");
+    NS_TEST_ASSERT_MSG_EQ(DswCsvReader::ParseDouble("+3", x), true, "Leading plus accepted");
+    NS_TEST_ASSERT_MSG_EQ_TOL(x, 3.0, 1e-12, "Plus value");
+
+    // 通过文件映射读取同样的数据
+    const std::string path = CreateTempDirFilename("dsw-csv-reader.csv");
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << data;
+    }
+    DswCsvReader fileReader;
+    NS_TEST_ASSERT_MSG_EQ(fileReader.Open(path), true, "Open temp file");
+    NS_TEST_ASSERT_MSG_EQ(fileReader.GetSize(), data.size(), "Whole file mapped");
+    uint32_t lines = 0;
+    while (fileReader.Next())
+    {
+        ++lines;
+    }
+    NS_TEST_ASSERT_MSG_EQ(lines, 3, "Same lines as the in-memory data");
+    fileReader.Close();
+    std::remove(path.c_str());
+    NS_TEST_ASSERT_MSG_EQ(fileReader.Open(path), false, "Missing file reported");
+}
+
+/**
+ * @ingroup dsw-topology-tests
+ * nodes.csv / links.csv 的校验规则
+ */
+class DswTopologyParseTestCase : public TestCase
+{
+  public:
+    DswTopologyParseTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+DswTopologyParseTestCase::DswTopologyParseTestCase()
+    : TestCase("DswTopologyHelper validates node and link lines")
+{
+}
+
+void
+DswTopologyParseTestCase::DoRun()
+{
+    const std::string nodes = "id,x,y,name,rate\n"
+                              "1,0,0,edge-1,10\n"
+                              "2,,,core-2,20.5\n"
+                              "3,1,1,router-3,5\n" // 名称前缀无效
+                              "4,1,1,edge-4,\n"    // 缺少速率
+                              "5,1,1,edge-5,-2\n"  // 速率非正
+                              "6,1,1,edge-6,fast\n"
+                              "0,1,1,edge-0,1\n" // 0 号保留
+                              "x,1,1,edge-7,1\n"
+                              "1,5,5,edge-1,1\n" // 重复 ID
+                              "8,a,1,edge-8,1\n";
+    DswTopologyHelper topo;
+    DswCsvReader reader;
+    reader.SetData(nodes.data(), nodes.size());
+    NS_TEST_ASSERT_MSG_EQ(topo.ReadNodes(reader), 2, "Only nodes 1 and 2 are valid");
+
+    const auto& specs = topo.GetNodeSpecs();
+    NS_TEST_ASSERT_MSG_EQ(specs[0].role, DswTopologyHelper::PRODUCER, "edge- is a producer");
+    NS_TEST_ASSERT_MSG_EQ(specs[0].hasPos, true, "Node 1 has a position");
+    NS_TEST_ASSERT_MSG_EQ(specs[1].role, DswTopologyHelper::CONSUMER, "core- is a consumer");
+    NS_TEST_ASSERT_MSG_EQ(specs[1].hasPos, false, "Node 2 is auto-placed");
+    NS_TEST_ASSERT_MSG_EQ_TOL(specs[1].appRate, 20.5, 1e-12, "Consumer rate");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodeSpec(2)->name, "core-2", "Lookup by id");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodeSpec(3), nullptr, "Rejected node is undefined");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodeSpec(1000), nullptr, "Unknown id is undefined");
+
+    const std::string links = "a,b,rate,id\n"
+                              "1,2,10Mbps,7\n"
+                              "2,3,1Gbps\n"    // id 缺省为序号
+                              "3,3,1Mbps\n"    // 自环
+                              "0,2,1Mbps\n"    // 0 号保留
+                              "1,2\n"          // 列数不足
+                              "1,4,10Mbps,\n"  // 空 id 列
+                              "4,5,fast\n"     // 速率无效
+                              "a,b,1Mbps\n"    // 非首行的表头
+                              "5,1,10Mbps,9\n";
+    reader.SetData(links.data(), links.size());
+    NS_TEST_ASSERT_MSG_EQ(topo.ReadLinks(reader), 4, "Four valid links");
+    const auto& ls = topo.GetLinkSpecs();
+    NS_TEST_ASSERT_MSG_EQ(ls[0].id, 7, "Explicit id");
+    NS_TEST_ASSERT_MSG_EQ(ls[1].id, 2, "Default id is the link count");
+    NS_TEST_ASSERT_MSG_EQ(ls[1].dataRate, DataRate("1Gbps"), "Rate parsed");
+    NS_TEST_ASSERT_MSG_EQ(ls[2].id, 3, "Empty id column uses the default");
+    NS_TEST_ASSERT_MSG_EQ(ls[2].rate, "10Mbps", "Rate string kept");
+    NS_TEST_ASSERT_MSG_EQ(ls[3].a, 5, "Original direction kept");
+}
+
+/**
+ * @ingroup dsw-topology-tests
+ * 从文件构建小拓扑：节点索引、去重、按距离计算的时延、地址与名称
+ */
+class DswTopologyBuildTestCase : public TestCase
+{
+  public:
+    DswTopologyBuildTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+DswTopologyBuildTestCase::DswTopologyBuildTestCase()
+    : TestCase("DswTopologyHelper builds nodes, links and addresses")
+{
+}
+
+void
+DswTopologyBuildTestCase::DoRun()
+{
+    const std::string nodesPath = CreateTempDirFilename("nodes.csv");
+    const std::string linksPath = CreateTempDirFilename("links.csv");
+    {
+        std::ofstream out(nodesPath.c_str());
+        out << "id,x,y,name,rate\n"
+               "1,0,0,edge-t1,10\n"
+               "2,3,4,core-t2,20\n";
+    }
+    {
+        std::ofstream out(linksPath.c_str());
+        out << "a,b,rate\n"
+               "1,2,10Mbps\n"
+               "2,1,1Mbps\n" // 与上一条重复
+               "2,5,100Mbps\n";
+    }
+
+    DswTopologyHelper topo;
+    topo.SetDelayByDistance(true, 1000.0, 2e8, 2.0);
+    NS_TEST_ASSERT_MSG_EQ(topo.LoadNodes(nodesPath), 2, "Two nodes");
+    NS_TEST_ASSERT_MSG_EQ(topo.LoadLinks(linksPath), 3, "Duplicates are removed at build time");
+    topo.Build();
+    std::remove(nodesPath.c_str());
+    std::remove(linksPath.c_str());
+
+    NS_TEST_ASSERT_MSG_EQ(topo.GetMaxId(), 5, "Max id from links");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodes().GetN(), 6, "Nodes 0..maxId are created");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodeIds().size(), 3, "Nodes 1, 2 and 5 are used");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodeSpec(5), nullptr, "Router-only node has no spec");
+    NS_TEST_ASSERT_MSG_EQ(Names::Find<Node>("core-t2"), topo.GetNodes().Get(2), "Node named");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetPosition(5).x, 0.0, "Auto layout starts at the origin");
+
+    const auto& links = topo.GetLinks();
+    NS_TEST_ASSERT_MSG_EQ(links.size(), 2, "Duplicate link ignored");
+    // 距离 5 单位 * 1000 m / 2e8 m/s * 2 = 50 us
+    NS_TEST_ASSERT_MSG_EQ(links[0].delay, MicroSeconds(50), "Distance-based delay");
+    NS_TEST_ASSERT_MSG_EQ_TOL(links[0].distanceMeters, 5000.0, 1e-9, "Distance in meters");
+    Ptr<PointToPointNetDevice> dev =
+        DynamicCast<PointToPointNetDevice>(links[0].devices.Get(0));
+    TimeValue delay;
+    dev->GetChannel()->GetAttribute("Delay", delay);
+    NS_TEST_ASSERT_MSG_EQ(delay.Get(), MicroSeconds(50), "Channel delay set");
+    DataRateValue rate;
+    dev->GetAttribute("DataRate", rate);
+    NS_TEST_ASSERT_MSG_EQ(rate.Get(), DataRate("10Mbps"), "Device rate set");
+    dev = DynamicCast<PointToPointNetDevice>(links[1].devices.Get(0));
+    dev->GetAttribute("DataRate", rate);
+    NS_TEST_ASSERT_MSG_EQ(rate.Get(), DataRate("100Mbps"), "Per-link rate");
+
+    NS_TEST_ASSERT_MSG_EQ(links[0].interfaces.GetAddress(0),
+                          Ipv4Address("10.0.0.1"),
+                          "First link, side a");
+    NS_TEST_ASSERT_MSG_EQ(links[1].interfaces.GetAddress(1),
+                          Ipv4Address("10.0.0.6"),
+                          "Each link gets its own network");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodeAddress(2), Ipv4Address("10.0.0.2"), "First interface");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodeAddress(2),
+                          topo.GetNodes().Get(2)->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal(),
+                          "Same as interface 1");
+    NS_TEST_ASSERT_MSG_EQ(topo.GetNodeAddress(0), Ipv4Address(), "Placeholder has no address");
+
+    Simulator::Destroy();
+    Names::Clear();
+}
+
+/**
+ * @ingroup dsw-topology-tests
+ * DswPartitioner：在长时延的桥上切开两个簇；网格上的负载均衡
+ */
+class DswPartitionerTestCase : public TestCase
+{
+  public:
+    DswPartitionerTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+DswPartitionerTestCase::DswPartitionerTestCase()
+    : TestCase("DswPartitioner cuts long links and balances the load")
+{
+}
+
+void
+DswPartitionerTestCase::DoRun()
+{
+    // 两个 4 节点的全连接簇（1us），由一条 1ms 的桥 3-4 相连
+    DswPartitioner bridge;
+    bridge.SetPartCount(2);
+    for (uint32_t v = 0; v < 8; ++v)
+    {
+        bridge.AddVertex(1.0);
+    }
+    for (uint32_t base = 0; base < 8; base += 4)
+    {
+        for (uint32_t a = base; a < base + 4; ++a)
+        {
+            for (uint32_t b = a + 1; b < base + 4; ++b)
+            {
+                bridge.AddEdge(a, b, MicroSeconds(1));
+            }
+        }
+    }
+    bridge.AddEdge(3, 4, MilliSeconds(1));
+    bridge.Run();
+    NS_TEST_ASSERT_MSG_EQ(bridge.GetCutEdges(), 1, "Only the bridge is cut");
+    NS_TEST_ASSERT_MSG_EQ(bridge.GetLookahead(), MilliSeconds(1), "Lookahead is the bridge delay");
+    for (uint32_t v = 0; v < 8; ++v)
+    {
+        NS_TEST_ASSERT_MSG_EQ(bridge.GetPart(v), v / 4, "Clusters stay together");
+    }
+
+    // 8x8 网格，4 个分区：每个分区 16 个顶点，切边不多于按象限切分的两倍
+    DswPartitioner grid;
+    grid.SetPartCount(4);
+    const uint32_t side = 8;
+    for (uint32_t v = 0; v < side * side; ++v)
+    {
+        grid.AddVertex(1.0);
+    }
+    for (uint32_t r = 0; r < side; ++r)
+    {
+        for (uint32_t c = 0; c < side; ++c)
+        {
+            const uint32_t v = r * side + c;
+            if (c + 1 < side)
+            {
+                grid.AddEdge(v, v + 1, MicroSeconds(10));
+            }
+            if (r + 1 < side)
+            {
+                grid.AddEdge(v, v + side, MicroSeconds(10));
+            }
+        }
+    }
+    grid.Run();
+    for (double w : grid.GetPartWeights())
+    {
+        NS_TEST_ASSERT_MSG_EQ(w, 16.0, "Balanced parts");
+    }
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(grid.GetCutEdges(), 32, "Compact parts");
+    NS_TEST_ASSERT_MSG_EQ_TOL(grid.GetCutWeight(),
+                              grid.GetCutEdges() / 10e-6,
+                              1e-3,
+                              "Cut weight is the inverse delay");
+
+    // 单个分区没有切边
+    DswPartitioner single;
+    single.AddVertex(1.0);
+    single.AddVertex(2.0);
+    single.AddEdge(0, 1, MicroSeconds(1));
+    single.Run();
+    NS_TEST_ASSERT_MSG_EQ(single.GetCutEdges(), 0, "Nothing to cut");
+    NS_TEST_ASSERT_MSG_EQ(single.GetLookahead(), Time::Max(), "No lookahead limit");
+}
+
+/**
+ * @ingroup dsw-topology-tests
+ * DswTopologyHelper::SetPartitioning：节点按划分结果获得 system id
+ */
+class DswTopologyPartitionTestCase : public TestCase
+{
+  public:
+    DswTopologyPartitionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+DswTopologyPartitionTestCase::DswTopologyPartitionTestCase()
+    : TestCase("DswTopologyHelper assigns system ids from the partition")
+{
+}
+
+void
+DswTopologyPartitionTestCase::DoRun()
+{
+    const std::string nodesPath = CreateTempDirFilename("nodes.csv");
+    const std::string linksPath = CreateTempDirFilename("links.csv");
+    const std::string partPath = CreateTempDirFilename("partition.csv");
+    {
+        // 两个相距 100 单位的三角形
+        std::ofstream out(nodesPath.c_str());
+        out << "1,0,0,edge-a1,1\n"
+               "2,0,1,edge-a2,1\n"
+               "3,1,0,core-a3,1\n"
+               "4,101,0,core-b4,1\n"
+               "5,101,1,edge-b5,1\n"
+               "6,102,0,edge-b6,1\n";
+    }
+    {
+        std::ofstream out(linksPath.c_str());
+        out << "1,2,10Mbps\n"
+               "1,3,10Mbps\n"
+               "2,3,10Mbps\n"
+               "3,4,10Mbps\n"
+               "4,5,10Mbps\n"
+               "4,6,10Mbps\n"
+               "5,6,10Mbps\n";
+    }
+
+    DswTopologyHelper topo;
+    topo.SetDelayByDistance(true, 1000.0, 2e8, 1.0);
+    topo.SetPartitioning(2);
+    topo.LoadNodes(nodesPath);
+    topo.LoadLinks(linksPath);
+    topo.Build();
+    std::remove(nodesPath.c_str());
+    std::remove(linksPath.c_str());
+
+    for (uint32_t id = 1; id <= 6; ++id)
+    {
+        const uint32_t expected = id <= 3 ? 0 : 1;
+        NS_TEST_ASSERT_MSG_EQ(topo.GetSystemId(id), expected, "Triangles stay together");
+        NS_TEST_ASSERT_MSG_EQ(topo.GetNodes().Get(id)->GetSystemId(),
+                              expected,
+                              "Node created with its system id");
+        NS_TEST_ASSERT_MSG_EQ(topo.IsLocal(id), true, "Everything is local without MPI");
+    }
+    NS_TEST_ASSERT_MSG_EQ(topo.GetPartitioner().GetCutEdges(), 1, "Only the bridge is cut");
+    // 100 单位 * 1000 m / 2e8 m/s = 500 us
+    NS_TEST_ASSERT_MSG_EQ(topo.GetPartitioner().GetLookahead(),
+                          MicroSeconds(500),
+                          "Lookahead is the bridge delay");
+
+    NS_TEST_ASSERT_MSG_EQ(topo.WritePartition(partPath), true, "Partition written");
+    std::ifstream in(partPath.c_str());
+    std::string line;
+    std::getline(in, line);
+    NS_TEST_ASSERT_MSG_EQ(line, "id,systemId", "Header");
+    std::getline(in, line);
+    NS_TEST_ASSERT_MSG_EQ(line, "1,0", "First node");
+    in.close();
+    std::remove(partPath.c_str());
+
+    Simulator::Destroy();
+    Names::Clear();
+}
+
+/**
+ * @ingroup dsw-topology-tests
+ * DswTopologyHelper 测试套件
+ */
+class DswTopologyTestSuite : public TestSuite
+{
+  public:
+    DswTopologyTestSuite();
+};
+
+DswTopologyTestSuite::DswTopologyTestSuite()
+    : TestSuite("dsw-topology", UNIT)
+{
+    AddTestCase(new DswCsvReaderTestCase, TestCase::QUICK);
+    AddTestCase(new DswTopologyParseTestCase, TestCase::QUICK);
+    AddTestCase(new DswTopologyBuildTestCase, TestCase::QUICK);
+    AddTestCase(new DswPartitionerTestCase, TestCase::QUICK);
+    AddTestCase(new DswTopologyPartitionTestCase, TestCase::QUICK);
+}
+
+/**
+ * @ingroup dsw-topology-tests
+ * Static variable for test initialization
+ */
+static DswTopologyTestSuite sdswTopologyTestSuite;
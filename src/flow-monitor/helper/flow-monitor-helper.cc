@@ -19,6 +19,7 @@
 
 #include "flow-monitor-helper.h"
 
+#include "ns3/abort.h"
 #include "ns3/flow-monitor.h"
 #include "ns3/ipv4-flow-classifier.h"
 #include "ns3/ipv4-flow-probe.h"
@@ -28,6 +29,8 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/node-list.h"
 #include "ns3/node.h"
+#include "ns3/simulator-impl.h"
+#include "ns3/simulator.h"
 
 namespace ns3
 {
@@ -59,11 +62,14 @@ FlowMonitorHelper::GetMonitor()
 {
     if (!m_flowMonitor)
     {
+        NS_ABORT_MSG_IF(Simulator::GetImplementation()->GetInstanceTypeId().GetName() ==
+                            "ns3::MultithreadedSimulatorImpl",
+                        "FlowMonitor is not thread-safe and cannot be used with "
+                        "ns3::MultithreadedSimulatorImpl");
         m_flowMonitor = m_monitorFactory.Create<FlowMonitor>();
-        m_flowClassifier4 = Create<Ipv4FlowClassifier>();
-        m_flowMonitor->AddFlowClassifier(m_flowClassifier4);
-        m_flowClassifier6 = Create<Ipv6FlowClassifier>();
-        m_flowMonitor->AddFlowClassifier(m_flowClassifier6);
+        // keep the classifiers created (and filtered) before the monitor
+        m_flowMonitor->AddFlowClassifier(GetClassifier());
+        m_flowMonitor->AddFlowClassifier(GetClassifier6());
     }
     return m_flowMonitor;
 }
@@ -137,6 +143,21 @@ FlowMonitorHelper::InstallAll()
     return m_flowMonitor;
 }
 
+Ptr<FlowMonitor>
+FlowMonitorHelper::InstallOnEndpoints()
+{
+    for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i)
+    {
+        Ptr<Node> node = *i;
+        if (node->GetNApplications() > 0 &&
+            (node->GetObject<Ipv4L3Protocol>() || node->GetObject<Ipv6L3Protocol>()))
+        {
+            Install(node);
+        }
+    }
+    return m_flowMonitor;
+}
+
 void
 FlowMonitorHelper::SerializeToXmlStream(std::ostream& os,
                                         uint16_t indent,
@@ -36,6 +36,10 @@ class Ipv6FlowClassifier;
 /**
  * \ingroup flow-monitor
  * \brief Helper to enable IP flow monitoring on a set of Nodes
+ *
+ * The monitor and classifiers are shared by all the nodes without any
+ * locking, so the helper aborts when the simulator implementation is
+ * ns3::MultithreadedSimulatorImpl.
  */
 class FlowMonitorHelper
 {
@@ -72,6 +76,20 @@ class FlowMonitorHelper
      */
     Ptr<FlowMonitor> InstallAll();
 
+    /**
+     * \brief Enable flow monitoring on the endpoints of the flows, i.e. on
+     * the nodes with applications
+     *
+     * The packets are then only seen when they are sent and received, and
+     * not at every hop.  The number of times they were forwarded is
+     * estimated from the decrease of their TTL, but there are no per-probe
+     * statistics of the forwarding nodes, and the packets dropped in the
+     * network are only counted as lost, after MaxPerHopDelay.
+     *
+     * \returns a pointer to the FlowMonitor object
+     */
+    Ptr<FlowMonitor> InstallOnEndpoints();
+
     /**
      * \brief Retrieve the FlowMonitor object created by the Install* methods
      * \returns a pointer to the FlowMonitor object
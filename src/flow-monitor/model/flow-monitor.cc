@@ -19,10 +19,14 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/abort.h"
 #include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -35,6 +39,22 @@ NS_LOG_COMPONENT_DEFINE("FlowMonitor");
 
 NS_OBJECT_ENSURE_REGISTERED(FlowMonitor);
 
+/**
+ * \brief Finalizer of the 64-bit MurmurHash3
+ * \param key the value to hash
+ * \returns the hash of the value
+ */
+static uint64_t
+MixKey(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
 TypeId
 FlowMonitor::GetTypeId()
 {
@@ -80,7 +100,48 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("SnapshotInterval",
+                          ("The interval between the snapshots of the flow statistics.  "
+                           "Zero disables the snapshots."),
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_snapshotInterval),
+                          MakeTimeChecker())
+            .AddAttribute("PacketSamplingRate",
+                          ("Track only one packet in this many of each flow.  "
+                           "1 tracks all the packets."),
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_samplingRate),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("PacketSamplingMode",
+                          ("How the tracked packets are selected when PacketSamplingRate "
+                           "is larger than 1."),
+                          EnumValue(FlowMonitor::SAMPLING_DETERMINISTIC),
+                          MakeEnumAccessor(&FlowMonitor::m_samplingMode),
+                          MakeEnumChecker(FlowMonitor::SAMPLING_DETERMINISTIC,
+                                          "Deterministic",
+                                          FlowMonitor::SAMPLING_HASH,
+                                          "Hash"))
+            .AddAttribute("HistogramType",
+                          ("The type of the histograms of the flows.  The log-linear "
+                           "histograms use the bin widths as the widths of their "
+                           "smallest bins."),
+                          EnumValue(FlowMonitor::HISTOGRAM_FIXED),
+                          MakeEnumAccessor(&FlowMonitor::m_histogramType),
+                          MakeEnumChecker(FlowMonitor::HISTOGRAM_FIXED,
+                                          "Fixed",
+                                          FlowMonitor::HISTOGRAM_LOG_LINEAR,
+                                          "LogLinear"))
+            .AddAttribute("HistogramSignificantBits",
+                          ("The significant bits of the log-linear histograms: their bins "
+                           "are at most 2^-HistogramSignificantBits of their start wide."),
+                          UintegerValue(7),
+                          MakeUintegerAccessor(&FlowMonitor::m_histogramSignificantBits),
+                          MakeUintegerChecker<uint8_t>(1, 20))
+            .AddTraceSource("Snapshot",
+                            "The changes of the counters of a flow since the previous snapshot.",
+                            MakeTraceSourceAccessor(&FlowMonitor::m_snapshotTrace),
+                            "ns3::FlowMonitor::SnapshotTracedCallback");
     return tid;
 }
 
@@ -91,7 +152,11 @@ FlowMonitor::GetInstanceTypeId() const
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_enabled(false),
+      m_samplingRate(1),
+      m_samplingMode(SAMPLING_DETERMINISTIC),
+      m_histogramType(HISTOGRAM_FIXED),
+      m_histogramSignificantBits(7)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -102,6 +167,9 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_snapshotEvent);
+    m_snapshotStream = nullptr;
+    m_snapshotFlowFilter = MakeNullCallback<bool, FlowId>();
     for (std::list<Ptr<FlowClassifier>>::iterator iter = m_classifiers.begin();
          iter != m_classifiers.end();
          iter++)
@@ -138,6 +206,15 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
         ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
         ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
         ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
+        if (m_histogramType == HISTOGRAM_LOG_LINEAR)
+        {
+            ref.delayLogHistogram.SetResolution(m_delayBinWidth, m_histogramSignificantBits);
+            ref.jitterLogHistogram.SetResolution(m_jitterBinWidth, m_histogramSignificantBits);
+            ref.packetSizeLogHistogram.SetResolution(m_packetSizeBinWidth,
+                                                     m_histogramSignificantBits);
+            ref.flowInterruptionsLogHistogram.SetResolution(m_flowInterruptionsBinWidth,
+                                                            m_histogramSignificantBits);
+        }
         return ref;
     }
     else
@@ -146,6 +223,33 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
     }
 }
 
+void
+FlowMonitor::AddToHistogram(Histogram& histogram, LogLinearHistogram& logHistogram, double value)
+{
+    if (m_histogramType == HISTOGRAM_LOG_LINEAR)
+    {
+        logHistogram.AddValue(value);
+    }
+    else
+    {
+        histogram.AddValue(value);
+    }
+}
+
+bool
+FlowMonitor::IsSampled(FlowId flowId, FlowPacketId packetId) const
+{
+    if (m_samplingRate <= 1)
+    {
+        return true;
+    }
+    if (m_samplingMode == SAMPLING_HASH)
+    {
+        return MixKey((uint64_t(flowId) << 32) | packetId) % m_samplingRate == 0;
+    }
+    return packetId % m_samplingRate == 0;
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -159,10 +263,12 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         return;
     }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    uint32_t entry = m_trackedPackets.Insert(flowId, packetId);
+    TrackedPacket& tracked = m_trackedPackets.Get(entry);
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
+    m_trackedPackets.Touch(entry);
     NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
                                                                  << packetId << ").");
 
@@ -190,19 +296,20 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    TrackedPacketMap::iterator tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    uint32_t entry = m_trackedPackets.Find(flowId, packetId);
+    if (entry == TrackedPacketTable::NONE)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    TrackedPacket& tracked = m_trackedPackets.Get(entry);
+    tracked.timesForwarded++;
+    tracked.lastSeenTime = Simulator::Now();
+    m_trackedPackets.Touch(entry);
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+    Time delay = (Simulator::Now() - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 }
 
@@ -210,47 +317,49 @@ void
 FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
                           uint32_t flowId,
                           uint32_t packetId,
-                          uint32_t packetSize)
+                          uint32_t packetSize,
+                          uint32_t hops)
 {
-    NS_LOG_FUNCTION(this << probe << flowId << packetId << packetSize);
+    NS_LOG_FUNCTION(this << probe << flowId << packetId << packetSize << hops);
     if (!m_enabled)
     {
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    TrackedPacketMap::iterator tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    uint32_t entry = m_trackedPackets.Find(flowId, packetId);
+    if (entry == TrackedPacketTable::NONE)
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
+    const TrackedPacket& tracked = m_trackedPackets.Get(entry);
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
+    Time delay = (now - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.delaySum += delay;
-    stats.delayHistogram.AddValue(delay.GetSeconds());
+    AddToHistogram(stats.delayHistogram, stats.delayLogHistogram, delay.GetSeconds());
     if (stats.rxPackets > 0)
     {
         Time jitter = stats.lastDelay - delay;
         if (jitter > Seconds(0))
         {
             stats.jitterSum += jitter;
-            stats.jitterHistogram.AddValue(jitter.GetSeconds());
+            AddToHistogram(stats.jitterHistogram, stats.jitterLogHistogram, jitter.GetSeconds());
         }
         else
         {
             stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            AddToHistogram(stats.jitterHistogram, stats.jitterLogHistogram, -jitter.GetSeconds());
         }
     }
     stats.lastDelay = delay;
 
     stats.rxBytes += packetSize;
-    stats.packetSizeHistogram.AddValue((double)packetSize);
+    AddToHistogram(stats.packetSizeHistogram, stats.packetSizeLogHistogram, (double)packetSize);
     stats.rxPackets++;
     if (stats.rxPackets == 1)
     {
@@ -262,16 +371,18 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         Time interArrivalTime = now - stats.timeLastRxPacket;
         if (interArrivalTime > m_flowInterruptionsMinTime)
         {
-            stats.flowInterruptionsHistogram.AddValue(interArrivalTime.GetSeconds());
+            AddToHistogram(stats.flowInterruptionsHistogram,
+                           stats.flowInterruptionsLogHistogram,
+                           interArrivalTime.GetSeconds());
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += std::max(tracked.timesForwarded, hops);
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    m_trackedPackets.Erase(entry); // we don't need to track this packet anymore
 }
 
 void
@@ -302,14 +413,14 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    TrackedPacketMap::iterator tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    uint32_t entry = m_trackedPackets.Find(flowId, packetId);
+    if (entry != TrackedPacketTable::NONE)
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        m_trackedPackets.Erase(entry);
     }
 }
 
@@ -325,23 +436,20 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (TrackedPacketMap::iterator iter = m_trackedPackets.begin();
-         iter != m_trackedPackets.end();)
+    // the packets are in the order of their last-seen time, so the lost
+    // packets are the first ones
+    for (uint32_t entry = m_trackedPackets.GetOldest();
+         entry != TrackedPacketTable::NONE &&
+         now - m_trackedPackets.Get(entry).lastSeenTime >= maxDelay;
+         entry = m_trackedPackets.GetOldest())
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-            // packet is considered lost, add it to the loss statistics
-            FlowStatsContainerI flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+        // packet is considered lost, add it to the loss statistics
+        FlowStatsContainerI flow = m_flowStats.find(m_trackedPackets.GetFlowId(entry));
+        NS_ASSERT(flow != m_flowStats.end());
+        flow->second.lostPackets++;
 
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
-        {
-            iter++;
-        }
+        // we won't track it anymore
+        m_trackedPackets.Erase(entry);
     }
 }
 
@@ -358,6 +466,185 @@ FlowMonitor::PeriodicCheckForLostPackets()
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
+FlowMonitor::TrackedPacketTable::TrackedPacketTable()
+    : m_slots(1024, Slot{0, NONE}),
+      m_free(NONE),
+      m_oldest(NONE),
+      m_newest(NONE),
+      m_size(0)
+{
+}
+
+std::size_t
+FlowMonitor::TrackedPacketTable::GetSlot(uint64_t key) const
+{
+    // hash the key to spread the sequential packet ids
+    return MixKey(key) & (m_slots.size() - 1);
+}
+
+std::size_t
+FlowMonitor::TrackedPacketTable::Probe(uint64_t key) const
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = GetSlot(key);
+    while (m_slots[i].entry != NONE && m_slots[i].key != key)
+    {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+uint32_t
+FlowMonitor::TrackedPacketTable::Find(FlowId flowId, FlowPacketId packetId) const
+{
+    return m_slots[Probe((uint64_t(flowId) << 32) | packetId)].entry;
+}
+
+uint32_t
+FlowMonitor::TrackedPacketTable::Insert(FlowId flowId, FlowPacketId packetId)
+{
+    if ((m_size + 1) * 2 > m_slots.size())
+    {
+        Grow();
+    }
+    uint64_t key = (uint64_t(flowId) << 32) | packetId;
+    Slot& slot = m_slots[Probe(key)];
+    if (slot.entry != NONE)
+    {
+        return slot.entry;
+    }
+    uint32_t entry = m_free;
+    if (entry != NONE)
+    {
+        m_free = m_entries[entry].next;
+    }
+    else
+    {
+        NS_ABORT_MSG_IF(m_entries.size() >= NONE, "Too many tracked packets");
+        entry = m_entries.size();
+        m_entries.emplace_back();
+    }
+    m_entries[entry].key = key;
+    m_entries[entry].packet = TrackedPacket();
+    Link(entry);
+    slot.key = key;
+    slot.entry = entry;
+    m_size++;
+    return entry;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Erase(uint32_t entry)
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = Probe(m_entries[entry].key);
+    NS_ASSERT(m_slots[i].entry == entry);
+    Unlink(entry);
+    m_entries[entry].next = m_free;
+    m_free = entry;
+    m_size--;
+
+    // shift back the following keys of the probe sequence into the hole,
+    // unless they are already at or after their first slot
+    std::size_t j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if (m_slots[j].entry == NONE)
+        {
+            break;
+        }
+        std::size_t k = GetSlot(m_slots[j].key);
+        if ((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j))
+        {
+            m_slots[i] = m_slots[j];
+            i = j;
+        }
+    }
+    m_slots[i].entry = NONE;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Touch(uint32_t entry)
+{
+    if (entry != m_newest)
+    {
+        Unlink(entry);
+        Link(entry);
+    }
+}
+
+FlowMonitor::TrackedPacket&
+FlowMonitor::TrackedPacketTable::Get(uint32_t entry)
+{
+    return m_entries[entry].packet;
+}
+
+FlowId
+FlowMonitor::TrackedPacketTable::GetFlowId(uint32_t entry) const
+{
+    return m_entries[entry].key >> 32;
+}
+
+uint32_t
+FlowMonitor::TrackedPacketTable::GetOldest() const
+{
+    return m_oldest;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Unlink(uint32_t entry)
+{
+    Entry& e = m_entries[entry];
+    if (e.prev != NONE)
+    {
+        m_entries[e.prev].next = e.next;
+    }
+    else
+    {
+        m_oldest = e.next;
+    }
+    if (e.next != NONE)
+    {
+        m_entries[e.next].prev = e.prev;
+    }
+    else
+    {
+        m_newest = e.prev;
+    }
+}
+
+void
+FlowMonitor::TrackedPacketTable::Link(uint32_t entry)
+{
+    Entry& e = m_entries[entry];
+    e.prev = m_newest;
+    e.next = NONE;
+    if (m_newest != NONE)
+    {
+        m_entries[m_newest].next = entry;
+    }
+    else
+    {
+        m_oldest = entry;
+    }
+    m_newest = entry;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Grow()
+{
+    std::vector<Slot> slots(m_slots.size() * 2, Slot{0, NONE});
+    slots.swap(m_slots);
+    for (const Slot& slot : slots)
+    {
+        if (slot.entry != NONE)
+        {
+            m_slots[Probe(slot.key)] = slot;
+        }
+    }
+}
+
 void
 FlowMonitor::NotifyConstructionCompleted()
 {
@@ -410,6 +697,11 @@ FlowMonitor::StartRightNow()
         return;
     }
     m_enabled = true;
+    if (m_snapshotInterval.IsStrictlyPositive())
+    {
+        m_snapshotEvent =
+            Simulator::Schedule(m_snapshotInterval, &FlowMonitor::PeriodicSnapshot, this);
+    }
 }
 
 void
@@ -423,6 +715,99 @@ FlowMonitor::StopRightNow()
     }
     m_enabled = false;
     CheckForLostPackets();
+    if (m_snapshotEvent.IsRunning())
+    {
+        // last snapshot, of the end of the monitoring
+        Simulator::Cancel(m_snapshotEvent);
+        SnapshotRightNow();
+    }
+}
+
+void
+FlowMonitor::VisitFlowStats(FlowStatsVisitor visitor) const
+{
+    NS_LOG_FUNCTION(this);
+    for (FlowStatsContainerCI iter = m_flowStats.begin(); iter != m_flowStats.end(); iter++)
+    {
+        visitor(iter->first, iter->second);
+    }
+}
+
+void
+FlowMonitor::SetSnapshotStream(Ptr<OutputStreamWrapper> stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_snapshotStream = stream;
+    if (m_snapshotStream)
+    {
+        *m_snapshotStream->GetStream() << "time(ns),flowId,txPackets,txBytes,rxPackets,rxBytes,"
+                                          "lostPackets,delaySum(ns),jitterSum(ns)"
+                                       << std::endl;
+    }
+}
+
+void
+FlowMonitor::SetSnapshotFlowFilter(Callback<bool, FlowId> filter)
+{
+    NS_LOG_FUNCTION(this);
+    m_snapshotFlowFilter = filter;
+}
+
+void
+FlowMonitor::SnapshotRightNow()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    std::ostream* os = m_snapshotStream ? m_snapshotStream->GetStream() : nullptr;
+    for (FlowStatsContainerCI iter = m_flowStats.begin(); iter != m_flowStats.end(); iter++)
+    {
+        FlowId flowId = iter->first;
+        if (!m_snapshotFlowFilter.IsNull() && !m_snapshotFlowFilter(flowId))
+        {
+            continue;
+        }
+        const FlowStats& stats = iter->second;
+        FlowSnapshot& last = m_snapshotTotals[flowId];
+        FlowSnapshot delta;
+        delta.txBytes = stats.txBytes - last.txBytes;
+        delta.rxBytes = stats.rxBytes - last.rxBytes;
+        delta.txPackets = stats.txPackets - last.txPackets;
+        delta.rxPackets = stats.rxPackets - last.rxPackets;
+        delta.lostPackets = stats.lostPackets - last.lostPackets;
+        delta.delaySum = stats.delaySum - last.delaySum;
+        delta.jitterSum = stats.jitterSum - last.jitterSum;
+        if (delta.txPackets == 0 && delta.rxPackets == 0 && delta.lostPackets == 0)
+        {
+            continue;
+        }
+        last.txBytes = stats.txBytes;
+        last.rxBytes = stats.rxBytes;
+        last.txPackets = stats.txPackets;
+        last.rxPackets = stats.rxPackets;
+        last.lostPackets = stats.lostPackets;
+        last.delaySum = stats.delaySum;
+        last.jitterSum = stats.jitterSum;
+
+        m_snapshotTrace(now, flowId, delta);
+        if (os)
+        {
+            *os << now.GetNanoSeconds() << ',' << flowId << ',' << delta.txPackets << ','
+                << delta.txBytes << ',' << delta.rxPackets << ',' << delta.rxBytes << ','
+                << delta.lostPackets << ',' << delta.delaySum.GetNanoSeconds() << ','
+                << delta.jitterSum.GetNanoSeconds() << '\n';
+        }
+    }
+    if (os)
+    {
+        os->flush();
+    }
+}
+
+void
+FlowMonitor::PeriodicSnapshot()
+{
+    SnapshotRightNow();
+    m_snapshotEvent = Simulator::Schedule(m_snapshotInterval, &FlowMonitor::PeriodicSnapshot, this);
 }
 
 void
@@ -473,7 +858,19 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
             os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
                << " bytes=\"" << flowI->second.bytesDropped[reasonCode] << "\" />\n";
         }
-        if (enableHistograms)
+        if (enableHistograms && m_histogramType == HISTOGRAM_LOG_LINEAR)
+        {
+            flowI->second.delayLogHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
+            flowI->second.jitterLogHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
+            flowI->second.packetSizeLogHistogram.SerializeToXmlStream(os,
+                                                                      indent,
+                                                                      "packetSizeHistogram");
+            flowI->second.flowInterruptionsLogHistogram.SerializeToXmlStream(
+                os,
+                indent,
+                "flowInterruptionsHistogram");
+        }
+        else if (enableHistograms)
         {
             flowI->second.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
             flowI->second.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
@@ -515,6 +912,34 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     os << std::string(indent, ' ') << "</FlowMonitor>\n";
 }
 
+void
+FlowMonitor::SerializeHistogramsToCsvStream(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(m_histogramType == HISTOGRAM_LOG_LINEAR,
+                        "Only the log-linear histograms can be serialized in CSV format");
+
+    os << "flowId,histogram,resolution,significantBits,count,min,max,bins\n";
+    for (const auto& flow : m_flowStats)
+    {
+        const std::pair<const char*, const LogLinearHistogram*> histograms[] = {
+            {"delay", &flow.second.delayLogHistogram},
+            {"jitter", &flow.second.jitterLogHistogram},
+            {"packetSize", &flow.second.packetSizeLogHistogram},
+            {"flowInterruptions", &flow.second.flowInterruptionsLogHistogram},
+        };
+        for (const auto& histogram : histograms)
+        {
+            const LogLinearHistogram& h = *histogram.second;
+            os << flow.first << "," << histogram.first << "," << h.GetResolution() << ","
+               << +h.GetSignificantBits() << "," << h.GetCount() << "," << h.GetMin() << ","
+               << h.GetMax() << ",";
+            h.SerializeBins(os);
+            os << "\n";
+        }
+    }
+}
+
 std::string
 FlowMonitor::SerializeToXmlString(uint16_t indent, bool enableHistograms, bool enableProbes)
 {
@@ -558,7 +983,12 @@ FlowMonitor::ResetAllStats()
         flowStat.jitterHistogram.Clear();
         flowStat.packetSizeHistogram.Clear();
         flowStat.flowInterruptionsHistogram.Clear();
+        flowStat.delayLogHistogram.Clear();
+        flowStat.jitterLogHistogram.Clear();
+        flowStat.packetSizeLogHistogram.Clear();
+        flowStat.flowInterruptionsLogHistogram.Clear();
     }
+    m_snapshotTotals.clear();
 }
 
 } // namespace ns3
@@ -20,17 +20,25 @@
 #ifndef FLOW_MONITOR_H
 #define FLOW_MONITOR_H
 
+#include "ns3/callback.h"
 #include "ns3/event-id.h"
 #include "ns3/flow-classifier.h"
 #include "ns3/flow-probe.h"
 #include "ns3/histogram.h"
+#include "ns3/log-linear-histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/output-stream-wrapper.h"
 #include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
 
+#include <functional>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
+class FlowMonitorTrackedPacketTableTestCase;
+
 namespace ns3
 {
 
@@ -46,9 +54,32 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * When the SnapshotInterval attribute is set, the FlowMonitor also takes
+ * periodic snapshots of the statistics while it is monitoring: each
+ * snapshot has, for each flow, the changes of its counters since the
+ * previous snapshot.  The snapshots are reported by the Snapshot trace
+ * source, and written in CSV format to the stream set by
+ * SetSnapshotStream().  A packet is counted as lost in the snapshot in
+ * which it is dropped or found to be lost, i.e. between MaxPerHopDelay
+ * and MaxPerHopDelay plus one second after it was last seen.
+ *
+ * When the PacketSamplingRate attribute is larger than one, the probes only
+ * track one packet in that many of each flow, and all the statistics are
+ * those of the sampled packets.  The decision is taken once, by the probe
+ * which sees the first transmission of the packet, and the other probes
+ * only report the packets that were sampled, so that a packet is either
+ * tracked at all the hops or at none.
+ *
+ * With the HistogramType attribute set to LogLinear, the histograms of the
+ * flows are LogLinearHistogram's, whose smallest bins have the widths set by
+ * the *BinWidth attributes, and whose memory only grows with the logarithm
+ * of the largest value.  The fixed-width Histogram's are then left empty.
  */
 class FlowMonitor : public Object
 {
+    /// allow FlowMonitorTrackedPacketTableTestCase access
+    friend class ::FlowMonitorTrackedPacketTableTestCase;
+
   public:
     /// \brief Structure that represents the measured metrics of an individual packet flow
     struct FlowStats
@@ -135,6 +166,57 @@ class FlowMonitor : public Object
         /// comment in attribute packetsDropped.
         std::vector<uint64_t> bytesDropped;   // bytesDropped[reasonCode] => number of dropped bytes
         Histogram flowInterruptionsHistogram; //!< histogram of durations of flow interruptions
+
+        /// Log-linear histograms of the packet delays, jitters, packet
+        /// sizes and durations of flow interruptions, filled instead of the
+        /// fixed-width ones when the HistogramType attribute is LogLinear
+        LogLinearHistogram delayLogHistogram;
+        LogLinearHistogram jitterLogHistogram;            //!< see delayLogHistogram
+        LogLinearHistogram packetSizeLogHistogram;        //!< see delayLogHistogram
+        LogLinearHistogram flowInterruptionsLogHistogram; //!< see delayLogHistogram
+    };
+
+    /// \brief Structure that represents the changes of the counters of a
+    /// flow between two snapshots
+    struct FlowSnapshot
+    {
+        uint64_t txBytes{0};     //!< Transmitted bytes
+        uint64_t rxBytes{0};     //!< Received bytes
+        uint32_t txPackets{0};   //!< Transmitted packets
+        uint32_t rxPackets{0};   //!< Received packets
+        uint32_t lostPackets{0}; //!< Packets assumed to be lost or dropped
+        Time delaySum;           //!< Sum of the delays of the received packets
+        Time jitterSum;          //!< Sum of the jitters of the received packets
+    };
+
+    /**
+     * TracedCallback signature for flow snapshots.
+     *
+     * \param [in] now The time of the snapshot.
+     * \param [in] flowId The flow.
+     * \param [in] snapshot The changes of the counters of the flow since
+     *            the previous snapshot.
+     */
+    typedef void (*SnapshotTracedCallback)(Time now,
+                                           FlowId flowId,
+                                           const FlowSnapshot& snapshot);
+
+    /// \brief How the packets to track are selected when PacketSamplingRate
+    /// is larger than one
+    enum SamplingMode
+    {
+        /// Track the packets whose id in their flow is a multiple of the rate
+        SAMPLING_DETERMINISTIC,
+        /// Track the packets whose hash of flow id and packet id is a
+        /// multiple of the rate, which avoids aliasing with periodic traffic
+        SAMPLING_HASH,
+    };
+
+    /// \brief Type of the histograms of the flows
+    enum HistogramType
+    {
+        HISTOGRAM_FIXED,      //!< Histogram, with bins of fixed width
+        HISTOGRAM_LOG_LINEAR, //!< LogLinearHistogram, with bounded relative error
     };
 
     // --- basic methods ---
@@ -170,6 +252,14 @@ class FlowMonitor : public Object
     /// \param probe the probe to add
     void AddProbe(Ptr<FlowProbe> probe);
 
+    /// FlowProbe implementations are supposed to call this method for a new
+    /// packet, before reporting its first transmission, and to neither
+    /// report nor tag the packet if it returns false.
+    /// \param flowId flow identification
+    /// \param packetId Packet ID
+    /// \returns true if the packet is to be tracked
+    bool IsSampled(FlowId flowId, FlowPacketId packetId) const;
+
     /// FlowProbe implementations are supposed to call this method to
     /// report that a new packet was transmitted (but keep in mind the
     /// distinction between a new packet entering the system and a
@@ -198,10 +288,14 @@ class FlowMonitor : public Object
     /// \param flowId flow identification
     /// \param packetId Packet ID
     /// \param packetSize packet size
+    /// \param hops number of times the packet was forwarded, as seen by
+    ///        the receiving probe (e.g. from the decrease of its TTL), or 0;
+    ///        used when the forwarding nodes have no probe
     void ReportLastRx(Ptr<FlowProbe> probe,
                       FlowId flowId,
                       FlowPacketId packetId,
-                      uint32_t packetSize);
+                      uint32_t packetSize,
+                      uint32_t hops = 0);
     /// FlowProbe implementations are supposed to call this method to
     /// report that a known packet is being dropped due to some reason.
     /// \param probe the reporting probe
@@ -246,6 +340,30 @@ class FlowMonitor : public Object
     /// \returns the flows statistics
     const FlowStatsContainer& GetFlowStats() const;
 
+    /// Function called for each flow by VisitFlowStats()
+    typedef std::function<void(FlowId, const FlowStats&)> FlowStatsVisitor;
+
+    /// Call a function for the statistics of each flow, in the order of the
+    /// flow ids, without copying them
+    /// \param visitor the function
+    void VisitFlowStats(FlowStatsVisitor visitor) const;
+
+    /// Write the snapshots of the flow statistics to a stream, in CSV
+    /// format.  A header line is written first, then one line per flow and
+    /// snapshot, with the time of the snapshot, the flow id and the changes
+    /// of the counters of the flow since the previous snapshot.  The flows
+    /// whose counters did not change are skipped.
+    /// \param stream the output stream, or 0 to stop writing the snapshots
+    void SetSnapshotStream(Ptr<OutputStreamWrapper> stream);
+
+    /// Select the flows of the snapshots
+    /// \param filter callback which returns true for the flows to include
+    ///        in the snapshots; a null callback includes all the flows
+    void SetSnapshotFlowFilter(Callback<bool, FlowId> filter);
+
+    /// Take a snapshot of the flow statistics *right now*
+    void SnapshotRightNow();
+
     /// Get a list of all FlowProbe's associated with this FlowMonitor
     /// \returns a list of all the probes
     const FlowProbeContainer& GetAllProbes() const;
@@ -260,6 +378,15 @@ class FlowMonitor : public Object
                               bool enableHistograms,
                               bool enableProbes);
 
+    /// Serializes the log-linear histograms of the flows to an std::ostream
+    /// in CSV format.  A header line is written first, then one line per
+    /// flow and histogram, with the parameters of the histogram, the number
+    /// of values, the smallest and largest values, and the non-empty bins
+    /// as "index:count" pairs.  The HistogramType attribute must be
+    /// LogLinear.
+    /// \param os the output stream
+    void SerializeHistogramsToCsvStream(std::ostream& os) const;
+
     /// Same as SerializeToXmlStream, but returns the output as a std::string
     /// \param indent number of spaces to use as base indentation level
     /// \param enableHistograms if true, include also the histograms in the output
@@ -289,34 +416,142 @@ class FlowMonitor : public Object
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
     };
 
+    /**
+     * \brief Store of the tracked packets
+     *
+     * An open addressing hash table, with linear probing, maps the
+     * (FlowId,PacketId) pairs to the entries of the packets.  The entries
+     * are also linked in the order of their last-seen time: this time only
+     * changes to the current time, so a packet seen again moves to the back
+     * of the list, and the packets to consider lost are at its front.  The
+     * loss checks only go through the packets that are lost.
+     */
+    class TrackedPacketTable
+    {
+        /// allow FlowMonitorTrackedPacketTableTestCase access
+        friend class ::FlowMonitorTrackedPacketTableTestCase;
+
+      public:
+        /// Index of no entry
+        static constexpr uint32_t NONE = 0xffffffff;
+
+        TrackedPacketTable();
+
+        /// Find a packet
+        /// \param flowId flow identification
+        /// \param packetId Packet ID
+        /// \returns the index of the entry of the packet, or NONE
+        uint32_t Find(FlowId flowId, FlowPacketId packetId) const;
+        /// Find a packet, and add it if it is not found
+        /// \param flowId flow identification
+        /// \param packetId Packet ID
+        /// \returns the index of the entry of the packet
+        uint32_t Insert(FlowId flowId, FlowPacketId packetId);
+        /// Remove a packet
+        /// \param entry the index of the entry of the packet
+        void Erase(uint32_t entry);
+        /// Move a packet to the back of the last-seen order, after its
+        /// last-seen time has been set to the current time
+        /// \param entry the index of the entry of the packet
+        void Touch(uint32_t entry);
+        /// \param entry the index of the entry of a packet
+        /// \returns the data of the packet
+        TrackedPacket& Get(uint32_t entry);
+        /// \param entry the index of the entry of a packet
+        /// \returns the flow of the packet
+        FlowId GetFlowId(uint32_t entry) const;
+        /// \returns the index of the entry of the packet seen the longest
+        /// time ago, or NONE
+        uint32_t GetOldest() const;
+
+      private:
+        /// A slot of the hash table
+        struct Slot
+        {
+            uint64_t key;   //!< The (FlowId,PacketId) pair
+            uint32_t entry; //!< The index of the entry, or NONE
+        };
+
+        /// A tracked packet, linked in the last-seen order
+        struct Entry
+        {
+            uint64_t key;         //!< The (FlowId,PacketId) pair
+            TrackedPacket packet; //!< The data of the packet
+            uint32_t prev;        //!< The previous entry in the last-seen order
+            uint32_t next;        //!< The next entry in the last-seen order, or free entry
+        };
+
+        /// \param key a (FlowId,PacketId) pair
+        /// \returns the first slot to probe for the key
+        std::size_t GetSlot(uint64_t key) const;
+        /// \param key a (FlowId,PacketId) pair
+        /// \returns the slot of the key, or an empty slot
+        std::size_t Probe(uint64_t key) const;
+        /// Remove an entry from the last-seen order
+        /// \param entry the index of the entry
+        void Unlink(uint32_t entry);
+        /// Add an entry at the back of the last-seen order
+        /// \param entry the index of the entry
+        void Link(uint32_t entry);
+        /// Double the number of slots
+        void Grow();
+
+        std::vector<Slot> m_slots;    //!< The hash table
+        std::vector<Entry> m_entries; //!< The entries
+        uint32_t m_free;              //!< The first free entry
+        uint32_t m_oldest;            //!< The front of the last-seen order
+        uint32_t m_newest;            //!< The back of the last-seen order
+        std::size_t m_size;           //!< The number of tracked packets
+    };
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
 
-    /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    TrackedPacketTable m_trackedPackets; //!< Tracked packets
+    Time m_maxPerHopDelay;               //!< Minimum per-hop delay
+    FlowProbeContainer m_flowProbes;     //!< all the FlowProbes
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
 
     EventId m_startEvent;               //!< Start event
     EventId m_stopEvent;                //!< Stop event
+    EventId m_snapshotEvent;            //!< Next periodic snapshot event
     bool m_enabled;                     //!< FlowMon is enabled
     double m_delayBinWidth;             //!< Delay bin width (for histograms)
     double m_jitterBinWidth;            //!< Jitter bin width (for histograms)
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    uint32_t m_samplingRate;            //!< One packet in this many is tracked
+    SamplingMode m_samplingMode;        //!< Selection of the tracked packets
+    HistogramType m_histogramType;      //!< Type of the histograms
+    uint8_t m_histogramSignificantBits; //!< Significant bits of the log-linear histograms
+
+    Time m_snapshotInterval;                     //!< Interval between the snapshots
+    Ptr<OutputStreamWrapper> m_snapshotStream;   //!< CSV output of the snapshots
+    Callback<bool, FlowId> m_snapshotFlowFilter; //!< Flows of the snapshots
+    /// Counters of the flows at the previous snapshot
+    std::unordered_map<FlowId, FlowSnapshot> m_snapshotTotals;
+    /// Trace of the snapshots
+    TracedCallback<Time, FlowId, const FlowSnapshot&> m_snapshotTrace;
 
     /// Get the stats for a given flow
     /// \param flowId the Flow identification
     /// \returns the stats of the flow
     FlowStats& GetStatsForFlow(FlowId flowId);
 
+    /// Add a value to the histogram of the configured type
+    /// \param histogram the fixed-width histogram
+    /// \param logHistogram the log-linear histogram
+    /// \param value the value
+    void AddToHistogram(Histogram& histogram, LogLinearHistogram& logHistogram, double value);
+
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Periodic function to take snapshots of the flow statistics
+    void PeriodicSnapshot();
 };
 
 } // namespace ns3
@@ -144,6 +144,11 @@ Ipv4FlowClassifier::Classify(const Ipv4Header& ipHeader,
     tuple.sourcePort = srcPort;
     tuple.destinationPort = dstPort;
 
+    if (!IsAllowed(tuple))
+    {
+        return false;
+    }
+
     // try to insert the tuple, but check if it already exists
     std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert =
         m_flowMap.insert(std::pair<FiveTuple, FlowId>(tuple, 0));
@@ -196,6 +201,40 @@ Ipv4FlowClassifier::FindFlow(FlowId flowId) const
     return retval;
 }
 
+void
+Ipv4FlowClassifier::AddFlowFilter(const FiveTuple& tuple)
+{
+    m_flowFilter.insert(tuple);
+}
+
+void
+Ipv4FlowClassifier::AddPortFilter(uint16_t port)
+{
+    m_portFilter.insert(port);
+}
+
+void
+Ipv4FlowClassifier::ClearFilters()
+{
+    m_flowFilter.clear();
+    m_portFilter.clear();
+}
+
+bool
+Ipv4FlowClassifier::IsAllowed(const FiveTuple& tuple) const
+{
+    if (m_flowFilter.empty() && m_portFilter.empty())
+    {
+        return true;
+    }
+    if (m_portFilter.find(tuple.sourcePort) != m_portFilter.end() ||
+        m_portFilter.find(tuple.destinationPort) != m_portFilter.end())
+    {
+        return true;
+    }
+    return m_flowFilter.find(tuple) != m_flowFilter.end();
+}
+
 bool
 Ipv4FlowClassifier::SortByCount::operator()(std::pair<Ipv4Header::DscpType, uint32_t> left,
                                             std::pair<Ipv4Header::DscpType, uint32_t> right)
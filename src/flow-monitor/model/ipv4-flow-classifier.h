@@ -24,6 +24,7 @@
 #include "ns3/ipv4-header.h"
 
 #include <map>
+#include <set>
 #include <stdint.h>
 
 namespace ns3
@@ -35,6 +36,11 @@ class Packet;
 /// From these packet headers, a tuple (source-ip, destination-ip,
 /// protocol, source-port, destination-port) is created, and a unique
 /// flow identifier is assigned for each different tuple combination
+///
+/// The classifier can be restricted to some flows with AddFlowFilter()
+/// and AddPortFilter(): once a filter is set, the packets of the other
+/// flows are not classified, so that they are neither tagged nor tracked
+/// by the probes.
 class Ipv4FlowClassifier : public FlowClassifier
 {
   public:
@@ -70,6 +76,20 @@ class Ipv4FlowClassifier : public FlowClassifier
     /// \returns the FiveTuple corresponding to flowId
     FiveTuple FindFlow(FlowId flowId) const;
 
+    /// Classify the packets of a flow, in addition to those selected by
+    /// the other filters
+    /// \param tuple the FiveTuple of the flow
+    void AddFlowFilter(const FiveTuple& tuple);
+
+    /// Classify the packets with this source or destination port, in
+    /// addition to those selected by the other filters.  Both directions of
+    /// the connections with a server on this port are thus classified.
+    /// \param port the TCP or UDP port
+    void AddPortFilter(uint16_t port);
+
+    /// Remove all the filters, so that all the packets are classified
+    void ClearFilters();
+
     /// Comparator used to sort the vector of DSCP values
     class SortByCount
     {
@@ -92,6 +112,12 @@ class Ipv4FlowClassifier : public FlowClassifier
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
   private:
+    /// \param tuple the FiveTuple of a packet
+    /// \returns true if the packet passes the filters
+    bool IsAllowed(const FiveTuple& tuple) const;
+
+    std::set<FiveTuple> m_flowFilter; //!< Allowed flows
+    std::set<uint16_t> m_portFilter;  //!< Allowed source or destination ports
     /// Map to Flows Identifiers to FlowIds
     std::map<FiveTuple, FlowId> m_flowMap;
     /// Map to FlowIds to FlowPacketId
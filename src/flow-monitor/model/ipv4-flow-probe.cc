@@ -67,12 +67,14 @@ class Ipv4FlowProbeTag : public Tag
      * \param packetSize the packet size
      * \param src packet source address
      * \param dst packet destination address
+     * \param ttl packet TTL when it was first transmitted
      */
     Ipv4FlowProbeTag(uint32_t flowId,
                      uint32_t packetId,
                      uint32_t packetSize,
                      Ipv4Address src,
-                     Ipv4Address dst);
+                     Ipv4Address dst,
+                     uint8_t ttl);
     /**
      * \brief Set the flow identifier
      * \param flowId the flow identifier
@@ -103,6 +105,11 @@ class Ipv4FlowProbeTag : public Tag
      * \returns the packet size
      */
     uint32_t GetPacketSize() const;
+    /**
+     * \brief Get the TTL of the packet when it was first transmitted
+     * \returns the TTL
+     */
+    uint8_t GetTtl() const;
     /**
      * \brief Checks if the addresses stored in tag are matching
      * the arguments.
@@ -121,6 +128,7 @@ class Ipv4FlowProbeTag : public Tag
     uint32_t m_packetSize; //!< packet size
     Ipv4Address m_src;     //!< IP source
     Ipv4Address m_dst;     //!< IP destination
+    uint8_t m_ttl;         //!< TTL at the first transmission
 };
 
 TypeId
@@ -142,7 +150,7 @@ Ipv4FlowProbeTag::GetInstanceTypeId() const
 uint32_t
 Ipv4FlowProbeTag::GetSerializedSize() const
 {
-    return 4 + 4 + 4 + 8;
+    return 4 + 4 + 4 + 8 + 1;
 }
 
 void
@@ -157,6 +165,7 @@ Ipv4FlowProbeTag::Serialize(TagBuffer buf) const
     buf.Write(tBuf, 4);
     m_dst.Serialize(tBuf);
     buf.Write(tBuf, 4);
+    buf.WriteU8(m_ttl);
 }
 
 void
@@ -171,6 +180,7 @@ Ipv4FlowProbeTag::Deserialize(TagBuffer buf)
     m_src = Ipv4Address::Deserialize(tBuf);
     buf.Read(tBuf, 4);
     m_dst = Ipv4Address::Deserialize(tBuf);
+    m_ttl = buf.ReadU8();
 }
 
 void
@@ -190,13 +200,15 @@ Ipv4FlowProbeTag::Ipv4FlowProbeTag(uint32_t flowId,
                                    uint32_t packetId,
                                    uint32_t packetSize,
                                    Ipv4Address src,
-                                   Ipv4Address dst)
+                                   Ipv4Address dst,
+                                   uint8_t ttl)
     : Tag(),
       m_flowId(flowId),
       m_packetId(packetId),
       m_packetSize(packetSize),
       m_src(src),
-      m_dst(dst)
+      m_dst(dst),
+      m_ttl(ttl)
 {
 }
 
@@ -236,6 +248,12 @@ Ipv4FlowProbeTag::GetPacketSize() const
     return m_packetSize;
 }
 
+uint8_t
+Ipv4FlowProbeTag::GetTtl() const
+{
+    return m_ttl;
+}
+
 bool
 Ipv4FlowProbeTag::IsSrcDstValid(Ipv4Address src, Ipv4Address dst) const
 {
@@ -341,7 +359,8 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
         return;
     }
 
-    if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId))
+    if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId) &&
+        m_flowMonitor->IsSampled(flowId, packetId))
     {
         uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
         NS_LOG_DEBUG("ReportFirstTx (" << this << ", " << flowId << ", " << packetId << ", " << size
@@ -354,7 +373,8 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
                               packetId,
                               size,
                               ipHeader.GetSource(),
-                              ipHeader.GetDestination());
+                              ipHeader.GetDestination(),
+                              ipHeader.GetTtl());
         ipPayload->AddByteTag(fTag);
     }
 }
@@ -410,9 +430,16 @@ Ipv4FlowProbe::ForwardUpLogger(const Ipv4Header& ipHeader,
         FlowPacketId packetId = fTag.GetPacketId();
 
         uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
+        // each forwarding node decremented the TTL, so that the number of hops
+        // is known even when the forwarding nodes have no probe
+        uint32_t hops = 0;
+        if (fTag.GetTtl() > ipHeader.GetTtl())
+        {
+            hops = fTag.GetTtl() - ipHeader.GetTtl();
+        }
         NS_LOG_DEBUG("ReportLastRx (" << this << ", " << flowId << ", " << packetId << ", " << size
-                                      << "); " << ipHeader << *ipPayload);
-        m_flowMonitor->ReportLastRx(this, flowId, packetId, size);
+                                      << ", " << hops << "); " << ipHeader << *ipPayload);
+        m_flowMonitor->ReportLastRx(this, flowId, packetId, size, hops);
     }
 }
 
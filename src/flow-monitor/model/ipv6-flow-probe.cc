@@ -284,7 +284,8 @@ Ipv6FlowProbe::SendOutgoingLogger(const Ipv6Header& ipHeader,
     FlowId flowId;
     FlowPacketId packetId;
 
-    if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId))
+    if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId) &&
+        m_flowMonitor->IsSampled(flowId, packetId))
     {
         uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
         NS_LOG_DEBUG("ReportFirstTx (" << this << ", " << flowId << ", " << packetId << ", " << size
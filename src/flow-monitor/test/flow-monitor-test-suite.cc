@@ -0,0 +1,988 @@
+//
+// Copyright (c) 2026 The ns3-dsw authors
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/application.h"
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup flow-monitor-tests
+ * FlowMonitor test suite.
+ */
+
+/**
+ * \ingroup flow-monitor
+ * \defgroup flow-monitor-tests Flow Monitor tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Probe reporting the packets chosen by the test cases.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] monitor The FlowMonitor.
+     */
+    FlowMonitorTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Application sending UDP packets of 100 bytes at a fixed interval.
+ */
+class FlowMonitorTestSender : public Application
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] sourcePort The source port of the packets.
+     * \param [in] destination The destination of the packets.
+     * \param [in] count The number of packets to send.
+     * \param [in] interval The interval between the packets.
+     */
+    FlowMonitorTestSender(uint16_t sourcePort,
+                          InetSocketAddress destination,
+                          uint32_t count,
+                          Time interval)
+        : m_sourcePort(sourcePort),
+          m_destination(destination),
+          m_count(count),
+          m_interval(interval)
+    {
+    }
+
+  private:
+    void StartApplication() override
+    {
+        m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+        m_socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_sourcePort));
+        m_socket->Connect(m_destination);
+        Send();
+    }
+
+    void StopApplication() override
+    {
+        Simulator::Cancel(m_sendEvent);
+        if (m_socket)
+        {
+            m_socket->Close();
+            m_socket = nullptr;
+        }
+    }
+
+    /// Send a packet, and schedule the next one.
+    void Send()
+    {
+        m_socket->Send(Create<Packet>(100));
+        if (--m_count > 0)
+        {
+            m_sendEvent = Simulator::Schedule(m_interval, &FlowMonitorTestSender::Send, this);
+        }
+    }
+
+    uint16_t m_sourcePort;           //!< Source port of the packets
+    InetSocketAddress m_destination; //!< Destination of the packets
+    uint32_t m_count;                //!< Number of packets left to send
+    Time m_interval;                 //!< Interval between the packets
+    Ptr<Socket> m_socket;            //!< Sending socket
+    EventId m_sendEvent;             //!< Next transmission
+};
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Application receiving the UDP packets sent to a port, so that they are
+ * not answered with ICMP errors.
+ */
+class FlowMonitorTestSink : public Application
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] port The port to listen on.
+     */
+    FlowMonitorTestSink(uint16_t port)
+        : m_port(port)
+    {
+    }
+
+  private:
+    void StartApplication() override
+    {
+        m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+        m_socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_port));
+        m_socket->SetRecvCallback(MakeCallback(&FlowMonitorTestSink::Receive, this));
+    }
+
+    void StopApplication() override
+    {
+        if (m_socket)
+        {
+            m_socket->Close();
+            m_socket = nullptr;
+        }
+    }
+
+    /**
+     * Drain the received packets.
+     *
+     * \param [in] socket The receiving socket.
+     */
+    void Receive(Ptr<Socket> socket)
+    {
+        while (socket->Recv())
+        {
+        }
+    }
+
+    uint16_t m_port;      //!< Listening port
+    Ptr<Socket> m_socket; //!< Receiving socket
+};
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Chain of IPv4 nodes linked by SimpleNetDevices with a delay of 1 ms,
+ * routed by global routing, whose first node sends UDP flows to the last
+ * one.
+ */
+class FlowMonitorTestChain
+{
+  public:
+    /**
+     * Build the chain.
+     *
+     * \param [in] nNodes The number of nodes, at least 2.
+     */
+    FlowMonitorTestChain(uint32_t nNodes)
+        : m_flows(0)
+    {
+        nodes.Create(nNodes);
+        InternetStackHelper internet;
+        internet.SetIpv6StackInstall(false);
+        internet.Install(nodes);
+        for (uint32_t i = 0; i < nNodes; ++i)
+        {
+            // resolve the addresses in two delays, without random jitter
+            nodes.Get(i)->GetObject<ArpL3Protocol>()->SetAttribute(
+                "RequestJitter",
+                StringValue("ns3::ConstantRandomVariable[Constant=0.0]"));
+        }
+
+        SimpleNetDeviceHelper devices;
+        devices.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1)));
+        Ipv4AddressHelper addresses("10.1.1.0", "255.255.255.0");
+        for (uint32_t i = 0; i + 1 < nNodes; ++i)
+        {
+            Ipv4InterfaceContainer interfaces =
+                addresses.Assign(devices.Install(NodeContainer(nodes.Get(i), nodes.Get(i + 1))));
+            addresses.NewNetwork();
+            if (i == 0)
+            {
+                source = interfaces.GetAddress(0);
+            }
+            destination = interfaces.GetAddress(1);
+        }
+        Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    }
+
+    /**
+     * Add a flow from the first node to the last one.  The first flow
+     * starts at 50 ms, and each other one 10 ms after the previous one, so
+     * that their first packets do not overflow the ARP queues.
+     *
+     * \param [in] sourcePort The source port of the flow.
+     * \param [in] destinationPort The destination port of the flow.
+     * \param [in] count The number of packets.
+     * \param [in] interval The interval between the packets.
+     */
+    void AddFlow(uint16_t sourcePort, uint16_t destinationPort, uint32_t count, Time interval)
+    {
+        Ptr<Application> sender =
+            CreateObject<FlowMonitorTestSender>(sourcePort,
+                                                InetSocketAddress(destination, destinationPort),
+                                                count,
+                                                interval);
+        sender->SetStartTime(MilliSeconds(50 + 10 * m_flows++));
+        nodes.Get(0)->AddApplication(sender);
+        nodes.Get(nodes.GetN() - 1)->AddApplication(
+            CreateObject<FlowMonitorTestSink>(destinationPort));
+    }
+
+    NodeContainer nodes;     //!< The nodes, in the order of the chain
+    Ipv4Address source;      //!< Address of the first node
+    Ipv4Address destination; //!< Address of the last node
+
+  private:
+    uint32_t m_flows; //!< Number of flows added
+};
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Check the hash table of the tracked packets: clusters of keys wrapping
+ * around the end of the slots, growth, and the last-seen order.
+ */
+class FlowMonitorTrackedPacketTableTestCase : public TestCase
+{
+  public:
+    FlowMonitorTrackedPacketTableTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// The table of the tracked packets.
+    typedef FlowMonitor::TrackedPacketTable Table;
+
+    /**
+     * Find the slot of a packet.
+     *
+     * \param [in] table The table.
+     * \param [in] flowId The flow of the packet.
+     * \param [in] packetId The packet.
+     * \returns The slot holding the packet, or the number of slots.
+     */
+    std::size_t SlotOf(const Table& table, FlowId flowId, FlowPacketId packetId) const;
+
+    /** Insert, find and erase keys whose probe sequences wrap around. */
+    void TestWrapAround();
+    /** Insert enough packets to grow the table several times. */
+    void TestGrow();
+    /** Check that the oldest packets come first after updates. */
+    void TestOrder();
+};
+
+FlowMonitorTrackedPacketTableTestCase::FlowMonitorTrackedPacketTableTestCase()
+    : TestCase("Tracked packet table")
+{
+}
+
+std::size_t
+FlowMonitorTrackedPacketTableTestCase::SlotOf(const Table& table,
+                                              FlowId flowId,
+                                              FlowPacketId packetId) const
+{
+    uint64_t key = (uint64_t(flowId) << 32) | packetId;
+    for (std::size_t i = 0; i < table.m_slots.size(); ++i)
+    {
+        if (table.m_slots[i].entry != Table::NONE && table.m_slots[i].key == key)
+        {
+            return i;
+        }
+    }
+    return table.m_slots.size();
+}
+
+void
+FlowMonitorTrackedPacketTableTestCase::TestWrapAround()
+{
+    Table table;
+    const std::size_t last = table.m_slots.size() - 1;
+
+    // three packets hashed to the last slot, and one to the first slot
+    std::vector<FlowPacketId> tail;
+    FlowPacketId head = 0;
+    bool headFound = false;
+    for (FlowPacketId id = 0; tail.size() < 3 || !headFound; ++id)
+    {
+        std::size_t slot = table.GetSlot((uint64_t(1) << 32) | id);
+        if (slot == last && tail.size() < 3)
+        {
+            tail.push_back(id);
+        }
+        else if (slot == 0 && !headFound)
+        {
+            head = id;
+            headFound = true;
+        }
+    }
+
+    std::vector<uint32_t> entries;
+    for (FlowPacketId id : tail)
+    {
+        entries.push_back(table.Insert(1, id));
+    }
+    uint32_t headEntry = table.Insert(1, head);
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, tail[0]), last, "First key not in its slot");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, tail[1]), 0, "Cluster does not wrap around");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, tail[2]), 1, "Cluster does not wrap around");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, head), 2, "Key not after the cluster");
+    NS_TEST_EXPECT_MSG_EQ(table.Insert(1, tail[1]), entries[1], "Key inserted twice");
+
+    // the following keys shift back across the end of the slots
+    table.Erase(entries[0]);
+    NS_TEST_EXPECT_MSG_EQ(table.Find(1, tail[0]), Table::NONE, "Erased key still found");
+    NS_TEST_EXPECT_MSG_EQ(table.Find(1, tail[1]), entries[1], "Key lost by erase");
+    NS_TEST_EXPECT_MSG_EQ(table.Find(1, tail[2]), entries[2], "Key lost by erase");
+    NS_TEST_EXPECT_MSG_EQ(table.Find(1, head), headEntry, "Key lost by erase");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, tail[1]), last, "Key not shifted back");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, tail[2]), 0, "Key not shifted back");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, head), 1, "Key not shifted back");
+
+    // a key already in its first slot stays there
+    table.Erase(entries[2]);
+    NS_TEST_EXPECT_MSG_EQ(table.Find(1, tail[2]), Table::NONE, "Erased key still found");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, head), 0, "Key not shifted back");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, tail[1]), last, "Key moved");
+    table.Erase(entries[1]);
+    NS_TEST_EXPECT_MSG_EQ(table.Find(1, tail[1]), Table::NONE, "Erased key still found");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, head), 0, "Key moved");
+
+    // the free entries are reused
+    uint32_t entry = table.Insert(1, tail[0]);
+    NS_TEST_EXPECT_MSG_LT(entry, 4, "Free entry not reused");
+    NS_TEST_EXPECT_MSG_EQ(SlotOf(table, 1, tail[0]), last, "Key not in its first slot");
+    table.Erase(headEntry);
+    table.Erase(entry);
+    NS_TEST_EXPECT_MSG_EQ(table.GetOldest(), Table::NONE, "Table not empty");
+}
+
+void
+FlowMonitorTrackedPacketTableTestCase::TestGrow()
+{
+    Table table;
+    const std::size_t initialSlots = table.m_slots.size();
+    const uint32_t count = 3000;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t entry = table.Insert(1 + i % 3, i / 3);
+        table.Get(entry).timesForwarded = i;
+    }
+    NS_TEST_EXPECT_MSG_EQ(table.m_size, count, "Wrong number of packets");
+    NS_TEST_EXPECT_MSG_GT(table.m_slots.size(), 4 * initialSlots, "Table did not grow");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(table.m_slots.size(), 2 * count, "Table too loaded");
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t entry = table.Find(1 + i % 3, i / 3);
+        NS_TEST_ASSERT_MSG_NE(entry, Table::NONE, "Packet " << i << " lost by Grow");
+        NS_TEST_EXPECT_MSG_EQ(table.Get(entry).timesForwarded, i, "Wrong data of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(table.GetFlowId(entry), 1 + i % 3, "Wrong flow of packet " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(table.Find(4, 0), Table::NONE, "Unknown packet found");
+}
+
+void
+FlowMonitorTrackedPacketTableTestCase::TestOrder()
+{
+    Table table;
+    std::vector<uint32_t> entries;
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        entries.push_back(table.Insert(1, i));
+        table.Get(entries[i]).timesForwarded = i;
+    }
+    // seen again: 1, then 3, twice, the second time while the newest
+    table.Touch(entries[1]);
+    table.Touch(entries[3]);
+    table.Touch(entries[3]);
+    // found again, without being seen
+    table.Insert(1, 0);
+
+    const uint32_t expected[] = {0, 2, 4, 1, 3};
+    for (uint32_t i : expected)
+    {
+        uint32_t oldest = table.GetOldest();
+        NS_TEST_ASSERT_MSG_NE(oldest, Table::NONE, "Table empty too soon");
+        NS_TEST_EXPECT_MSG_EQ(table.Get(oldest).timesForwarded, i, "Wrong last-seen order");
+        table.Erase(oldest);
+    }
+    NS_TEST_EXPECT_MSG_EQ(table.GetOldest(), Table::NONE, "Table not empty");
+}
+
+void
+FlowMonitorTrackedPacketTableTestCase::DoRun()
+{
+    TestWrapAround();
+    TestGrow();
+    TestOrder();
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Check that CheckForLostPackets expires exactly the packets not seen
+ * for MaxPerHopDelay, with the periodic checks also running.
+ */
+class FlowMonitorLostPacketsTestCase : public TestCase
+{
+  public:
+    FlowMonitorLostPacketsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the number of lost packets of flow 1.
+     *
+     * \param [in] expected The expected number.
+     */
+    void CheckLost(uint32_t expected);
+
+    Ptr<FlowMonitor> m_monitor; //!< The monitor
+};
+
+FlowMonitorLostPacketsTestCase::FlowMonitorLostPacketsTestCase()
+    : TestCase("Lost packets after MaxPerHopDelay")
+{
+}
+
+void
+FlowMonitorLostPacketsTestCase::CheckLost(uint32_t expected)
+{
+    m_monitor->CheckForLostPackets();
+    const FlowMonitor::FlowStats& stats = m_monitor->GetFlowStats().at(1);
+    NS_TEST_EXPECT_MSG_EQ(stats.lostPackets,
+                          expected,
+                          "Wrong lost packets at " << Simulator::Now().As(Time::S));
+}
+
+void
+FlowMonitorLostPacketsTestCase::DoRun()
+{
+    m_monitor = CreateObject<FlowMonitor>();
+    m_monitor->SetAttribute("MaxPerHopDelay", TimeValue(MilliSeconds(2500)));
+    m_monitor->StartRightNow();
+    Ptr<FlowProbe> probe = Create<FlowMonitorTestProbe>(m_monitor);
+
+    // packet i is sent at i * 100 ms; packet 3 is seen again at 2550 ms
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(100 * i),
+                            &FlowMonitor::ReportFirstTx,
+                            m_monitor,
+                            probe,
+                            1,
+                            i,
+                            100);
+    }
+    Simulator::Schedule(MilliSeconds(2550),
+                        &FlowMonitor::ReportForwarding,
+                        m_monitor,
+                        probe,
+                        1,
+                        3,
+                        100);
+
+    // at 3390 ms the packets seen up to 890 ms are lost, and packet 9 is
+    // lost at 3400 ms exactly
+    Simulator::Schedule(MilliSeconds(2000), &FlowMonitorLostPacketsTestCase::CheckLost, this, 0);
+    Simulator::Schedule(MilliSeconds(3390), &FlowMonitorLostPacketsTestCase::CheckLost, this, 8);
+    Simulator::Schedule(MilliSeconds(3400), &FlowMonitorLostPacketsTestCase::CheckLost, this, 9);
+    // packet 3 is still tracked, and received
+    Simulator::Schedule(MilliSeconds(5000),
+                        &FlowMonitor::ReportLastRx,
+                        m_monitor,
+                        probe,
+                        1,
+                        3,
+                        100,
+                        0);
+    Simulator::Schedule(MilliSeconds(9000), &FlowMonitorLostPacketsTestCase::CheckLost, this, 9);
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    const FlowMonitor::FlowStats& stats = m_monitor->GetFlowStats().at(1);
+    NS_TEST_EXPECT_MSG_EQ(stats.txPackets, 10, "Wrong transmitted packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, 1, "Packet 3 not received");
+    NS_TEST_EXPECT_MSG_EQ(stats.timesForwarded, 1, "Packet 3 not forwarded");
+
+    Simulator::Destroy();
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Check the periodic and on-demand snapshots of the flow statistics: the
+ * changes of the counters in each interval, the flow filter, the CSV
+ * stream, and VisitFlowStats.
+ */
+class FlowMonitorSnapshotTestCase : public TestCase
+{
+  public:
+    FlowMonitorSnapshotTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record a snapshot.
+     *
+     * \param [in] now The time of the snapshot.
+     * \param [in] flowId The flow.
+     * \param [in] snapshot The changes of the counters of the flow.
+     */
+    void Snapshot(Time now, FlowId flowId, const FlowMonitor::FlowSnapshot& snapshot);
+
+    /**
+     * Select the flows of the snapshots.
+     *
+     * \param [in] flowId The flow.
+     * \returns true for the flow to port 9.
+     */
+    bool IsSnapshotFlow(FlowId flowId) const;
+
+    /// A snapshot reported by the trace source
+    struct Record
+    {
+        Time time;                          //!< Time of the snapshot
+        FlowId flowId;                      //!< Flow
+        FlowMonitor::FlowSnapshot snapshot; //!< Changes of the counters
+    };
+
+    std::vector<Record> m_records;        //!< The snapshots
+    Ptr<Ipv4FlowClassifier> m_classifier; //!< The classifier
+};
+
+FlowMonitorSnapshotTestCase::FlowMonitorSnapshotTestCase()
+    : TestCase("Snapshots of the flow statistics")
+{
+}
+
+void
+FlowMonitorSnapshotTestCase::Snapshot(Time now,
+                                      FlowId flowId,
+                                      const FlowMonitor::FlowSnapshot& snapshot)
+{
+    m_records.push_back({now, flowId, snapshot});
+}
+
+bool
+FlowMonitorSnapshotTestCase::IsSnapshotFlow(FlowId flowId) const
+{
+    return m_classifier->FindFlow(flowId).destinationPort == 9;
+}
+
+void
+FlowMonitorSnapshotTestCase::DoRun()
+{
+    // 25 packets to port 9, every 100 ms from 50 ms, and 5 to port 10
+    FlowMonitorTestChain chain(2);
+    chain.AddFlow(5000, 9, 25, MilliSeconds(100));
+    chain.AddFlow(5001, 10, 5, MilliSeconds(100));
+
+    FlowMonitorHelper helper;
+    helper.SetMonitorAttribute("SnapshotInterval", TimeValue(Seconds(1)));
+    Ptr<FlowMonitor> monitor = helper.InstallAll();
+    m_classifier = DynamicCast<Ipv4FlowClassifier>(helper.GetClassifier());
+    monitor->TraceConnectWithoutContext(
+        "Snapshot",
+        MakeCallback(&FlowMonitorSnapshotTestCase::Snapshot, this));
+    monitor->SetSnapshotFlowFilter(MakeCallback(&FlowMonitorSnapshotTestCase::IsSnapshotFlow, this));
+    std::ostringstream csv;
+    monitor->SetSnapshotStream(Create<OutputStreamWrapper>(&csv));
+    Simulator::Schedule(MilliSeconds(1500), &FlowMonitor::SnapshotRightNow, monitor);
+    Simulator::Stop(Seconds(4.5));
+    Simulator::Run();
+
+    // the periodic snapshots at 1, 2 and 3 s, and the one at 1.5 s; the
+    // snapshot at 4 s is empty
+    const int64_t times[] = {1000, 1500, 2000, 3000};
+    const uint32_t packets[] = {10, 5, 5, 5};
+    NS_TEST_ASSERT_MSG_EQ(m_records.size(), 4, "Wrong number of snapshots");
+    for (std::size_t i = 0; i < m_records.size(); ++i)
+    {
+        const Record& r = m_records[i];
+        NS_TEST_EXPECT_MSG_EQ(r.time, MilliSeconds(times[i]), "Wrong time of snapshot " << i);
+        NS_TEST_EXPECT_MSG_EQ(IsSnapshotFlow(r.flowId), true, "Flow not filtered out");
+        NS_TEST_EXPECT_MSG_EQ(r.snapshot.txPackets, packets[i], "Wrong tx in snapshot " << i);
+        NS_TEST_EXPECT_MSG_EQ(r.snapshot.rxPackets, packets[i], "Wrong rx in snapshot " << i);
+        // 100 bytes of payload, and the UDP and IPv4 headers
+        NS_TEST_EXPECT_MSG_EQ(r.snapshot.txBytes, 128 * packets[i], "Wrong tx bytes");
+        NS_TEST_EXPECT_MSG_EQ(r.snapshot.rxBytes, 128 * packets[i], "Wrong rx bytes");
+        NS_TEST_EXPECT_MSG_EQ(r.snapshot.lostPackets, 0, "Unexpected lost packets");
+    }
+    // once the addresses are resolved, each packet takes 1 ms
+    NS_TEST_EXPECT_MSG_EQ(m_records[1].snapshot.delaySum, MilliSeconds(5), "Wrong delays");
+    NS_TEST_EXPECT_MSG_EQ(m_records[2].snapshot.delaySum, MilliSeconds(5), "Wrong delays");
+
+    // the CSV stream has a header and the same rows as the trace source
+    std::istringstream lines(csv.str());
+    std::string line;
+    std::getline(lines, line);
+    NS_TEST_EXPECT_MSG_EQ(line,
+                          "time(ns),flowId,txPackets,txBytes,rxPackets,rxBytes,"
+                          "lostPackets,delaySum(ns),jitterSum(ns)",
+                          "Wrong CSV header");
+    for (const Record& r : m_records)
+    {
+        std::ostringstream expected;
+        expected << r.time.GetNanoSeconds() << ',' << r.flowId << ',' << r.snapshot.txPackets
+                 << ',' << r.snapshot.txBytes << ',' << r.snapshot.rxPackets << ','
+                 << r.snapshot.rxBytes << ',' << r.snapshot.lostPackets << ','
+                 << r.snapshot.delaySum.GetNanoSeconds() << ','
+                 << r.snapshot.jitterSum.GetNanoSeconds();
+        NS_TEST_EXPECT_MSG_EQ(bool(std::getline(lines, line)), true, "Missing CSV row");
+        NS_TEST_EXPECT_MSG_EQ(line, expected.str(), "Wrong CSV row");
+    }
+    NS_TEST_EXPECT_MSG_EQ(bool(std::getline(lines, line)), false, "Unexpected CSV row");
+
+    // the filter only applies to the snapshots
+    std::vector<FlowId> flows;
+    monitor->VisitFlowStats([&](FlowId flowId, const FlowMonitor::FlowStats& stats) {
+        flows.push_back(flowId);
+        uint32_t expected = IsSnapshotFlow(flowId) ? 25 : 5;
+        NS_TEST_EXPECT_MSG_EQ(stats.txPackets, expected, "Wrong tx of flow " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, expected, "Wrong rx of flow " << flowId);
+    });
+    NS_TEST_ASSERT_MSG_EQ(flows.size(), 2, "Wrong number of flows");
+    NS_TEST_EXPECT_MSG_LT(flows[0], flows[1], "Flows not visited in order");
+
+    Simulator::Destroy();
+    m_classifier = nullptr;
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Check the hash sampling on a chain: each packet is tracked at all the
+ * hops or at none, and about one packet in PacketSamplingRate is tracked.
+ */
+class FlowMonitorSamplingTestCase : public TestCase
+{
+  public:
+    FlowMonitorSamplingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorSamplingTestCase::FlowMonitorSamplingTestCase()
+    : TestCase("Hash sampling of the packets")
+{
+}
+
+void
+FlowMonitorSamplingTestCase::DoRun()
+{
+    const uint32_t count = 1000;
+    const uint32_t rate = 4;
+    FlowMonitorTestChain chain(4);
+    chain.AddFlow(5000, 9, count, MilliSeconds(5));
+    chain.AddFlow(5001, 10, count, MilliSeconds(5));
+
+    FlowMonitorHelper helper;
+    helper.SetMonitorAttribute("PacketSamplingRate", UintegerValue(rate));
+    helper.SetMonitorAttribute("PacketSamplingMode", EnumValue(FlowMonitor::SAMPLING_HASH));
+    Ptr<FlowMonitor> monitor = helper.InstallAll();
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    monitor->CheckForLostPackets();
+
+    const FlowMonitor::FlowStatsContainer& flows = monitor->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ(flows.size(), 2, "Wrong number of flows");
+    for (const auto& flow : flows)
+    {
+        const FlowMonitor::FlowStats& stats = flow.second;
+        uint32_t sampled = 0;
+        for (FlowPacketId packetId = 0; packetId < count; ++packetId)
+        {
+            sampled += monitor->IsSampled(flow.first, packetId) ? 1 : 0;
+        }
+        NS_TEST_EXPECT_MSG_EQ(stats.txPackets, sampled, "Wrong sampled packets");
+        NS_TEST_EXPECT_MSG_EQ_TOL(double(stats.txPackets),
+                                  double(count) / rate,
+                                  0.2 * count / rate,
+                                  "Sampling rate not respected");
+
+        // the packets sampled by the sender are tracked up to the receiver
+        NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, stats.txPackets, "Sampled packets not received");
+        NS_TEST_EXPECT_MSG_EQ(stats.lostPackets, 0, "Sampled packets lost");
+        NS_TEST_EXPECT_MSG_EQ(stats.timesForwarded, 2 * stats.rxPackets, "Wrong forwarding");
+        for (Ptr<FlowProbe> probe : monitor->GetAllProbes())
+        {
+            NS_TEST_EXPECT_MSG_EQ(probe->GetStats()[flow.first].packets,
+                                  stats.txPackets,
+                                  "Sampling decision differs between the hops");
+        }
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Check that the flows not allowed by the filters of the classifier are
+ * not monitored.
+ */
+class FlowMonitorClassifierFilterTestCase : public TestCase
+{
+  public:
+    FlowMonitorClassifierFilterTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorClassifierFilterTestCase::FlowMonitorClassifierFilterTestCase()
+    : TestCase("Flow filters of the classifier")
+{
+}
+
+void
+FlowMonitorClassifierFilterTestCase::DoRun()
+{
+    FlowMonitorTestChain chain(3);
+    chain.AddFlow(5000, 9, 10, MilliSeconds(10));
+    chain.AddFlow(5001, 10, 10, MilliSeconds(10));
+    chain.AddFlow(5002, 11, 10, MilliSeconds(10));
+    chain.AddFlow(5003, 11, 10, MilliSeconds(10));
+
+    FlowMonitorHelper helper;
+    Ptr<FlowMonitor> monitor = helper.InstallAll();
+    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier>(helper.GetClassifier());
+    classifier->AddPortFilter(9);
+    Ipv4FlowClassifier::FiveTuple tuple;
+    tuple.sourceAddress = chain.source;
+    tuple.destinationAddress = chain.destination;
+    tuple.protocol = 17;
+    tuple.sourcePort = 5002;
+    tuple.destinationPort = 11;
+    classifier->AddFlowFilter(tuple);
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    std::set<uint16_t> sourcePorts;
+    for (const auto& flow : monitor->GetFlowStats())
+    {
+        sourcePorts.insert(classifier->FindFlow(flow.first).sourcePort);
+        NS_TEST_EXPECT_MSG_EQ(flow.second.txPackets, 10, "Wrong tx of flow " << flow.first);
+        NS_TEST_EXPECT_MSG_EQ(flow.second.rxPackets, 10, "Wrong rx of flow " << flow.first);
+        NS_TEST_EXPECT_MSG_EQ(flow.second.timesForwarded, 10, "Wrong forwarding");
+    }
+    NS_TEST_EXPECT_MSG_EQ(sourcePorts.size(), 2, "Wrong number of flows");
+    NS_TEST_EXPECT_MSG_EQ(sourcePorts.count(5000), 1, "Flow to the allowed port missing");
+    NS_TEST_EXPECT_MSG_EQ(sourcePorts.count(5002), 1, "Allowed flow missing");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Check that InstallOnEndpoints only installs probes on the nodes with
+ * applications, and that the forwardings derived from the TTL match those
+ * counted by the probes of all the nodes.
+ */
+class FlowMonitorEndpointsTestCase : public TestCase
+{
+  public:
+    FlowMonitorEndpointsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a flow over a chain of 5 nodes.
+     *
+     * \param [in] endpoints Whether to install the probes only on the
+     *            endpoints, or on all the nodes.
+     * \returns The statistics of the flow.
+     */
+    FlowMonitor::FlowStats RunChain(bool endpoints);
+};
+
+FlowMonitorEndpointsTestCase::FlowMonitorEndpointsTestCase()
+    : TestCase("Probes on the endpoints only")
+{
+}
+
+FlowMonitor::FlowStats
+FlowMonitorEndpointsTestCase::RunChain(bool endpoints)
+{
+    FlowMonitorTestChain chain(5);
+    chain.AddFlow(5000, 9, 100, MilliSeconds(10));
+
+    FlowMonitorHelper helper;
+    Ptr<FlowMonitor> monitor = endpoints ? helper.InstallOnEndpoints() : helper.InstallAll();
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetAllProbes().size(), (endpoints ? 2 : 5), "Wrong probes");
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetFlowStats().size(), 1, "Wrong number of flows");
+    FlowMonitor::FlowStats stats = monitor->GetFlowStats().begin()->second;
+    Simulator::Destroy();
+    return stats;
+}
+
+void
+FlowMonitorEndpointsTestCase::DoRun()
+{
+    FlowMonitor::FlowStats all = RunChain(false);
+    FlowMonitor::FlowStats ends = RunChain(true);
+
+    NS_TEST_EXPECT_MSG_EQ(all.rxPackets, 100, "Packets not received");
+    NS_TEST_EXPECT_MSG_EQ(all.timesForwarded, 300, "Wrong forwarding");
+    NS_TEST_EXPECT_MSG_EQ(ends.txPackets, all.txPackets, "Wrong tx on the endpoints");
+    NS_TEST_EXPECT_MSG_EQ(ends.rxPackets, all.rxPackets, "Wrong rx on the endpoints");
+    NS_TEST_EXPECT_MSG_EQ(ends.lostPackets, 0, "Packets lost on the endpoints");
+    NS_TEST_EXPECT_MSG_EQ(ends.timesForwarded, all.timesForwarded, "Wrong hops from the TTL");
+    NS_TEST_EXPECT_MSG_EQ(ends.delaySum, all.delaySum, "Wrong delays on the endpoints");
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * Check the log-linear histograms of a flow, and their CSV serialization.
+ */
+class FlowMonitorLogLinearHistogramTestCase : public TestCase
+{
+  public:
+    FlowMonitorLogLinearHistogramTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorLogLinearHistogramTestCase::FlowMonitorLogLinearHistogramTestCase()
+    : TestCase("Log-linear histograms in CSV format")
+{
+}
+
+void
+FlowMonitorLogLinearHistogramTestCase::DoRun()
+{
+    FlowMonitorTestChain chain(3);
+    chain.AddFlow(5000, 9, 50, MilliSeconds(20));
+
+    FlowMonitorHelper helper;
+    helper.SetMonitorAttribute("HistogramType", EnumValue(FlowMonitor::HISTOGRAM_LOG_LINEAR));
+    helper.SetMonitorAttribute("DelayBinWidth", DoubleValue(1e-6));
+    Ptr<FlowMonitor> monitor = helper.InstallAll();
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(monitor->GetFlowStats().size(), 1, "Wrong number of flows");
+    FlowId flowId = monitor->GetFlowStats().begin()->first;
+    const FlowMonitor::FlowStats& stats = monitor->GetFlowStats().begin()->second;
+    NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, 50, "Packets not received");
+    NS_TEST_EXPECT_MSG_EQ(stats.delayHistogram.GetNBins(), 0, "Fixed-width histogram filled");
+    NS_TEST_EXPECT_MSG_EQ(stats.delayLogHistogram.GetCount(), 50, "Wrong delays");
+    // two hops of 1 ms, once the addresses are resolved
+    NS_TEST_EXPECT_MSG_EQ_TOL(stats.delayLogHistogram.GetMin(), 0.002, 1e-9, "Wrong delay");
+    NS_TEST_EXPECT_MSG_EQ_TOL(stats.delayLogHistogram.GetQuantile(0.5),
+                              0.002,
+                              0.002 / 128,
+                              "Wrong median delay");
+
+    std::ostringstream csv;
+    monitor->SerializeHistogramsToCsvStream(csv);
+    std::istringstream lines(csv.str());
+    std::string line;
+    std::getline(lines, line);
+    NS_TEST_EXPECT_MSG_EQ(line,
+                          "flowId,histogram,resolution,significantBits,count,min,max,bins",
+                          "Wrong CSV header");
+    // name, resolution and number of values of each histogram
+    const std::pair<std::string, const LogLinearHistogram*> histograms[] = {
+        {"delay,1e-06,7,50,", &stats.delayLogHistogram},
+        {"jitter,0.001,7,49,", &stats.jitterLogHistogram},
+        {"packetSize,20,7,50,", &stats.packetSizeLogHistogram},
+        {"flowInterruptions,0.25,7,0,", &stats.flowInterruptionsLogHistogram},
+    };
+    for (const auto& histogram : histograms)
+    {
+        NS_TEST_ASSERT_MSG_EQ(bool(std::getline(lines, line)), true, "Missing CSV row");
+        std::ostringstream prefix;
+        prefix << flowId << "," << histogram.first;
+        NS_TEST_EXPECT_MSG_EQ(line.substr(0, prefix.str().size()), prefix.str(), "Wrong CSV row");
+
+        // the bins are the last field, as "index:count" pairs
+        std::istringstream bins(line.substr(line.rfind(',') + 1));
+        uint64_t total = 0;
+        uint32_t index;
+        uint32_t count;
+        char colon;
+        while (bins >> index >> colon >> count)
+        {
+            NS_TEST_EXPECT_MSG_EQ(count,
+                                  histogram.second->GetBinCount(index),
+                                  "Wrong count of bin " << index << " in " << line);
+            total += count;
+        }
+        NS_TEST_EXPECT_MSG_EQ(total, histogram.second->GetCount(), "Missing bins in " << line);
+    }
+    NS_TEST_EXPECT_MSG_EQ(bool(std::getline(lines, line)), false, "Unexpected CSV row");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * FlowMonitor test suite.
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", UNIT)
+{
+    AddTestCase(new FlowMonitorTrackedPacketTableTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorLostPacketsTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorSnapshotTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorSamplingTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorClassifierFilterTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorEndpointsTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorLogLinearHistogramTestCase(), TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
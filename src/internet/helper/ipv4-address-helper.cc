@@ -135,60 +135,111 @@ Ipv4AddressHelper::Assign(const NetDeviceContainer& c)
     Ipv4InterfaceContainer retval;
     for (uint32_t i = 0; i < c.GetN(); ++i)
     {
-        Ptr<NetDevice> device = c.Get(i);
+        AssignAddress(c.Get(i), NewAddress(), retval);
+    }
+    return retval;
+}
 
-        Ptr<Node> node = device->GetNode();
-        NS_ASSERT_MSG(node,
-                      "Ipv4AddressHelper::Assign(): NetDevice is not not associated "
-                      "with any node -> fail");
+void
+Ipv4AddressHelper::AssignAddress(Ptr<NetDevice> device,
+                                 Ipv4Address address,
+                                 Ipv4InterfaceContainer& retval)
+{
+    Ptr<Node> node = device->GetNode();
+    NS_ASSERT_MSG(node,
+                  "Ipv4AddressHelper::Assign(): NetDevice is not not associated "
+                  "with any node -> fail");
 
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        NS_ASSERT_MSG(ipv4,
-                      "Ipv4AddressHelper::Assign(): NetDevice is associated"
-                      " with a node without IPv4 stack installed -> fail "
-                      "(maybe need to use InternetStackHelper?)");
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    NS_ASSERT_MSG(ipv4,
+                  "Ipv4AddressHelper::Assign(): NetDevice is associated"
+                  " with a node without IPv4 stack installed -> fail "
+                  "(maybe need to use InternetStackHelper?)");
 
-        int32_t interface = ipv4->GetInterfaceForDevice(device);
-        if (interface == -1)
-        {
-            interface = ipv4->AddInterface(device);
-        }
-        NS_ASSERT_MSG(interface >= 0,
-                      "Ipv4AddressHelper::Assign(): "
-                      "Interface index not found");
-
-        Ipv4InterfaceAddress ipv4Addr = Ipv4InterfaceAddress(NewAddress(), m_mask);
-        ipv4->AddAddress(interface, ipv4Addr);
-        ipv4->SetMetric(interface, 1);
-        ipv4->SetUp(interface);
-        retval.Add(ipv4, interface);
-
-        // Install the default traffic control configuration if the traffic
-        // control layer has been aggregated, if this is not
-        // a loopback interface, and there is no queue disc installed already
-        Ptr<TrafficControlLayer> tc = node->GetObject<TrafficControlLayer>();
-        if (tc && !DynamicCast<LoopbackNetDevice>(device) && !tc->GetRootQueueDiscOnDevice(device))
+    int32_t interface = ipv4->GetInterfaceForDevice(device);
+    if (interface == -1)
+    {
+        interface = ipv4->AddInterface(device);
+    }
+    NS_ASSERT_MSG(interface >= 0,
+                  "Ipv4AddressHelper::Assign(): "
+                  "Interface index not found");
+
+    Ipv4InterfaceAddress ipv4Addr = Ipv4InterfaceAddress(address, m_mask);
+    ipv4->AddAddress(interface, ipv4Addr);
+    ipv4->SetMetric(interface, 1);
+    ipv4->SetUp(interface);
+    retval.Add(ipv4, interface);
+
+    // Install the default traffic control configuration if the traffic
+    // control layer has been aggregated, if this is not
+    // a loopback interface, and there is no queue disc installed already
+    Ptr<TrafficControlLayer> tc = node->GetObject<TrafficControlLayer>();
+    if (tc && !DynamicCast<LoopbackNetDevice>(device) && !tc->GetRootQueueDiscOnDevice(device))
+    {
+        Ptr<NetDeviceQueueInterface> ndqi = device->GetObject<NetDeviceQueueInterface>();
+        // It is useless to install a queue disc if the device has no
+        // NetDeviceQueueInterface attached: the device queue is never
+        // stopped and every packet enqueued in the queue disc is
+        // immediately dequeued, hence there will never be backlog
+        if (ndqi)
         {
-            Ptr<NetDeviceQueueInterface> ndqi = device->GetObject<NetDeviceQueueInterface>();
-            // It is useless to install a queue disc if the device has no
-            // NetDeviceQueueInterface attached: the device queue is never
-            // stopped and every packet enqueued in the queue disc is
-            // immediately dequeued, hence there will never be backlog
-            if (ndqi)
-            {
-                std::size_t nTxQueues = ndqi->GetNTxQueues();
-                NS_LOG_LOGIC("Installing default traffic control configuration ("
-                             << nTxQueues << " device queue(s))");
-                TrafficControlHelper tcHelper = TrafficControlHelper::Default(nTxQueues);
-                tcHelper.Install(device);
-            }
+            std::size_t nTxQueues = ndqi->GetNTxQueues();
+            NS_LOG_LOGIC("Installing default traffic control configuration ("
+                         << nTxQueues << " device queue(s))");
+            TrafficControlHelper tcHelper = TrafficControlHelper::Default(nTxQueues);
+            tcHelper.Install(device);
         }
     }
-    return retval;
 }
 
 const uint32_t N_BITS = 32; //!< number of bits in a IPv4 address
 
+Ipv4InterfaceContainer
+Ipv4AddressHelper::AssignPointToPoint(const NetDeviceContainer& c)
+{
+    NS_LOG_FUNCTION_NOARGS();
+    NS_ASSERT_MSG(c.GetN() % 2 == 0,
+                  "Ipv4AddressHelper::AssignPointToPoint(): Expected pairs of net devices");
+    NS_ASSERT_MSG(m_base + 1 <= m_max,
+                  "Ipv4AddressHelper::AssignPointToPoint(): Network too small for two addresses");
+
+    Ipv4InterfaceContainer retval;
+    const uint32_t nPairs = c.GetN() / 2;
+    if (nPairs == 0)
+    {
+        return retval;
+    }
+    if (m_address != m_base)
+    {
+        NewNetwork();
+    }
+
+    const uint64_t lastNetwork = static_cast<uint64_t>(m_network) + nPairs - 1;
+    NS_ASSERT_MSG(lastNetwork < (static_cast<uint64_t>(1) << (N_BITS - m_shift)),
+                  "Ipv4AddressHelper::AssignPointToPoint(): Network overflow");
+
+    //
+    // Every address from the first to the last one of the batch belongs to
+    // the networks used here, so register them with the global generator as
+    // one block instead of one address at a time.
+    //
+    Ipv4AddressGenerator::AddAllocatedRange(
+        Ipv4Address((m_network << m_shift) | m_base),
+        Ipv4Address((static_cast<uint32_t>(lastNetwork) << m_shift) | (m_base + 1)));
+
+    for (uint32_t i = 0; i < nPairs; ++i)
+    {
+        uint32_t network = (m_network + i) << m_shift;
+        AssignAddress(c.Get(2 * i), Ipv4Address(network | m_base), retval);
+        AssignAddress(c.Get(2 * i + 1), Ipv4Address(network | (m_base + 1)), retval);
+    }
+
+    m_network = static_cast<uint32_t>(lastNetwork) + 1;
+    m_address = m_base;
+    return retval;
+}
+
 uint32_t
 Ipv4AddressHelper::NumAddressBits(uint32_t maskbits) const
 {
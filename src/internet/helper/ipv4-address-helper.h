@@ -178,7 +178,42 @@ class Ipv4AddressHelper
      */
     Ipv4InterfaceContainer Assign(const NetDeviceContainer& c);
 
+    /**
+     * @brief Assign one network to each consecutive pair of net devices in
+     * the container, as returned by PointToPointHelper::InstallMany.
+     *
+     * This is equivalent to calling Assign on each pair followed by
+     * NewNetwork, but the addresses of the whole batch are computed directly
+     * and registered with the Ipv4AddressGenerator as a single block, so the
+     * cost does not grow with the number of networks already allocated.  It
+     * is intended for large topologies, typically with a /30 mask:
+     *
+     *   SetBase ("10.0.0.0", "255.255.255.252");
+     *   AssignPointToPoint (devices);
+     *
+     * gives 10.0.0.1/10.0.0.2 to the first pair, 10.0.0.5/10.0.0.6 to the
+     * second, and so on.  If the current network already has addresses
+     * allocated, assignment starts on the next network.  On return the helper
+     * points to the first unused network.
+     *
+     * @param c The NetDeviceContainer holding pairs of net devices; devices
+     * 2i and 2i+1 share a network.
+     *
+     * @returns A container holding the added NetDevices, in the same order
+     * @see Assign
+     */
+    Ipv4InterfaceContainer AssignPointToPoint(const NetDeviceContainer& c);
+
   private:
+    /**
+     * \brief Add an address to the Ipv4 interface of a net device, creating
+     * the interface if needed.
+     * \param device the net device
+     * \param address the address to add
+     * \param retval the container the interface is added to
+     */
+    void AssignAddress(Ptr<NetDevice> device, Ipv4Address address, Ipv4InterfaceContainer& retval);
+
     /**
      * \brief Returns the number of address bits (hostpart) for a given netmask
      * \param maskbits the netmask
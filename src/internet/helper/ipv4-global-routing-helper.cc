@@ -72,4 +72,10 @@ Ipv4GlobalRoutingHelper::RecomputeRoutingTables()
     GlobalRouteManager::InitializeRoutes();
 }
 
+void
+Ipv4GlobalRoutingHelper::UpdateRoutingTables()
+{
+    GlobalRouteManager::UpdateRoutes();
+}
+
 } // namespace ns3
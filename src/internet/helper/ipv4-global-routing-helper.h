@@ -88,6 +88,16 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      *
      */
     static void RecomputeRoutingTables();
+    /**
+     * \brief Update the routes installed by a prior call to
+     * PopulateRoutingTables() after a change in the topology, for instance
+     * a link going down.
+     *
+     * Only the nodes whose shortest paths may have changed run the SPF
+     * computation again; the routing tables end up equivalent to those of
+     * RecomputeRoutingTables().
+     */
+    static void UpdateRoutingTables();
 };
 
 } // namespace ns3
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ipv4-next-hop-routing-helper.h"
+
+#include "ns3/ipv4-next-hop-routing.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ipv4NextHopRoutingHelper");
+
+Ipv4NextHopRoutingHelper::Ipv4NextHopRoutingHelper()
+{
+}
+
+Ipv4NextHopRoutingHelper*
+Ipv4NextHopRoutingHelper::Copy() const
+{
+    return new Ipv4NextHopRoutingHelper(*this);
+}
+
+Ptr<Ipv4RoutingProtocol>
+Ipv4NextHopRoutingHelper::Create(Ptr<Node> node) const
+{
+    NS_LOG_LOGIC("Adding NextHopRouting Protocol to node " << node->GetId());
+    return CreateObject<Ipv4NextHopRouting>();
+}
+
+void
+Ipv4NextHopRoutingHelper::PopulateRoutingTables()
+{
+    Ipv4NextHopRouting::PopulateRoutingTables();
+}
+
+} // namespace ns3
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef IPV4_NEXT_HOP_ROUTING_HELPER_H
+#define IPV4_NEXT_HOP_ROUTING_HELPER_H
+
+#include "ns3/ipv4-routing-helper.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup ipv4Helpers
+ *
+ * \brief Helper class that adds ns3::Ipv4NextHopRouting objects
+ */
+class Ipv4NextHopRoutingHelper : public Ipv4RoutingHelper
+{
+  public:
+    Ipv4NextHopRoutingHelper();
+
+    /**
+     * \returns pointer to clone of this Ipv4NextHopRoutingHelper
+     *
+     * This method is mainly for internal use by the other helpers;
+     * clients are expected to free the dynamic memory allocated by this method
+     */
+    Ipv4NextHopRoutingHelper* Copy() const override;
+
+    /**
+     * \param node the node on which the routing protocol will run
+     * \returns a newly-created routing protocol
+     *
+     * This method will be called by ns3::InternetStackHelper::Install
+     */
+    Ptr<Ipv4RoutingProtocol> Create(Ptr<Node> node) const override;
+
+    /**
+     * \brief Compute the next-hop tables of all the nodes with an
+     * Ipv4NextHopRouting protocol.
+     *
+     * This must be called once the topology, addresses and, with the
+     * NextHopRoutingApplicationNodesOnly global value, applications are set
+     * up, and again after any change of the topology.
+     */
+    static void PopulateRoutingTables();
+};
+
+} // namespace ns3
+
+#endif /* IPV4_NEXT_HOP_ROUTING_HELPER_H */
@@ -58,22 +58,24 @@ operator<<(std::ostream& os, const SPFVertex::VertexType& t)
 std::ostream&
 operator<<(std::ostream& os, const CandidateQueue& q)
 {
-    typedef CandidateQueue::CandidateList_t List_t;
-    typedef List_t::const_iterator CIter_t;
-    const CandidateQueue::CandidateList_t& list = q.m_candidates;
+    std::vector<CandidateQueue::Entry> sorted = q.m_heap;
+    std::sort(sorted.begin(), sorted.end(), &CandidateQueue::Before);
 
     os << "*** CandidateQueue Begin (<id, distance, LSA-type>) ***" << std::endl;
-    for (CIter_t iter = list.begin(); iter != list.end(); iter++)
+    for (const auto& entry : sorted)
     {
-        os << "<" << (*iter)->GetVertexId() << ", " << (*iter)->GetDistanceFromRoot() << ", "
-           << (*iter)->GetVertexType() << ">" << std::endl;
+        os << "<" << entry.vertex->GetVertexId() << ", " << entry.vertex->GetDistanceFromRoot()
+           << ", " << entry.vertex->GetVertexType() << ">" << std::endl;
     }
     os << "*** CandidateQueue End ***";
     return os;
 }
 
 CandidateQueue::CandidateQueue()
-    : m_candidates()
+    : m_heap(),
+      m_pos(),
+      m_ids(),
+      m_seq(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -88,7 +90,7 @@ void
 CandidateQueue::Clear()
 {
     NS_LOG_FUNCTION(this);
-    while (!m_candidates.empty())
+    while (!m_heap.empty())
     {
         SPFVertex* p = Pop();
         delete p;
@@ -100,25 +102,40 @@ void
 CandidateQueue::Push(SPFVertex* vNew)
 {
     NS_LOG_FUNCTION(this << vNew);
+    NS_ASSERT_MSG(m_pos.find(vNew) == m_pos.end(), "Vertex is already a candidate");
 
-    CandidateList_t::iterator i = std::upper_bound(m_candidates.begin(),
-                                                   m_candidates.end(),
-                                                   vNew,
-                                                   &CandidateQueue::CompareSPFVertex);
-    m_candidates.insert(i, vNew);
+    m_heap.push_back({vNew, m_seq++});
+    m_ids.emplace(vNew->GetVertexId().Get(), vNew);
+    SiftUp(m_heap.size() - 1);
 }
 
 SPFVertex*
 CandidateQueue::Pop()
 {
     NS_LOG_FUNCTION(this);
-    if (m_candidates.empty())
+    if (m_heap.empty())
     {
         return nullptr;
     }
 
-    SPFVertex* v = m_candidates.front();
-    m_candidates.pop_front();
+    SPFVertex* v = m_heap.front().vertex;
+    m_pos.erase(v);
+    auto range = m_ids.equal_range(v->GetVertexId().Get());
+    for (auto i = range.first; i != range.second; ++i)
+    {
+        if (i->second == v)
+        {
+            m_ids.erase(i);
+            break;
+        }
+    }
+    Entry last = m_heap.back();
+    m_heap.pop_back();
+    if (!m_heap.empty())
+    {
+        Place(0, last);
+        SiftDown(0);
+    }
     return v;
 }
 
@@ -126,44 +143,57 @@ SPFVertex*
 CandidateQueue::Top() const
 {
     NS_LOG_FUNCTION(this);
-    if (m_candidates.empty())
+    if (m_heap.empty())
     {
         return nullptr;
     }
 
-    return m_candidates.front();
+    return m_heap.front().vertex;
 }
 
 bool
 CandidateQueue::Empty() const
 {
     NS_LOG_FUNCTION(this);
-    return m_candidates.empty();
+    return m_heap.empty();
 }
 
 uint32_t
 CandidateQueue::Size() const
 {
     NS_LOG_FUNCTION(this);
-    return m_candidates.size();
+    return m_heap.size();
 }
 
 SPFVertex*
 CandidateQueue::Find(const Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this);
-    CandidateList_t::const_iterator i = m_candidates.begin();
-
-    for (; i != m_candidates.end(); i++)
+    // Should several candidates share the ID, return the one popped first
+    const Entry* found = nullptr;
+    auto range = m_ids.equal_range(addr.Get());
+    for (auto i = range.first; i != range.second; ++i)
     {
-        SPFVertex* v = *i;
-        if (v->GetVertexId() == addr)
+        const Entry& entry = m_heap[m_pos.at(i->second)];
+        if (!found || Before(entry, *found))
         {
-            return v;
+            found = &entry;
         }
     }
+    return found ? found->vertex : nullptr;
+}
+
+void
+CandidateQueue::Update(SPFVertex* v)
+{
+    NS_LOG_FUNCTION(this << v);
+    auto i = m_pos.find(v);
+    NS_ASSERT_MSG(i != m_pos.end(), "Vertex " << v->GetVertexId() << " is not a candidate");
 
-    return nullptr;
+    // The former sorted list placed an updated vertex after the ones
+    // already queued with the same key; a fresh sequence number does too.
+    m_heap[i->second].seq = m_seq++;
+    SiftUp(i->second);
 }
 
 void
@@ -171,18 +201,78 @@ CandidateQueue::Reorder()
 {
     NS_LOG_FUNCTION(this);
 
-    m_candidates.sort(&CandidateQueue::CompareSPFVertex);
+    for (std::size_t pos = m_heap.size() / 2; pos-- > 0;)
+    {
+        SiftDown(pos);
+    }
     NS_LOG_LOGIC("After reordering the CandidateQueue");
     NS_LOG_LOGIC(*this);
 }
 
-/*
- * In this implementation, SPFVertex follows the ordering where
- * a vertex is ranked first if its GetDistanceFromRoot () is smaller;
- * In case of a tie, NetworkLSA is always ranked before RouterLSA.
- *
- * This ordering is necessary for implementing ECMP
- */
+void
+CandidateQueue::SiftUp(std::size_t pos)
+{
+    Entry entry = m_heap[pos];
+    while (pos > 0)
+    {
+        std::size_t parent = (pos - 1) / 2;
+        if (!Before(entry, m_heap[parent]))
+        {
+            break;
+        }
+        Place(pos, m_heap[parent]);
+        pos = parent;
+    }
+    Place(pos, entry);
+}
+
+void
+CandidateQueue::SiftDown(std::size_t pos)
+{
+    Entry entry = m_heap[pos];
+    const std::size_t n = m_heap.size();
+    for (;;)
+    {
+        std::size_t child = 2 * pos + 1;
+        if (child >= n)
+        {
+            break;
+        }
+        if (child + 1 < n && Before(m_heap[child + 1], m_heap[child]))
+        {
+            ++child;
+        }
+        if (!Before(m_heap[child], entry))
+        {
+            break;
+        }
+        Place(pos, m_heap[child]);
+        pos = child;
+    }
+    Place(pos, entry);
+}
+
+void
+CandidateQueue::Place(std::size_t pos, const Entry& entry)
+{
+    m_heap[pos] = entry;
+    m_pos[entry.vertex] = pos;
+}
+
+bool
+CandidateQueue::Before(const Entry& e1, const Entry& e2)
+{
+    if (CompareSPFVertex(e1.vertex, e2.vertex))
+    {
+        return true;
+    }
+    if (CompareSPFVertex(e2.vertex, e1.vertex))
+    {
+        return false;
+    }
+    return e1.seq < e2.seq;
+}
+
 bool
 CandidateQueue::CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2)
 {
@@ -22,8 +22,9 @@
 
 #include "ns3/ipv4-address.h"
 
-#include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -45,9 +46,12 @@ class SPFVertex;
  * priority queue.
  *
  * Although a STL priority_queue almost does what we want, the requirement
- * for a Find () operation, the dynamic nature of the data and the derived
- * requirement for a Reorder () operation led us to implement this simple
- * enhanced priority queue.
+ * for a Find () operation and for lowering the distance of a queued vertex
+ * led us to implement this enhanced priority queue.  It is a binary heap
+ * with an index of the heap positions and of the vertex IDs, so that Push (),
+ * Pop (), Update () and Find () are O(log n) or O(1).  Vertices with the same
+ * distance and type leave the queue in the order they were pushed (or
+ * updated), as they did with the former sorted list.
  */
 class CandidateQueue
 {
@@ -144,6 +148,19 @@ class CandidateQueue
      */
     SPFVertex* Find(const Ipv4Address addr) const;
 
+    /**
+     * @brief Restore the queue order after the distance of a queued vertex
+     * has been lowered (decrease-key).
+     *
+     * The vertex is then ordered after the vertices already queued with the
+     * same distance and type.
+     *
+     * @see SPFVertex
+     * @param v The Shortest Path First Vertex whose distance has been lowered;
+     * it must be in the queue.
+     */
+    void Update(SPFVertex* v);
+
     /**
      * @brief Reorders the Candidate Queue according to the priority scheme.
      *
@@ -153,13 +170,49 @@ class CandidateQueue
      * increasing distance.
      *
      * This method is provided in case the values of m_distanceFromRoot change
-     * during the routing calculations.
+     * during the routing calculations.  It rebuilds the whole heap; prefer
+     * Update () when the changed vertex is known.
      *
      * @see SPFVertex
      */
     void Reorder();
 
   private:
+    /** A queued vertex and its push order. */
+    struct Entry
+    {
+        SPFVertex* vertex; //!< The vertex
+        uint64_t seq;      //!< Push (or update) order, breaks ties
+    };
+
+    /**
+     * \brief return true if e1 should be popped before e2
+     *
+     * \param e1 first operand
+     * \param e2 second operand
+     * \return True if e1 should be popped before e2; false otherwise
+     */
+    static bool Before(const Entry& e1, const Entry& e2);
+
+    /**
+     * \brief Move the entry at a heap position towards the root.
+     * \param pos The heap position.
+     */
+    void SiftUp(std::size_t pos);
+
+    /**
+     * \brief Move the entry at a heap position towards the leaves.
+     * \param pos The heap position.
+     */
+    void SiftDown(std::size_t pos);
+
+    /**
+     * \brief Store an entry at a heap position and update the index.
+     * \param pos The heap position.
+     * \param entry The entry.
+     */
+    void Place(std::size_t pos, const Entry& entry);
+
     /**
      * \brief return true if v1 < v2
      *
@@ -173,8 +226,10 @@ class CandidateQueue
      */
     static bool CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2);
 
-    typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
-    CandidateList_t m_candidates;                  //!< SPFVertex candidates
+    std::vector<Entry> m_heap;                                //!< Binary heap of candidates
+    std::unordered_map<const SPFVertex*, std::size_t> m_pos; //!< Vertex to heap position
+    std::unordered_multimap<uint32_t, SPFVertex*> m_ids;     //!< Vertex ID to vertices
+    uint64_t m_seq;                                          //!< Next push order
 
     /**
      * \brief Stream insertion operator.
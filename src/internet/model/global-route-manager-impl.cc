@@ -26,17 +26,27 @@
 #include "candidate-queue.h"
 #include "global-router-interface.h"
 #include "ipv4-global-routing.h"
+#include "ipv4-routing-table-entry.h"
 #include "ipv4.h"
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <queue>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -45,6 +55,17 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/**
+ * \ingroup globalrouting
+ * The number of threads computing the routes of the routers, see
+ * GlobalRouteManagerImpl::InitializeRoutes ().
+ */
+static GlobalValue g_globalRoutingThreads(
+    "GlobalRoutingThreads",
+    "The number of threads computing the global routes (0 for one per hardware thread)",
+    UintegerValue(1),
+    MakeUintegerChecker<uint32_t>());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -428,7 +449,8 @@ SPFVertex::ClearVertexProcessed()
 
 GlobalRouteManagerLSDB::GlobalRouteManagerLSDB()
     : m_database(),
-      m_extdatabase()
+      m_extdatabase(),
+      m_linkDataIndexValid(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -476,6 +498,7 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     else
     {
         m_database.insert(LSDBPair_t(addr, lsa));
+        m_linkDataIndexValid = false;
     }
 }
 
@@ -500,13 +523,10 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    LSDBMap_t::const_iterator i;
-    for (i = m_database.begin(); i != m_database.end(); i++)
+    LSDBMap_t::const_iterator i = m_database.find(addr);
+    if (i != m_database.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return i->second;
     }
     return nullptr;
 }
@@ -516,26 +536,68 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // The index of the TransitNetwork link records is built on the first
+    // lookup after a change of the database.  As with a walk of the database,
+    // the first LSA in address order wins if several share the link data.
     //
-    LSDBMap_t::const_iterator i;
-    for (i = m_database.begin(); i != m_database.end(); i++)
+    if (!m_linkDataIndexValid)
     {
-        GlobalRoutingLSA* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
+        m_linkDataIndex.clear();
+        for (LSDBMap_t::const_iterator i = m_database.begin(); i != m_database.end(); i++)
         {
-            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork &&
-                lr->GetLinkData() == addr)
+            GlobalRoutingLSA* temp = i->second;
+            for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
             {
-                return temp;
+                GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
+                if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+                {
+                    m_linkDataIndex.emplace(lr->GetLinkData().Get(), temp);
+                }
             }
         }
+        m_linkDataIndexValid = true;
+    }
+    auto i = m_linkDataIndex.find(addr.Get());
+    if (i != m_linkDataIndex.end())
+    {
+        return i->second;
     }
     return nullptr;
 }
 
+GlobalRouteManagerLSDB*
+GlobalRouteManagerLSDB::Copy() const
+{
+    NS_LOG_FUNCTION(this);
+    GlobalRouteManagerLSDB* copy = new GlobalRouteManagerLSDB();
+    for (LSDBMap_t::const_iterator i = m_database.begin(); i != m_database.end(); i++)
+    {
+        GlobalRoutingLSA* lsa = new GlobalRoutingLSA();
+        *lsa = *i->second;
+        copy->m_database.insert(LSDBPair_t(i->first, lsa));
+    }
+    for (GlobalRoutingLSA* ext : m_extdatabase)
+    {
+        GlobalRoutingLSA* lsa = new GlobalRoutingLSA();
+        *lsa = *ext;
+        copy->m_extdatabase.push_back(lsa);
+    }
+    return copy;
+}
+
+std::vector<GlobalRoutingLSA*>
+GlobalRouteManagerLSDB::GetLSAs() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<GlobalRoutingLSA*> lsas;
+    lsas.reserve(m_database.size());
+    for (LSDBMap_t::const_iterator i = m_database.begin(); i != m_database.end(); i++)
+    {
+        lsas.push_back(i->second);
+    }
+    return lsas;
+}
+
 // ---------------------------------------------------------------------------
 //
 // GlobalRouteManagerImpl Implementation
@@ -543,7 +605,8 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 // ---------------------------------------------------------------------------
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_nNodes(0)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB();
@@ -698,12 +761,22 @@ GlobalRouteManagerImpl::BuildGlobalRoutingDatabase()
 //
 void
 GlobalRouteManagerImpl::InitializeRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_INFO("About to start SPF calculation");
+    BuildRouterNodeIndex();
+    CalculateRoutes(GetRoots());
+    NS_LOG_INFO("Finished SPF calculation");
+}
+
+std::vector<Ipv4Address>
+GlobalRouteManagerImpl::GetRoots() const
 {
     NS_LOG_FUNCTION(this);
     //
     // Walk the list of nodes in the system.
     //
-    NS_LOG_INFO("About to start SPF calculation");
+    std::vector<Ipv4Address> roots;
     NodeList::Iterator listEnd = NodeList::End();
     for (NodeList::Iterator i = NodeList::Begin(); i != listEnd; i++)
     {
@@ -727,10 +800,603 @@ GlobalRouteManagerImpl::InitializeRoutes()
         //
         if (rtr && rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            roots.push_back(rtr->GetRouterId());
         }
     }
-    NS_LOG_INFO("Finished SPF calculation");
+    return roots;
+}
+
+void
+GlobalRouteManagerImpl::CalculateRoutes(const std::vector<Ipv4Address>& roots)
+{
+    NS_LOG_FUNCTION(this << roots.size());
+    UintegerValue threadsValue;
+    g_globalRoutingThreads.GetValue(threadsValue);
+    uint32_t threads = threadsValue.Get();
+    if (threads == 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = std::min<std::size_t>(threads, roots.size());
+    if (threads > 1)
+    {
+        SPFCalculateParallel(roots, threads);
+    }
+    else
+    {
+        for (const auto& root : roots)
+        {
+            SPFCalculate(root);
+        }
+    }
+}
+
+namespace
+{
+
+/// A link record as compared by UpdateRoutes (): link type, link ID, link data and metric
+typedef std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> LinkRecordKey_t;
+
+/// A link of the SPF graph: from vertex, to vertex and cost
+typedef std::tuple<uint32_t, uint32_t, uint32_t> SPFLink_t;
+
+/// The distance to a vertex that can not be reached
+const uint64_t UNREACHABLE = std::numeric_limits<uint64_t>::max();
+
+/**
+ * \ingroup globalrouting
+ * \brief The graph of the first stage of the SPF calculation: the routers and
+ * transit networks of the LSDB, and the links between them.
+ */
+struct SPFGraph
+{
+    /// The vertex and cost of the links from each vertex
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> out;
+    /// The vertex and cost of the links to each vertex
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> in;
+};
+
+/**
+ * \brief Get the key of a link record.
+ * \param lr the link record
+ * \returns the key
+ */
+LinkRecordKey_t
+GetLinkRecordKey(const GlobalRoutingLinkRecord* lr)
+{
+    return std::make_tuple(lr->GetLinkType(),
+                           lr->GetLinkId().Get(),
+                           lr->GetLinkData().Get(),
+                           lr->GetMetric());
+}
+
+/**
+ * \brief Compare two LSAs, except for their link records and SPF status.
+ * \param a the first LSA
+ * \param b the second LSA
+ * \returns true if the LSAs are the same
+ */
+bool
+IsSameLSAHeader(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    if (a->GetLSType() != b->GetLSType() || a->GetLinkStateId() != b->GetLinkStateId() ||
+        a->GetAdvertisingRouter() != b->GetAdvertisingRouter() ||
+        a->GetNetworkLSANetworkMask() != b->GetNetworkLSANetworkMask() ||
+        a->GetNode() != b->GetNode() || a->GetNAttachedRouters() != b->GetNAttachedRouters())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->GetNAttachedRouters(); i++)
+    {
+        if (a->GetAttachedRouter(i) != b->GetAttachedRouter(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Compare the link records of two LSAs.
+ * \param a the first LSA
+ * \param b the second LSA
+ * \returns true if the LSAs have the same link records, in the same order
+ */
+bool
+IsSameLinkRecords(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    if (a->GetNLinkRecords() != b->GetNLinkRecords())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->GetNLinkRecords(); i++)
+    {
+        if (GetLinkRecordKey(a->GetLinkRecord(i)) != GetLinkRecordKey(b->GetLinkRecord(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Get the link records of an LSA that are not in another LSA,
+ * counting repeated records.
+ * \param lsa the LSA
+ * \param other the other LSA
+ * \returns the link records of lsa missing from other
+ */
+std::vector<GlobalRoutingLinkRecord*>
+GetMissingLinkRecords(const GlobalRoutingLSA* lsa, const GlobalRoutingLSA* other)
+{
+    std::map<LinkRecordKey_t, uint32_t> count;
+    for (uint32_t i = 0; i < other->GetNLinkRecords(); i++)
+    {
+        count[GetLinkRecordKey(other->GetLinkRecord(i))]++;
+    }
+    std::vector<GlobalRoutingLinkRecord*> missing;
+    for (uint32_t i = 0; i < lsa->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(i);
+        auto j = count.find(GetLinkRecordKey(lr));
+        if (j != count.end() && j->second > 0)
+        {
+            j->second--;
+        }
+        else
+        {
+            missing.push_back(lr);
+        }
+    }
+    return missing;
+}
+
+/**
+ * \brief Build the graph that SPFNext () explores.
+ * \param lsdb the LSDB
+ * \param lsas the Router and Network LSAs of the LSDB
+ * \param index the vertex of each link state ID
+ * \returns the graph
+ */
+SPFGraph
+BuildSPFGraph(const GlobalRouteManagerLSDB* lsdb,
+              const std::vector<GlobalRoutingLSA*>& lsas,
+              const std::unordered_map<uint32_t, uint32_t>& index)
+{
+    SPFGraph graph;
+    graph.out.resize(lsas.size());
+    graph.in.resize(lsas.size());
+    for (uint32_t v = 0; v < lsas.size(); v++)
+    {
+        GlobalRoutingLSA* lsa = lsas[v];
+        if (lsa->GetLSType() == GlobalRoutingLSA::RouterLSA)
+        {
+            for (uint32_t i = 0; i < lsa->GetNLinkRecords(); i++)
+            {
+                GlobalRoutingLinkRecord* l = lsa->GetLinkRecord(i);
+                if (l->GetLinkType() == GlobalRoutingLinkRecord::StubNetwork)
+                {
+                    continue;
+                }
+                auto w = index.find(l->GetLinkId().Get());
+                if (w != index.end())
+                {
+                    graph.out[v].emplace_back(w->second, l->GetMetric());
+                    graph.in[w->second].emplace_back(v, l->GetMetric());
+                }
+            }
+        }
+        else if (lsa->GetLSType() == GlobalRoutingLSA::NetworkLSA)
+        {
+            for (uint32_t i = 0; i < lsa->GetNAttachedRouters(); i++)
+            {
+                GlobalRoutingLSA* w_lsa = lsdb->GetLSAByLinkData(lsa->GetAttachedRouter(i));
+                if (!w_lsa)
+                {
+                    continue;
+                }
+                auto w = index.find(w_lsa->GetLinkStateId().Get());
+                if (w != index.end())
+                {
+                    graph.out[v].emplace_back(w->second, 0);
+                    graph.in[w->second].emplace_back(v, 0);
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+/**
+ * \brief Get the links to and from a vertex.
+ * \param graph the graph
+ * \param v the vertex
+ * \returns the links, sorted
+ */
+std::vector<SPFLink_t>
+GetLinks(const SPFGraph& graph, uint32_t v)
+{
+    std::vector<SPFLink_t> links;
+    for (const auto& w : graph.out[v])
+    {
+        links.emplace_back(v, w.first, w.second);
+    }
+    for (const auto& w : graph.in[v])
+    {
+        links.emplace_back(w.first, v, w.second);
+    }
+    std::sort(links.begin(), links.end());
+    return links;
+}
+
+/**
+ * \brief Compute the distance from every vertex to a target vertex, with
+ * a Dijkstra search on the reversed links.
+ * \param graph the graph
+ * \param target the target vertex
+ * \returns the distance from each vertex to target, or UNREACHABLE
+ */
+std::vector<uint64_t>
+GetDistancesTo(const SPFGraph& graph, uint32_t target)
+{
+    typedef std::pair<uint64_t, uint32_t> Item_t;
+    std::vector<uint64_t> distance(graph.in.size(), UNREACHABLE);
+    std::priority_queue<Item_t, std::vector<Item_t>, std::greater<Item_t>> queue;
+    distance[target] = 0;
+    queue.emplace(0, target);
+    while (!queue.empty())
+    {
+        Item_t item = queue.top();
+        queue.pop();
+        if (item.first > distance[item.second])
+        {
+            continue;
+        }
+        for (const auto& w : graph.in[item.second])
+        {
+            uint64_t d = item.first + w.second;
+            if (d < distance[w.first])
+            {
+                distance[w.first] = d;
+                queue.emplace(d, w.first);
+            }
+        }
+    }
+    return distance;
+}
+
+/**
+ * \brief Get the destination of the routes to a link record.
+ * \param lr the link record
+ * \param dest the destination
+ * \param mask the mask of the destination
+ * \returns false if SPFIntraAddRouter () and SPFIntraAddStub () add no route
+ * to the link record
+ */
+bool
+GetLinkRecordDestination(const GlobalRoutingLinkRecord* lr, Ipv4Address& dest, Ipv4Mask& mask)
+{
+    if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+    {
+        dest = lr->GetLinkData();
+        mask = Ipv4Mask::GetOnes();
+        return true;
+    }
+    if (lr->GetLinkType() == GlobalRoutingLinkRecord::StubNetwork)
+    {
+        mask = Ipv4Mask(lr->GetLinkData().Get());
+        dest = lr->GetLinkId().CombineMask(mask);
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void
+GlobalRouteManagerImpl::UpdateRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    //
+    // Keep the LSDB the current routes were computed from, and gather the new
+    // Link State Advertisements.
+    //
+    std::unique_ptr<GlobalRouteManagerLSDB> oldLsdb(m_lsdb);
+    m_lsdb = new GlobalRouteManagerLSDB();
+    BuildGlobalRoutingDatabase();
+    BuildRouterNodeIndex();
+
+    auto getRouting = [this](Ipv4Address routerId) -> Ptr<Ipv4GlobalRouting> {
+        auto node = m_routerNodes->find(routerId.Get());
+        NS_ASSERT(node != m_routerNodes->end());
+        return node->second->GetObject<GlobalRouter>()->GetRoutingProtocol();
+    };
+    auto all = [](const Ipv4RoutingTableEntry&) { return true; };
+
+    //
+    // Compare the LSAs.  Only the changes of the link records of Router LSAs
+    // are handled incrementally.
+    //
+    std::vector<GlobalRoutingLSA*> oldLsas = oldLsdb->GetLSAs();
+    std::vector<GlobalRoutingLSA*> newLsas = m_lsdb->GetLSAs();
+    bool full = oldLsas.size() != newLsas.size() ||
+                oldLsdb->GetNumExtLSAs() != m_lsdb->GetNumExtLSAs();
+    for (uint32_t i = 0; !full && i < m_lsdb->GetNumExtLSAs(); i++)
+    {
+        full = !IsSameLSAHeader(oldLsdb->GetExtLSA(i), m_lsdb->GetExtLSA(i)) ||
+               !IsSameLinkRecords(oldLsdb->GetExtLSA(i), m_lsdb->GetExtLSA(i));
+    }
+    std::unordered_map<uint32_t, uint32_t> index;
+    std::vector<uint32_t> changed;
+    for (uint32_t v = 0; !full && v < newLsas.size(); v++)
+    {
+        index.emplace(newLsas[v]->GetLinkStateId().Get(), v);
+        if (!IsSameLSAHeader(oldLsas[v], newLsas[v]))
+        {
+            full = true;
+        }
+        else if (!IsSameLinkRecords(oldLsas[v], newLsas[v]))
+        {
+            full = newLsas[v]->GetLSType() != GlobalRoutingLSA::RouterLSA;
+            changed.push_back(v);
+        }
+    }
+    if (full)
+    {
+        NS_LOG_LOGIC("The set of LSAs changed, computing all routes");
+        for (const auto& node : *m_routerNodes)
+        {
+            node.second->GetObject<GlobalRouter>()->GetRoutingProtocol()->RemoveRoutes(all);
+        }
+        CalculateRoutes(GetRoots());
+        return;
+    }
+    NS_LOG_LOGIC(changed.size() << " of " << newLsas.size() << " LSAs changed");
+    if (changed.empty())
+    {
+        return;
+    }
+
+    //
+    // Find the links added and removed, and the distances to their ends.
+    //
+    SPFGraph oldGraph = BuildSPFGraph(oldLsdb.get(), oldLsas, index);
+    SPFGraph newGraph = BuildSPFGraph(m_lsdb, newLsas, index);
+    std::vector<SPFLink_t> removed;
+    std::vector<SPFLink_t> added;
+    std::vector<bool> near(newLsas.size(), false);
+    for (uint32_t x : changed)
+    {
+        std::vector<SPFLink_t> oldLinks = GetLinks(oldGraph, x);
+        std::vector<SPFLink_t> newLinks = GetLinks(newGraph, x);
+        std::set_difference(oldLinks.begin(),
+                            oldLinks.end(),
+                            newLinks.begin(),
+                            newLinks.end(),
+                            std::back_inserter(removed));
+        std::set_difference(newLinks.begin(),
+                            newLinks.end(),
+                            oldLinks.begin(),
+                            oldLinks.end(),
+                            std::back_inserter(added));
+        // The next hops of the neighbors come from the link records of x
+        for (const auto& links : {oldLinks, newLinks})
+        {
+            for (const auto& link : links)
+            {
+                near[std::get<0>(link)] = true;
+                near[std::get<1>(link)] = true;
+            }
+        }
+        near[x] = true;
+    }
+    std::unordered_map<uint32_t, std::vector<uint64_t>> oldDistance;
+    std::unordered_map<uint32_t, std::vector<uint64_t>> newDistance;
+    auto addTarget = [&](uint32_t t) {
+        if (oldDistance.find(t) == oldDistance.end())
+        {
+            oldDistance.emplace(t, GetDistancesTo(oldGraph, t));
+            newDistance.emplace(t, GetDistancesTo(newGraph, t));
+        }
+    };
+    for (uint32_t x : changed)
+    {
+        addTarget(x);
+    }
+    for (const auto& links : {removed, added})
+    {
+        for (const auto& link : links)
+        {
+            addTarget(std::get<0>(link));
+            addTarget(std::get<1>(link));
+        }
+    }
+    auto onShortestPath = [](const std::vector<SPFLink_t>& links,
+                             std::unordered_map<uint32_t, std::vector<uint64_t>>& distance,
+                             uint32_t r) {
+        for (const auto& link : links)
+        {
+            uint64_t from = distance[std::get<0>(link)][r];
+            if (from != UNREACHABLE && from + std::get<2>(link) <= distance[std::get<1>(link)][r])
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    //
+    // A root whose shortest paths did not change keeps its routes, except
+    // for those to the records of the changed routers.
+    //
+    std::vector<Ipv4Address> affected;
+    for (const auto& root : GetRoots())
+    {
+        uint32_t r = index.at(root.Get());
+        Ptr<Ipv4GlobalRouting> gr = getRouting(root);
+        bool recompute = near[r] || onShortestPath(removed, oldDistance, r) ||
+                         onShortestPath(added, newDistance, r);
+        GlobalRoutingLinkRecord* transitLink = nullptr;
+        GlobalRoutingLinkRecord* peerLink = nullptr;
+        if (!recompute && !IsStubNode(root, transitLink, peerLink))
+        {
+            for (uint32_t x : changed)
+            {
+                if (oldDistance[x][r] != UNREACHABLE &&
+                    !PatchRoutes(gr, oldLsas[x], newLsas[x]))
+                {
+                    recompute = true;
+                    break;
+                }
+            }
+        }
+        if (recompute)
+        {
+            gr->RemoveRoutes(all);
+            affected.push_back(root);
+        }
+    }
+    NS_LOG_INFO("Updating the routes of " << affected.size() << " routers");
+    CalculateRoutes(affected);
+}
+
+bool
+GlobalRouteManagerImpl::PatchRoutes(Ptr<Ipv4GlobalRouting> gr,
+                                    GlobalRoutingLSA* oldLsa,
+                                    GlobalRoutingLSA* newLsa)
+{
+    NS_LOG_FUNCTION(this << gr << oldLsa << newLsa);
+    //
+    // SPFIntraAddRouter () added a host route per exit from the root to the
+    // router for each of its point-to-point links, so the exits can be read
+    // back from the routes to the first one.
+    //
+    std::vector<SPFVertex::NodeExit_t> exits;
+    for (uint32_t i = 0; i < oldLsa->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* lr = oldLsa->GetLinkRecord(i);
+        if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+        {
+            for (Ipv4RoutingTableEntry* route : gr->GetHostRoutesTo(lr->GetLinkData()))
+            {
+                exits.emplace_back(route->GetGateway(), route->GetInterface());
+            }
+            break;
+        }
+    }
+    if (exits.empty())
+    {
+        NS_LOG_LOGIC("No exit to " << oldLsa->GetLinkStateId());
+        return false;
+    }
+
+    Ipv4Address dest;
+    Ipv4Mask mask;
+    // Destination, mask, gateway and interface of the routes to remove
+    std::map<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>, uint32_t> remove;
+    for (GlobalRoutingLinkRecord* lr : GetMissingLinkRecords(oldLsa, newLsa))
+    {
+        if (GetLinkRecordDestination(lr, dest, mask))
+        {
+            for (const auto& exit : exits)
+            {
+                remove[std::make_tuple(dest.Get(),
+                                       mask.Get(),
+                                       exit.first.Get(),
+                                       static_cast<uint32_t>(exit.second))]++;
+            }
+        }
+    }
+    if (!remove.empty())
+    {
+        gr->RemoveRoutes([&remove](const Ipv4RoutingTableEntry& route) {
+            auto i = remove.find(std::make_tuple(route.GetDestNetwork().Get(),
+                                                 route.GetDestNetworkMask().Get(),
+                                                 route.GetGateway().Get(),
+                                                 route.GetInterface()));
+            if (i == remove.end() || i->second == 0)
+            {
+                return false;
+            }
+            i->second--;
+            return true;
+        });
+    }
+    for (GlobalRoutingLinkRecord* lr : GetMissingLinkRecords(newLsa, oldLsa))
+    {
+        if (!GetLinkRecordDestination(lr, dest, mask))
+        {
+            continue;
+        }
+        for (const auto& exit : exits)
+        {
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+            {
+                gr->AddHostRouteTo(dest, exit.first, exit.second);
+            }
+            else
+            {
+                gr->AddNetworkRouteTo(dest, mask, exit.first, exit.second);
+            }
+        }
+    }
+    return true;
+}
+
+void
+GlobalRouteManagerImpl::BuildRouterNodeIndex()
+{
+    NS_LOG_FUNCTION(this);
+    auto routerNodes = std::make_shared<RouterNodeMap_t>();
+    NodeList::Iterator listEnd = NodeList::End();
+    for (NodeList::Iterator i = NodeList::Begin(); i != listEnd; i++)
+    {
+        Ptr<GlobalRouter> rtr = (*i)->GetObject<GlobalRouter>();
+        if (rtr)
+        {
+            // As with a walk of the NodeList, the first node wins
+            routerNodes->emplace(rtr->GetRouterId().Get(), *i);
+        }
+    }
+    m_routerNodes = routerNodes;
+    m_nNodes = NodeList::GetNNodes();
+}
+
+void
+GlobalRouteManagerImpl::SPFCalculateParallel(const std::vector<Ipv4Address>& roots,
+                                             uint32_t threads)
+{
+    NS_LOG_FUNCTION(this << roots.size() << threads);
+    //
+    // The workers only share read-only data: the router index, and the nodes
+    // and LSAs of other routers.  Each worker writes the SPF state to its own
+    // copy of the LSDB and the routes to the node at the root of its tree.
+    //
+    std::vector<std::unique_ptr<GlobalRouteManagerImpl>> workers;
+    for (uint32_t t = 0; t < threads; ++t)
+    {
+        auto worker = std::make_unique<GlobalRouteManagerImpl>();
+        worker->DebugUseLsdb(m_lsdb->Copy());
+        worker->m_routerNodes = m_routerNodes;
+        worker->m_nNodes = m_nNodes;
+        workers.push_back(std::move(worker));
+    }
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> pool;
+    for (uint32_t t = 0; t < threads; ++t)
+    {
+        GlobalRouteManagerImpl* worker = workers[t].get();
+        pool.emplace_back([worker, &roots, &next]() {
+            for (std::size_t k = next++; k < roots.size(); k = next++)
+            {
+                worker->SPFCalculate(roots[k]);
+            }
+        });
+    }
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
 }
 
 //
@@ -961,7 +1627,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                     // If we've changed the cost to get to the vertex represented by <w>, we
                     // must reorder the priority queue keyed to that cost.
                     //
-                    candidate.Reorder();
+                    candidate.Update(cw);
                 }
             } // new lower cost path found
         }     // end W is already on the candidate list
@@ -1243,6 +1909,7 @@ void
 GlobalRouteManagerImpl::DebugSPFCalculate(Ipv4Address root)
 {
     NS_LOG_FUNCTION(this << root);
+    BuildRouterNodeIndex();
     SPFCalculate(root);
 }
 
@@ -1254,12 +1921,46 @@ GlobalRouteManagerImpl::DebugSPFCalculate(Ipv4Address root)
 //
 bool
 GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
+{
+    NS_LOG_FUNCTION(this << root);
+    GlobalRoutingLinkRecord* transitLink = nullptr;
+    GlobalRoutingLinkRecord* lr = nullptr;
+    if (!IsStubNode(root, transitLink, lr))
+    {
+        return false;
+    }
+    if (!lr)
+    {
+        // No router to install a default route to
+        return true;
+    }
+    // Next hop is stored in the LinkID field of lr
+    Ptr<Node> node = m_spfrootNode ? m_spfrootNode : m_lsdb->GetLSA(root)->GetNode();
+    Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+    NS_ASSERT(router);
+    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
+    NS_ASSERT(gr);
+    gr->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
+                          Ipv4Mask("0.0.0.0"),
+                          lr->GetLinkData(),
+                          FindOutgoingInterfaceId(transitLink->GetLinkData()));
+    NS_LOG_LOGIC("Inserting default route for node "
+                 << root << " to next hop " << lr->GetLinkData() << " via interface "
+                 << FindOutgoingInterfaceId(transitLink->GetLinkData()));
+    return true;
+}
+
+bool
+GlobalRouteManagerImpl::IsStubNode(Ipv4Address root,
+                                   GlobalRoutingLinkRecord*& transitLink,
+                                   GlobalRoutingLinkRecord*& peerLink) const
 {
     NS_LOG_FUNCTION(this << root);
     GlobalRoutingLSA* rlsa = m_lsdb->GetLSA(root);
     Ipv4Address myRouterId = rlsa->GetLinkStateId();
     int transits = 0;
-    GlobalRoutingLinkRecord* transitLink = nullptr;
+    transitLink = nullptr;
+    peerLink = nullptr;
     for (uint32_t i = 0; i < rlsa->GetNLinkRecords(); i++)
     {
         GlobalRoutingLinkRecord* l = rlsa->GetLinkRecord(i);
@@ -1315,19 +2016,7 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
                 // Find the link record that corresponds to our routerId
                 if (lr->GetLinkId() == myRouterId)
                 {
-                    // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter> router = rlsa->GetNode()->GetObject<GlobalRouter>();
-                    NS_ASSERT(router);
-                    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                    NS_ASSERT(gr);
-                    gr->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
-                                          Ipv4Mask("0.0.0.0"),
-                                          lr->GetLinkData(),
-                                          FindOutgoingInterfaceId(transitLink->GetLinkData()));
-                    NS_LOG_LOGIC("Inserting default route for node "
-                                 << myRouterId << " to next hop " << lr->GetLinkData()
-                                 << " via interface "
-                                 << FindOutgoingInterfaceId(transitLink->GetLinkData()));
+                    peerLink = lr;
                     return true;
                 }
             }
@@ -1365,6 +2054,15 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // We also mark this vertex as being in the SPF tree.
     //
     m_spfroot = v;
+    m_spfrootNode = nullptr;
+    if (m_routerNodes)
+    {
+        auto node = m_routerNodes->find(root.Get());
+        if (node != m_routerNodes->end())
+        {
+            m_spfrootNode = node->second;
+        }
+    }
     v->SetDistanceFromRoot(0);
     v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
@@ -1376,10 +2074,12 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (m_nNodes > 0 && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
         delete m_spfroot;
+        m_spfroot = nullptr;
+        m_spfrootNode = nullptr;
         return;
     }
 
@@ -1501,6 +2201,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     delete m_spfroot;
     m_spfroot = nullptr;
+    m_spfrootNode = nullptr;
 }
 
 void
@@ -1557,105 +2258,83 @@ GlobalRouteManagerImpl::SPFAddASExternal(GlobalRoutingLSA* extlsa, SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
+    // SPFCalculate () has looked up the node that has the router ID
+    // corresponding to the root vertex.  This is the one we're going to write
     // the routing information to.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    Ptr<Node> node = m_spfrootNode;
+    Ptr<GlobalRouter> rtr = node ? node->GetObject<GlobalRouter>() : nullptr;
+    if (!rtr || rtr->GetRouterId() != routerId)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        NS_LOG_LOGIC("Can't find root node " << routerId);
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for node " << node->GetId());
+    //
+    // Routing information is updated using the Ipv4 interface.  We need to QI
+    // for that interface.  If the node is acting as an IP version 4 router, it
+    // should absolutely have an Ipv4 interface.
+    //
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    NS_ASSERT_MSG(ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "QI for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = extlsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
 
-        if (!rtr)
+    //
+    // Here's why we did all of that work.  We're going to add a host route to the
+    // host address found in the m_linkData field of the point-to-point link
+    // record.  In the case of a point-to-point link, this is the local IP address
+    // of the node connected to the link.  Each of these point-to-point links
+    // will correspond to a local interface that has an IP address to which
+    // the node at the root of the SPF tree can send packets.  The vertex <v>
+    // (corresponding to the node that has these links and interfaces) has
+    // an m_nextHop address precalculated for us that is the address to which the
+    // root node should send packets to be forwarded to these IP addresses.
+    // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+    // which the packets should be send for forwarding.
+    //
+    Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+    if (!router)
+    {
+        return;
+    }
+    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
+    NS_ASSERT(gr);
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " add external network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = extlsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add external network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
 // Processing logic from RFC 2328, page 166 and quagga ospf_spf_process_stubs ()
@@ -1723,105 +2402,83 @@ GlobalRouteManagerImpl::SPFIntraAddStub(GlobalRoutingLinkRecord* l, SPFVertex* v
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
+    // SPFCalculate () has looked up the node that has the router ID
+    // corresponding to the root vertex.  This is the one we're going to write
     // the routing information to.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    Ptr<Node> node = m_spfrootNode;
+    Ptr<GlobalRouter> rtr = node ? node->GetObject<GlobalRouter>() : nullptr;
+    if (!rtr || rtr->GetRouterId() != routerId)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        NS_LOG_LOGIC("Can't find root node " << routerId);
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for node " << node->GetId());
+    //
+    // Routing information is updated using the Ipv4 interface.  We need to QI
+    // for that interface.  If the node is acting as an IP version 4 router, it
+    // should absolutely have an Ipv4 interface.
+    //
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    NS_ASSERT_MSG(ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "QI for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask(l->GetLinkData().Get());
+    Ipv4Address tempip = l->GetLinkId();
+    tempip = tempip.CombineMask(tempmask);
+    //
+    // Here's why we did all of that work.  We're going to add a host route to the
+    // host address found in the m_linkData field of the point-to-point link
+    // record.  In the case of a point-to-point link, this is the local IP address
+    // of the node connected to the link.  Each of these point-to-point links
+    // will correspond to a local interface that has an IP address to which
+    // the node at the root of the SPF tree can send packets.  The vertex <v>
+    // (corresponding to the node that has these links and interfaces) has
+    // an m_nextHop address precalculated for us that is the address to which the
+    // root node should send packets to be forwarded to these IP addresses.
+    // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+    // which the packets should be send for forwarding.
+    //
 
-        if (!rtr)
+    Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+    if (!router)
+    {
+        return;
+    }
+    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
+    NS_ASSERT(gr);
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " add network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask(l->GetLinkData().Get());
-            Ipv4Address tempip = l->GetLinkId();
-            tempip = tempip.CombineMask(tempmask);
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
@@ -1845,60 +2502,44 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask)
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
     //
-    // Walk the list of nodes in the system looking for the one corresponding to
-    // the node at the root of the SPF tree.  This is the node for which we are
-    // building the routing table.
+    // SPFCalculate () has looked up the node at the root of the SPF tree.  This
+    // is the node for which we are building the routing table.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    Ptr<Node> node = m_spfrootNode;
+    Ptr<GlobalRouter> rtr = node ? node->GetObject<GlobalRouter>() : nullptr;
+    if (!rtr || rtr->GetRouterId() != routerId)
     {
-        Ptr<Node> node = *i;
-
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
         //
-        // If the node doesn't have a GlobalRouter interface it can't be the one
-        // we're interested in.
+        // Couldn't find it.
         //
-        if (!rtr)
-        {
-            continue;
-        }
-
-        if (rtr->GetRouterId() == routerId)
-        {
-            //
-            // This is the node we're building the routing table for.  We're going to need
-            // the Ipv4 interface to look for the ipv4 interface index.  Since this node
-            // is participating in routing IP version 4 packets, it certainly must have
-            // an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Look through the interfaces on this node for one that has the IP address
-            // we're looking for.  If we find one, return the corresponding interface
-            // index, or -1 if not found.
-            //
-            int32_t interface = ipv4->GetInterfaceForPrefix(a, amask);
-
-#if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif
-            return interface;
-        }
+        NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node " << routerId);
+        return -1;
     }
     //
-    // Couldn't find it.
+    // This is the node we're building the routing table for.  We're going to need
+    // the Ipv4 interface to look for the ipv4 interface index.  Since this node
+    // is participating in routing IP version 4 packets, it certainly must have
+    // an Ipv4 interface.
+    //
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    NS_ASSERT_MSG(ipv4,
+                  "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Look through the interfaces on this node for one that has the IP address
+    // we're looking for.  If we find one, return the corresponding interface
+    // index, or -1 if not found.
     //
-    NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node " << routerId);
-    return -1;
+    int32_t interface = ipv4->GetInterfaceForPrefix(a, amask);
+
+#if 0
+  if (interface < 0)
+    {
+      NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
+                      "Expected an interface associated with address a:" << a);
+    }
+#endif
+    return interface;
 }
 
 //
@@ -1934,130 +2575,105 @@ GlobalRouteManagerImpl::SPFIntraAddRouter(SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
+    // SPFCalculate () has looked up the node that has the router ID
+    // corresponding to the root vertex.  This is the one we're going to write
     // the routing information to.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    Ptr<Node> node = m_spfrootNode;
+    Ptr<GlobalRouter> rtr = node ? node->GetObject<GlobalRouter>() : nullptr;
+    if (!rtr || rtr->GetRouterId() != routerId)
+    {
+        NS_LOG_LOGIC("Can't find root node " << routerId);
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for node " << node->GetId());
+    //
+    // Routing information is updated using the Ipv4 interface.  We need to
+    // GetObject for that interface.  If the node is acting as an IP version 4
+    // router, it should absolutely have an Ipv4 interface.
+    //
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    NS_ASSERT_MSG(ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+
+    uint32_t nLinkRecords = lsa->GetNLinkRecords();
+    //
+    // Iterate through the link records on the vertex to which we're going to add
+    // routes.  To make sure we're being clear, we're going to add routing table
+    // entries to the tables on the node corresping to the root of the SPF tree.
+    // These entries will have routes to the IP addresses we find from looking at
+    // the local side of the point-to-point links found on the node described by
+    // the vertex <v>.
+    //
+    NS_LOG_LOGIC(" Node " << node->GetId() << " found " << nLinkRecords
+                          << " link records in LSA " << lsa << "with LinkStateId "
+                          << lsa->GetLinkStateId());
+    for (uint32_t j = 0; j < nLinkRecords; ++j)
     {
-        Ptr<Node> node = *i;
         //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
+        // We are only concerned about point-to-point links
         //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+        if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
             continue;
         }
         //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
+        // Here's why we did all of that work.  We're going to add a host route to the
+        // host address found in the m_linkData field of the point-to-point link
+        // record.  In the case of a point-to-point link, this is the local IP address
+        // of the node connected to the link.  Each of these point-to-point links
+        // will correspond to a local interface that has an IP address to which
+        // the node at the root of the SPF tree can send packets.  The vertex <v>
+        // (corresponding to the node that has these links and interfaces) has
+        // an m_nextHop address precalculated for us that is the address to which the
+        // root node should send packets to be forwarded to these IP addresses.
+        // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+        // which the packets should be send for forwarding.
         //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+        if (!router)
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-
-            uint32_t nLinkRecords = lsa->GetNLinkRecords();
-            //
-            // Iterate through the link records on the vertex to which we're going to add
-            // routes.  To make sure we're being clear, we're going to add routing table
-            // entries to the tables on the node corresping to the root of the SPF tree.
-            // These entries will have routes to the IP addresses we find from looking at
-            // the local side of the point-to-point links found on the node described by
-            // the vertex <v>.
-            //
-            NS_LOG_LOGIC(" Node " << node->GetId() << " found " << nLinkRecords
-                                  << " link records in LSA " << lsa << "with LinkStateId "
-                                  << lsa->GetLinkStateId());
-            for (uint32_t j = 0; j < nLinkRecords; ++j)
+            continue;
+        }
+        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
+        NS_ASSERT(gr);
+        // walk through all available exit directions due to ECMP,
+        // and add host route for each of the exit direction toward
+        // the vertex 'v'
+        for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+        {
+            SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+            Ipv4Address nextHop = exit.first;
+            int32_t outIf = exit.second;
+            if (outIf >= 0)
             {
-                //
-                // We are only concerned about point-to-point links
-                //
-                GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
-                if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                    continue;
-                }
-                //
-                // Here's why we did all of that work.  We're going to add a host route to the
-                // host address found in the m_linkData field of the point-to-point link
-                // record.  In the case of a point-to-point link, this is the local IP address
-                // of the node connected to the link.  Each of these point-to-point links
-                // will correspond to a local interface that has an IP address to which
-                // the node at the root of the SPF tree can send packets.  The vertex <v>
-                // (corresponding to the node that has these links and interfaces) has
-                // an m_nextHop address precalculated for us that is the address to which the
-                // root node should send packets to be forwarded to these IP addresses.
-                // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-                // which the packets should be send for forwarding.
-                //
-                Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-                if (!router)
-                {
-                    continue;
-                }
-                Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                NS_ASSERT(gr);
-                // walk through all available exit directions due to ECMP,
-                // and add host route for each of the exit direction toward
-                // the vertex 'v'
-                for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-                {
-                    SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                    Ipv4Address nextHop = exit.first;
-                    int32_t outIf = exit.second;
-                    if (outIf >= 0)
-                    {
-                        gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
-                        NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                               << " adding host route to " << lr->GetLinkData()
-                                               << " using next hop " << nextHop
-                                               << " and outgoing interface " << outIf);
-                    }
-                    else
-                    {
-                        NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                               << " NOT able to add host route to "
-                                               << lr->GetLinkData() << " using next hop " << nextHop
-                                               << " since outgoing interface id is negative "
-                                               << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
+                gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
+                NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                       << " adding host route to " << lr->GetLinkData()
+                                       << " using next hop " << nextHop
+                                       << " and outgoing interface " << outIf);
             }
-            //
-            // Done adding the routes for the selected node.
-            //
-            return;
-        }
+            else
+            {
+                NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                       << " NOT able to add host route to "
+                                       << lr->GetLinkData() << " using next hop " << nextHop
+                                       << " since outgoing interface id is negative "
+                                       << outIf);
+            }
+        } // for all routes from the root the vertex 'v'
     }
 }
 
@@ -2078,91 +2694,70 @@ GlobalRouteManagerImpl::SPFIntraAddTransit(SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
+    // SPFCalculate () has looked up the node that has the router ID
+    // corresponding to the root vertex.  This is the one we're going to write
     // the routing information to.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    Ptr<Node> node = m_spfrootNode;
+    Ptr<GlobalRouter> rtr = node ? node->GetObject<GlobalRouter>() : nullptr;
+    if (!rtr || rtr->GetRouterId() != routerId)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        NS_LOG_LOGIC("Can't find root node " << routerId);
+        return;
+    }
+    NS_LOG_LOGIC("setting routes for node " << node->GetId());
+    //
+    // Routing information is updated using the Ipv4 interface.  We need to
+    // GetObject for that interface.  If the node is acting as an IP version 4
+    // router, it should absolutely have an Ipv4 interface.
+    //
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    NS_ASSERT_MSG(ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = lsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+    Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+    if (!router)
+    {
+        return;
+    }
+    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
+    NS_ASSERT(gr);
+    // walk through all available exit directions due to ECMP,
+    // and add host route for each of the exit direction toward
+    // the vertex 'v'
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
 
-        if (!rtr)
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " add network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = lsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all available exit directions due to ECMP,
-            // and add host route for each of the exit direction toward
-            // the vertex 'v'
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative " << outIf);
-                }
-            }
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative " << outIf);
         }
     }
 }
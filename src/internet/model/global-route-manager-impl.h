@@ -29,8 +29,10 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -672,6 +674,23 @@ class GlobalRouteManagerLSDB
      */
     uint32_t GetNumExtLSAs() const;
 
+    /**
+     * @brief Make a deep copy of the database, including the LSAs.
+     *
+     * The SPF calculation keeps its state in the LSAs, so each thread computing
+     * routes works on its own copy.
+     *
+     * @returns A new database, owned by the caller.
+     */
+    GlobalRouteManagerLSDB* Copy() const;
+
+    /**
+     * @brief Get the Router and Network Link State Advertisements.
+     *
+     * @returns The Link State Advertisements, in link state ID order.
+     */
+    std::vector<GlobalRoutingLSA*> GetLSAs() const;
+
   private:
     typedef std::map<Ipv4Address, GlobalRoutingLSA*>
         LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
@@ -681,6 +700,9 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+    mutable std::unordered_map<uint32_t, GlobalRoutingLSA*>
+        m_linkDataIndex;               //!< TransitNetwork link data to LSA, see GetLSAByLinkData ()
+    mutable bool m_linkDataIndexValid; //!< Whether m_linkDataIndex matches m_database
 };
 
 /**
@@ -725,6 +747,22 @@ class GlobalRouteManagerImpl
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Rebuild the routing database and update the routes of the
+     * routers whose shortest paths may have changed.
+     *
+     * The new Link State Advertisements are compared with those the current
+     * routes were computed from.  A router runs the SPF calculation again if
+     * its own LSA changed, if it is adjacent to a router whose LSA changed, or
+     * if a link that was added or removed is on one of its shortest paths.
+     * The routes of the other routers only change where the prefixes
+     * advertised by a changed router moved, and are patched in place.
+     *
+     * Changes of the Network or AS-external LSAs, or of the set of routers,
+     * fall back to the full recomputation of InitializeRoutes ().
+     */
+    virtual void UpdateRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -738,8 +776,82 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
+    /// Router ID to node, for the nodes with a GlobalRouter interface
+    typedef std::unordered_map<uint32_t, Ptr<Node>> RouterNodeMap_t;
+
     SPFVertex* m_spfroot;           //!< the root node
+    Ptr<Node> m_spfrootNode;        //!< the node at the root of the SPF tree, if any
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    std::shared_ptr<const RouterNodeMap_t> m_routerNodes; //!< router ID to node index
+    uint32_t m_nNodes; //!< number of nodes when m_routerNodes was built
+
+    /**
+     * \brief Index the nodes with a GlobalRouter interface by router ID.
+     *
+     * The SPF calculation needs the node at the root of the tree; looking it up
+     * here once avoids a walk of the NodeList for every vertex, and lets
+     * the worker threads of InitializeRoutes () share the index read-only.
+     */
+    void BuildRouterNodeIndex();
+
+    /**
+     * \brief Calculate the shortest path first trees of several roots on
+     * worker threads.
+     *
+     * Each worker runs SPFCalculate () with its own copy of the LSDB, and only
+     * writes to the routing table of its current root, so the routes are
+     * the same as with a sequential calculation.
+     *
+     * \param roots the router IDs of the roots
+     * \param threads the number of threads
+     */
+    void SPFCalculateParallel(const std::vector<Ipv4Address>& roots, uint32_t threads);
+
+    /**
+     * \brief Get the router IDs of the routers that compute their routes on
+     * this system.
+     *
+     * \returns the router IDs, in NodeList order
+     */
+    std::vector<Ipv4Address> GetRoots() const;
+
+    /**
+     * \brief Calculate the routes of several roots, on as many threads as
+     * the GlobalRoutingThreads global value asks for.
+     *
+     * \param roots the router IDs of the roots
+     */
+    void CalculateRoutes(const std::vector<Ipv4Address>& roots);
+
+    /**
+     * \brief Test if a node is a stub, from an OSPF sense, without
+     * installing any route.
+     *
+     * \param root the root node
+     * \param transitLink set to the only link of type 1 of the root, if any
+     * \param peerLink set to the link of type 1 back to the root in the LSA of
+     * the peer, if any
+     * \returns true if the node is a stub
+     */
+    bool IsStubNode(Ipv4Address root,
+                    GlobalRoutingLinkRecord*& transitLink,
+                    GlobalRoutingLinkRecord*& peerLink) const;
+
+    /**
+     * \brief Update the routes of a root to the prefixes advertised by a
+     * router whose shortest paths from the root did not change.
+     *
+     * The routes to the records of oldLsa that are gone are removed, and
+     * routes to the new records of newLsa are added, with the exits of the
+     * existing host routes to the router.
+     *
+     * \param gr the routing protocol of the root
+     * \param oldLsa the LSA the routes were computed from
+     * \param newLsa the new LSA of the router
+     * \returns false if the exits to the router could not be found, in which
+     * case the routes of the root must be computed again
+     */
+    bool PatchRoutes(Ptr<Ipv4GlobalRouting> gr, GlobalRoutingLSA* oldLsa, GlobalRoutingLSA* newLsa);
 
     /**
      * \brief Test if a node is a stub, from an OSPF sense.
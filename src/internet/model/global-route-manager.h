@@ -70,6 +70,18 @@ class GlobalRouteManager
      * per-node forwarding tables
      */
     static void InitializeRoutes();
+
+    /**
+     * @brief Rebuild the routing database and update the forwarding tables
+     * of the nodes affected by the Link State Advertisements that changed
+     * since the routes were last computed.
+     *
+     * The routes of the other nodes are left in place, or patched when only
+     * the prefixes advertised by a changed router moved.  The resulting
+     * forwarding tables are equivalent to those of DeleteGlobalRoutes(),
+     * BuildGlobalRoutingDatabase() and InitializeRoutes().
+     */
+    static void UpdateRoutes();
 };
 
 } // namespace ns3
@@ -255,14 +255,9 @@ GlobalRoutingLinkRecord*
 GlobalRoutingLSA::GetLinkRecord(uint32_t n) const
 {
     NS_LOG_FUNCTION(this << n);
-    uint32_t j = 0;
-    for (ListOfLinkRecords_t::const_iterator i = m_linkRecords.begin(); i != m_linkRecords.end();
-         i++, j++)
+    if (n < m_linkRecords.size())
     {
-        if (j == n)
-        {
-            return *i;
-        }
+        return m_linkRecords[n];
     }
     NS_ASSERT_MSG(false, "GlobalRoutingLSA::GetLinkRecord (): invalid index");
     return nullptr;
@@ -1132,9 +1127,10 @@ GlobalRouter::ProcessPointToPointLink(Ptr<NetDevice> ndLocal, GlobalRoutingLSA*
     // the second is a stub network record with the network number.
     //
     GlobalRoutingLinkRecord* plr;
-    if (ipv4Remote->IsUp(interfaceRemote))
+    if (ipv4Remote->IsUp(interfaceRemote) && ndLocal->IsLinkUp() && ndRemote->IsLinkUp())
     {
-        NS_LOG_LOGIC("Remote side interface " << interfaceRemote << " is up-- add a type 1 link");
+        NS_LOG_LOGIC("Remote side interface " << interfaceRemote
+                                              << " and link are up-- add a type 1 link");
 
         plr = new GlobalRoutingLinkRecord;
         NS_ABORT_MSG_IF(plr == nullptr,
@@ -33,6 +33,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -529,15 +530,16 @@ class GlobalRoutingLSA
     /**
      * A convenience typedef to avoid too much writers cramp.
      */
-    typedef std::list<GlobalRoutingLinkRecord*> ListOfLinkRecords_t;
+    typedef std::vector<GlobalRoutingLinkRecord*> ListOfLinkRecords_t;
 
     /**
      * Each Link State Advertisement contains a number of Link Records that
      * describe the kinds of links that are attached to a given node.  We
      * consider PointToPoint and StubNetwork links.
      *
-     * m_linkRecords is an STL list container to hold the Link Records that have
-     * been discovered and prepared for the advertisement.
+     * m_linkRecords is an STL vector container to hold the Link Records that have
+     * been discovered and prepared for the advertisement, so that GetLinkRecord ()
+     * is a constant time operation.
      *
      * @see GlobalRouting::DiscoverLSAs ()
      */
@@ -127,6 +127,15 @@ class Ipv4AddressGeneratorImpl
      */
     bool AddAllocated(const Ipv4Address addr);
 
+    /**
+     * \brief Add a contiguous block of addresses to the list of IPv4 entries
+     *
+     * \param low The first Ipv4Address of the block
+     * \param high The last Ipv4Address of the block
+     * \returns true on success
+     */
+    bool AddAllocatedRange(const Ipv4Address low, const Ipv4Address high);
+
     /**
      * \brief Check the Ipv4Address allocation in the list of IPv4 entries
      *
@@ -448,6 +457,70 @@ Ipv4AddressGeneratorImpl::AddAllocated(const Ipv4Address address)
     return true;
 }
 
+bool
+Ipv4AddressGeneratorImpl::AddAllocatedRange(const Ipv4Address low, const Ipv4Address high)
+{
+    NS_LOG_FUNCTION(this << low << high);
+
+    uint32_t addrLow = low.Get();
+    uint32_t addrHigh = high.Get();
+
+    NS_ABORT_MSG_UNLESS(addrLow && addrLow <= addrHigh,
+                        "Ipv4AddressGeneratorImpl::AddAllocatedRange(): Invalid range "
+                            << low << " to " << high);
+
+    //
+    // Find the first block that ends at or after the start of the new range,
+    // then check that the new range ends before that block starts.
+    //
+    std::list<Entry>::iterator i = m_entries.begin();
+    while (i != m_entries.end() && (*i).addrHigh < addrLow)
+    {
+        ++i;
+    }
+    if (i != m_entries.end() && (*i).addrLow <= addrHigh)
+    {
+        NS_LOG_LOGIC("Ipv4AddressGeneratorImpl::AddAllocatedRange(): Address Collision in "
+                     << low << " to " << high);
+        if (!m_test)
+        {
+            NS_FATAL_ERROR("Ipv4AddressGeneratorImpl::AddAllocatedRange(): Address Collision in "
+                           << low << " to " << high);
+        }
+        return false;
+    }
+
+    //
+    // Merge with the neighbouring blocks when they are adjacent.
+    //
+    if (i != m_entries.begin())
+    {
+        std::list<Entry>::iterator prev = i;
+        --prev;
+        if ((*prev).addrHigh + 1 == addrLow)
+        {
+            (*prev).addrHigh = addrHigh;
+            if (i != m_entries.end() && addrHigh + 1 == (*i).addrLow)
+            {
+                (*prev).addrHigh = (*i).addrHigh;
+                m_entries.erase(i);
+            }
+            return true;
+        }
+    }
+    if (i != m_entries.end() && addrHigh + 1 == (*i).addrLow)
+    {
+        (*i).addrLow = addrLow;
+        return true;
+    }
+
+    Entry entry;
+    entry.addrLow = addrLow;
+    entry.addrHigh = addrHigh;
+    m_entries.insert(i, entry);
+    return true;
+}
+
 bool
 Ipv4AddressGeneratorImpl::IsAddressAllocated(const Ipv4Address address)
 {
@@ -609,6 +682,14 @@ Ipv4AddressGenerator::AddAllocated(const Ipv4Address addr)
     return SimulationSingleton<Ipv4AddressGeneratorImpl>::Get()->AddAllocated(addr);
 }
 
+bool
+Ipv4AddressGenerator::AddAllocatedRange(const Ipv4Address low, const Ipv4Address high)
+{
+    NS_LOG_FUNCTION(low << high);
+
+    return SimulationSingleton<Ipv4AddressGeneratorImpl>::Get()->AddAllocatedRange(low, high);
+}
+
 bool
 Ipv4AddressGenerator::IsAddressAllocated(const Ipv4Address addr)
 {
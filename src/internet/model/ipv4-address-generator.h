@@ -125,6 +125,19 @@ class Ipv4AddressGenerator
      */
     static bool AddAllocated(const Ipv4Address addr);
 
+    /**
+     * \brief Add a contiguous block of addresses to the list of IPv4 entries
+     *
+     * Equivalent to calling AddAllocated for every address in [low, high],
+     * but the block is checked and recorded in a single pass.  Used by bulk
+     * allocators such as Ipv4AddressHelper::AssignPointToPoint.
+     *
+     * \param low The first Ipv4Address of the block
+     * \param high The last Ipv4Address of the block
+     * \returns true on success
+     */
+    static bool AddAllocatedRange(const Ipv4Address low, const Ipv4Address high);
+
     /**
      * \brief Check the Ipv4Address allocation in the list of IPv4 entries
      *
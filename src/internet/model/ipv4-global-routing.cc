@@ -30,7 +30,9 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <tuple>
 #include <vector>
 
 namespace ns3
@@ -40,6 +42,29 @@ NS_LOG_COMPONENT_DEFINE("Ipv4GlobalRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4GlobalRouting);
 
+/**
+ * \brief The network mask of a prefix length.
+ * \param length the prefix length
+ * \return the mask
+ */
+static uint32_t
+PrefixMask(uint8_t length)
+{
+    return length == 0 ? 0 : 0xffffffffU << (32 - length);
+}
+
+/**
+ * \brief The bit of an address following a prefix.
+ * \param addr the address
+ * \param length the prefix length, lower than 32
+ * \return the bit, 0 or 1
+ */
+static uint32_t
+NextBit(uint32_t addr, uint8_t length)
+{
+    return (addr >> (31 - length)) & 1;
+}
+
 TypeId
 Ipv4GlobalRouting::GetTypeId()
 {
@@ -58,13 +83,22 @@ Ipv4GlobalRouting::GetTypeId()
                           "Interface notification events (up/down, or add/remove address)",
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_respondToInterfaceEvents),
+                          MakeBooleanChecker())
+            .AddAttribute("IncrementalRecompute",
+                          "Set to true if the response to interface and link events should only "
+                          "update the global routes affected by the change "
+                          "(see Ipv4GlobalRoutingHelper::UpdateRoutingTables)",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&Ipv4GlobalRouting::m_incrementalRecompute),
                           MakeBooleanChecker());
     return tid;
 }
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_respondToInterfaceEvents(false),
+      m_incrementalRecompute(false),
+      m_indexValid(false)
 {
     NS_LOG_FUNCTION(this);
 
@@ -83,6 +117,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    m_indexValid = false;
 }
 
 void
@@ -92,6 +127,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    m_indexValid = false;
 }
 
 void
@@ -101,18 +137,24 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
                                      uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    NS_ASSERT_MSG(networkMask.Get() == PrefixMask(networkMask.GetPrefixLength()),
+                  "Non-contiguous network mask " << networkMask);
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    m_indexValid = false;
 }
 
 void
 Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask, uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << interface);
+    NS_ASSERT_MSG(networkMask.Get() == PrefixMask(networkMask.GetPrefixLength()),
+                  "Non-contiguous network mask " << networkMask);
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    m_indexValid = false;
 }
 
 void
@@ -122,9 +164,12 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
                                         uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    NS_ASSERT_MSG(networkMask.Get() == PrefixMask(networkMask.GetPrefixLength()),
+                  "Non-contiguous network mask " << networkMask);
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    m_indexValid = false;
 }
 
 Ptr<Ipv4Route>
@@ -132,74 +177,80 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
 {
     NS_LOG_FUNCTION(this << dest << oif);
     NS_LOG_LOGIC("Looking for route for destination " << dest);
-    Ptr<Ipv4Route> rtentry = nullptr;
-    // store all available routes that bring packets to their destination
-    typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
-    RouteVec_t allRoutes;
+    if (!m_indexValid)
+    {
+        BuildIndex();
+    }
+    // the range of m_indexRoutes holding all available routes that bring
+    // packets to their destination, and the number of them on oif
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    uint32_t nRoutes = 0;
 
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (HostRoutesCI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    auto host = m_hostIndex.find(dest.Get());
+    if (host != m_hostIndex.end())
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        begin = host->second.first;
+        end = host->second.second;
+        nRoutes = CountRoutes(begin, end, oif);
+        NS_LOG_LOGIC(nRoutes << " global host routes found");
+    }
+    if (nRoutes == 0) // if no host route is found
+    {
+        //
+        // Walk down the trie along the destination address; path holds the
+        // nodes of the matching prefixes, shortest first.
+        //
+        int32_t path[33];
+        uint32_t depth = 0;
+        uint32_t addr = dest.Get();
+        for (int32_t i = 0; i >= 0;)
         {
-            if (oif)
+            const PrefixNode& node = m_trie[i];
+            if ((addr & PrefixMask(node.length)) != node.prefix)
             {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
+                break;
             }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
+            path[depth++] = i;
+            i = node.length < 32 ? node.child[NextBit(addr, node.length)] : -1;
         }
-    }
-    if (allRoutes.empty()) // if no host route is found
-    {
+
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+        for (uint32_t d = depth; d-- > 0 && nRoutes == 0;)
         {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
-            {
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
-            }
+            const PrefixNode& node = m_trie[path[d]];
+            begin = node.networkBegin;
+            end = node.networkEnd;
+            nRoutes = CountRoutes(begin, end, oif);
         }
-    }
-    if (allRoutes.empty()) // consider external if no host/network found
-    {
-        for (ASExternalRoutesI k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
+        if (nRoutes == 0) // consider external if no host/network found
         {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+            for (uint32_t d = 0; d < depth; d++)
             {
-                NS_LOG_LOGIC("Found external route" << *k);
-                if (oif)
+                const PrefixNode& node = m_trie[path[d]];
+                for (uint32_t k = node.externalBegin; k < node.externalEnd; k++)
                 {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
+                    if (CountRoutes(k, k + 1, oif) == 1)
                     {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
+                        // keep the first matching route, in the order of m_ASexternalRoutes
+                        if (nRoutes == 0 || m_indexRank[k] < m_indexRank[begin])
+                        {
+                            begin = k;
+                            end = k + 1;
+                            nRoutes = 1;
+                        }
+                        break;
                     }
                 }
-                allRoutes.push_back(*k);
-                break;
             }
         }
+        else
+        {
+            NS_LOG_LOGIC(nRoutes << " global network routes found");
+        }
     }
-    if (!allRoutes.empty()) // if route(s) is found
+    if (nRoutes > 0) // if route(s) is found
     {
         // pick up one of the routes uniformly at random if random
         // ECMP routing is enabled, or always select the first route
@@ -207,15 +258,15 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
         uint32_t selectIndex;
         if (m_randomEcmpRouting)
         {
-            selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
+            selectIndex = m_rand->GetInteger(0, nRoutes - 1);
         }
         else
         {
             selectIndex = 0;
         }
-        Ipv4RoutingTableEntry* route = allRoutes.at(selectIndex);
+        Ipv4RoutingTableEntry* route = SelectRoute(begin, end, oif, selectIndex);
         // create a Ipv4Route object from the selected routing table entry
-        rtentry = Create<Ipv4Route>();
+        Ptr<Ipv4Route> rtentry = Create<Ipv4Route>();
         rtentry->SetDestination(route->GetDest());
         /// \todo handle multi-address case
         rtentry->SetSource(m_ipv4->GetAddress(route->GetInterface(), 0).GetLocal());
@@ -230,6 +281,186 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     }
 }
 
+uint32_t
+Ipv4GlobalRouting::CountRoutes(uint32_t begin, uint32_t end, Ptr<NetDevice> oif) const
+{
+    if (!oif)
+    {
+        return end - begin;
+    }
+    uint32_t n = 0;
+    for (uint32_t k = begin; k < end; k++)
+    {
+        if (oif == m_ipv4->GetNetDevice(m_indexRoutes[k]->GetInterface()))
+        {
+            n++;
+        }
+        else
+        {
+            NS_LOG_LOGIC("Not on requested interface, skipping");
+        }
+    }
+    return n;
+}
+
+Ipv4RoutingTableEntry*
+Ipv4GlobalRouting::SelectRoute(uint32_t begin, uint32_t end, Ptr<NetDevice> oif, uint32_t n) const
+{
+    if (!oif)
+    {
+        return m_indexRoutes[begin + n];
+    }
+    for (uint32_t k = begin; k < end; k++)
+    {
+        if (oif == m_ipv4->GetNetDevice(m_indexRoutes[k]->GetInterface()) && n-- == 0)
+        {
+            return m_indexRoutes[k];
+        }
+    }
+    NS_ASSERT(false);
+    return nullptr;
+}
+
+void
+Ipv4GlobalRouting::BuildIndex()
+{
+    NS_LOG_FUNCTION(this);
+    /// A route and the position in its list, to be sorted by destination
+    struct IndexedRoute
+    {
+        uint32_t prefix;              //!< destination, masked by the prefix length
+        uint8_t length;               //!< prefix length
+        uint32_t rank;                //!< position in the list of routes
+        Ipv4RoutingTableEntry* route; //!< the route
+
+        /**
+         * \brief Order by destination, then by position in the list.
+         * \param o the other route
+         * \return true if this route comes first
+         */
+        bool operator<(const IndexedRoute& o) const
+        {
+            return std::tie(length, prefix, rank) < std::tie(o.length, o.prefix, o.rank);
+        }
+    };
+
+    m_indexRoutes.clear();
+    m_indexRank.clear();
+    m_hostIndex.clear();
+    m_trie.clear();
+    m_trie.push_back({0, 0, {-1, -1}, 0, 0, 0, 0});
+
+    //
+    // Each list is sorted by destination into m_indexRoutes; the routes to
+    // the same destination keep their relative order, which is the ECMP order.
+    //
+    std::vector<IndexedRoute> sorted;
+    auto addSorted = [this, &sorted]() {
+        std::sort(sorted.begin(), sorted.end());
+        for (const IndexedRoute& r : sorted)
+        {
+            m_indexRoutes.push_back(r.route);
+            m_indexRank.push_back(r.rank);
+        }
+    };
+
+    uint32_t rank = 0;
+    for (HostRoutesCI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    {
+        sorted.push_back({(*i)->GetDest().Get(), 32, rank++, *i});
+    }
+    addSorted();
+    for (uint32_t k = 0; k < m_indexRoutes.size(); k++)
+    {
+        auto host = m_hostIndex.emplace(sorted[k].prefix, std::make_pair(k, k)).first;
+        host->second.second = k + 1;
+    }
+
+    sorted.clear();
+    rank = 0;
+    for (NetworkRoutesCI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    {
+        uint8_t length = (*j)->GetDestNetworkMask().GetPrefixLength();
+        sorted.push_back({(*j)->GetDestNetwork().Get() & PrefixMask(length), length, rank++, *j});
+    }
+    uint32_t base = m_indexRoutes.size();
+    addSorted();
+    for (uint32_t k = base; k < m_indexRoutes.size(); k++)
+    {
+        const IndexedRoute& r = sorted[k - base];
+        int32_t node = InsertPrefix(r.prefix, r.length);
+        if (m_trie[node].networkBegin == m_trie[node].networkEnd)
+        {
+            m_trie[node].networkBegin = k;
+        }
+        m_trie[node].networkEnd = k + 1;
+    }
+
+    sorted.clear();
+    rank = 0;
+    for (ASExternalRoutesCI l = m_ASexternalRoutes.begin(); l != m_ASexternalRoutes.end(); l++)
+    {
+        uint8_t length = (*l)->GetDestNetworkMask().GetPrefixLength();
+        sorted.push_back({(*l)->GetDestNetwork().Get() & PrefixMask(length), length, rank++, *l});
+    }
+    base = m_indexRoutes.size();
+    addSorted();
+    for (uint32_t k = base; k < m_indexRoutes.size(); k++)
+    {
+        const IndexedRoute& r = sorted[k - base];
+        int32_t node = InsertPrefix(r.prefix, r.length);
+        if (m_trie[node].externalBegin == m_trie[node].externalEnd)
+        {
+            m_trie[node].externalBegin = k;
+        }
+        m_trie[node].externalEnd = k + 1;
+    }
+    m_indexValid = true;
+}
+
+int32_t
+Ipv4GlobalRouting::InsertPrefix(uint32_t prefix, uint8_t length)
+{
+    //
+    // Walk down from the root along the prefix.  Each node on the way is a
+    // prefix of the new one; a child that only shares part of its prefix
+    // is split at the first differing bit.
+    //
+    int32_t i = 0;
+    while (m_trie[i].length != length)
+    {
+        uint32_t bit = NextBit(prefix, m_trie[i].length);
+        int32_t c = m_trie[i].child[bit];
+        if (c < 0)
+        {
+            c = m_trie.size();
+            m_trie.push_back({prefix, length, {-1, -1}, 0, 0, 0, 0});
+            m_trie[i].child[bit] = c;
+            return c;
+        }
+        uint8_t common = std::min(length, m_trie[c].length);
+        uint32_t diff = prefix ^ m_trie[c].prefix;
+        for (uint8_t b = m_trie[i].length; b < common; b++)
+        {
+            if (NextBit(diff, b))
+            {
+                common = b;
+                break;
+            }
+        }
+        if (common < m_trie[c].length)
+        {
+            int32_t split = m_trie.size();
+            m_trie.push_back({prefix & PrefixMask(common), common, {-1, -1}, 0, 0, 0, 0});
+            m_trie[split].child[NextBit(m_trie[c].prefix, common)] = c;
+            m_trie[i].child[bit] = split;
+            c = split;
+        }
+        i = c;
+    }
+    return i;
+}
+
 uint32_t
 Ipv4GlobalRouting::GetNRoutes() const
 {
@@ -289,6 +520,7 @@ void
 Ipv4GlobalRouting::RemoveRoute(uint32_t index)
 {
     NS_LOG_FUNCTION(this << index);
+    m_indexValid = false;
     if (index < m_hostRoutes.size())
     {
         uint32_t tmp = 0;
@@ -339,6 +571,62 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
     NS_ASSERT(false);
 }
 
+std::vector<Ipv4RoutingTableEntry*>
+Ipv4GlobalRouting::GetHostRoutesTo(Ipv4Address dest) const
+{
+    NS_LOG_FUNCTION(this << dest);
+    std::vector<Ipv4RoutingTableEntry*> routes;
+    if (m_indexValid)
+    {
+        auto host = m_hostIndex.find(dest.Get());
+        if (host != m_hostIndex.end())
+        {
+            routes.assign(m_indexRoutes.begin() + host->second.first,
+                          m_indexRoutes.begin() + host->second.second);
+        }
+        return routes;
+    }
+    for (HostRoutesCI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    {
+        if ((*i)->GetDest() == dest)
+        {
+            routes.push_back(*i);
+        }
+    }
+    return routes;
+}
+
+uint32_t
+Ipv4GlobalRouting::RemoveRoutes(std::function<bool(const Ipv4RoutingTableEntry&)> match)
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t n = 0;
+    auto removeFrom = [&match, &n](std::list<Ipv4RoutingTableEntry*>& routes) {
+        for (auto i = routes.begin(); i != routes.end();)
+        {
+            if (match(**i))
+            {
+                delete *i;
+                i = routes.erase(i);
+                n++;
+            }
+            else
+            {
+                i++;
+            }
+        }
+    };
+    removeFrom(m_hostRoutes);
+    removeFrom(m_networkRoutes);
+    removeFrom(m_ASexternalRoutes);
+    if (n > 0)
+    {
+        m_indexValid = false;
+    }
+    NS_LOG_LOGIC("Removed " << n << " routes");
+    return n;
+}
+
 int64_t
 Ipv4GlobalRouting::AssignStreams(int64_t stream)
 {
@@ -365,6 +653,11 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_indexRoutes.clear();
+    m_indexRank.clear();
+    m_hostIndex.clear();
+    m_trie.clear();
+    m_indexValid = false;
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -531,47 +824,67 @@ void
 Ipv4GlobalRouting::NotifyInterfaceUp(uint32_t i)
 {
     NS_LOG_FUNCTION(this << i);
-    if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
+    //
+    // Watch the link of the device as well: a link going down, or back up,
+    // changes the topology without any interface event.
+    //
+    if (i >= m_watchedInterfaces.size())
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        m_watchedInterfaces.resize(i + 1, false);
     }
+    Ptr<NetDevice> device = m_ipv4->GetNetDevice(i);
+    if (!m_watchedInterfaces[i] && device)
+    {
+        device->AddLinkChangeCallback(MakeCallback(&Ipv4GlobalRouting::NotifyLinkChange, this));
+        m_watchedInterfaces[i] = true;
+    }
+    RecomputeRoutes();
 }
 
 void
 Ipv4GlobalRouting::NotifyInterfaceDown(uint32_t i)
 {
     NS_LOG_FUNCTION(this << i);
-    if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
-    {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
-    }
+    RecomputeRoutes();
 }
 
 void
 Ipv4GlobalRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address)
 {
     NS_LOG_FUNCTION(this << interface << address);
-    if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
-    {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
-    }
+    RecomputeRoutes();
 }
 
 void
 Ipv4GlobalRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address)
 {
     NS_LOG_FUNCTION(this << interface << address);
+    RecomputeRoutes();
+}
+
+void
+Ipv4GlobalRouting::NotifyLinkChange()
+{
+    NS_LOG_FUNCTION(this);
+    RecomputeRoutes();
+}
+
+void
+Ipv4GlobalRouting::RecomputeRoutes()
+{
+    NS_LOG_FUNCTION(this);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        if (m_incrementalRecompute)
+        {
+            GlobalRouteManager::UpdateRoutes();
+        }
+        else
+        {
+            GlobalRouteManager::DeleteGlobalRoutes();
+            GlobalRouteManager::BuildGlobalRoutingDatabase();
+            GlobalRouteManager::InitializeRoutes();
+        }
     }
 }
 
@@ -26,8 +26,12 @@
 #include "ns3/ptr.h"
 #include "ns3/random-variable-stream.h"
 
+#include <functional>
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -65,6 +69,17 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * The routes are kept in lists, in the order they were added, and indexed
+ * for the lookups: a hash table maps a destination to its host routes, and
+ * a path-compressed binary trie (Patricia trie) of the network prefixes
+ * holds the network and external routes.  The index is rebuilt on the first
+ * lookup after the routes change.  Host routes take precedence over network
+ * routes, and the longest matching network prefix wins; the routes to
+ * that destination or prefix are the ECMP candidates, in the order they were
+ * added.  External routes are only considered if no other route matches,
+ * and the first matching one, in the order they were added, is used.
+ * Network masks must be contiguous.
+ *
  * \see Ipv4RoutingProtocol
  * \see GlobalRouteManager
  */
@@ -221,6 +236,23 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     void RemoveRoute(uint32_t i);
 
+    /**
+     * \brief Get the host routes to a destination.
+     *
+     * \param dest The destination.
+     * \return The host routes to dest, in the order they were added.
+     */
+    std::vector<Ipv4RoutingTableEntry*> GetHostRoutesTo(Ipv4Address dest) const;
+
+    /**
+     * \brief Remove the routes matched by a predicate, in a single walk of the
+     * routing table.
+     *
+     * \param match The predicate, called once per route in table order.
+     * \return The number of routes removed.
+     */
+    uint32_t RemoveRoutes(std::function<bool(const Ipv4RoutingTableEntry&)> match);
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -241,6 +273,11 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// Set to true if this interface should respond to interface events by globallly recomputing
     /// routes
     bool m_respondToInterfaceEvents;
+    /// Set to true if the response to interface and link events only updates the routes
+    /// affected by the change
+    bool m_incrementalRecompute;
+    /// Interfaces whose device link changes are watched
+    std::vector<bool> m_watchedInterfaces;
     /// A uniform random number generator for randomly routing packets among ECMP
     Ptr<UniformRandomVariable> m_rand;
 
@@ -273,10 +310,79 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
+    /**
+     * \brief Recompute the global routes after an interface or link event,
+     * if RespondToInterfaceEvents is set.
+     */
+    void RecomputeRoutes();
+
+    /**
+     * \brief Called when the link of a device with an interface changes.
+     */
+    void NotifyLinkChange();
+
+    /// A node of the trie of network prefixes
+    struct PrefixNode
+    {
+        uint32_t prefix;        //!< network address, masked by the prefix length
+        uint8_t length;         //!< prefix length
+        int32_t child[2];       //!< index of the child for the next bit, or -1
+        uint32_t networkBegin;  //!< first network route of the prefix in m_indexRoutes
+        uint32_t networkEnd;    //!< past the last network route of the prefix
+        uint32_t externalBegin; //!< first external route of the prefix in m_indexRoutes
+        uint32_t externalEnd;   //!< past the last external route of the prefix
+    };
+
+    /**
+     * \brief Rebuild the lookup index from the lists of routes.
+     */
+    void BuildIndex();
+
+    /**
+     * \brief Find or add the trie node of a network prefix.
+     * \param prefix the network address, masked by the prefix length
+     * \param length the prefix length
+     * \return the index of the node in m_trie
+     */
+    int32_t InsertPrefix(uint32_t prefix, uint8_t length);
+
+    /**
+     * \brief Count the indexed routes leaving through an output device.
+     * \param begin first route in m_indexRoutes
+     * \param end past the last route in m_indexRoutes
+     * \param oif output device, or 0 for any
+     * \return the number of routes
+     */
+    uint32_t CountRoutes(uint32_t begin, uint32_t end, Ptr<NetDevice> oif) const;
+
+    /**
+     * \brief Get an indexed route leaving through an output device.
+     * \param begin first route in m_indexRoutes
+     * \param end past the last route in m_indexRoutes
+     * \param oif output device, or 0 for any
+     * \param n the rank of the route among those leaving through oif
+     * \return the route
+     */
+    Ipv4RoutingTableEntry* SelectRoute(uint32_t begin,
+                                       uint32_t end,
+                                       Ptr<NetDevice> oif,
+                                       uint32_t n) const;
+
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    /// Indexed routes, grouped by destination or prefix
+    std::vector<Ipv4RoutingTableEntry*> m_indexRoutes;
+    /// Position in m_ASexternalRoutes of each indexed route (external routes only)
+    std::vector<uint32_t> m_indexRank;
+    /// Host destination to range of its routes in m_indexRoutes
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> m_hostIndex;
+    /// Trie of the network prefixes, rooted at index 0 (0.0.0.0/0)
+    std::vector<PrefixNode> m_trie;
+    /// Whether the index matches the lists of routes
+    bool m_indexValid;
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
@@ -0,0 +1,499 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ipv4-next-hop-routing.h"
+
+#include "ipv4-list-routing.h"
+#include "ipv4-route.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/channel.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ipv4NextHopRouting");
+
+NS_OBJECT_ENSURE_REGISTERED(Ipv4NextHopRouting);
+
+const uint16_t Ipv4NextHopRouting::NO_ROUTE;
+
+/**
+ * \ingroup ipv4Routing
+ * The number of threads computing the next-hop tables, see
+ * Ipv4NextHopRouting::PopulateRoutingTables ().
+ */
+static GlobalValue g_nextHopRoutingThreads(
+    "NextHopRoutingThreads",
+    "The number of threads computing the next-hop tables (0 for one per hardware thread)",
+    UintegerValue(1),
+    MakeUintegerChecker<uint32_t>());
+
+/**
+ * \ingroup ipv4Routing
+ * Whether only the nodes with applications are destinations in the next-hop
+ * tables, see Ipv4NextHopRouting::PopulateRoutingTables ().
+ */
+static GlobalValue g_nextHopRoutingApplicationNodesOnly(
+    "NextHopRoutingApplicationNodesOnly",
+    "Only keep the next hops to the nodes with applications",
+    BooleanValue(false),
+    MakeBooleanChecker());
+
+TypeId
+Ipv4NextHopRouting::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::Ipv4NextHopRouting")
+                            .SetParent<Ipv4RoutingProtocol>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<Ipv4NextHopRouting>();
+    return tid;
+}
+
+Ipv4NextHopRouting::Ipv4NextHopRouting()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ipv4NextHopRouting::~Ipv4NextHopRouting()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+Ipv4NextHopRouting::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_ipv4 = nullptr;
+    m_destinations = nullptr;
+    m_nextHops.clear();
+    m_table.clear();
+    Ipv4RoutingProtocol::DoDispose();
+}
+
+/**
+ * \brief Get the Ipv4NextHopRouting protocol of a node, if any.
+ * \param ipv4 the Ipv4 of the node
+ * \returns the protocol, or 0
+ */
+static Ptr<Ipv4NextHopRouting>
+GetNextHopRouting(Ptr<Ipv4> ipv4)
+{
+    Ptr<Ipv4RoutingProtocol> protocol = ipv4->GetRoutingProtocol();
+    Ptr<Ipv4NextHopRouting> routing = DynamicCast<Ipv4NextHopRouting>(protocol);
+    Ptr<Ipv4ListRouting> list = DynamicCast<Ipv4ListRouting>(protocol);
+    for (uint32_t i = 0; !routing && list && i < list->GetNRoutingProtocols(); i++)
+    {
+        int16_t priority;
+        routing = DynamicCast<Ipv4NextHopRouting>(list->GetRoutingProtocol(i, priority));
+    }
+    return routing;
+}
+
+void
+Ipv4NextHopRouting::PopulateRoutingTables()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    const uint32_t nNodes = NodeList::GetNNodes();
+    BooleanValue applicationNodesOnly;
+    g_nextHopRoutingApplicationNodesOnly.GetValue(applicationNodesOnly);
+
+    //
+    // Index the destination nodes, and their addresses.
+    //
+    std::vector<Ptr<Ipv4>> ipv4s(nNodes);
+    std::vector<Ptr<Ipv4NextHopRouting>> routings(nNodes);
+    std::vector<uint32_t> destinations; // node of each destination index
+    auto destinationMap = std::make_shared<DestinationMap_t>();
+    for (uint32_t n = 0; n < nNodes; n++)
+    {
+        Ptr<Node> node = NodeList::GetNode(n);
+        ipv4s[n] = node->GetObject<Ipv4>();
+        if (!ipv4s[n])
+        {
+            continue;
+        }
+        routings[n] = GetNextHopRouting(ipv4s[n]);
+        if (applicationNodesOnly.Get() && node->GetNApplications() == 0)
+        {
+            continue;
+        }
+        for (uint32_t i = 0; i < ipv4s[n]->GetNInterfaces(); i++)
+        {
+            for (uint32_t j = 0; j < ipv4s[n]->GetNAddresses(i); j++)
+            {
+                Ipv4Address local = ipv4s[n]->GetAddress(i, j).GetLocal();
+                if (!local.IsLocalhost())
+                {
+                    destinationMap->emplace(local.Get(), destinations.size());
+                }
+            }
+        }
+        destinations.push_back(n);
+    }
+
+    //
+    // Find the links from the nodes that forward with an Ipv4NextHopRouting.
+    // The searches go from the destinations, on the reversed links.
+    //
+    struct Link
+    {
+        uint32_t from;    //!< The node at the start of the link
+        uint16_t nextHop; //!< The index of the link in the next hops of that node
+        uint16_t metric;  //!< The metric of the output interface
+    };
+
+    std::vector<std::vector<Link>> in(nNodes);
+    bool unitMetrics = true;
+    for (uint32_t n = 0; n < nNodes; n++)
+    {
+        if (!routings[n])
+        {
+            continue;
+        }
+        Ptr<Ipv4> ipv4 = ipv4s[n];
+        std::vector<NextHop> nextHops;
+        for (uint32_t i = 0; i < ipv4->GetNInterfaces(); i++)
+        {
+            Ptr<NetDevice> device = ipv4->GetNetDevice(i);
+            Ptr<Channel> channel = device->GetChannel();
+            if (!ipv4->IsUp(i) || !channel || !device->IsLinkUp())
+            {
+                continue;
+            }
+            for (std::size_t k = 0; k < channel->GetNDevices(); k++)
+            {
+                Ptr<NetDevice> peer = channel->GetDevice(k);
+                if (peer == device)
+                {
+                    continue;
+                }
+                uint32_t m = peer->GetNode()->GetId();
+                Ptr<Ipv4> peerIpv4 = ipv4s[m];
+                int32_t peerInterface = peerIpv4 ? peerIpv4->GetInterfaceForDevice(peer) : -1;
+                if (peerInterface < 0 || !peerIpv4->IsUp(peerInterface) ||
+                    peerIpv4->GetNAddresses(peerInterface) == 0)
+                {
+                    continue;
+                }
+                NS_ABORT_MSG_IF(nextHops.size() >= NO_ROUTE,
+                                "Too many neighbors on node " << n << " for Ipv4NextHopRouting");
+                in[m].push_back({n,
+                                 static_cast<uint16_t>(nextHops.size()),
+                                 ipv4->GetMetric(i)});
+                unitMetrics = unitMetrics && ipv4->GetMetric(i) == 1;
+                nextHops.push_back({i, peerIpv4->GetAddress(peerInterface, 0).GetLocal()});
+            }
+        }
+        routings[n]->m_nextHops = std::move(nextHops);
+        routings[n]->m_table.assign(destinations.size(), NO_ROUTE);
+        routings[n]->m_destinations = destinationMap;
+    }
+
+    //
+    // One search per destination.  Each search only writes the table entries
+    // of its destination, so the searches can run on several threads.
+    //
+    auto search = [&](uint32_t d, std::vector<uint64_t>& distance) {
+        const uint64_t unreachable = std::numeric_limits<uint64_t>::max();
+        std::fill(distance.begin(), distance.end(), unreachable);
+        uint32_t target = destinations[d];
+        distance[target] = 0;
+        if (unitMetrics)
+        {
+            std::queue<uint32_t> queue;
+            queue.push(target);
+            while (!queue.empty())
+            {
+                uint32_t v = queue.front();
+                queue.pop();
+                for (const Link& link : in[v])
+                {
+                    if (distance[link.from] == unreachable)
+                    {
+                        distance[link.from] = distance[v] + 1;
+                        routings[link.from]->m_table[d] = link.nextHop;
+                        queue.push(link.from);
+                    }
+                }
+            }
+            return;
+        }
+        typedef std::pair<uint64_t, uint32_t> Item_t;
+        std::priority_queue<Item_t, std::vector<Item_t>, std::greater<Item_t>> queue;
+        queue.emplace(0, target);
+        while (!queue.empty())
+        {
+            Item_t item = queue.top();
+            queue.pop();
+            if (item.first > distance[item.second])
+            {
+                continue;
+            }
+            for (const Link& link : in[item.second])
+            {
+                uint64_t d2 = item.first + link.metric;
+                if (d2 < distance[link.from])
+                {
+                    distance[link.from] = d2;
+                    routings[link.from]->m_table[d] = link.nextHop;
+                    queue.emplace(d2, link.from);
+                }
+            }
+        }
+    };
+
+    UintegerValue threadsValue;
+    g_nextHopRoutingThreads.GetValue(threadsValue);
+    uint32_t threads = threadsValue.Get();
+    if (threads == 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = std::min<std::size_t>(threads, destinations.size());
+    NS_LOG_INFO("Computing the next hops to " << destinations.size() << " of " << nNodes
+                                              << " nodes on " << threads << " threads");
+    if (threads <= 1)
+    {
+        std::vector<uint64_t> distance(nNodes);
+        for (uint32_t d = 0; d < destinations.size(); d++)
+        {
+            search(d, distance);
+        }
+        return;
+    }
+    std::atomic<uint32_t> next(0);
+    std::vector<std::thread> pool;
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        pool.emplace_back([&]() {
+            std::vector<uint64_t> distance(nNodes);
+            for (uint32_t d = next++; d < destinations.size(); d = next++)
+            {
+                search(d, distance);
+            }
+        });
+    }
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+}
+
+bool
+Ipv4NextHopRouting::LookupNextHop(Ipv4Address dest,
+                                  uint32_t& interface,
+                                  Ipv4Address& gateway) const
+{
+    NS_LOG_FUNCTION(this << dest);
+    if (!m_destinations)
+    {
+        return false;
+    }
+    auto d = m_destinations->find(dest.Get());
+    if (d == m_destinations->end() || m_table[d->second] == NO_ROUTE)
+    {
+        NS_LOG_LOGIC("No next hop to " << dest);
+        return false;
+    }
+    const NextHop& nextHop = m_nextHops[m_table[d->second]];
+    interface = nextHop.interface;
+    gateway = nextHop.gateway;
+    return true;
+}
+
+Ptr<Ipv4Route>
+Ipv4NextHopRouting::RouteOutput(Ptr<Packet> p,
+                                const Ipv4Header& header,
+                                Ptr<NetDevice> oif,
+                                Socket::SocketErrno& sockerr)
+{
+    NS_LOG_FUNCTION(this << p << &header << oif << &sockerr);
+    Ipv4Address dest = header.GetDestination();
+    uint32_t interface;
+    Ipv4Address gateway;
+    if (dest.IsMulticast() || !LookupNextHop(dest, interface, gateway) ||
+        (oif && oif != m_ipv4->GetNetDevice(interface)))
+    {
+        sockerr = Socket::ERROR_NOROUTETOHOST;
+        return nullptr;
+    }
+    Ptr<Ipv4Route> rtentry = Create<Ipv4Route>();
+    rtentry->SetDestination(dest);
+    rtentry->SetSource(m_ipv4->GetAddress(interface, 0).GetLocal());
+    rtentry->SetGateway(gateway);
+    rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interface));
+    sockerr = Socket::ERROR_NOTERROR;
+    return rtentry;
+}
+
+bool
+Ipv4NextHopRouting::RouteInput(Ptr<const Packet> p,
+                               const Ipv4Header& header,
+                               Ptr<const NetDevice> idev,
+                               const UnicastForwardCallback& ucb,
+                               const MulticastForwardCallback& mcb,
+                               const LocalDeliverCallback& lcb,
+                               const ErrorCallback& ecb)
+{
+    NS_LOG_FUNCTION(this << p << header << header.GetSource() << header.GetDestination() << idev
+                         << &lcb << &ecb);
+    // Check if input device supports IP
+    NS_ASSERT(m_ipv4->GetInterfaceForDevice(idev) >= 0);
+    uint32_t iif = m_ipv4->GetInterfaceForDevice(idev);
+
+    if (m_ipv4->IsDestinationAddress(header.GetDestination(), iif))
+    {
+        if (!lcb.IsNull())
+        {
+            NS_LOG_LOGIC("Local delivery to " << header.GetDestination());
+            lcb(p, header, iif);
+            return true;
+        }
+        // The local delivery callback is null.  This may be a multicast
+        // or broadcast packet, so return false so that another
+        // multicast routing protocol can handle it.
+        return false;
+    }
+
+    // Check if input device supports IP forwarding
+    if (!m_ipv4->IsForwarding(iif))
+    {
+        NS_LOG_LOGIC("Forwarding disabled for this interface");
+        ecb(p, header, Socket::ERROR_NOROUTETOHOST);
+        return true;
+    }
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> rtentry = RouteOutput(nullptr, header, nullptr, sockerr);
+    if (rtentry)
+    {
+        NS_LOG_LOGIC("Found next hop- calling unicast callback");
+        ucb(rtentry, p, header);
+        return true;
+    }
+    NS_LOG_LOGIC("Did not find next hop- returning false");
+    return false; // Let other routing protocols try to handle this
+}
+
+void
+Ipv4NextHopRouting::NotifyInterfaceUp(uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << interface);
+}
+
+void
+Ipv4NextHopRouting::NotifyInterfaceDown(uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << interface);
+}
+
+void
+Ipv4NextHopRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address)
+{
+    NS_LOG_FUNCTION(this << interface << address);
+}
+
+void
+Ipv4NextHopRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address)
+{
+    NS_LOG_FUNCTION(this << interface << address);
+}
+
+void
+Ipv4NextHopRouting::SetIpv4(Ptr<Ipv4> ipv4)
+{
+    NS_LOG_FUNCTION(this << ipv4);
+    NS_ASSERT(!m_ipv4 && ipv4);
+    m_ipv4 = ipv4;
+}
+
+void
+Ipv4NextHopRouting::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit) const
+{
+    NS_LOG_FUNCTION(this << stream);
+    std::ostream* os = stream->GetStream();
+    // Copy the current ostream state
+    std::ios oldState(nullptr);
+    oldState.copyfmt(*os);
+
+    *os << std::resetiosflags(std::ios::adjustfield) << std::setiosflags(std::ios::left);
+
+    *os << "Node: " << m_ipv4->GetObject<Node>()->GetId() << ", Time: " << Now().As(unit)
+        << ", Local time: " << m_ipv4->GetObject<Node>()->GetLocalTime().As(unit)
+        << ", Ipv4NextHopRouting table" << std::endl;
+
+    std::vector<uint32_t> destinations;
+    if (m_destinations)
+    {
+        for (const auto& d : *m_destinations)
+        {
+            if (m_table[d.second] != NO_ROUTE)
+            {
+                destinations.push_back(d.first);
+            }
+        }
+    }
+    std::sort(destinations.begin(), destinations.end());
+    if (!destinations.empty())
+    {
+        *os << "Destination     Gateway         Iface" << std::endl;
+        for (uint32_t dest : destinations)
+        {
+            const NextHop& nextHop = m_nextHops[m_table[m_destinations->at(dest)]];
+            std::ostringstream destStr;
+            std::ostringstream gw;
+            destStr << Ipv4Address(dest);
+            *os << std::setw(16) << destStr.str();
+            gw << nextHop.gateway;
+            *os << std::setw(16) << gw.str();
+            if (!Names::FindName(m_ipv4->GetNetDevice(nextHop.interface)).empty())
+            {
+                *os << Names::FindName(m_ipv4->GetNetDevice(nextHop.interface));
+            }
+            else
+            {
+                *os << nextHop.interface;
+            }
+            *os << std::endl;
+        }
+    }
+    *os << std::endl;
+    // Restore the previous ostream state
+    (*os).copyfmt(oldState);
+}
+
+} // namespace ns3
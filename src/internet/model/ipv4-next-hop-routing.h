@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV4_NEXT_HOP_ROUTING_H
+#define IPV4_NEXT_HOP_ROUTING_H
+
+#include "ipv4-routing-protocol.h"
+#include "ipv4.h"
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ptr.h"
+
+#include <memory>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup ipv4Routing
+ *
+ * \brief Routing protocol for static topologies, with a next-hop table
+ * indexed by destination node.
+ *
+ * PopulateRoutingTables () runs a shortest path search towards each
+ * destination node over the links between the IPv4 interfaces of all nodes,
+ * and gives each node one next hop (output interface and gateway) per
+ * destination node.  A hash table shared by all nodes maps the addresses
+ * of the destination nodes to their index in these tables, so a lookup is
+ * a hash lookup and an array access, and each node only keeps two bytes per
+ * destination.
+ *
+ * The searches are a breadth first search when all interfaces have the
+ * default metric of 1, and a Dijkstra search otherwise.  They run on the
+ * number of threads set by the NextHopRoutingThreads global value.  With the
+ * NextHopRoutingApplicationNodesOnly global value set, only the nodes with
+ * applications are destinations.
+ *
+ * The links are found from the channels of the devices: a node is a
+ * neighbor of another if one of its interfaces that is up shares a channel
+ * with one of the other.  The tables do not follow the changes of the
+ * topology; PopulateRoutingTables () must be called again after them.
+ * Multicast and bridged links are not supported.
+ *
+ * \see Ipv4GlobalRouting
+ */
+class Ipv4NextHopRouting : public Ipv4RoutingProtocol
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    Ipv4NextHopRouting();
+    ~Ipv4NextHopRouting() override;
+
+    // These methods inherited from base class
+    Ptr<Ipv4Route> RouteOutput(Ptr<Packet> p,
+                               const Ipv4Header& header,
+                               Ptr<NetDevice> oif,
+                               Socket::SocketErrno& sockerr) override;
+
+    bool RouteInput(Ptr<const Packet> p,
+                    const Ipv4Header& header,
+                    Ptr<const NetDevice> idev,
+                    const UnicastForwardCallback& ucb,
+                    const MulticastForwardCallback& mcb,
+                    const LocalDeliverCallback& lcb,
+                    const ErrorCallback& ecb) override;
+    void NotifyInterfaceUp(uint32_t interface) override;
+    void NotifyInterfaceDown(uint32_t interface) override;
+    void NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address) override;
+    void NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address) override;
+    void SetIpv4(Ptr<Ipv4> ipv4) override;
+    void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
+                           Time::Unit unit = Time::S) const override;
+
+    /**
+     * \brief Compute the next-hop tables of all the nodes with an
+     * Ipv4NextHopRouting protocol.
+     */
+    static void PopulateRoutingTables();
+
+    /**
+     * \brief Look up the next hop to a destination.
+     *
+     * \param dest The destination address.
+     * \param interface Set to the output interface.
+     * \param gateway Set to the gateway.
+     * \return false if there is no route to dest.
+     */
+    bool LookupNextHop(Ipv4Address dest, uint32_t& interface, Ipv4Address& gateway) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// A next hop: output interface and gateway
+    struct NextHop
+    {
+        uint32_t interface;  //!< The output interface
+        Ipv4Address gateway; //!< The gateway
+    };
+
+    /// Destination address to destination index, shared by all nodes
+    typedef std::unordered_map<uint32_t, uint32_t> DestinationMap_t;
+
+    /// Table entry of the destinations without a next hop
+    static const uint16_t NO_ROUTE = 0xffff;
+
+    Ptr<Ipv4> m_ipv4;                                      //!< Ipv4 reference
+    std::shared_ptr<const DestinationMap_t> m_destinations; //!< Index of the destinations
+    std::vector<NextHop> m_nextHops;                        //!< The next hops of this node
+    std::vector<uint16_t> m_table; //!< Index in m_nextHops, per destination index
+};
+
+} // namespace ns3
+
+#endif /* IPV4_NEXT_HOP_ROUTING_H */
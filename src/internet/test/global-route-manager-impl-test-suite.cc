@@ -222,6 +222,78 @@ GlobalRouteManagerImplTestCase::DoRun()
     // does not crash
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief CandidateQueue order, Find and decrease-key
+ */
+class CandidateQueueTestCase : public TestCase
+{
+  public:
+    CandidateQueueTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Create a vertex.
+     * \param id the vertex ID
+     * \param type the vertex type
+     * \param distance the distance from the root
+     * \returns the vertex
+     */
+    static SPFVertex* MakeVertex(const char* id, SPFVertex::VertexType type, uint32_t distance);
+};
+
+CandidateQueueTestCase::CandidateQueueTestCase()
+    : TestCase("CandidateQueue order, Find and Update")
+{
+}
+
+SPFVertex*
+CandidateQueueTestCase::MakeVertex(const char* id, SPFVertex::VertexType type, uint32_t distance)
+{
+    SPFVertex* v = new SPFVertex;
+    v->SetVertexId(Ipv4Address(id));
+    v->SetVertexType(type);
+    v->SetDistanceFromRoot(distance);
+    return v;
+}
+
+void
+CandidateQueueTestCase::DoRun()
+{
+    CandidateQueue candidate;
+    SPFVertex* r1 = MakeVertex("0.0.0.1", SPFVertex::VertexRouter, 5);
+    SPFVertex* r2 = MakeVertex("0.0.0.2", SPFVertex::VertexRouter, 3);
+    SPFVertex* r3 = MakeVertex("0.0.0.3", SPFVertex::VertexRouter, 5);
+    SPFVertex* n4 = MakeVertex("10.0.0.4", SPFVertex::VertexNetwork, 5);
+    SPFVertex* r5 = MakeVertex("0.0.0.5", SPFVertex::VertexRouter, 9);
+    for (SPFVertex* v : {r1, r2, r3, n4, r5})
+    {
+        candidate.Push(v);
+    }
+    NS_TEST_ASSERT_MSG_EQ(candidate.Size(), 5, "Wrong size");
+    NS_TEST_ASSERT_MSG_EQ(candidate.Find(Ipv4Address("0.0.0.3")), r3, "Find by vertex ID");
+    NS_TEST_ASSERT_MSG_EQ(candidate.Find(Ipv4Address("0.0.0.9")), nullptr, "Unknown vertex ID");
+
+    // Lower r5 to the distance of r1 and r3: it goes after them, as it did
+    // when the queue was a sorted list
+    r5->SetDistanceFromRoot(5);
+    candidate.Update(r5);
+
+    // Networks before routers at the same distance, then in push order
+    SPFVertex* expected[] = {r2, n4, r1, r3, r5};
+    for (SPFVertex* v : expected)
+    {
+        NS_TEST_ASSERT_MSG_EQ(candidate.Top(), v, "Wrong top");
+        SPFVertex* popped = candidate.Pop();
+        NS_TEST_ASSERT_MSG_EQ(popped, v, "Wrong order");
+        delete popped;
+    }
+    NS_TEST_ASSERT_MSG_EQ(candidate.Empty(), true, "Queue not empty");
+    NS_TEST_ASSERT_MSG_EQ(candidate.Pop(), nullptr, "Pop from empty queue");
+}
+
 /**
  * \ingroup internet-test
  *
@@ -239,6 +311,7 @@ GlobalRouteManagerImplTestSuite::GlobalRouteManagerImplTestSuite()
     : TestSuite("global-route-manager-impl", UNIT)
 {
     AddTestCase(new GlobalRouteManagerImplTestCase(), TestCase::QUICK);
+    AddTestCase(new CandidateQueueTestCase(), TestCase::QUICK);
 }
 
 static GlobalRouteManagerImplTestSuite
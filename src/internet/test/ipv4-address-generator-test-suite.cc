@@ -339,6 +339,66 @@ AddressCollisionTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(added, false, "404");
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 address range allocation Test
+ */
+class AddressRangeTestCase : public TestCase
+{
+  public:
+    AddressRangeTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+AddressRangeTestCase::AddressRangeTestCase()
+    : TestCase("Make sure that address ranges are merged and checked for collisions.")
+{
+}
+
+void
+AddressRangeTestCase::DoTeardown()
+{
+    Ipv4AddressGenerator::Reset();
+    Simulator::Destroy();
+}
+
+void
+AddressRangeTestCase::DoRun()
+{
+    Ipv4AddressGenerator::AddAllocatedRange("0.0.0.10", "0.0.0.19");
+    Ipv4AddressGenerator::AddAllocatedRange("0.0.0.30", "0.0.0.39");
+    // Fills the gap and joins both blocks
+    Ipv4AddressGenerator::AddAllocatedRange("0.0.0.20", "0.0.0.29");
+    Ipv4AddressGenerator::AddAllocated("0.0.0.9");
+    Ipv4AddressGenerator::AddAllocatedRange("0.0.0.1", "0.0.0.8");
+
+    Ipv4AddressGenerator::TestMode();
+    bool added = Ipv4AddressGenerator::AddAllocated("0.0.0.25");
+    NS_TEST_EXPECT_MSG_EQ(added, false, "500");
+
+    added = Ipv4AddressGenerator::AddAllocatedRange("0.0.0.39", "0.0.0.45");
+    NS_TEST_EXPECT_MSG_EQ(added, false, "501");
+
+    added = Ipv4AddressGenerator::AddAllocatedRange("0.0.0.50", "0.0.0.60");
+    NS_TEST_EXPECT_MSG_EQ(added, true, "502");
+
+    added = Ipv4AddressGenerator::AddAllocatedRange("0.0.0.45", "0.0.0.50");
+    NS_TEST_EXPECT_MSG_EQ(added, false, "503");
+
+    added = Ipv4AddressGenerator::AddAllocatedRange("0.0.0.40", "0.0.0.49");
+    NS_TEST_EXPECT_MSG_EQ(added, true, "504");
+
+    added = Ipv4AddressGenerator::AddAllocated("0.0.0.61");
+    NS_TEST_EXPECT_MSG_EQ(added, true, "505");
+
+    added = Ipv4AddressGenerator::AddAllocated("0.0.0.44");
+    NS_TEST_EXPECT_MSG_EQ(added, false, "506");
+}
+
 /**
  * \ingroup internet-test
  *
@@ -360,6 +420,7 @@ Ipv4AddressGeneratorTestSuite::Ipv4AddressGeneratorTestSuite()
     AddTestCase(new NetworkAndAddressTestCase(), TestCase::QUICK);
     AddTestCase(new ExampleAddressGeneratorTestCase(), TestCase::QUICK);
     AddTestCase(new AddressCollisionTestCase(), TestCase::QUICK);
+    AddTestCase(new AddressRangeTestCase(), TestCase::QUICK);
 }
 
 static Ipv4AddressGeneratorTestSuite
@@ -15,8 +15,11 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-generator.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
@@ -275,6 +278,80 @@ IpAddressHelperTestCasev4::DoTeardown()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 address helper bulk point-to-point assignment Test
+ */
+class PointToPointAllocatorHelperTestCase : public TestCase
+{
+  public:
+    PointToPointAllocatorHelperTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+PointToPointAllocatorHelperTestCase::PointToPointAllocatorHelperTestCase()
+    : TestCase("Make sure AssignPointToPoint gives one network per device pair")
+{
+}
+
+void
+PointToPointAllocatorHelperTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(3);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    SimpleNetDeviceHelper simple;
+    NetDeviceContainer devices;
+    devices.Add(simple.Install(NodeContainer(nodes.Get(0), nodes.Get(1))));
+    devices.Add(simple.Install(NodeContainer(nodes.Get(1), nodes.Get(2))));
+    devices.Add(simple.Install(NodeContainer(nodes.Get(2), nodes.Get(0))));
+
+    Ipv4AddressHelper address("10.1.0.0", "255.255.255.252");
+    Ipv4InterfaceContainer interfaces = address.AssignPointToPoint(devices);
+    NS_TEST_ASSERT_MSG_EQ(interfaces.GetN(), 6, "One interface per device");
+    NS_TEST_ASSERT_MSG_EQ(interfaces.GetAddress(0), Ipv4Address("10.1.0.1"), "First pair, a");
+    NS_TEST_ASSERT_MSG_EQ(interfaces.GetAddress(1), Ipv4Address("10.1.0.2"), "First pair, b");
+    NS_TEST_ASSERT_MSG_EQ(interfaces.GetAddress(2), Ipv4Address("10.1.0.5"), "Second pair, a");
+    NS_TEST_ASSERT_MSG_EQ(interfaces.GetAddress(5), Ipv4Address("10.1.0.10"), "Third pair, b");
+
+    Ptr<Ipv4> ipv4 = nodes.Get(1)->GetObject<Ipv4>();
+    NS_TEST_ASSERT_MSG_EQ(ipv4->GetAddress(1, 0).GetLocal(),
+                          Ipv4Address("10.1.0.2"),
+                          "Address configured on the interface");
+    NS_TEST_ASSERT_MSG_EQ(ipv4->GetAddress(1, 0).GetMask(),
+                          Ipv4Mask("255.255.255.252"),
+                          "Mask configured on the interface");
+    NS_TEST_ASSERT_MSG_EQ(ipv4->IsUp(2), true, "Interface is up");
+
+    // The helper continues after the batch, and a partly used network is skipped
+    NS_TEST_ASSERT_MSG_EQ(address.NewAddress(), Ipv4Address("10.1.0.13"), "Next network");
+    devices = simple.Install(NodeContainer(nodes.Get(0), nodes.Get(1)));
+    interfaces = address.AssignPointToPoint(devices);
+    NS_TEST_ASSERT_MSG_EQ(interfaces.GetAddress(0), Ipv4Address("10.1.0.17"), "Fresh network");
+
+    // The whole batch is registered with the generator
+    Ipv4AddressGenerator::TestMode();
+    NS_TEST_ASSERT_MSG_EQ(Ipv4AddressGenerator::AddAllocated("10.1.0.6"),
+                          false,
+                          "Address of the batch is allocated");
+    NS_TEST_ASSERT_MSG_EQ(Ipv4AddressGenerator::AddAllocated("10.1.0.21"),
+                          true,
+                          "Address after the batch is free");
+}
+
+void
+PointToPointAllocatorHelperTestCase::DoTeardown()
+{
+    Ipv4AddressGenerator::Reset();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -295,6 +372,7 @@ Ipv4AddressHelperTestSuite::Ipv4AddressHelperTestSuite()
     AddTestCase(new AddressAllocatorHelperTestCase(), TestCase::QUICK);
     AddTestCase(new ResetAllocatorHelperTestCase(), TestCase::QUICK);
     AddTestCase(new IpAddressHelperTestCasev4(), TestCase::QUICK);
+    AddTestCase(new PointToPointAllocatorHelperTestCase(), TestCase::QUICK);
 }
 
 static Ipv4AddressHelperTestSuite
@@ -41,6 +41,8 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -1313,6 +1315,343 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 GlobalRouting computed on several threads
+ *
+ * Routes of a grid with many equal-cost paths, computed sequentially and
+ * with GlobalRoutingThreads, must be the same and in the same order.
+ */
+class Ipv4GlobalRoutingThreadsTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingThreadsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Print the routing tables of all nodes.
+     * \returns the routing tables, one route per line
+     */
+    std::string DumpRoutes() const;
+
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+Ipv4GlobalRoutingThreadsTestCase::Ipv4GlobalRoutingThreadsTestCase()
+    : TestCase("Global routing computed on several threads")
+{
+}
+
+std::string
+Ipv4GlobalRoutingThreadsTestCase::DumpRoutes() const
+{
+    std::ostringstream os;
+    for (uint32_t n = 0; n < m_nodes.GetN(); ++n)
+    {
+        Ptr<Ipv4GlobalRouting> routing =
+            m_nodes.Get(n)->GetObject<Ipv4L3Protocol>()->GetRoutingProtocol()->GetObject<
+                Ipv4GlobalRouting>();
+        for (uint32_t i = 0; i < routing->GetNRoutes(); ++i)
+        {
+            os << n << ": " << *routing->GetRoute(i) << "\n";
+        }
+    }
+    return os.str();
+}
+
+void
+Ipv4GlobalRoutingThreadsTestCase::DoRun()
+{
+    // 5x5 grid of point-to-point links
+    const uint32_t side = 5;
+    m_nodes.Create(side * side);
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.252");
+    for (uint32_t r = 0; r < side; ++r)
+    {
+        for (uint32_t c = 0; c < side; ++c)
+        {
+            const uint32_t n = r * side + c;
+            for (uint32_t peer : {c + 1 < side ? n + 1 : n, r + 1 < side ? n + side : n})
+            {
+                if (peer == n)
+                {
+                    continue;
+                }
+                Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+                NetDeviceContainer net = simpleHelper.Install(m_nodes.Get(n), channel);
+                net.Add(simpleHelper.Install(m_nodes.Get(peer), channel));
+                ipv4.Assign(net);
+                ipv4.NewNetwork();
+            }
+        }
+    }
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    const std::string sequential = DumpRoutes();
+
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(4));
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    const std::string parallel = DumpRoutes();
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(1));
+
+    NS_TEST_ASSERT_MSG_GT(sequential.size(), 0, "No routes computed");
+    NS_TEST_ASSERT_MSG_EQ(parallel, sequential, "Different routes computed on several threads");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 GlobalRouting lookups in the route index
+ *
+ * Host routes first, then the longest matching network prefix, then the
+ * first matching external route; ECMP order and the output device filter.
+ */
+class Ipv4GlobalRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Look up a route.
+     * \param dest the destination
+     * \param oif the output device, or 0 for any
+     * \returns the gateway of the route, or 0.0.0.0 if none
+     */
+    Ipv4Address Lookup(const char* dest, Ptr<NetDevice> oif = nullptr);
+
+    Ptr<Ipv4GlobalRouting> m_routing; //!< Routing protocol under test.
+};
+
+Ipv4GlobalRoutingLookupTestCase::Ipv4GlobalRoutingLookupTestCase()
+    : TestCase("Global routing lookups in the route index")
+{
+}
+
+Ipv4Address
+Ipv4GlobalRoutingLookupTestCase::Lookup(const char* dest, Ptr<NetDevice> oif)
+{
+    Ipv4Header header;
+    header.SetDestination(Ipv4Address(dest));
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = m_routing->RouteOutput(Create<Packet>(), header, oif, sockerr);
+    return route ? route->GetGateway() : Ipv4Address::GetAny();
+}
+
+void
+Ipv4GlobalRoutingLookupTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+
+    SimpleNetDeviceHelper simpleHelper;
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.1.0", "255.255.255.0");
+    NetDeviceContainer devices;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        devices.Add(simpleHelper.Install(node, CreateObject<SimpleChannel>()));
+        ipv4.Assign(devices.Get(i));
+        ipv4.NewNetwork();
+    }
+
+    m_routing = CreateObject<Ipv4GlobalRouting>();
+    m_routing->SetIpv4(node->GetObject<Ipv4>());
+    m_routing->AddNetworkRouteTo("10.10.0.0", "255.255.0.0", "10.0.1.2", 1);
+    m_routing->AddNetworkRouteTo("10.10.5.0", "255.255.255.0", "10.0.2.2", 2);
+    m_routing->AddNetworkRouteTo("10.10.5.0", "255.255.255.0", "10.0.3.2", 3);
+    m_routing->AddHostRouteTo("10.10.5.7", "10.0.1.3", 1);
+    m_routing->AddASExternalRouteTo("0.0.0.0", "0.0.0.0", "10.0.3.9", 3);
+    m_routing->AddASExternalRouteTo("192.168.0.0", "255.255.0.0", "10.0.2.9", 2);
+
+    NS_TEST_ASSERT_MSG_EQ(Lookup("10.10.5.7"), Ipv4Address("10.0.1.3"), "Host route first");
+    NS_TEST_ASSERT_MSG_EQ(Lookup("10.10.5.8"), Ipv4Address("10.0.2.2"), "Longest prefix");
+    NS_TEST_ASSERT_MSG_EQ(Lookup("10.10.5.8", devices.Get(2)),
+                          Ipv4Address("10.0.3.2"),
+                          "Second ECMP route on its device");
+    NS_TEST_ASSERT_MSG_EQ(Lookup("10.10.5.8", devices.Get(0)),
+                          Ipv4Address("10.0.1.2"),
+                          "Shorter prefix on the requested device");
+    NS_TEST_ASSERT_MSG_EQ(Lookup("10.10.6.1"), Ipv4Address("10.0.1.2"), "Shorter prefix");
+    NS_TEST_ASSERT_MSG_EQ(Lookup("192.168.1.1"), Ipv4Address("10.0.3.9"), "First external");
+    NS_TEST_ASSERT_MSG_EQ(Lookup("192.168.1.1", devices.Get(1)),
+                          Ipv4Address("10.0.2.9"),
+                          "External route on the requested device");
+
+    // The host route is the first route of the table
+    m_routing->RemoveRoute(0);
+    NS_TEST_ASSERT_MSG_EQ(Lookup("10.10.5.7"), Ipv4Address("10.0.2.2"), "Index not updated");
+
+    m_routing = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 GlobalRouting updated after a change of the topology
+ *
+ * After an interface goes down, a metric changes, or the interface comes
+ * back up, the routes updated by UpdateRoutingTables must be those computed
+ * by RecomputeRoutingTables, up to their order.
+ */
+class Ipv4GlobalRoutingUpdateTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingUpdateTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Print the routing tables of all nodes, sorted.
+     * \returns the routes, one per line
+     */
+    std::string DumpSortedRoutes() const;
+
+    /**
+     * \brief Update the routes, and compare them to the recomputed routes.
+     * \param change the change of the topology
+     * \returns the routes
+     */
+    std::string CheckUpdate(const std::string& change);
+
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+Ipv4GlobalRoutingUpdateTestCase::Ipv4GlobalRoutingUpdateTestCase()
+    : TestCase("Global routing updated after a change of the topology")
+{
+}
+
+std::string
+Ipv4GlobalRoutingUpdateTestCase::DumpSortedRoutes() const
+{
+    std::vector<std::string> routes;
+    for (uint32_t n = 0; n < m_nodes.GetN(); ++n)
+    {
+        Ptr<Ipv4GlobalRouting> routing =
+            m_nodes.Get(n)->GetObject<Ipv4L3Protocol>()->GetRoutingProtocol()->GetObject<
+                Ipv4GlobalRouting>();
+        for (uint32_t i = 0; i < routing->GetNRoutes(); ++i)
+        {
+            std::ostringstream os;
+            os << n << ": " << *routing->GetRoute(i) << "\n";
+            routes.push_back(os.str());
+        }
+    }
+    std::sort(routes.begin(), routes.end());
+    std::string dump;
+    for (const auto& route : routes)
+    {
+        dump += route;
+    }
+    return dump;
+}
+
+std::string
+Ipv4GlobalRoutingUpdateTestCase::CheckUpdate(const std::string& change)
+{
+    Ipv4GlobalRoutingHelper::UpdateRoutingTables();
+    const std::string updated = DumpSortedRoutes();
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_EXPECT_MSG_EQ(updated, DumpSortedRoutes(), "Different routes after " << change);
+    return updated;
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::DoRun()
+{
+    // 4x4 grid of point-to-point links, and a stub router on node 0
+    const uint32_t side = 4;
+    m_nodes.Create(side * side + 1);
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.252");
+    std::vector<NetDeviceContainer> links;
+    auto link = [&](uint32_t a, uint32_t b) {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer net = simpleHelper.Install(m_nodes.Get(a), channel);
+        net.Add(simpleHelper.Install(m_nodes.Get(b), channel));
+        ipv4.Assign(net);
+        ipv4.NewNetwork();
+        links.push_back(net);
+    };
+    for (uint32_t r = 0; r < side; ++r)
+    {
+        for (uint32_t c = 0; c < side; ++c)
+        {
+            const uint32_t n = r * side + c;
+            if (c + 1 < side)
+            {
+                link(n, n + 1);
+            }
+            if (r + 1 < side)
+            {
+                link(n, n + side);
+            }
+        }
+    }
+    link(0, side * side);
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    const std::string initial = DumpSortedRoutes();
+    NS_TEST_ASSERT_MSG_EQ(CheckUpdate("no change"), initial, "Routes changed");
+
+    // The link between nodes 5 and 6 goes down on the side of node 5
+    Ptr<NetDevice> device = links[9].Get(0);
+    Ptr<Ipv4> ipv4Five = device->GetNode()->GetObject<Ipv4>();
+    NS_TEST_ASSERT_MSG_EQ(device->GetNode(), m_nodes.Get(5), "Unexpected link order");
+    const uint32_t interface = ipv4Five->GetInterfaceForDevice(device);
+    ipv4Five->SetDown(interface);
+    NS_TEST_EXPECT_MSG_NE(CheckUpdate("interface down"), initial, "Routes not updated");
+
+    // A higher metric on the link between nodes 9 and 10
+    Ptr<NetDevice> other = links[16].Get(1);
+    Ptr<Ipv4> ipv4Ten = other->GetNode()->GetObject<Ipv4>();
+    NS_TEST_ASSERT_MSG_EQ(other->GetNode(), m_nodes.Get(10), "Unexpected link order");
+    ipv4Ten->SetMetric(ipv4Ten->GetInterfaceForDevice(other), 5);
+    CheckUpdate("metric change");
+
+    ipv4Ten->SetMetric(ipv4Ten->GetInterfaceForDevice(other), 1);
+    ipv4Five->SetUp(interface);
+    NS_TEST_EXPECT_MSG_EQ(CheckUpdate("interface up"), initial, "Routes not restored");
+
+    // A new stub network on node 15, which leaves the shortest paths as they are
+    SimpleNetDeviceHelper lanHelper;
+    NetDeviceContainer lan = lanHelper.Install(m_nodes.Get(15), CreateObject<SimpleChannel>());
+    ipv4.SetBase("10.1.0.0", "255.255.255.0");
+    ipv4.Assign(lan);
+    NS_TEST_EXPECT_MSG_NE(CheckUpdate("new stub network"), initial, "Stub network not routed");
+    Ptr<Ipv4> ipv4Fifteen = m_nodes.Get(15)->GetObject<Ipv4>();
+    ipv4Fifteen->SetDown(ipv4Fifteen->GetInterfaceForDevice(lan.Get(0)));
+    NS_TEST_EXPECT_MSG_EQ(CheckUpdate("stub network down"), initial, "Stub network still routed");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -1335,6 +1674,9 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingThreadsTestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingLookupTestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingUpdateTestCase, TestCase::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
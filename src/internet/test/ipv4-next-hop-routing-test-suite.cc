@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/application.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-next-hop-routing-helper.h"
+#include "ns3/ipv4-next-hop-routing.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Build a network of nodes with Ipv4NextHopRouting, connected by
+ * point-to-point links.
+ */
+class Ipv4NextHopRoutingNetwork
+{
+  public:
+    /**
+     * \brief Create the nodes.
+     * \param n the number of nodes
+     */
+    Ipv4NextHopRoutingNetwork(uint32_t n);
+
+    /**
+     * \brief Connect two nodes.
+     * \param a the first node
+     * \param b the second node
+     * \returns the addresses of a and b on the link
+     */
+    std::pair<Ipv4Address, Ipv4Address> Link(uint32_t a, uint32_t b);
+
+    /**
+     * \brief Get the routing protocol of a node.
+     * \param n the node
+     * \returns the routing protocol
+     */
+    Ptr<Ipv4NextHopRouting> GetRouting(uint32_t n) const;
+
+    /**
+     * \brief Look up the gateway of the next hop from a node.
+     * \param n the node
+     * \param dest the destination
+     * \returns the gateway, or 0.0.0.0 if there is no route
+     */
+    Ipv4Address Lookup(uint32_t n, Ipv4Address dest) const;
+
+    /**
+     * \brief Print the routing tables of all nodes.
+     * \returns the routing tables
+     */
+    std::string DumpRoutes() const;
+
+    NodeContainer m_nodes; //!< The nodes.
+    /// The links, with their devices and interfaces
+    std::vector<std::pair<NetDeviceContainer, Ipv4InterfaceContainer>> m_links;
+
+  private:
+    Ipv4AddressHelper m_ipv4; //!< Address helper.
+};
+
+Ipv4NextHopRoutingNetwork::Ipv4NextHopRoutingNetwork(uint32_t n)
+{
+    m_nodes.Create(n);
+    InternetStackHelper internet;
+    Ipv4NextHopRoutingHelper routingHelper;
+    internet.SetRoutingHelper(routingHelper);
+    internet.Install(m_nodes);
+    m_ipv4.SetBase("10.0.0.0", "255.255.255.252");
+}
+
+std::pair<Ipv4Address, Ipv4Address>
+Ipv4NextHopRoutingNetwork::Link(uint32_t a, uint32_t b)
+{
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    NetDeviceContainer net = simpleHelper.Install(m_nodes.Get(a), channel);
+    net.Add(simpleHelper.Install(m_nodes.Get(b), channel));
+    Ipv4InterfaceContainer interfaces = m_ipv4.Assign(net);
+    m_ipv4.NewNetwork();
+    m_links.emplace_back(net, interfaces);
+    return {interfaces.GetAddress(0), interfaces.GetAddress(1)};
+}
+
+Ptr<Ipv4NextHopRouting>
+Ipv4NextHopRoutingNetwork::GetRouting(uint32_t n) const
+{
+    return DynamicCast<Ipv4NextHopRouting>(
+        m_nodes.Get(n)->GetObject<Ipv4>()->GetRoutingProtocol());
+}
+
+Ipv4Address
+Ipv4NextHopRoutingNetwork::Lookup(uint32_t n, Ipv4Address dest) const
+{
+    uint32_t interface;
+    Ipv4Address gateway;
+    if (!GetRouting(n)->LookupNextHop(dest, interface, gateway))
+    {
+        return Ipv4Address::GetAny();
+    }
+    return gateway;
+}
+
+std::string
+Ipv4NextHopRoutingNetwork::DumpRoutes() const
+{
+    std::ostringstream os;
+    Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper>(&os);
+    for (uint32_t n = 0; n < m_nodes.GetN(); ++n)
+    {
+        GetRouting(n)->PrintRoutingTable(stream);
+    }
+    return os.str();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 NextHopRouting on a ring with metrics
+ *
+ * The next hops follow the lowest metric, and a packet goes through the
+ * ring to its destination.
+ */
+class Ipv4NextHopRoutingRingTestCase : public TestCase
+{
+  public:
+    Ipv4NextHopRoutingRingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Receive a packet.
+     * \param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+
+    uint32_t m_received{0}; //!< Number of received packets.
+};
+
+Ipv4NextHopRoutingRingTestCase::Ipv4NextHopRoutingRingTestCase()
+    : TestCase("Next-hop routing on a ring with metrics")
+{
+}
+
+void
+Ipv4NextHopRoutingRingTestCase::ReceivePkt(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_received++;
+    }
+}
+
+void
+Ipv4NextHopRoutingRingTestCase::DoRun()
+{
+    // 0 - 1 - 2 - 3 - 0, with a metric of 10 from node 0 to node 3
+    Ipv4NextHopRoutingNetwork network(4);
+    auto link01 = network.Link(0, 1);
+    auto link12 = network.Link(1, 2);
+    auto link23 = network.Link(2, 3);
+    auto link30 = network.Link(3, 0);
+    Ptr<Ipv4> ipv4Zero = network.m_nodes.Get(0)->GetObject<Ipv4>();
+    ipv4Zero->SetMetric(ipv4Zero->GetInterfaceForAddress(link30.second), 10);
+    Ipv4NextHopRoutingHelper::PopulateRoutingTables();
+
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(0, link12.second),
+                          link01.second,
+                          "Node 0 reaches node 2 through node 1");
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(0, link30.first),
+                          link01.second,
+                          "Node 0 avoids its link of metric 10");
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(3, link01.first),
+                          link30.second,
+                          "Node 3 uses the link of metric 1 to node 0");
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(1, link01.second),
+                          Ipv4Address::GetAny(),
+                          "No next hop to the node itself");
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(1, Ipv4Address("10.9.9.9")),
+                          Ipv4Address::GetAny(),
+                          "No next hop to an unknown address");
+
+    Ptr<Socket> rxSocket =
+        network.m_nodes.Get(3)->GetObject<UdpSocketFactory>()->CreateSocket();
+    rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234));
+    rxSocket->SetRecvCallback(MakeCallback(&Ipv4NextHopRoutingRingTestCase::ReceivePkt, this));
+    Ptr<Socket> txSocket =
+        network.m_nodes.Get(0)->GetObject<UdpSocketFactory>()->CreateSocket();
+    Simulator::Schedule(Seconds(1), [txSocket, link23]() {
+        txSocket->SendTo(Create<Packet>(100), 0, InetSocketAddress(link23.second, 1234));
+    });
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "Packet not delivered");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 NextHopRouting computed on several threads
+ *
+ * The tables of a grid, computed sequentially and with NextHopRoutingThreads,
+ * must be the same.
+ */
+class Ipv4NextHopRoutingThreadsTestCase : public TestCase
+{
+  public:
+    Ipv4NextHopRoutingThreadsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4NextHopRoutingThreadsTestCase::Ipv4NextHopRoutingThreadsTestCase()
+    : TestCase("Next-hop routing computed on several threads")
+{
+}
+
+void
+Ipv4NextHopRoutingThreadsTestCase::DoRun()
+{
+    // 5x5 grid
+    const uint32_t side = 5;
+    Ipv4NextHopRoutingNetwork network(side * side);
+    for (uint32_t r = 0; r < side; ++r)
+    {
+        for (uint32_t c = 0; c < side; ++c)
+        {
+            const uint32_t n = r * side + c;
+            if (c + 1 < side)
+            {
+                network.Link(n, n + 1);
+            }
+            if (r + 1 < side)
+            {
+                network.Link(n, n + side);
+            }
+        }
+    }
+
+    Ipv4NextHopRoutingHelper::PopulateRoutingTables();
+    const std::string sequential = network.DumpRoutes();
+    // The far corner is 8 hops away from node 0, with the next hop on the first link
+    Ipv4Address corner = network.m_links.back().second.GetAddress(1);
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(0, corner),
+                          network.m_links[0].second.GetAddress(1),
+                          "Next hop to the far corner");
+
+    Config::SetGlobal("NextHopRoutingThreads", UintegerValue(4));
+    Ipv4NextHopRoutingHelper::PopulateRoutingTables();
+    const std::string parallel = network.DumpRoutes();
+    Config::SetGlobal("NextHopRoutingThreads", UintegerValue(1));
+
+    NS_TEST_EXPECT_MSG_EQ(parallel, sequential, "Different tables computed on several threads");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 NextHopRouting with only the nodes with applications as
+ * destinations
+ */
+class Ipv4NextHopRoutingApplicationNodesTestCase : public TestCase
+{
+  public:
+    Ipv4NextHopRoutingApplicationNodesTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4NextHopRoutingApplicationNodesTestCase::Ipv4NextHopRoutingApplicationNodesTestCase()
+    : TestCase("Next-hop routing to the nodes with applications")
+{
+}
+
+void
+Ipv4NextHopRoutingApplicationNodesTestCase::DoRun()
+{
+    // 0 - 1 - 2, with an application on node 2
+    Ipv4NextHopRoutingNetwork network(3);
+    auto link01 = network.Link(0, 1);
+    auto link12 = network.Link(1, 2);
+    network.m_nodes.Get(2)->AddApplication(CreateObject<Application>());
+
+    Config::SetGlobal("NextHopRoutingApplicationNodesOnly", BooleanValue(true));
+    Ipv4NextHopRoutingHelper::PopulateRoutingTables();
+    Config::SetGlobal("NextHopRoutingApplicationNodesOnly", BooleanValue(false));
+
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(0, link12.second),
+                          link01.second,
+                          "Next hop to the node with an application");
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(0, link12.first),
+                          Ipv4Address::GetAny(),
+                          "Next hop to a node without application");
+    NS_TEST_EXPECT_MSG_EQ(network.Lookup(2, link01.first),
+                          Ipv4Address::GetAny(),
+                          "Next hop to a node without application");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 NextHopRouting TestSuite
+ */
+class Ipv4NextHopRoutingTestSuite : public TestSuite
+{
+  public:
+    Ipv4NextHopRoutingTestSuite();
+};
+
+Ipv4NextHopRoutingTestSuite::Ipv4NextHopRoutingTestSuite()
+    : TestSuite("ipv4-next-hop-routing", UNIT)
+{
+    AddTestCase(new Ipv4NextHopRoutingRingTestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4NextHopRoutingThreadsTestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4NextHopRoutingApplicationNodesTestCase, TestCase::QUICK);
+}
+
+static Ipv4NextHopRoutingTestSuite
+    g_nextHopRoutingTestSuite; //!< Static variable for test initialization
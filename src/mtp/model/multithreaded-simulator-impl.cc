@@ -0,0 +1,817 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <tuple>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Logging in the event loop is avoided, as in DefaultSimulatorImpl.
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+
+/** Time stamp used for an empty event list or an unbounded window. */
+constexpr uint64_t NO_TS = 0x7fffffffffffffffULL;
+
+/**
+ * Add two time stamps, saturating at NO_TS.
+ *
+ * \param [in] a The first time stamp.
+ * \param [in] b The second time stamp.
+ * \returns The sum.
+ */
+uint64_t
+SaturatingAdd(uint64_t a, uint64_t b)
+{
+    return (b >= NO_TS - a) ? NO_TS : a + b;
+}
+
+/**
+ * Find the representative of a node in a union-find forest.
+ *
+ * \param [in,out] parent The forest.
+ * \param [in] i The node.
+ * \returns The representative.
+ */
+uint32_t
+FindRoot(std::vector<uint32_t>& parent, uint32_t i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+} // unnamed namespace
+
+thread_local MultithreadedSimulatorImpl::Partition* MultithreadedSimulatorImpl::g_current =
+    nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads, 0 for the number of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MinLookahead",
+                          "Point-to-point channels with a delay up to this value are never "
+                          "cut between partitions.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_minLookahead),
+                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_maxThreads(0),
+      m_minLookahead(Time(0)),
+      m_partitioned(false),
+      m_lookahead(NO_TS),
+      m_windowEnd(NO_TS),
+      m_command(RUN),
+      m_stop(false),
+      m_waiting(0),
+      m_phase(0),
+      m_nThreads(1),
+      m_mainThreadId(std::this_thread::get_id())
+{
+    NS_LOG_FUNCTION(this);
+    m_factory.SetTypeId("ns3::MapScheduler");
+    m_global = CreatePartition(0);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::unique_ptr<MultithreadedSimulatorImpl::Partition>
+MultithreadedSimulatorImpl::CreatePartition(uint32_t index) const
+{
+    auto partition = std::make_unique<Partition>();
+    partition->events = m_factory.Create<Scheduler>();
+    partition->mailbox = nullptr;
+    partition->index = index;
+    partition->currentTs = 0;
+    partition->currentContext = Simulator::NO_CONTEXT;
+    partition->currentUid = EventId::UID::INVALID;
+    partition->uid = EventId::UID::VALID;
+    partition->packetUid = 0;
+    partition->eventCount = 0;
+    partition->sent = 0;
+    return partition;
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_partitions.emplace_back(std::move(m_global));
+    for (auto& partition : m_partitions)
+    {
+        Message* message = partition->mailbox.exchange(nullptr);
+        while (message != nullptr)
+        {
+            Message* next = message->next;
+            message->event->Unref();
+            delete message;
+            message = next;
+        }
+        while (!partition->events->IsEmpty())
+        {
+            Scheduler::Event next = partition->events->RemoveNext();
+            next.impl->Unref();
+        }
+        partition->events = nullptr;
+    }
+    m_partitions.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (true)
+    {
+        Ptr<EventImpl> ev;
+        {
+            std::unique_lock lock{m_destroyMutex};
+            if (m_destroyEvents.empty())
+            {
+                break;
+            }
+            ev = m_destroyEvents.front().PeekEventImpl();
+            m_destroyEvents.pop_front();
+        }
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    m_factory = schedulerFactory;
+    m_partitions.emplace_back(std::move(m_global));
+    for (auto& partition : m_partitions)
+    {
+        Ptr<Scheduler> scheduler = m_factory.Create<Scheduler>();
+        while (!partition->events->IsEmpty())
+        {
+            scheduler->Insert(partition->events->RemoveNext());
+        }
+        partition->events = scheduler;
+    }
+    m_global = std::move(m_partitions.back());
+    m_partitions.pop_back();
+}
+
+// Threads share one process, so there is only one system.
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount() const
+{
+    return m_partitions.size();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t nodeId) const
+{
+    return PartitionOf(nodeId)->index;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return TimeStep(m_lookahead);
+}
+
+MultithreadedSimulatorImpl::Partition*
+MultithreadedSimulatorImpl::PartitionOf(uint32_t context) const
+{
+    if (context < m_partitionOf.size())
+    {
+        return m_partitions[m_partitionOf[context]].get();
+    }
+    return m_global.get();
+}
+
+MultithreadedSimulatorImpl::Partition*
+MultithreadedSimulatorImpl::Current() const
+{
+    if (g_current != nullptr)
+    {
+        return g_current;
+    }
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+                  "MultithreadedSimulatorImpl: invocation from a thread of another simulator");
+    return m_global.get();
+}
+
+void
+MultithreadedSimulatorImpl::PartitionNodes(uint32_t count)
+{
+    NS_LOG_FUNCTION(this << count);
+    uint32_t nNodes = NodeList::GetNNodes();
+
+    // Merge the nodes which cannot be simulated apart; keep the other
+    // point-to-point links as candidate cuts.
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    std::vector<std::tuple<uint32_t, uint32_t, uint64_t>> links;
+    std::vector<uint32_t> weight(nNodes, 1);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        Ptr<Node> node = NodeList::GetNode(i);
+        weight[i] += node->GetNDevices();
+        for (uint32_t j = 0; j < node->GetNDevices(); ++j)
+        {
+            Ptr<NetDevice> device = node->GetDevice(j);
+            Ptr<Channel> channel = device->GetChannel();
+            if (!channel)
+            {
+                continue;
+            }
+            Ptr<PointToPointChannel> p2p = DynamicCast<PointToPointChannel>(channel);
+            if (p2p && p2p->GetNDevices() == 2)
+            {
+                TimeValue delay;
+                p2p->GetAttribute("Delay", delay);
+                if (delay.Get() > m_minLookahead)
+                {
+                    if (p2p->GetDevice(0) == device)
+                    {
+                        links.emplace_back(i,
+                                           p2p->GetDevice(1)->GetNode()->GetId(),
+                                           delay.Get().GetTimeStep());
+                    }
+                    continue;
+                }
+            }
+            for (std::size_t k = 0; k < channel->GetNDevices(); ++k)
+            {
+                uint32_t other = channel->GetDevice(k)->GetNode()->GetId();
+                parent[FindRoot(parent, other)] = FindRoot(parent, i);
+            }
+        }
+    }
+
+    // Groups of nodes, numbered by their smallest node id, and the links
+    // between them.
+    std::vector<uint32_t> group(nNodes);
+    std::vector<uint32_t> groupWeight;
+    std::vector<uint32_t> groupOfRoot(nNodes, nNodes);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        uint32_t root = FindRoot(parent, i);
+        if (groupOfRoot[root] == nNodes)
+        {
+            groupOfRoot[root] = groupWeight.size();
+            groupWeight.push_back(0);
+        }
+        group[i] = groupOfRoot[root];
+        groupWeight[group[i]] += weight[i];
+    }
+    std::vector<std::vector<uint32_t>> neighbors(groupWeight.size());
+    for (const auto& [a, b, delay] : links)
+    {
+        if (group[a] != group[b])
+        {
+            neighbors[group[a]].push_back(group[b]);
+            neighbors[group[b]].push_back(group[a]);
+        }
+    }
+
+    // Breadth-first order keeps each partition connected where possible.
+    std::vector<uint32_t> order;
+    std::vector<bool> visited(groupWeight.size(), false);
+    for (uint32_t start = 0; start < groupWeight.size(); ++start)
+    {
+        if (visited[start])
+        {
+            continue;
+        }
+        std::deque<uint32_t> queue{start};
+        visited[start] = true;
+        while (!queue.empty())
+        {
+            uint32_t g = queue.front();
+            queue.pop_front();
+            order.push_back(g);
+            for (uint32_t n : neighbors[g])
+            {
+                if (!visited[n])
+                {
+                    visited[n] = true;
+                    queue.push_back(n);
+                }
+            }
+        }
+    }
+
+    count = std::max<uint32_t>(1, std::min<std::size_t>(count, groupWeight.size()));
+    uint64_t total = std::accumulate(groupWeight.begin(), groupWeight.end(), uint64_t(0));
+    std::vector<uint32_t> partitionOfGroup(groupWeight.size());
+    uint32_t current = 0;
+    uint64_t assigned = 0;
+    for (uint32_t g : order)
+    {
+        if (current + 1 < count && assigned * count >= total * (current + 1))
+        {
+            current++;
+        }
+        partitionOfGroup[g] = current;
+        assigned += groupWeight[g];
+    }
+    count = current + 1;
+
+    m_partitionOf.resize(nNodes);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        m_partitionOf[i] = partitionOfGroup[group[i]];
+    }
+    m_lookahead = NO_TS;
+    for (const auto& [a, b, delay] : links)
+    {
+        if (m_partitionOf[a] != m_partitionOf[b])
+        {
+            m_lookahead = std::min(m_lookahead, delay);
+        }
+    }
+
+    m_partitions.clear();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        m_partitions.emplace_back(CreatePartition(i));
+        m_partitions.back()->currentTs = m_global->currentTs;
+        m_partitions.back()->uid = m_global->uid;
+    }
+    m_global->index = count;
+
+    // Hand the events scheduled so far over to their partitions; they
+    // keep their uids, so that the EventIds already returned stay valid.
+    std::vector<Scheduler::Event> global;
+    while (!m_global->events->IsEmpty())
+    {
+        Scheduler::Event ev = m_global->events->RemoveNext();
+        Partition* partition = PartitionOf(ev.key.m_context);
+        if (partition == m_global.get())
+        {
+            global.push_back(ev);
+        }
+        else
+        {
+            partition->events->Insert(ev);
+        }
+    }
+    for (const auto& ev : global)
+    {
+        m_global->events->Insert(ev);
+    }
+    m_partitioned = true;
+    NS_LOG_INFO(count << " partitions, lookahead " << TimeStep(m_lookahead));
+}
+
+EventId
+MultithreadedSimulatorImpl::Insert(Partition* partition,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = partition->uid;
+    partition->uid++;
+    partition->events->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::Send(Partition* source,
+                                 Partition* destination,
+                                 uint64_t ts,
+                                 uint32_t context,
+                                 EventImpl* event)
+{
+    NS_ABORT_MSG_IF(ts < m_windowEnd,
+                    "MultithreadedSimulatorImpl: event for context "
+                        << context << " at " << TimeStep(ts)
+                        << " crosses partitions with less than the lookahead "
+                        << TimeStep(m_lookahead));
+    auto message = new Message{nullptr, ts, context, source->index, source->sent++, event};
+    Message* head = destination->mailbox.load(std::memory_order_relaxed);
+    do
+    {
+        message->next = head;
+    } while (!destination->mailbox.compare_exchange_weak(head,
+                                                         message,
+                                                         std::memory_order_release,
+                                                         std::memory_order_relaxed));
+}
+
+void
+MultithreadedSimulatorImpl::Receive(Partition* partition)
+{
+    Message* message = partition->mailbox.exchange(nullptr, std::memory_order_acquire);
+    if (message == nullptr)
+    {
+        return;
+    }
+    auto& received = partition->received;
+    for (; message != nullptr; message = message->next)
+    {
+        received.push_back(message);
+    }
+    std::sort(received.begin(), received.end(), [](const Message* a, const Message* b) {
+        return std::tie(a->ts, a->source, a->seq) < std::tie(b->ts, b->source, b->seq);
+    });
+    for (Message* m : received)
+    {
+        Insert(partition, m->ts, m->context, m->event);
+        delete m;
+    }
+    received.clear();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(Partition* partition)
+{
+    Scheduler::Event next = partition->events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= partition->currentTs);
+    partition->eventCount++;
+    partition->currentTs = next.key.m_ts;
+    partition->currentContext = next.key.m_context;
+    partition->currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::RunWindow(Partition* partition)
+{
+    while (!partition->events->IsEmpty() &&
+           partition->events->PeekNext().key.m_ts < m_windowEnd)
+    {
+        ProcessOneEvent(partition);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Barrier()
+{
+    uint32_t phase = m_phase.load(std::memory_order_acquire);
+    if (m_waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == m_nThreads)
+    {
+        m_waiting.store(0, std::memory_order_relaxed);
+        m_phase.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    while (m_phase.load(std::memory_order_acquire) == phase)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Worker(Partition* partition)
+{
+    g_current = partition;
+    Packet::SetUidCounter(partition->index, &partition->packetUid);
+    while (true)
+    {
+        Barrier();
+        if (m_command == EXIT)
+        {
+            break;
+        }
+        RunWindow(partition);
+        Barrier();
+        Receive(partition);
+        Barrier();
+    }
+    Packet::SetUidCounter(0, nullptr);
+    g_current = nullptr;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    for (const auto& partition : m_partitions)
+    {
+        if (!partition->events->IsEmpty() || partition->mailbox.load() != nullptr)
+        {
+            return false;
+        }
+    }
+    return m_global->events->IsEmpty() && m_global->mailbox.load() == nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    m_mainThreadId = std::this_thread::get_id();
+    m_stop = false;
+    if (!m_partitioned)
+    {
+        uint32_t threads = m_maxThreads;
+        if (threads == 0)
+        {
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        }
+        PartitionNodes(threads);
+    }
+
+    m_nThreads = m_partitions.size();
+    m_command = RUN;
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < m_nThreads; ++i)
+    {
+        workers.emplace_back(&MultithreadedSimulatorImpl::Worker, this, m_partitions[i].get());
+    }
+
+    Partition* global = m_global.get();
+    while (!m_stop)
+    {
+        uint64_t next = NO_TS;
+        for (const auto& partition : m_partitions)
+        {
+            if (!partition->events->IsEmpty())
+            {
+                next = std::min(next, partition->events->PeekNext().key.m_ts);
+            }
+        }
+        uint64_t nextGlobal = global->events->IsEmpty() ? NO_TS : global->events->PeekNext().key.m_ts;
+        if (next == NO_TS && nextGlobal == NO_TS)
+        {
+            break;
+        }
+        if (nextGlobal < next)
+        {
+            // Global events may touch any node: run them alone.
+            ProcessOneEvent(global);
+            continue;
+        }
+
+        m_windowEnd = std::min(SaturatingAdd(next, m_lookahead), SaturatingAdd(nextGlobal, 1));
+        Barrier();
+        g_current = m_partitions[0].get();
+        Packet::SetUidCounter(0, &g_current->packetUid);
+        RunWindow(g_current);
+        Packet::SetUidCounter(0, nullptr);
+        Barrier();
+        Receive(g_current);
+        g_current = nullptr;
+        Barrier();
+        Receive(global);
+    }
+
+    m_command = EXIT;
+    Barrier();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    m_nThreads = 1;
+    m_windowEnd = NO_TS;
+
+    // The clock seen from outside Run() is the latest one.
+    for (const auto& partition : m_partitions)
+    {
+        global->currentTs = std::max(global->currentTs, partition->currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    Partition* partition = Current();
+    Time tAbsolute = delay + TimeStep(partition->currentTs);
+    return Insert(partition, tAbsolute.GetTimeStep(), partition->currentContext, event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    Partition* source = Current();
+    Partition* destination = PartitionOf(context);
+    Time tAbsolute = delay + TimeStep(source->currentTs);
+    if (source == destination || source == m_global.get())
+    {
+        // The main thread owns every partition between windows.
+        Insert(destination, tAbsolute.GetTimeStep(), context, event);
+    }
+    else
+    {
+        Send(source, destination, tAbsolute.GetTimeStep(), context, event);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    EventId id(Ptr<EventImpl>(event, false), Current()->currentTs, 0xffffffff, 2);
+    std::unique_lock lock{m_destroyMutex};
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(Current()->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs() - Current()->currentTs);
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        std::unique_lock lock{m_destroyMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Partition* partition = PartitionOf(id.GetContext());
+    NS_ASSERT_MSG(partition == Current() || Current() == m_global.get(),
+                  "MultithreadedSimulatorImpl: cannot remove an event of another partition");
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    partition->events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        std::unique_lock lock{m_destroyMutex};
+        return std::find(m_destroyEvents.begin(), m_destroyEvents.end(), id) ==
+               m_destroyEvents.end();
+    }
+    const Partition* partition = PartitionOf(id.GetContext());
+    return id.PeekEventImpl() == nullptr || id.GetTs() < partition->currentTs ||
+           (id.GetTs() == partition->currentTs && id.GetUid() <= partition->currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(NO_TS);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return Current()->currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = m_global->eventCount;
+    for (const auto& partition : m_partitions)
+    {
+        count += partition->eventCount;
+    }
+    return count;
+}
+
+} // namespace ns3
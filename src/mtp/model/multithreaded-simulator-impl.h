@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/nstime.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+class Scheduler;
+
+/**
+ * \defgroup mtp Multithreaded Parallel Simulation
+ *
+ * Conservative parallel simulation on the threads of a single process.
+ */
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Conservative parallel simulator running on the threads of a
+ * single process.
+ *
+ * At the first call to Run() the nodes are split into partitions, one
+ * per thread.  Nodes joined by a channel other than a point-to-point
+ * channel, or by a point-to-point channel whose delay does not exceed
+ * \c MinLookahead, always share a partition; these groups are then
+ * assigned in breadth-first order, so that each partition is a connected
+ * region of roughly the same number of nodes and devices.  The smallest
+ * delay of the point-to-point channels between partitions is the
+ * lookahead.
+ *
+ * Each partition has its own event list, clock and event uids, and runs
+ * on its own thread.  Time advances in windows: every partition executes
+ * its events earlier than the smallest next event time plus the
+ * lookahead, then all threads meet at a barrier.  An event scheduled for
+ * a node of another partition is necessarily beyond the end of the
+ * window; it is pushed on a lock-free list of the destination, which
+ * sorts and inserts the events it received at the start of the next
+ * window.  Packets created by a partition take their uids from a counter
+ * of that partition (see Packet::SetUidCounter), so runs are reproducible
+ * whatever the thread timing.
+ *
+ * Events without a node context (Simulator::NO_CONTEXT, or a context
+ * which is not a node id) belong to a global partition which the main
+ * thread executes alone, between windows; node events at the same time
+ * run first.
+ *
+ * An event may only touch the objects of its own node, as with
+ * DistributedSimulatorImpl; trace sinks shared between nodes must be
+ * thread-safe.  Stop() called from an event stops the simulation at the
+ * end of the current window.  Nodes created after the first Run() are
+ * simulated in the global partition.
+ *
+ * This implementation is only built with NS3_MTP, which also makes the
+ * reference counts of ns-3 objects and packets thread-safe.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    void Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Get the number of node partitions.
+     *
+     * \returns The number of partitions, 0 before the first Run().
+     */
+    uint32_t GetPartitionCount() const;
+    /**
+     * Get the partition of a node.
+     *
+     * \param [in] nodeId The node id.
+     * \returns The partition index, or GetPartitionCount() for nodes
+     *          simulated in the global partition.
+     */
+    uint32_t GetPartition(uint32_t nodeId) const;
+    /**
+     * Get the lookahead between partitions.
+     *
+     * \returns The smallest delay of the channels between partitions,
+     *          or GetMaximumSimulationTime() if there are none.
+     */
+    Time GetLookahead() const;
+
+  private:
+    void DoDispose() override;
+
+    /** An event sent to another partition. */
+    struct Message
+    {
+        Message* next;    //!< Next message in the mailbox
+        uint64_t ts;      //!< Event time stamp
+        uint32_t context; //!< Event context
+        uint32_t source;  //!< Index of the sending partition
+        uint64_t seq;     //!< Sequence number within the sending partition
+        EventImpl* event; //!< The event
+    };
+
+    /** A partition: the event list and clock of a group of nodes. */
+    struct Partition
+    {
+        Ptr<Scheduler> events;          //!< Event list
+        std::atomic<Message*> mailbox;  //!< Events sent by other partitions
+        uint32_t index;                 //!< Partition index
+        uint64_t currentTs;             //!< Time stamp of the current event
+        uint32_t currentContext;        //!< Context of the current event
+        uint32_t currentUid;            //!< Uid of the current event
+        uint32_t uid;                   //!< Next event uid
+        uint32_t packetUid;             //!< Next packet uid
+        uint64_t eventCount;            //!< Number of events executed
+        uint64_t sent;                  //!< Number of messages sent
+        std::vector<Message*> received; //!< Messages being inserted
+    };
+
+    /**
+     * Split the nodes into partitions and compute the lookahead.
+     *
+     * \param [in] count The maximum number of partitions.
+     */
+    void PartitionNodes(uint32_t count);
+    /**
+     * Get the partition of an event context.
+     *
+     * \param [in] context The context.
+     * \returns The partition.
+     */
+    Partition* PartitionOf(uint32_t context) const;
+    /**
+     * Get the partition of the calling thread.
+     *
+     * \returns The partition.
+     */
+    Partition* Current() const;
+    /**
+     * Insert an event in a partition owned by the calling thread.
+     *
+     * \param [in] partition The partition.
+     * \param [in] ts The event time stamp.
+     * \param [in] context The event context.
+     * \param [in] event The event.
+     * \returns The event id.
+     */
+    EventId Insert(Partition* partition, uint64_t ts, uint32_t context, EventImpl* event);
+    /**
+     * Move the messages received by a partition into its event list, in
+     * (time stamp, source, sequence) order.
+     *
+     * \param [in] partition The partition.
+     */
+    void Receive(Partition* partition);
+    /**
+     * Execute the events of a partition earlier than the end of the window.
+     *
+     * \param [in] partition The partition.
+     */
+    void RunWindow(Partition* partition);
+    /**
+     * The loop of a worker thread.
+     *
+     * \param [in] partition The partition of the thread.
+     */
+    void Worker(Partition* partition);
+    /**
+     * Wait until all threads reach the barrier.
+     */
+    void Barrier();
+
+    /**
+     * Create an empty partition.
+     *
+     * \param [in] index The partition index.
+     * \returns The partition.
+     */
+    std::unique_ptr<Partition> CreatePartition(uint32_t index) const;
+    /**
+     * Send an event to another partition.
+     *
+     * \param [in] source The sending partition.
+     * \param [in] destination The destination partition.
+     * \param [in] ts The event time stamp.
+     * \param [in] context The event context.
+     * \param [in] event The event.
+     */
+    void Send(Partition* source,
+              Partition* destination,
+              uint64_t ts,
+              uint32_t context,
+              EventImpl* event);
+    /**
+     * Execute the next event of a partition.
+     *
+     * \param [in] partition The partition.
+     */
+    void ProcessOneEvent(Partition* partition);
+
+    /** Partition of the calling thread, if it runs a window. */
+    static thread_local Partition* g_current;
+
+    /** Commands given to the worker threads. */
+    enum Command
+    {
+        RUN, //!< Run a window, then receive messages
+        EXIT //!< Leave the worker loop
+    };
+
+    uint32_t m_maxThreads;    //!< MaxThreads attribute
+    Time m_minLookahead;      //!< MinLookahead attribute
+    ObjectFactory m_factory;  //!< Scheduler factory
+    bool m_partitioned;       //!< Whether the nodes have been partitioned
+    uint64_t m_lookahead;     //!< Lookahead, in time steps
+    std::vector<uint32_t> m_partitionOf; //!< Partition of each node id
+    std::vector<std::unique_ptr<Partition>> m_partitions; //!< Node partitions
+    std::unique_ptr<Partition> m_global; //!< Global partition, run by the main thread
+
+    uint64_t m_windowEnd;             //!< End of the current window (excluded)
+    Command m_command;                //!< Command for the worker threads
+    std::atomic<bool> m_stop;         //!< Stop at the end of the window
+    std::atomic<uint32_t> m_waiting;  //!< Threads waiting at the barrier
+    std::atomic<uint32_t> m_phase;    //!< Barrier generation
+    uint32_t m_nThreads;              //!< Threads meeting at the barrier
+    std::thread::id m_mainThreadId;   //!< Thread running the global partition
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    DestroyEvents m_destroyEvents; //!< The events to run at Destroy
+    mutable std::mutex m_destroyMutex; //!< Protects m_destroyEvents
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
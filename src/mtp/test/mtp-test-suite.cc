@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+/**
+ * \ingroup mtp
+ * \defgroup mtp-tests Multithreaded simulation tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Check the partitions and the lookahead computed for a chain whose
+ * links have mixed delays.
+ */
+class MtpPartitionTestCase : public TestCase
+{
+  public:
+    MtpPartitionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MtpPartitionTestCase::MtpPartitionTestCase()
+    : TestCase("Partitioning of a chain of point-to-point links")
+{
+}
+
+void
+MtpPartitionTestCase::DoRun()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(3));
+    impl->SetAttribute("MinLookahead", TimeValue(MicroSeconds(10)));
+    Simulator::SetImplementation(impl);
+
+    // 0 -1ms- 1 -1us- 2 -2ms- 3 -1us- 4 -3ms- 5
+    const char* delays[] = {"1ms", "1us", "2ms", "1us", "3ms"};
+    NodeContainer nodes;
+    nodes.Create(6);
+    PointToPointHelper p2p;
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        p2p.SetChannelAttribute("Delay", StringValue(delays[i]));
+        p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+    }
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), 3, "Wrong number of partitions");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartition(0), impl->GetPartition(1), "Light group split");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartition(1), impl->GetPartition(2), "Short link cut");
+    NS_TEST_EXPECT_MSG_NE(impl->GetPartition(2), impl->GetPartition(3), "Groups not spread");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartition(3), impl->GetPartition(4), "Short link cut");
+    NS_TEST_EXPECT_MSG_NE(impl->GetPartition(4), impl->GetPartition(5), "Groups not spread");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetLookahead(), MilliSeconds(2), "Wrong lookahead");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Run packets around a ring of point-to-point links with the default and
+ * the multithreaded simulators, and compare what every node received.
+ * The multithreaded simulator runs twice, and must give the packets the
+ * same uids both times.
+ */
+class MtpEquivalenceTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] threads The number of threads of the multithreaded simulator.
+     */
+    MtpEquivalenceTestCase(uint32_t threads);
+
+  private:
+    void DoRun() override;
+
+    /** A received packet: time, size, receiving device. */
+    typedef std::tuple<int64_t, uint32_t, uint32_t> Reception;
+    /** The uid of a received packet: time, uid. */
+    typedef std::pair<int64_t, uint64_t> ReceivedUid;
+
+    /**
+     * Run the ring.
+     *
+     * \param [in] impl The simulator implementation.
+     */
+    void RunRing(Ptr<SimulatorImpl> impl);
+    /**
+     * Run the ring with the multithreaded simulator.
+     *
+     * \returns The uids of the packets received by each node.
+     */
+    std::vector<std::vector<ReceivedUid>> RunMultithreaded();
+    /**
+     * Send a packet.
+     *
+     * \param [in] device The sending device.
+     * \param [in] size The packet size.
+     */
+    void Send(Ptr<NetDevice> device, uint32_t size);
+    /**
+     * Log a received packet and forward it on the other device of the node.
+     *
+     * \param [in] device The receiving device.
+     * \param [in] packet The packet.
+     * \param [in] protocol The protocol number.
+     * \param [in] sender The sender address.
+     * \returns true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& sender);
+
+    uint32_t m_threads;                           //!< Number of threads
+    std::vector<std::vector<Reception>> m_rx;     //!< Packets received by each node
+    std::vector<std::vector<Reception>> m_refRx;  //!< Reference receptions
+    std::vector<std::vector<ReceivedUid>> m_uids; //!< Uids received by each node
+};
+
+MtpEquivalenceTestCase::MtpEquivalenceTestCase(uint32_t threads)
+    : TestCase("Same receptions as the default simulator with " + std::to_string(threads) +
+               " threads"),
+      m_threads(threads)
+{
+}
+
+void
+MtpEquivalenceTestCase::Send(Ptr<NetDevice> device, uint32_t size)
+{
+    device->Send(Create<Packet>(size), device->GetBroadcast(), 0x0800);
+}
+
+bool
+MtpEquivalenceTestCase::Receive(Ptr<NetDevice> device,
+                                Ptr<const Packet> packet,
+                                uint16_t protocol,
+                                const Address& sender)
+{
+    Ptr<Node> node = device->GetNode();
+    NS_ASSERT(Simulator::GetContext() == node->GetId());
+    uint32_t size = packet->GetSize();
+    m_rx[node->GetId()].emplace_back(Simulator::Now().GetTimeStep(), size, device->GetIfIndex());
+    m_uids[node->GetId()].emplace_back(Simulator::Now().GetTimeStep(), packet->GetUid());
+    if (size > 100)
+    {
+        // Forward on the other device, one byte shorter.
+        Send(node->GetDevice(1 - device->GetIfIndex()), size - 1);
+    }
+    return true;
+}
+
+void
+MtpEquivalenceTestCase::RunRing(Ptr<SimulatorImpl> impl)
+{
+    Simulator::SetImplementation(impl);
+    const uint32_t n = 12;
+    NodeContainer nodes;
+    nodes.Create(n);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        p2p.SetChannelAttribute("Delay", TimeValue(MicroSeconds(500 + 250 * (i % 3))));
+        p2p.Install(nodes.Get(i), nodes.Get((i + 1) % n));
+    }
+    m_rx.assign(n, {});
+    m_uids.assign(n, {});
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        Ptr<Node> node = nodes.Get(i);
+        for (uint32_t j = 0; j < node->GetNDevices(); ++j)
+        {
+            node->GetDevice(j)->SetReceiveCallback(
+                MakeCallback(&MtpEquivalenceTestCase::Receive, this));
+        }
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            Simulator::ScheduleWithContext(i,
+                                           MicroSeconds(37 * i + 300 * k),
+                                           &MtpEquivalenceTestCase::Send,
+                                           this,
+                                           node->GetDevice(k % 2),
+                                           130 + 5 * k + i % 7);
+        }
+    }
+    Simulator::Run();
+}
+
+std::vector<std::vector<MtpEquivalenceTestCase::ReceivedUid>>
+MtpEquivalenceTestCase::RunMultithreaded()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(m_threads));
+    RunRing(impl);
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), m_threads, "Wrong number of partitions");
+    if (m_threads > 1)
+    {
+        NS_TEST_EXPECT_MSG_EQ(impl->GetLookahead(), MicroSeconds(500), "Wrong lookahead");
+    }
+    Simulator::Destroy();
+    for (auto& uids : m_uids)
+    {
+        std::sort(uids.begin(), uids.end());
+    }
+    return m_uids;
+}
+
+void
+MtpEquivalenceTestCase::DoRun()
+{
+    RunRing(CreateObject<DefaultSimulatorImpl>());
+    uint64_t refEvents = Simulator::GetEventCount();
+    Time refEnd = Simulator::Now();
+    Simulator::Destroy();
+    m_refRx = m_rx;
+
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(m_threads));
+    RunRing(impl);
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), m_threads, "Wrong number of partitions");
+    if (m_threads > 1)
+    {
+        NS_TEST_EXPECT_MSG_EQ(impl->GetLookahead(), MicroSeconds(500), "Wrong lookahead");
+    }
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), refEvents, "Different number of events");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), refEnd, "Different end time");
+    Simulator::Destroy();
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < m_rx.size(); ++i)
+    {
+        // Events at the same time on one node may run in another order.
+        std::sort(m_rx[i].begin(), m_rx[i].end());
+        std::sort(m_refRx[i].begin(), m_refRx[i].end());
+        NS_TEST_EXPECT_MSG_EQ((m_rx[i] == m_refRx[i]), true, "Different receptions on node " << i);
+        total += m_refRx[i].size();
+    }
+    NS_TEST_EXPECT_MSG_GT(total, 1000, "Too little traffic to compare");
+
+    std::vector<std::vector<ReceivedUid>> first = RunMultithreaded();
+    std::vector<std::vector<ReceivedUid>> second = RunMultithreaded();
+    for (uint32_t i = 0; i < first.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ((first[i] == second[i]), true, "Different uids on node " << i);
+    }
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * MultithreadedSimulatorImpl test suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite();
+};
+
+MtpTestSuite::MtpTestSuite()
+    : TestSuite("mtp", UNIT)
+{
+    AddTestCase(new MtpPartitionTestCase(), TestCase::QUICK);
+    AddTestCase(new MtpEquivalenceTestCase(1), TestCase::QUICK);
+    AddTestCase(new MtpEquivalenceTestCase(2), TestCase::QUICK);
+    AddTestCase(new MtpEquivalenceTestCase(4), TestCase::QUICK);
+}
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
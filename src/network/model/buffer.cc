@@ -47,6 +47,17 @@ struct Zeroes
     const uint32_t size; //!< buffer size
 } g_zeroes;              //!< Zero-filled buffer
 
+#ifdef NS3_MTP
+/**
+ * Copies of a buffer may be used by different threads, so the data they
+ * share is never extended in place.
+ */
+constexpr bool GROW_SHARED_DATA = false;
+#else
+/** Copies of a buffer may extend the data they share in place. */
+constexpr bool GROW_SHARED_DATA = true;
+#endif
+
 } // namespace
 
 namespace ns3
@@ -54,7 +65,11 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
+#endif
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -266,8 +281,7 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -289,8 +303,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
@@ -315,7 +328,7 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+    bool isDirty = m_data->m_count > 1 && (!GROW_SHARED_DATA || m_start > m_data->m_dirtyStart);
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -333,8 +346,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -361,7 +373,7 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+    bool isDirty = m_data->m_count > 1 && (!GROW_SHARED_DATA || m_end < m_data->m_dirtyEnd);
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -379,8 +391,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -25,7 +25,13 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#else
+// The free list is shared by all threads: the multithreaded simulator
+// leaves recycling to the (per-thread) memory allocator instead.
 #define BUFFER_FREE_LIST 1
+#endif
 
 namespace ns3
 {
@@ -665,7 +671,11 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
          * the size of the m_data field below.
          */
@@ -769,7 +779,11 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
+#ifdef NS3_MTP
+    static thread_local uint32_t g_recommendedStart;
+#else
     static uint32_t g_recommendedStart;
+#endif
 
     /**
      * offset to the start of the virtual zero area from the start
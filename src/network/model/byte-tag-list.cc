@@ -24,7 +24,17 @@
 #include <limits>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+// Copies of a tag list may be used by different threads, so the data
+// they share is never appended to in place
+#define GROW_SHARED_DATA 0
+#else
+// The free list is shared by all threads, so it is left out of the
+// multithreaded simulator build
 #define USE_FREE_LIST 1
+#define GROW_SHARED_DATA 1
+#endif
 #define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (std::numeric_limits<int32_t>::max())
 
@@ -43,7 +53,11 @@ NS_LOG_COMPONENT_DEFINE("ByteTagList");
 struct ByteTagListData
 {
     uint32_t size;   //!< size of the data
-    uint32_t count;  //!< use counter (for smart deallocation)
+#ifdef NS3_MTP
+    std::atomic<uint32_t> count; //!< use counter (for smart deallocation)
+#else
+    uint32_t count; //!< use counter (for smart deallocation)
+#endif
     uint32_t dirty;  //!< number of bytes actually in use
     uint8_t data[4]; //!< data
 };
@@ -211,7 +225,7 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
         m_data = Allocate(spaceNeeded);
         m_used = 0;
     }
-    else if (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used))
+    else if (m_data->size < spaceNeeded || (m_data->count != 1 && (!GROW_SHARED_DATA || m_data->dirty != m_used)))
     {
         ByteTagListData* newData = Allocate(spaceNeeded);
         std::memcpy(&newData->data, &m_data->data, m_used);
@@ -386,8 +400,7 @@ ByteTagList::Deallocate(ByteTagListData* data)
         return;
     }
     g_maxSize = std::max(g_maxSize, data->size);
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
         if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
         {
@@ -423,8 +436,7 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
         uint8_t* buffer = (uint8_t*)data;
         delete[] buffer;
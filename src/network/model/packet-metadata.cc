@@ -29,6 +29,29 @@
 #include <list>
 #include <utility>
 
+namespace
+{
+
+#ifdef NS3_MTP
+/**
+ * The free list and its size heuristic are shared by all threads, so the
+ * multithreaded simulator leaves recycling to the memory allocator.
+ */
+constexpr bool METADATA_FREE_LIST = false;
+/**
+ * Copies of a packet may be used by different threads, so the metadata
+ * they share is never appended to in place.
+ */
+constexpr bool GROW_SHARED_DATA = false;
+#else
+/** Recycle metadata storage through PacketMetadata::m_freeList. */
+constexpr bool METADATA_FREE_LIST = true;
+/** Copies of a packet may append to the metadata they share in place. */
+constexpr bool GROW_SHARED_DATA = true;
+#endif
+
+} // unnamed namespace
+
 namespace ns3
 {
 
@@ -38,7 +61,11 @@ bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
+#ifdef NS3_MTP
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
+#else
 uint16_t PacketMetadata::m_chunkUid = 0;
+#endif
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
 
 PacketMetadata::DataFreeList::~DataFreeList()
@@ -80,8 +107,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -105,7 +131,8 @@ PacketMetadata::Reserve(uint32_t size)
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
     if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+        (m_data->m_count == 1 ||
+         (GROW_SHARED_DATA && (m_head == 0xffff || m_data->m_dirtyEnd == m_used))))
     {
         /* enough room, not dirty. */
     }
@@ -136,6 +163,10 @@ bool
 PacketMetadata::IsStateOk() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_data == nullptr)
+    {
+        return m_head == 0xffff && m_tail == 0xffff;
+    }
     bool ok = m_used <= m_data->m_size;
     ok &= IsPointerOk(m_head);
     ok &= IsPointerOk(m_tail);
@@ -385,7 +416,8 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
     if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+        (m_data->m_count != 1 &&
+         (!GROW_SHARED_DATA || (m_head != 0xffff && m_used != m_data->m_dirtyEnd))))
     {
         ReserveCopy(n);
     }
@@ -422,7 +454,8 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
     if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+        (m_data->m_count != 1 &&
+         (!GROW_SHARED_DATA || (m_head != 0xffff && m_used != m_data->m_dirtyEnd))))
     {
         ReserveCopy(n);
     }
@@ -567,6 +600,10 @@ PacketMetadata::Data*
 PacketMetadata::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
+    if (!METADATA_FREE_LIST)
+    {
+        return PacketMetadata::Allocate(size);
+    }
     NS_LOG_LOGIC("create size=" << size << ", max=" << m_maxSize);
     if (size > m_maxSize)
     {
@@ -593,7 +630,7 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    if (!m_enable || !METADATA_FREE_LIST)
     {
         PacketMetadata::Deallocate(data);
         return;
@@ -650,6 +687,10 @@ void
 PacketMetadata::AddHeader(const Header& header, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &header << size);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
     DoAddHeader(uid, size);
     NS_ASSERT(IsStateOk());
@@ -681,6 +722,10 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
 {
     uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &header << size);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -726,6 +771,10 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
 {
     uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &trailer << size);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -748,6 +797,10 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
 {
     uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &trailer << size);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -792,6 +845,17 @@ void
 PacketMetadata::AddAtEnd(const PacketMetadata& o)
 {
     NS_LOG_FUNCTION(this << &o);
+    if (m_data == nullptr)
+    {
+        return;
+    }
+    if (o.m_data == nullptr)
+    {
+        // The appended bytes are not described, so the result cannot
+        // describe its bytes either.
+        *this = PacketMetadata(m_packetUid);
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -868,6 +932,10 @@ void
 PacketMetadata::AddPaddingAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -879,6 +947,10 @@ void
 PacketMetadata::RemoveAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -940,6 +1012,10 @@ void
 PacketMetadata::RemoveAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
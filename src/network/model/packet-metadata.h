@@ -27,6 +27,10 @@
 
 #include <limits>
 #include <stdint.h>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 #include <vector>
 
 namespace ns3
@@ -176,6 +180,16 @@ class PacketMetadata
      * \param size size of the header
      */
     inline PacketMetadata(uint64_t uid, uint32_t size);
+    /**
+     * \brief Constructor of a lightweight metadata, which records nothing
+     * even when the metadata is enabled, and has no storage.
+     *
+     * All the operations on it are no-ops.  When it is appended to another
+     * metadata, the result is lightweight too, with the uid of the latter.
+     *
+     * \param uid packet uid
+     */
+    inline explicit PacketMetadata(uint64_t uid);
     /**
      * \brief Copy constructor
      * \param o the object to copy
@@ -192,6 +206,12 @@ class PacketMetadata
     // Delete default constructor to avoid misuse
     PacketMetadata() = delete;
 
+    /**
+     * \returns true if this metadata was built by PacketMetadata(uint64_t),
+     * or copied from one
+     */
+    inline bool IsLightweight() const;
+
     /**
      * \brief Add an header
      * \param header header to add
@@ -426,7 +446,11 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /** size (in bytes) of m_data buffer below */
         uint16_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
@@ -686,10 +710,14 @@ class PacketMetadata
      */
     static bool m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
+    static uint32_t m_maxSize; //!< maximum metadata size
+#ifdef NS3_MTP
+    static thread_local uint16_t m_chunkUid; //!< Chunk Uid
+#else
     static uint16_t m_chunkUid; //!< Chunk Uid
+#endif
 
-    Data* m_data; //!< Metadata storage
+    Data* m_data; //!< Metadata storage, or null if lightweight
     /*
        head -(next)-> tail
          ^             |
@@ -720,6 +748,21 @@ PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
     }
 }
 
+PacketMetadata::PacketMetadata(uint64_t uid)
+    : m_data(nullptr),
+      m_head(0xffff),
+      m_tail(0xffff),
+      m_used(0),
+      m_packetUid(uid)
+{
+}
+
+bool
+PacketMetadata::IsLightweight() const
+{
+    return m_data == nullptr;
+}
+
 PacketMetadata::PacketMetadata(const PacketMetadata& o)
     : m_data(o.m_data),
       m_head(o.m_head),
@@ -727,9 +770,11 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_used(o.m_used),
       m_packetUid(o.m_packetUid)
 {
-    NS_ASSERT(m_data != nullptr);
-    NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
-    m_data->m_count++;
+    if (m_data != nullptr)
+    {
+        NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
+        m_data->m_count++;
+    }
 }
 
 PacketMetadata&
@@ -738,15 +783,15 @@ PacketMetadata::operator=(const PacketMetadata& o)
     if (m_data != o.m_data)
     {
         // not self assignment
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (m_data != nullptr && --m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
         m_data = o.m_data;
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count++;
+        if (m_data != nullptr)
+        {
+            m_data->m_count++;
+        }
     }
     m_head = o.m_head;
     m_tail = o.m_tail;
@@ -757,9 +802,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
 
 PacketMetadata::~PacketMetadata()
 {
-    NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (m_data != nullptr && --m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -37,6 +37,18 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+/**
+ * \ingroup packet
+ * Assert that a TagData is a merge, i.e. has several incoming links.
+ * With NS3_MTP, the other lists sharing it may let go of it at any time
+ * from another thread, so it may have become private to this list.
+ */
+#ifdef NS3_MTP
+#define NS_ASSERT_TAG_MERGE(data)
+#else
+#define NS_ASSERT_TAG_MERGE(data) NS_ASSERT((data)->count > 1)
+#endif
+
 PacketTagList::TagData*
 PacketTagList::CreateTagData(size_t dataSize)
 {
@@ -121,7 +133,7 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 
     // At this point cur is a merge, but untested for tid
     NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
+    NS_ASSERT_TAG_MERGE(cur);
 
     /*
        Walk the remainder of the list, copying, until we find tid
@@ -149,8 +161,7 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     while (/* cur && */ cur->tid != tid)
     {
         NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
+        NS_ASSERT_TAG_MERGE(cur);
         TagData* copy = CreateTagData(cur->size);
         copy->tid = cur->tid;
         copy->count = 1;
@@ -160,12 +171,14 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
         copy->next->count++;    // mark new merge
         *prevNext = copy;       // point prior list at copy
         prevNext = &copy->next; // advance
+        // unmerge cur; another thread may have let go of it meanwhile
+        ReleaseTagData(cur);
         cur = copy->next;
     }
     // Sanity check:
     NS_ASSERT(cur != nullptr);  // cur should be non-zero
     NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
+    NS_ASSERT_TAG_MERGE(cur);   // cur should be a merge
 
     // link around tid, removing it from our list
     found = (this->*Writer)(tag, false, cur, prevNext);
@@ -201,13 +214,14 @@ PacketTagList::RemoveWriter(Tag& tag,
     else
     {
         // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
+        NS_ASSERT_TAG_MERGE(cur);
         if (cur->next != nullptr)
         {
             // there's a next, so make it a merge
             cur->next->count++;
         }
+        // unmerge cur, since we linked around it already
+        ReleaseTagData(cur);
     }
     return found;
 }
@@ -243,7 +257,7 @@ PacketTagList::ReplaceWriter(Tag& tag,
     {
         // cur is always a merge at this point
         // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
+        NS_ASSERT_TAG_MERGE(cur);
         TagData* copy = CreateTagData(tag.GetSerializedSize());
         copy->tid = tag.GetInstanceTypeId();
         copy->count = 1;
@@ -253,7 +267,8 @@ PacketTagList::ReplaceWriter(Tag& tag,
         {
             copy->next->count++; // mark new merge
         }
-        *prevNext = copy; // point prior list at copy
+        *prevNext = copy;     // point prior list at copy
+        ReleaseTagData(cur); // unmerge cur
     }
     return found;
 }
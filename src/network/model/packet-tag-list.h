@@ -29,6 +29,10 @@
 #include <ostream>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -141,8 +145,12 @@ class PacketTagList
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
+        TagData* next; //!< Pointer to next in list
+#ifdef NS3_MTP
+        std::atomic<uint32_t> count; //!< Number of incoming links
+#else
+        uint32_t count; //!< Number of incoming links
+#endif
         TypeId tid;      //!< Type of the tag serialized into #data
         uint32_t size;   //!< Size of the \c data buffer
         uint8_t data[1]; //!< Serialization buffer
@@ -252,6 +260,13 @@ class PacketTagList
      * \returns The newly constructed TagData object.
      */
     static TagData* CreateTagData(size_t dataSize);
+    /**
+     * Drop one incoming link to a TagData, freeing it and, in turn, the
+     * links it holds once it has none left.
+     *
+     * \param [in] data The TagData.
+     */
+    static inline void ReleaseTagData(TagData* data);
 
     /**
      * Typedef of method function pointer for copy-on-write operations
@@ -354,12 +369,18 @@ PacketTagList::~PacketTagList()
 
 void
 PacketTagList::RemoveAll()
+{
+    ReleaseTagData(m_next);
+    m_next = nullptr;
+}
+
+void
+PacketTagList::ReleaseTagData(TagData* data)
 {
     TagData* prev = nullptr;
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (TagData* cur = data; cur != nullptr; cur = cur->next)
     {
-        cur->count--;
-        if (cur->count > 0)
+        if (--cur->count > 0)
         {
             break;
         }
@@ -375,7 +396,6 @@ PacketTagList::RemoveAll()
         prev->~TagData();
         std::free(prev);
     }
-    m_next = nullptr;
 }
 
 } // namespace ns3
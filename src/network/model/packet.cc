@@ -30,7 +30,42 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
+
+#ifdef NS3_MTP
+namespace
+{
+/// Packet uid counter of the partition run by this thread, if any.
+thread_local uint32_t* g_uidCounter = nullptr;
+/// Partition bits of the packet uids allocated by this thread.
+thread_local uint64_t g_uidPartition = 0;
+} // unnamed namespace
+
+void
+Packet::SetUidCounter(uint32_t partition, uint32_t* counter)
+{
+    NS_ASSERT(partition < 0xffff);
+    g_uidCounter = counter;
+    g_uidPartition = static_cast<uint64_t>(partition + 1) << 48;
+}
+#endif
+
+uint64_t
+Packet::AllocateUid()
+{
+    uint64_t systemId = static_cast<uint64_t>(Simulator::GetSystemId()) << 32;
+#ifdef NS3_MTP
+    if (g_uidCounter != nullptr)
+    {
+        return g_uidPartition | systemId | (*g_uidCounter)++;
+    }
+#endif
+    return systemId | m_globalUid++;
+}
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -146,10 +181,9 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(AllocateUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -186,10 +220,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -213,10 +246,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -234,6 +266,23 @@ Packet::Packet(const Buffer& buffer,
 {
 }
 
+Ptr<Packet>
+Packet::CreateLightweight(uint32_t size)
+{
+    NS_LOG_FUNCTION(size);
+    // see Packet::Packet () for the uid
+    PacketMetadata metadata(AllocateUid());
+    // call the constructor directly rather than
+    // through Create because it is private.
+    return Ptr<Packet>(new Packet(Buffer(size), ByteTagList(), PacketTagList(), metadata), false);
+}
+
+bool
+Packet::IsLightweight() const
+{
+    return m_metadata.IsLightweight();
+}
+
 Ptr<Packet>
 Packet::CreateFragment(uint32_t start, uint32_t length) const
 {
@@ -455,6 +504,11 @@ Packet::ToString() const
 void
 Packet::Print(std::ostream& os) const
 {
+    if (IsLightweight())
+    {
+        os << "Lightweight (size=" << GetSize() << ")";
+        return;
+    }
     PacketMetadata::ItemIterator i = m_metadata.BeginItem(m_buffer);
     while (i.HasNext())
     {
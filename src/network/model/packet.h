@@ -35,6 +35,10 @@
 
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -208,6 +212,11 @@ class PacketTagIterator
  * call Packet::EnableChecking: its runtime cost is lower than
  * Packet::EnablePrinting.
  *
+ * - Lightweight packets, created by Packet::CreateLightweight, have no
+ * metadata even when it is enabled, so that bulk traffic does not pay for
+ * it while the other packets can still be printed and checked.  Their
+ * fragments and copies are lightweight too.
+ *
  * - The set of tags contain simulation-specific information which cannot
  * be stored in the packet byte buffer because the protocol headers or trailers
  * have no standard-conformant field for this information. So-called
@@ -290,6 +299,23 @@ class Packet : public SimpleRefCount<Packet>
      * \param size the size of the input buffer.
      */
     Packet(const uint8_t* buffer, uint32_t size);
+    /**
+     * \brief Create a lightweight packet with a zero-filled payload.
+     *
+     * A lightweight packet never records metadata, which allocates no
+     * metadata storage; the byte tags and packet tags work as usual.
+     * Packet::Print only shows its size.  When it is added at the end of
+     * another packet, that packet becomes lightweight too.
+     *
+     * \param size the size of the zero-filled payload
+     * \returns the packet, with a new uid
+     */
+    static Ptr<Packet> CreateLightweight(uint32_t size);
+    /**
+     * \returns true if this packet was created by CreateLightweight, or
+     * is a copy or fragment of such a packet
+     */
+    bool IsLightweight() const;
     /**
      * \brief Create a new packet which contains a fragment of the original
      * packet.
@@ -536,6 +562,23 @@ class Packet : public SimpleRefCount<Packet>
      * errors will be detected and will abort the program.
      */
     static void EnableChecking();
+#ifdef NS3_MTP
+    /**
+     * \brief Give the packets created by the calling thread uids of their own.
+     *
+     * By default the uids come from a counter shared by all the threads,
+     * so that they depend on the thread timing.  A parallel simulator
+     * calls this method from the thread running a partition, with a
+     * counter owned by that partition: the lower 32 bits of the uids are
+     * then taken from that counter, and bits 48 to 63 hold the partition
+     * index plus one.
+     *
+     * \param partition the index of the partition run by the calling thread
+     * \param counter the packet uid counter of the partition, or nullptr to
+     *        use the shared counter again
+     */
+    static void SetUidCounter(uint32_t partition, uint32_t* counter);
+#endif
 
     /**
      * \brief Returns number of bytes required for packet
@@ -787,6 +830,12 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * \brief Allocate the uid of a new packet.
+     * \returns the uid, with the system id in bits 32 to 47
+     */
+    static uint64_t AllocateUid();
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -795,7 +844,11 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
 };
 
 /**
@@ -1264,6 +1264,129 @@ PacketTagListTest::DoRun()
 } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Lightweight packet unit tests.
+ *
+ * The metadata checking is enabled, so that every operation on the
+ * metadata asserts PacketMetadata::IsStateOk; the metadata cannot be
+ * enabled once a header has been added without it, so this test runs first.
+ */
+class PacketLightweightTest : public TestCase
+{
+  public:
+    PacketLightweightTest();
+    void DoRun() override;
+
+  private:
+    /**
+     * Checks that a packet carries exactly one ATestTag<1>, over the given range
+     * \param p The packet
+     * \param start The expected tag start
+     * \param end The expected tag end
+     */
+    void CheckByteTag(Ptr<const Packet> p, uint32_t start, uint32_t end);
+};
+
+PacketLightweightTest::PacketLightweightTest()
+    : TestCase("Lightweight packets")
+{
+}
+
+void
+PacketLightweightTest::CheckByteTag(Ptr<const Packet> p, uint32_t start, uint32_t end)
+{
+    ByteTagIterator i = p->GetByteTagIterator();
+    NS_TEST_ASSERT_MSG_EQ(i.HasNext(), true, "Byte tag lost");
+    ByteTagIterator::Item item = i.Next();
+    NS_TEST_EXPECT_MSG_EQ(item.GetTypeId(), ATestTag<1>::GetTypeId(), "Wrong byte tag");
+    NS_TEST_EXPECT_MSG_EQ(item.GetStart(), start, "Wrong byte tag start");
+    NS_TEST_EXPECT_MSG_EQ(item.GetEnd(), end, "Wrong byte tag end");
+    NS_TEST_EXPECT_MSG_EQ(i.HasNext(), false, "Unexpected byte tag");
+}
+
+void
+PacketLightweightTest::DoRun()
+{
+    PacketMetadata::EnableChecking();
+
+    Ptr<Packet> p = Packet::CreateLightweight(100);
+    NS_TEST_EXPECT_MSG_EQ(p->IsLightweight(), true, "Not lightweight");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 100, "Wrong size");
+    p->AddHeader(ATestHeader<10>());
+    p->AddTrailer(ATestTrailer<5>());
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 115, "Wrong size");
+    NS_TEST_EXPECT_MSG_EQ(p->ToString(), "Lightweight (size=115)", "Wrong print");
+
+    // the normal packets still record their metadata
+    Ptr<Packet> normal = Create<Packet>(100);
+    normal->AddHeader(ATestHeader<10>());
+    NS_TEST_EXPECT_MSG_EQ(normal->IsLightweight(), false, "Lightweight");
+    NS_TEST_EXPECT_MSG_NE(normal->ToString().find("anon::ATestHeader<10>"),
+                          std::string::npos,
+                          "Header not printed");
+
+    // byte tags are kept and follow the bytes
+    p->AddByteTag(ATestTag<1>(), 10, 110);
+    CheckByteTag(p, 10, 110);
+
+    // packet tags work as usual
+    p->AddPacketTag(ATestTag<2>(7));
+    ATestTag<2> packetTag;
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(packetTag), true, "Packet tag lost");
+    NS_TEST_EXPECT_MSG_EQ(packetTag.GetData(), 7, "Wrong packet tag");
+
+    // copies and fragments stay lightweight
+    Ptr<Packet> copy = p->Copy();
+    NS_TEST_EXPECT_MSG_EQ(copy->IsLightweight(), true, "Copy not lightweight");
+    NS_TEST_EXPECT_MSG_EQ(copy->GetUid(), p->GetUid(), "Copy uid changed");
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(packetTag), true, "Packet tag not copied");
+    ATestHeader<10> header;
+    copy->RemoveHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(copy->GetSize(), 105, "Wrong size");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 115, "Original changed by its copy");
+    CheckByteTag(copy, 0, 100);
+
+    Ptr<Packet> fragment = p->CreateFragment(50, 30);
+    NS_TEST_EXPECT_MSG_EQ(fragment->IsLightweight(), true, "Fragment not lightweight");
+    NS_TEST_EXPECT_MSG_EQ(fragment->GetUid(), p->GetUid(), "Fragment uid changed");
+    NS_TEST_EXPECT_MSG_EQ(fragment->GetSize(), 30, "Wrong size");
+    CheckByteTag(fragment, 0, 30);
+    fragment->RemoveAtStart(10);
+    fragment->RemoveAtEnd(10);
+    fragment->AddPaddingAtEnd(5);
+    NS_TEST_EXPECT_MSG_EQ(fragment->GetSize(), 15, "Wrong size");
+
+    // appended to an empty packet, the result is lightweight
+    Ptr<Packet> empty = Create<Packet>();
+    empty->AddAtEnd(p);
+    NS_TEST_EXPECT_MSG_EQ(empty->IsLightweight(), true, "Not lightweight");
+    NS_TEST_EXPECT_MSG_EQ(empty->GetSize(), 115, "Wrong size");
+    CheckByteTag(empty, 10, 110);
+
+    // appended to a normal packet, the result is lightweight too, since its
+    // metadata could not describe the appended bytes
+    uint64_t uid = normal->GetUid();
+    normal->AddAtEnd(p);
+    NS_TEST_EXPECT_MSG_EQ(normal->IsLightweight(), true, "Not lightweight");
+    NS_TEST_EXPECT_MSG_EQ(normal->GetUid(), uid, "Uid changed");
+    NS_TEST_EXPECT_MSG_EQ(normal->GetSize(), 225, "Wrong size");
+    NS_TEST_EXPECT_MSG_EQ(normal->ToString(), "Lightweight (size=225)", "Wrong print");
+    CheckByteTag(normal, 120, 220);
+    normal->RemoveHeader(header);
+    normal->RemoveAtEnd(115);
+    NS_TEST_EXPECT_MSG_EQ(normal->GetSize(), 100, "Wrong size");
+    NS_TEST_EXPECT_MSG_EQ(normal->GetByteTagIterator().HasNext(), false, "Byte tag not removed");
+
+    // and a normal packet appended to a lightweight one is not described either
+    Ptr<Packet> q = Packet::CreateLightweight(10);
+    q->AddAtEnd(Create<Packet>(20));
+    NS_TEST_EXPECT_MSG_EQ(q->IsLightweight(), true, "Not lightweight");
+    NS_TEST_EXPECT_MSG_EQ(q->ToString(), "Lightweight (size=30)", "Wrong print");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1279,6 +1402,7 @@ class PacketTestSuite : public TestSuite
 PacketTestSuite::PacketTestSuite()
     : TestSuite("packet", UNIT)
 {
+    AddTestCase(new PacketLightweightTest, TestCase::QUICK);
     AddTestCase(new PacketTest, TestCase::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::QUICK);
 }
@@ -329,4 +329,27 @@ PointToPointHelper::Install(std::string aName, std::string bName)
     return Install(a, b);
 }
 
+NetDeviceContainer
+PointToPointHelper::InstallMany(const std::vector<Link>& links)
+{
+    NS_LOG_FUNCTION(this << links.size());
+
+    TypeId::AttributeInformation delayInfo;
+    bool found = PointToPointChannel::GetTypeId().LookupAttributeByName("Delay", &delayInfo);
+    NS_ABORT_MSG_UNLESS(found, "PointToPointChannel has no Delay attribute");
+
+    NetDeviceContainer container;
+    for (const auto& link : links)
+    {
+        NetDeviceContainer pair = Install(link.a, link.b);
+        Ptr<PointToPointNetDevice> devA = DynamicCast<PointToPointNetDevice>(pair.Get(0));
+        Ptr<PointToPointNetDevice> devB = DynamicCast<PointToPointNetDevice>(pair.Get(1));
+        devA->SetDataRate(link.dataRate);
+        devB->SetDataRate(link.dataRate);
+        delayInfo.accessor->Set(PeekPointer(devA->GetChannel()), TimeValue(link.delay));
+        container.Add(pair);
+    }
+    return container;
+}
+
 } // namespace ns3
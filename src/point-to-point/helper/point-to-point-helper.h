@@ -19,13 +19,16 @@
 #ifndef POINT_TO_POINT_HELPER_H
 #define POINT_TO_POINT_HELPER_H
 
+#include "ns3/data-rate.h"
 #include "ns3/net-device-container.h"
 #include "ns3/node-container.h"
+#include "ns3/nstime.h"
 #include "ns3/object-factory.h"
 #include "ns3/queue.h"
 #include "ns3/trace-helper.h"
 
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -43,6 +46,17 @@ class Node;
 class PointToPointHelper : public PcapHelperForDevice, public AsciiTraceHelperForDevice
 {
   public:
+    /**
+     * \brief The endpoints and parameters of one link created by InstallMany
+     */
+    struct Link
+    {
+        Ptr<Node> a;       //!< first node
+        Ptr<Node> b;       //!< second node
+        DataRate dataRate; //!< data rate of both net devices
+        Time delay;        //!< channel delay
+    };
+
     /**
      * Create a PointToPointHelper to make life easier when creating point to
      * point networks.
@@ -153,6 +167,21 @@ class PointToPointHelper : public PcapHelperForDevice, public AsciiTraceHelperFo
      */
     NetDeviceContainer Install(std::string aNode, std::string bNode);
 
+    /**
+     * \param links the links to create
+     * \return a NetDeviceContainer with two net devices per link, in the order
+     * of the links (a first, then b)
+     *
+     * Creates every link as Install(a, b) would, but with the data rate of
+     * both devices and the channel delay taken from each Link instead of from
+     * SetDeviceAttribute and SetChannelAttribute.  The object factories are
+     * configured once and reused, and the per-link values are written through
+     * cached attribute accessors, so no attribute is looked up by name or
+     * parsed from a string inside the loop.  The other device, channel and
+     * queue attributes apply to all links as usual.
+     */
+    NetDeviceContainer InstallMany(const std::vector<Link>& links);
+
   private:
     /**
      * \brief Enable pcap output the indicated net device.
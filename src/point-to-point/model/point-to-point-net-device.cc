@@ -335,7 +335,14 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
     NS_LOG_FUNCTION(this << packet);
     uint16_t protocol = 0;
 
-    if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt(packet))
+    if (!m_linkUp)
+    {
+        //
+        // The link is down, so the packet is lost.
+        //
+        m_phyRxDropTrace(packet);
+    }
+    else if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt(packet))
     {
         //
         // If we have an error model and it indicates that it is time to lose a
@@ -399,6 +406,33 @@ PointToPointNetDevice::NotifyLinkUp()
     m_linkChangeCallbacks();
 }
 
+void
+PointToPointNetDevice::NotifyLinkDown()
+{
+    NS_LOG_FUNCTION(this);
+    m_linkUp = false;
+    m_linkChangeCallbacks();
+}
+
+void
+PointToPointNetDevice::SetLinkUp(bool up)
+{
+    NS_LOG_FUNCTION(this << up);
+    if (up == m_linkUp)
+    {
+        return;
+    }
+    if (up)
+    {
+        NS_ASSERT_MSG(m_channel, "Cannot bring up the link of a device without a channel");
+        NotifyLinkUp();
+    }
+    else
+    {
+        NotifyLinkDown();
+    }
+}
+
 void
 PointToPointNetDevice::SetIfIndex(const uint32_t index)
 {
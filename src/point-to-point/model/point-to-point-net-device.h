@@ -142,6 +142,17 @@ class PointToPointNetDevice : public NetDevice
      */
     void SetReceiveErrorModel(Ptr<ErrorModel> em);
 
+    /**
+     * Bring the link down or back up, for instance to model a link failure.
+     *
+     * While its link is down, the PointToPointNetDevice drops the packets it
+     * is asked to send and the packets it receives.  The link change
+     * callbacks are called when the state changes.
+     *
+     * \param up true to bring the link up, false to bring it down.
+     */
+    void SetLinkUp(bool up);
+
     /**
      * Receive a packet from a connected PointToPointChannel.
      *
@@ -268,6 +279,13 @@ class PointToPointNetDevice : public NetDevice
      */
     void NotifyLinkUp();
 
+    /**
+     * \brief Make the link down
+     *
+     * It calls also the linkChange callback.
+     */
+    void NotifyLinkDown();
+
     /**
      * Enumeration of the states of the transmit machine of the net device.
      */
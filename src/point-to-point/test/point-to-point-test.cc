@@ -17,12 +17,16 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/data-rate.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-helper.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <string>
 
@@ -139,6 +143,176 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \brief Test class for PointToPointHelper::InstallMany
+ *
+ * Checks that every link gets its own data rate and delay, and that the
+ * helper's other attributes still apply to all of them.
+ */
+class PointToPointInstallManyTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointInstallManyTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+};
+
+PointToPointInstallManyTest::PointToPointInstallManyTest()
+    : TestCase("PointToPointHelper::InstallMany")
+{
+}
+
+void
+PointToPointInstallManyTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(3);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("Mtu", UintegerValue(1400));
+    p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("7p"));
+
+    std::vector<PointToPointHelper::Link> links;
+    links.push_back({nodes.Get(0), nodes.Get(1), DataRate("10Mbps"), MilliSeconds(2)});
+    links.push_back({nodes.Get(1), nodes.Get(2), DataRate("1Gbps"), MicroSeconds(30)});
+    links.push_back({nodes.Get(2), nodes.Get(0), DataRate("5Mbps"), Seconds(1)});
+    NetDeviceContainer devices = p2p.InstallMany(links);
+
+    NS_TEST_ASSERT_MSG_EQ(devices.GetN(), 6, "Two devices per link");
+    for (uint32_t i = 0; i < links.size(); ++i)
+    {
+        Ptr<PointToPointNetDevice> devA =
+            DynamicCast<PointToPointNetDevice>(devices.Get(2 * i));
+        Ptr<PointToPointNetDevice> devB =
+            DynamicCast<PointToPointNetDevice>(devices.Get(2 * i + 1));
+        NS_TEST_ASSERT_MSG_EQ(devA->GetNode(), links[i].a, "Device a on node a");
+        NS_TEST_ASSERT_MSG_EQ(devB->GetNode(), links[i].b, "Device b on node b");
+        NS_TEST_ASSERT_MSG_EQ(devA->GetChannel(), devB->GetChannel(), "Shared channel");
+
+        DataRateValue rate;
+        devA->GetAttribute("DataRate", rate);
+        NS_TEST_ASSERT_MSG_EQ(rate.Get(), links[i].dataRate, "Data rate of device a");
+        devB->GetAttribute("DataRate", rate);
+        NS_TEST_ASSERT_MSG_EQ(rate.Get(), links[i].dataRate, "Data rate of device b");
+        TimeValue delay;
+        devA->GetChannel()->GetAttribute("Delay", delay);
+        NS_TEST_ASSERT_MSG_EQ(delay.Get(), links[i].delay, "Channel delay");
+
+        NS_TEST_ASSERT_MSG_EQ(devA->GetMtu(), 1400, "Common device attribute");
+        NS_TEST_ASSERT_MSG_EQ(devB->GetQueue()->GetMaxSize(),
+                              QueueSize("7p"),
+                              "Common queue attribute");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \brief Test class for PointToPointNetDevice::SetLinkUp
+ *
+ * Checks that the link change callbacks are called on each change of the
+ * link state, and that no packet goes through a link that is down.
+ */
+class PointToPointLinkDownTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointLinkDownTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Callback function which counts the received packets
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    /**
+     * \brief Callback function which counts the link changes
+     */
+    void LinkChange();
+
+    uint32_t m_received{0};    //!< received packets
+    uint32_t m_linkChanges{0}; //!< link changes of the receiving device
+};
+
+PointToPointLinkDownTest::PointToPointLinkDownTest()
+    : TestCase("PointToPointNetDevice::SetLinkUp")
+{
+}
+
+bool
+PointToPointLinkDownTest::RxPacket(Ptr<NetDevice> dev,
+                                   Ptr<const Packet> pkt,
+                                   uint16_t mode,
+                                   const Address& sender)
+{
+    m_received++;
+    return true;
+}
+
+void
+PointToPointLinkDownTest::LinkChange()
+{
+    m_linkChanges++;
+}
+
+void
+PointToPointLinkDownTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper p2p;
+    NetDeviceContainer devices = p2p.Install(nodes);
+    Ptr<PointToPointNetDevice> devA = DynamicCast<PointToPointNetDevice>(devices.Get(0));
+    Ptr<PointToPointNetDevice> devB = DynamicCast<PointToPointNetDevice>(devices.Get(1));
+    devB->SetReceiveCallback(MakeCallback(&PointToPointLinkDownTest::RxPacket, this));
+    devB->AddLinkChangeCallback(MakeCallback(&PointToPointLinkDownTest::LinkChange, this));
+
+    // Packets in flight when the receiving side goes down are lost
+    Simulator::Schedule(Seconds(1.0), [devA]() {
+        devA->Send(Create<Packet>(100), devA->GetBroadcast(), 0x800);
+    });
+    Simulator::Schedule(Seconds(1.0), &PointToPointNetDevice::SetLinkUp, devB, false);
+    Simulator::Schedule(Seconds(1.0), &PointToPointNetDevice::SetLinkUp, devB, false);
+    Simulator::Schedule(Seconds(2.0), [this, devA, devB]() {
+        NS_TEST_EXPECT_MSG_EQ(m_received, 0, "Packet received on a link that is down");
+        devA->SetLinkUp(false);
+        NS_TEST_EXPECT_MSG_EQ(devA->IsLinkUp(), false, "Link still up");
+        NS_TEST_EXPECT_MSG_EQ(devA->Send(Create<Packet>(100), devA->GetBroadcast(), 0x800),
+                              false,
+                              "Packet sent on a link that is down");
+        devA->SetLinkUp(true);
+        devB->SetLinkUp(true);
+        devA->Send(Create<Packet>(100), devA->GetBroadcast(), 0x800);
+    });
+
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "Packet lost on a link that is back up");
+    NS_TEST_EXPECT_MSG_EQ(m_linkChanges, 2, "One link change callback per change");
+
+    Simulator::Destroy();
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -155,6 +329,8 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::QUICK);
+    AddTestCase(new PointToPointInstallManyTest, TestCase::QUICK);
+    AddTestCase(new PointToPointLinkDownTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
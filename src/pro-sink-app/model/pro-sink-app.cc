@@ -5,12 +5,24 @@
 #include "ns3/socket-factory.h"
 #include "ns3/uinteger.h"
 #include "ns3/buffer.h" // 包含 Buffer
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/pointer.h"
+#include "ns3/string.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-protocol.h"
 #include <cmath>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE("ProSinkApp"); 
 
+NS_OBJECT_ENSURE_REGISTERED(TaskHeader);
+NS_OBJECT_ENSURE_REGISTERED(TaskTimestampTag);
+NS_OBJECT_ENSURE_REGISTERED(MySink);
+NS_OBJECT_ENSURE_REGISTERED(MyProducer);
+
 // --- 0. TaskHeader 实现 ---
 
 TypeId TaskHeader::GetTypeId(void)
@@ -77,6 +89,67 @@ uint32_t TaskHeader::GetTaskId(void) const
     return m_taskId;
 }
 
+// --- 0. TaskTimestampTag 实现 ---
+
+TypeId TaskTimestampTag::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::TaskTimestampTag")
+        .SetParent<Tag>()
+        .SetGroupName("Applications")
+        .AddConstructor<TaskTimestampTag>()
+    ;
+    return tid;
+}
+
+TypeId TaskTimestampTag::GetInstanceTypeId(void) const
+{
+    return GetTypeId();
+}
+
+uint32_t TaskTimestampTag::GetSerializedSize(void) const
+{
+    // created (8 bytes) + sent (8 bytes)
+    return sizeof(int64_t) * 2;
+}
+
+void TaskTimestampTag::Serialize(TagBuffer i) const
+{
+    i.WriteU64(m_created);
+    i.WriteU64(m_sent);
+}
+
+void TaskTimestampTag::Deserialize(TagBuffer i)
+{
+    m_created = i.ReadU64();
+    m_sent = i.ReadU64();
+}
+
+void TaskTimestampTag::Print(std::ostream &os) const
+{
+    os << "Created=" << TimeStep(m_created).As(Time::S) << " Sent=" << TimeStep(m_sent).As(Time::S);
+}
+
+TaskTimestampTag::TaskTimestampTag()
+    : m_created(0), m_sent(0)
+{
+}
+
+void TaskTimestampTag::SetTimestamps(Time created, Time sent)
+{
+    m_created = created.GetTimeStep();
+    m_sent = sent.GetTimeStep();
+}
+
+Time TaskTimestampTag::GetCreated(void) const
+{
+    return TimeStep(m_created);
+}
+
+Time TaskTimestampTag::GetSent(void) const
+{
+    return TimeStep(m_sent);
+}
+
 
 // --- 1. MySink 实现 ---
 
@@ -91,6 +164,60 @@ TypeId MySink::GetTypeId(void)
                         "Trace triggered when a task is completed.",
                         MakeTraceSourceAccessor(&MySink::m_taskCompletedTrace),
                         "ns3::TracedCallback<uint32_t, uint32_t, uint32_t, uint32_t>")
+        .AddTraceSource("TaskEvicted",
+                        "Trace triggered when an incomplete task is dropped from the "
+                        "reassembly table (nodeId, producerId, taskId, rxBytes).",
+                        MakeTraceSourceAccessor(&MySink::m_taskEvictedTrace),
+                        "ns3::TracedCallback<uint32_t, uint32_t, uint32_t, uint32_t>")
+        .AddAttribute("ReassemblyTimeout",
+                      "Time without any packet after which an incomplete task is evicted. "
+                      "Zero disables the timeout.",
+                      TimeValue(Seconds(1)),
+                      MakeTimeAccessor(&MySink::m_reassemblyTimeout),
+                      MakeTimeChecker())
+        .AddAttribute("MaxPendingTasks",
+                      "Maximum number of incomplete tasks kept for reassembly; the least "
+                      "recently updated one is evicted beyond this. Zero means no limit.",
+                      UintegerValue(0),
+                      MakeUintegerAccessor(&MySink::m_maxPendingTasks),
+                      MakeUintegerChecker<uint32_t>())
+        .AddAttribute("ServiceModel",
+                      "Stepped polls the queue every simulation step and spends accumulated "
+                      "processing credit; Exact schedules one event per task completion and "
+                      "stays idle while the queue is empty.",
+                      EnumValue(MySink::SERVICE_EXACT),
+                      MakeEnumAccessor(&MySink::m_serviceModel),
+                      MakeEnumChecker(MySink::SERVICE_STEPPED, "Stepped",
+                                      MySink::SERVICE_EXACT, "Exact"))
+        .AddAttribute("Servers",
+                      "Number of parallel servers, each processing tasks at the configured "
+                      "rate (Exact model only).",
+                      UintegerValue(1),
+                      MakeUintegerAccessor(&MySink::m_servers),
+                      MakeUintegerChecker<uint32_t>(1))
+        .AddAttribute("ExponentialService",
+                      "If true, service times are exponential with mean 1/rate (M/M/c); "
+                      "otherwise they are exactly 1/rate (Exact model only).",
+                      BooleanValue(false),
+                      MakeBooleanAccessor(&MySink::m_exponentialService),
+                      MakeBooleanChecker())
+        .AddAttribute("QueueCapacity",
+                      "Maximum number of complete tasks waiting for service; further tasks "
+                      "are dropped. Zero means no limit.",
+                      UintegerValue(0),
+                      MakeUintegerAccessor(&MySink::m_queueCapacity),
+                      MakeUintegerChecker<uint32_t>())
+        .AddTraceSource("TaskDropped",
+                        "Trace triggered when a complete task is dropped because the queue "
+                        "is full (nodeId, producerId, taskId, queueLength).",
+                        MakeTraceSourceAccessor(&MySink::m_taskDroppedTrace),
+                        "ns3::TracedCallback<uint32_t, uint32_t, uint32_t, uint32_t>")
+        .AddTraceSource("TaskLatency",
+                        "Trace triggered when a task is completed, with its latency split into "
+                        "queueing (producer backlog and sink queue), transfer and service time "
+                        "(nodeId, producerId, taskId, queueing, transfer, service).",
+                        MakeTraceSourceAccessor(&MySink::m_taskLatencyTrace),
+                        "ns3::TracedCallback<uint32_t, uint32_t, uint32_t, ns3::Time, ns3::Time, ns3::Time>")
     ;
     return tid;
 }
@@ -99,11 +226,21 @@ MySink::MySink()
     : m_socket(nullptr),
       m_port(8080),
       m_taskSize(256 * 1024),
+      m_reassemblyTimeout(Seconds(1)),
+      m_maxPendingTasks(0),
+      m_tasksEvicted(0),
       m_simulationStep(MilliSeconds(1)),
       m_tasksCompleted(0),
       m_tasksPerSecond(1000.0),
       m_processingCredit(0.0),
-      m_running(false)
+      m_running(false),
+      m_serviceModel(SERVICE_EXACT),
+      m_servers(1),
+      m_exponentialService(false),
+      m_queueCapacity(0),
+      m_tasksDropped(0),
+      m_serviceTimeGenerator(CreateObject<ExponentialRandomVariable>()),
+      m_busyServers(0)
 {
 }
 
@@ -119,6 +256,49 @@ MySink::Setup(double tasksPerSecond, Time simulationStep)
     m_simulationStep = simulationStep;
 }
 
+uint32_t
+MySink::GetPendingTasks() const
+{
+    return m_pendingTasks.size();
+}
+
+uint32_t
+MySink::GetTasksEvicted() const
+{
+    return m_tasksEvicted;
+}
+
+uint32_t
+MySink::GetQueueLength() const
+{
+    return m_taskQueue.size();
+}
+
+uint32_t
+MySink::GetBusyServers() const
+{
+    return m_busyServers;
+}
+
+uint32_t
+MySink::GetTasksDropped() const
+{
+    return m_tasksDropped;
+}
+
+int64_t
+MySink::AssignStreams(int64_t stream)
+{
+    m_serviceTimeGenerator->SetStream(stream);
+    return 1;
+}
+
+uint64_t
+MySink::TaskKey(uint32_t producerId, uint32_t taskId)
+{
+    return (static_cast<uint64_t>(producerId) << 32) | taskId;
+}
+
 void
 MySink::StartApplication()
 {
@@ -134,18 +314,38 @@ MySink::StartApplication()
     }
     m_socket->SetRecvCallback(MakeCallback(&MySink::HandleRead, this));
     m_running = true;
-    Simulator::Schedule(m_simulationStep, &MySink::ProcessTasks, this);
+    if (m_serviceModel == SERVICE_STEPPED)
+    {
+        Simulator::Schedule(m_simulationStep, &MySink::ProcessTasks, this);
+    }
+    else
+    {
+        m_inService.assign(m_servers, QueuedTask());
+        m_serviceEvents.assign(m_servers, EventId());
+        m_busyServers = 0;
+        if (m_exponentialService)
+        {
+            m_serviceTimeGenerator->SetAttribute("Mean", DoubleValue(1.0 / m_tasksPerSecond));
+        }
+    }
 }
 
 void
 MySink::StopApplication()
 {
     m_running = false;
+    Simulator::Cancel(m_evictEvent);
+    for (auto& ev : m_serviceEvents)
+    {
+        Simulator::Cancel(ev);
+    }
     if (m_socket != nullptr)
     {
         m_socket->SetRecvCallback(Callback<void, Ptr<Socket>>());
     }
-    NS_LOG_UNCOND("消费者应用停止。节点 " << GetNode()->GetId() << " 总共处理任务数: " << m_tasksCompleted << ". 队列中剩余任务数: " << m_taskQueue.size());
+    NS_LOG_UNCOND("消费者应用停止。节点 " << GetNode()->GetId() << " 总共处理任务数: " << m_tasksCompleted << ". 队列中剩余任务数: " << m_taskQueue.size()
+                  << ". 未收全任务数: " << m_pendingTasks.size() << ". 淘汰任务数: " << m_tasksEvicted
+                  << ". 丢弃任务数: " << m_tasksDropped);
 }
 
 void
@@ -165,26 +365,179 @@ MySink::HandleRead(Ptr<Socket> socket)
 
         uint32_t producerId = header.GetProducerId();
         uint32_t taskId = header.GetTaskId();
-        std::pair<uint32_t, uint32_t> taskKey = {producerId, taskId};
+        uint64_t key = TaskKey(producerId, taskId);
+        // 没有时间戳标签（包不是 MyProducer 发出的）时，时延从收到第一个包算起
+        TaskTimestampTag timestamps;
+        if (!packet->PeekPacketTag(timestamps))
+        {
+            timestamps.SetTimestamps(Simulator::Now(), Simulator::Now());
+        }
 
-        // 2. 累加字节数
-        m_currentRxBytesPerTask[taskKey] += packet->GetSize();
+        // 2. 累加字节数，并把该任务移到“最新”一端
+        auto it = m_pendingTasks.find(key);
+        if (it == m_pendingTasks.end())
+        {
+            if (m_maxPendingTasks > 0 && m_pendingTasks.size() >= m_maxPendingTasks)
+            {
+                EvictTask(m_pendingTasks.find(m_pendingAge.front()));
+            }
+            m_pendingAge.push_back(key);
+            it = m_pendingTasks
+                     .emplace(key,
+                              PendingTask{0,
+                                          Time(),
+                                          timestamps.GetCreated(),
+                                          timestamps.GetSent(),
+                                          std::prev(m_pendingAge.end())})
+                     .first;
+        }
+        else
+        {
+            m_pendingAge.splice(m_pendingAge.end(), m_pendingAge, it->second.age);
+        }
+        it->second.rxBytes += packet->GetSize();
+        it->second.lastRx = Simulator::Now();
 
         // 3. 检查任务是否完整接收
-        if (m_currentRxBytesPerTask[taskKey] >= m_taskSize)
+        if (it->second.rxBytes >= m_taskSize)
+        {
+            QueuedTask task{producerId,
+                            taskId,
+                            it->second.created,
+                            it->second.sent,
+                            Simulator::Now(),
+                            Simulator::Now()};
+            // 清理重组表
+            m_pendingAge.erase(it->second.age);
+            m_pendingTasks.erase(it);
+            EnqueueTask(task);
+        }
+    }
+    ScheduleEviction();
+}
+
+void
+MySink::EvictTask(std::unordered_map<uint64_t, PendingTask>::iterator it)
+{
+    uint32_t producerId = static_cast<uint32_t>(it->first >> 32);
+    uint32_t taskId = static_cast<uint32_t>(it->first);
+    NS_LOG_INFO(Simulator::Now().GetSeconds() << "s: [消费者 " << GetNode()->GetId() << "]: 任务 "
+                << producerId << "-" << taskId << " 未收全 (" << it->second.rxBytes
+                << " 字节)，被淘汰。");
+    m_tasksEvicted++;
+    m_taskEvictedTrace(GetNode()->GetId(), producerId, taskId, it->second.rxBytes);
+    m_pendingAge.erase(it->second.age);
+    m_pendingTasks.erase(it);
+}
+
+void
+MySink::EvictExpiredTasks()
+{
+    // m_pendingAge 按最近收包时间有序，只需从最旧的一端检查
+    Time now = Simulator::Now();
+    while (!m_pendingAge.empty())
+    {
+        auto it = m_pendingTasks.find(m_pendingAge.front());
+        if (it->second.lastRx + m_reassemblyTimeout > now)
+        {
+            break;
+        }
+        EvictTask(it);
+    }
+    ScheduleEviction();
+}
+
+void
+MySink::ScheduleEviction()
+{
+    // 任意时刻只保留一个淘汰事件，对应最旧任务的超时时刻
+    if (!m_running || m_reassemblyTimeout.IsZero() || m_pendingAge.empty() ||
+        m_evictEvent.IsRunning())
+    {
+        return;
+    }
+    const PendingTask& oldest = m_pendingTasks.find(m_pendingAge.front())->second;
+    Time delay = std::max(oldest.lastRx + m_reassemblyTimeout - Simulator::Now(), Time(0));
+    m_evictEvent = Simulator::Schedule(delay, &MySink::EvictExpiredTasks, this);
+}
+
+void
+MySink::EnqueueTask(const QueuedTask& task)
+{
+    bool serverIdle = m_serviceModel == SERVICE_EXACT && m_busyServers < m_servers;
+    if (m_queueCapacity > 0 && m_taskQueue.size() >= m_queueCapacity && !serverIdle)
+    {
+        m_tasksDropped++;
+        NS_LOG_INFO(Simulator::Now().GetSeconds() << "s: [消费者 " << GetNode()->GetId() << "]: 任务 "
+                    << task.producerId << "-" << task.taskId << " 因队列已满 ("
+                    << m_taskQueue.size() << ") 被丢弃。");
+        m_taskDroppedTrace(GetNode()->GetId(), task.producerId, task.taskId, m_taskQueue.size());
+        return;
+    }
+
+    m_taskQueue.push(task);
+    // 打印入列日志
+    NS_LOG_UNCOND(Simulator::Now().GetSeconds() << "s: [消费者 " << GetNode()->GetId() << "]: 任务 " 
+                  << task.producerId << "-" << task.taskId << " 入列，队列共有" 
+                  << m_taskQueue.size() << "个任务等待处理。");
+
+    if (m_serviceModel == SERVICE_EXACT)
+    {
+        StartService();
+    }
+}
+
+void
+MySink::StartService()
+{
+    for (uint32_t server = 0; server < m_servers && !m_taskQueue.empty(); ++server)
+    {
+        if (m_serviceEvents[server].IsRunning())
         {
-            m_taskQueue.push(taskKey);
-            // 打印入列日志
-            NS_LOG_UNCOND(Simulator::Now().GetSeconds() << "s: [消费者 " << GetNode()->GetId() << "]: 任务 " 
-                          << taskKey.first << "-" << taskKey.second << " 入列，队列共有" 
-                          << m_taskQueue.size() << "个任务等待处理。");
-
-            // 清理map
-            m_currentRxBytesPerTask.erase(taskKey);
+            continue;
         }
+        m_inService[server] = m_taskQueue.front();
+        m_inService[server].serviceStart = Simulator::Now();
+        m_taskQueue.pop();
+        m_busyServers++;
+        Time serviceTime = m_exponentialService
+                               ? Seconds(m_serviceTimeGenerator->GetValue())
+                               : Seconds(1.0 / m_tasksPerSecond);
+        m_serviceEvents[server] =
+            Simulator::Schedule(serviceTime, &MySink::ServiceCompleted, this, server);
     }
 }
 
+void
+MySink::ServiceCompleted(uint32_t server)
+{
+    m_busyServers--;
+    TaskCompleted(m_inService[server]);
+    // 队列非空时立即开始下一个任务；队列为空则不再调度任何事件
+    StartService();
+}
+
+void
+MySink::TaskCompleted(const QueuedTask& task)
+{
+    m_tasksCompleted++;
+
+    // 打印处理完成日志
+    NS_LOG_UNCOND(Simulator::Now().GetSeconds() << "s: [消费者 " << GetNode()->GetId() << "]: 任务 " 
+                  << task.producerId << "-" << task.taskId << " 处理完成，队列共有" 
+                  << m_taskQueue.size() << "个任务等待处理。消费者 " 
+                  << GetNode()->GetId() << " 处理总数 " << m_tasksCompleted << "。");
+
+    // 触发 Trace (nodeId, producerId, taskId, totalCompleted)
+    m_taskCompletedTrace(GetNode()->GetId(), task.producerId, task.taskId, m_tasksCompleted);
+
+    // 排队 = 生产者积压 + 消费者队列等待；传输 = 开始发送到收全；服务 = 开始服务到完成
+    Time queueing = (task.sent - task.created) + (task.serviceStart - task.received);
+    Time transfer = task.received - task.sent;
+    Time service = Simulator::Now() - task.serviceStart;
+    m_taskLatencyTrace(GetNode()->GetId(), task.producerId, task.taskId, queueing, transfer, service);
+}
+
 void
 MySink::ProcessTasks()
 {
@@ -193,19 +546,12 @@ MySink::ProcessTasks()
     uint32_t tasksToProcess = floor(m_processingCredit);
     for (uint32_t i = 0; i < tasksToProcess && !m_taskQueue.empty(); ++i)
     {
-        std::pair<uint32_t, uint32_t> taskKey = m_taskQueue.front();
+        QueuedTask task = m_taskQueue.front();
         m_taskQueue.pop();
-        m_tasksCompleted++;
         m_processingCredit -= 1.0;
-        
-        // 打印处理完成日志
-        NS_LOG_UNCOND(Simulator::Now().GetSeconds() << "s: [消费者 " << GetNode()->GetId() << "]: 任务 " 
-                      << taskKey.first << "-" << taskKey.second << " 处理完成，队列共有" 
-                      << m_taskQueue.size() << "个任务等待处理。消费者 " 
-                      << GetNode()->GetId() << " 处理总数 " << m_tasksCompleted << "。");
-        
-        // 触发 Trace (nodeId, producerId, taskId, totalCompleted)
-        m_taskCompletedTrace(GetNode()->GetId(), taskKey.first, taskKey.second, m_tasksCompleted);
+        // Stepped 模式没有单独的服务阶段，等待到处理时刻都计入排队
+        task.serviceStart = Simulator::Now();
+        TaskCompleted(task);
     }
     if (m_running)
     {
@@ -221,6 +567,65 @@ TypeId MyProducer::GetTypeId(void)
         .SetParent<Application>()
         .SetGroupName("Applications")
         .AddConstructor<MyProducer>()
+        .AddAttribute("ArrivalModel",
+                      "Stepped draws arrivals inside each simulation step and discards the "
+                      "interval left over at the step boundary; Exact schedules every arrival "
+                      "directly from the ArrivalProcess.",
+                      EnumValue(MyProducer::ARRIVAL_EXACT),
+                      MakeEnumAccessor(&MyProducer::m_arrivalModel),
+                      MakeEnumChecker(MyProducer::ARRIVAL_STEPPED, "Stepped",
+                                      MyProducer::ARRIVAL_EXACT, "Exact"))
+        .AddAttribute("ArrivalProcess",
+                      "Task arrival process used by the Exact arrival model. Its mean rate is "
+                      "set to the lambda given to Setup().",
+                      StringValue("ns3::PoissonArrivalProcess"),
+                      MakePointerAccessor(&MyProducer::m_arrivalProcess),
+                      MakePointerChecker<TaskArrivalProcess>())
+        .AddAttribute("DispatchPolicy",
+                      "Policy choosing the destination sink of each task.",
+                      StringValue("ns3::UniformDispatchPolicy"),
+                      MakePointerAccessor(&MyProducer::m_dispatchPolicy),
+                      MakePointerChecker<TaskDispatchPolicy>())
+        .AddAttribute("SendMode",
+                      "How the packets of a task are handed to the socket: Burst (all at once), "
+                      "Paced (spread at the egress link rate) or Writable (only while the egress "
+                      "queue has room).",
+                      EnumValue(MyProducer::SEND_BURST),
+                      MakeEnumAccessor(&MyProducer::m_sendMode),
+                      MakeEnumChecker(MyProducer::SEND_BURST, "Burst",
+                                      MyProducer::SEND_PACED, "Paced",
+                                      MyProducer::SEND_WRITABLE, "Writable"))
+        .AddAttribute("PacingRate",
+                      "Rate used in Paced mode. Zero means use the DataRate of the egress "
+                      "NetDevice towards the selected sink.",
+                      DataRateValue(DataRate(0)),
+                      MakeDataRateAccessor(&MyProducer::m_pacingRate),
+                      MakeDataRateChecker())
+        .AddAttribute("PacingBurst",
+                      "Number of packets sent per pacing event in Paced mode.",
+                      UintegerValue(1),
+                      MakeUintegerAccessor(&MyProducer::m_pacingBurst),
+                      MakeUintegerChecker<uint32_t>(1))
+        .AddAttribute("PacingOverhead",
+                      "Per-packet protocol overhead in bytes (UDP + IPv4 + PPP) added to the "
+                      "payload when computing the pacing interval.",
+                      UintegerValue(8 + 20 + 2),
+                      MakeUintegerAccessor(&MyProducer::m_pacingOverhead),
+                      MakeUintegerChecker<uint32_t>())
+        .AddAttribute("LightweightPackets",
+                      "If true, the task packets are lightweight packets, which record no "
+                      "metadata even when packet printing is enabled.  They keep their byte "
+                      "tags, so FlowMonitor still tracks them, but Packet::Print and the "
+                      "ascii traces only show their size.",
+                      BooleanValue(false),
+                      MakeBooleanAccessor(&MyProducer::m_lightweightPackets),
+                      MakeBooleanChecker())
+        .AddAttribute("SendRetryDelay",
+                      "Delay before sending a packet again after the socket refused it. The "
+                      "task does not move on until all of its packets were accepted.",
+                      TimeValue(MilliSeconds(1)),
+                      MakeTimeAccessor(&MyProducer::m_sendRetryDelay),
+                      MakeTimeChecker(TimeStep(1)))
         .AddTraceSource("TaskSent",
                         "Trace triggered when a new task starts sending.",
                         MakeTraceSourceAccessor(&MyProducer::m_taskSentTrace),
@@ -235,14 +640,25 @@ MyProducer::MyProducer()
       m_packetSize(0),
       m_packetsSentForCurrentTask(0),
       m_totalTasksSent(0),
+      m_sendFailures(0),
       m_isSending(false),
       m_currentSendingProducerId(0),
       m_currentSendingTaskId(0),
       m_simulationStep(MilliSeconds(1)),
       m_lambda(0.0),
-      m_interTaskTimeGenerator(nullptr),
-      m_sinkSelector(nullptr),
-      m_running(false)
+      m_interTaskTimeGenerator(CreateObject<ExponentialRandomVariable>()),
+      m_dispatchPolicy(nullptr),
+      m_running(false),
+      m_arrivalModel(ARRIVAL_EXACT),
+      m_arrivalProcess(nullptr),
+      m_sendMode(SEND_BURST),
+      m_pacingBurst(1),
+      m_pacingOverhead(0),
+      m_pacingInterval(Seconds(0)),
+      m_egressQueue(nullptr),
+      m_writing(false),
+      m_waitingForWritable(false),
+      m_lightweightPackets(false)
 {
 }
 
@@ -259,28 +675,68 @@ MyProducer::Setup(const std::vector<Address>& sinkAddresses, double lambda, uint
     m_packetSize = packetSize;
     m_simulationStep = simulationStep;
     m_lambda = lambda;
-    m_interTaskTimeGenerator = CreateObject<ExponentialRandomVariable>();
     m_interTaskTimeGenerator->SetAttribute("Mean", DoubleValue(1.0 / m_lambda));
-    m_sinkSelector = CreateObject<UniformRandomVariable>();
-    m_sinkSelector->SetAttribute("Min", DoubleValue(0));
-    m_sinkSelector->SetAttribute("Max", DoubleValue(m_sinkAddresses.size() > 0 ? m_sinkAddresses.size() - 1 : 0));
+    m_dispatchPolicy->SetSinks(m_sinkAddresses);
+}
+
+Ptr<TaskDispatchPolicy>
+MyProducer::GetDispatchPolicy() const
+{
+    return m_dispatchPolicy;
+}
+
+int64_t
+MyProducer::AssignStreams(int64_t stream)
+{
+    int64_t currentStream = stream;
+    m_interTaskTimeGenerator->SetStream(currentStream++);
+    if (m_arrivalProcess)
+    {
+        currentStream += m_arrivalProcess->AssignStreams(currentStream);
+    }
+    currentStream += m_dispatchPolicy->AssignStreams(currentStream);
+    return currentStream - stream;
 }
 
 void
 MyProducer::StartApplication()
 {
+    // 策略可能在 Setup 之后被替换
+    if (m_dispatchPolicy->GetSinks().size() != m_sinkAddresses.size())
+    {
+        m_dispatchPolicy->SetSinks(m_sinkAddresses);
+    }
     TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
     m_socket = Socket::CreateSocket(GetNode(), tid);
+    if (m_sendMode == SEND_WRITABLE)
+    {
+        // 对有真实发送缓冲的 socket，缓冲腾出空间时会回调；
+        // UdpSocketImpl 没有发送缓冲，回调在 SendTo 内同步触发，由 m_writing 屏蔽
+        m_socket->SetSendCallback(MakeCallback(&MyProducer::HandleSend, this));
+    }
     m_running = true;
-    Simulator::Schedule(m_simulationStep, &MyProducer::GenerateTasks, this);
+    if (m_arrivalModel == ARRIVAL_EXACT && m_arrivalProcess)
+    {
+        m_arrivalProcess->SetRate(m_lambda);
+        ScheduleNextArrival();
+    }
+    else
+    {
+        Simulator::Schedule(m_simulationStep, &MyProducer::GenerateTasks, this);
+    }
 }
 
 void
 MyProducer::StopApplication()
 {
     m_running = false;
+    Simulator::Cancel(m_arrivalEvent);
+    Simulator::Cancel(m_sendEvent);
+    DisconnectEgressQueue();
+    m_waitingForWritable = false;
     if (m_socket != nullptr)
     {
+        m_socket->SetSendCallback(Callback<void, Ptr<Socket>, uint32_t>());
         m_socket->Close();
     }
     NS_LOG_UNCOND("生产者应用停止。节点 " << GetNode()->GetId() << " 总共发送任务数: " << m_totalTasksSent << ". 队列中剩余任务数: " << m_taskQueue.size());
@@ -307,7 +763,7 @@ MyProducer::GenerateTasks()
          NS_LOG_INFO(Simulator::Now().GetSeconds() << "s: [生产者 " << GetNode()->GetId() << "]: 生成了 " << numTasksToGenerate << " 个新任务。");
         for (uint32_t i = 0; i < numTasksToGenerate; ++i)
         {
-            m_taskQueue.push(true);
+            m_taskQueue.push(Simulator::Now());
         }
         if (!m_isSending)
         {
@@ -320,6 +776,30 @@ MyProducer::GenerateTasks()
     }
 }
 
+void
+MyProducer::ScheduleNextArrival()
+{
+    Time interval = m_arrivalProcess->GetNextInterval();
+    if (interval == Time::Max())
+    {
+        NS_LOG_INFO(Simulator::Now().GetSeconds() << "s: [生产者 " << GetNode()->GetId() << "]: 到达过程结束。");
+        return;
+    }
+    m_arrivalEvent = Simulator::Schedule(interval, &MyProducer::TaskArrival, this);
+}
+
+void
+MyProducer::TaskArrival()
+{
+    if (!m_running) return;
+    m_taskQueue.push(Simulator::Now());
+    if (!m_isSending)
+    {
+        SendNextTask();
+    }
+    ScheduleNextArrival();
+}
+
 void
 MyProducer::SendNextTask()
 {
@@ -329,9 +809,11 @@ MyProducer::SendNextTask()
         return;
     }
     m_isSending = true;
+    m_currentTaskCreated = m_taskQueue.front();
+    m_currentTaskSent = Simulator::Now();
     m_taskQueue.pop();
     m_totalTasksSent++;
-    int sink_idx = m_sinkSelector->GetInteger();
+    uint32_t sink_idx = m_dispatchPolicy->SelectSink(GetNode());
     m_currentTarget = m_sinkAddresses[sink_idx];
 
     // 存储当前任务信息，用于添加到包头
@@ -347,6 +829,7 @@ MyProducer::SendNextTask()
     m_taskSentTrace(GetNode()->GetId(), m_totalTasksSent, m_currentTarget);
 
     m_packetsSentForCurrentTask = 0;
+    ResolveEgress();
     SendPacket();
 }
 
@@ -363,21 +846,204 @@ MyProducer::SendPacket()
         SendNextTask();
         return;
     }
-    
+
+    if (m_sendMode == SEND_PACED && !m_pacingInterval.IsZero())
+    {
+        // 每个事件发送 m_pacingBurst 个包，下一个事件在这些包按链路速率发完后触发
+        uint32_t sent = 0;
+        while (sent < m_pacingBurst && m_packetsSentForCurrentTask * m_packetSize < m_taskSize)
+        {
+            if (!SendOnePacket())
+            {
+                break;
+            }
+            ++sent;
+        }
+        Time delay = sent > 0 ? m_pacingInterval * sent : m_sendRetryDelay;
+        m_sendEvent = Simulator::Schedule(delay, &MyProducer::SendPacket, this);
+        return;
+    }
+
+    if (m_sendMode == SEND_WRITABLE)
+    {
+        // 出口队列有空间就一直写；写满后等待队列降到低水位再唤醒
+        // socket 拒绝发送时不再等待出口队列，而是在 SendRetryDelay 后重试
+        m_writing = true;
+        bool failed = false;
+        while (!failed && m_packetsSentForCurrentTask * m_packetSize < m_taskSize &&
+               IsEgressWritable())
+        {
+            failed = !SendOnePacket();
+        }
+        m_writing = false;
+        if (m_packetsSentForCurrentTask * m_packetSize >= m_taskSize)
+        {
+            SendNextTask();
+        }
+        else if (failed)
+        {
+            m_sendEvent = Simulator::Schedule(m_sendRetryDelay, &MyProducer::SendPacket, this);
+        }
+        else
+        {
+            m_waitingForWritable = true;
+        }
+        return;
+    }
+
+    Time delay = SendOnePacket() ? Seconds(0) : m_sendRetryDelay;
+    if (m_isSending)
+    {
+        m_sendEvent = Simulator::Schedule(delay, &MyProducer::SendPacket, this);
+    }
+}
+
+bool
+MyProducer::SendOnePacket()
+{
     // 1. 创建包头
     TaskHeader header;
     header.SetData(m_currentSendingProducerId, m_currentSendingTaskId);
+    TaskTimestampTag timestamps;
+    timestamps.SetTimestamps(m_currentTaskCreated, m_currentTaskSent);
 
-    // 2. 创建包并添加包头
-    Ptr<Packet> packet = Create<Packet>(m_packetSize);
+    // 2. 创建包并添加包头和时间戳标签
+    Ptr<Packet> packet = m_lightweightPackets ? Packet::CreateLightweight(m_packetSize)
+                                              : Create<Packet>(m_packetSize);
     packet->AddHeader(header);
-    
+    packet->AddPacketTag(timestamps);
+
     // 3. 发送
-    m_socket->SendTo(packet, 0, m_currentTarget);
+    if (m_socket->SendTo(packet, 0, m_currentTarget) < 0)
+    {
+        m_sendFailures++;
+        NS_LOG_WARN("[生产者 " << GetNode()->GetId() << "]: 任务 " << m_currentSendingProducerId
+                               << "-" << m_currentSendingTaskId << " 的第 "
+                               << m_packetsSentForCurrentTask << " 个包发送失败 (socket 错误 "
+                               << m_socket->GetErrno() << ")，稍后重试。");
+        return false;
+    }
     m_packetsSentForCurrentTask++;
-    if (m_isSending)
+    return true;
+}
+
+uint32_t
+MyProducer::GetSendFailures() const
+{
+    return m_sendFailures;
+}
+
+void
+MyProducer::ResolveEgress()
+{
+    DisconnectEgressQueue();
+    m_pacingInterval = Seconds(0);
+    if (m_sendMode == SEND_BURST)
+    {
+        return;
+    }
+
+    // 通过路由表查询到目标的出口设备
+    Ptr<NetDevice> egress = nullptr;
+    Ptr<Ipv4> ipv4 = GetNode()->GetObject<Ipv4>();
+    if (ipv4 && ipv4->GetRoutingProtocol() && InetSocketAddress::IsMatchingType(m_currentTarget))
+    {
+        Ipv4Header ipHeader;
+        ipHeader.SetDestination(InetSocketAddress::ConvertFrom(m_currentTarget).GetIpv4());
+        ipHeader.SetProtocol(UdpL4Protocol::PROT_NUMBER);
+        Socket::SocketErrno err;
+        Ptr<Ipv4Route> route =
+            ipv4->GetRoutingProtocol()->RouteOutput(nullptr, ipHeader, nullptr, err);
+        if (route)
+        {
+            egress = route->GetOutputDevice();
+        }
+    }
+
+    DataRate rate = m_pacingRate;
+    if (egress)
+    {
+        DataRateValue deviceRate;
+        if (rate.GetBitRate() == 0 && egress->GetAttributeFailSafe("DataRate", deviceRate))
+        {
+            rate = deviceRate.Get();
+        }
+        PointerValue txQueue;
+        if (m_sendMode == SEND_WRITABLE && egress->GetAttributeFailSafe("TxQueue", txQueue))
+        {
+            m_egressQueue = txQueue.Get<Queue<Packet>>();
+        }
+    }
+
+    if (m_sendMode == SEND_PACED)
+    {
+        if (rate.GetBitRate() == 0)
+        {
+            NS_LOG_WARN("[生产者 " << GetNode()->GetId() << "]: 无法确定 pacing 速率，退回 Burst 发送。");
+            return;
+        }
+        m_pacingInterval = rate.CalculateBytesTxTime(m_packetSize + TaskHeader().GetSerializedSize() +
+                                                     m_pacingOverhead);
+    }
+    else if (m_egressQueue)
+    {
+        m_egressQueue->TraceConnectWithoutContext(
+            "Dequeue",
+            MakeCallback(&MyProducer::HandleEgressDequeue, this));
+    }
+}
+
+bool
+MyProducer::IsEgressWritable() const
+{
+    if (!m_egressQueue)
+    {
+        // 没有可观测的出口队列时，只受 socket 发送缓冲约束
+        return m_socket->GetTxAvailable() >= m_packetSize + TaskHeader().GetSerializedSize();
+    }
+    return !m_egressQueue->WouldOverflow(1, m_packetSize + TaskHeader().GetSerializedSize() +
+                                                m_pacingOverhead);
+}
+
+void
+MyProducer::HandleEgressDequeue(Ptr<const Packet> packet)
+{
+    if (!m_waitingForWritable || !m_isSending || !m_running)
+    {
+        return;
+    }
+    // 低水位：队列降到一半以下再唤醒，一次写入多个包
+    QueueSize maxSize = m_egressQueue->GetMaxSize();
+    uint32_t current = maxSize.GetUnit() == QueueSizeUnit::PACKETS ? m_egressQueue->GetNPackets()
+                                                                   : m_egressQueue->GetNBytes();
+    if (current > maxSize.GetValue() / 2)
+    {
+        return;
+    }
+    m_waitingForWritable = false;
+    m_sendEvent = Simulator::ScheduleNow(&MyProducer::SendPacket, this);
+}
+
+void
+MyProducer::HandleSend(Ptr<Socket> socket, uint32_t available)
+{
+    if (m_writing || !m_waitingForWritable || !m_isSending || !m_running || m_egressQueue)
+    {
+        return;
+    }
+    m_waitingForWritable = false;
+    m_sendEvent = Simulator::ScheduleNow(&MyProducer::SendPacket, this);
+}
+
+void
+MyProducer::DisconnectEgressQueue()
+{
+    if (m_egressQueue)
     {
-        Simulator::ScheduleNow(&MyProducer::SendPacket, this);
+        m_egressQueue->TraceDisconnectWithoutContext(
+            "Dequeue",
+            MakeCallback(&MyProducer::HandleEgressDequeue, this));
+        m_egressQueue = nullptr;
     }
 }
 
@@ -8,15 +8,23 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/traced-callback.h"
 #include "ns3/header.h" // 包含 Header
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/queue.h"
+#include "ns3/task-arrival-process.h"
+#include "ns3/task-dispatch-policy.h"
+#include "ns3/task-latency-monitor.h"
 
+#include <list>
 #include <queue>
 #include <vector>
 #include <map>     // 包含 map
+#include <unordered_map>
 #include <utility> // 包含 pair
 
 namespace ns3 {
 
-// --- 0. 自定义包头 (TaskHeader) 声明 ---
+// --- 0. 自定义包头 (TaskHeader) 与时间戳标签 (TaskTimestampTag) 声明 ---
 // 用于在生产者和消费者之间传递任务标识
 class TaskHeader : public Header
 {
@@ -40,21 +48,87 @@ private:
     uint32_t m_taskId;
 };
 
+// 随任务的每个包传递任务的时间戳，用于统计时延。作为包标签而不是包头字段，
+// 不占用线路上的字节，不改变链路负载和吞吐统计
+class TaskTimestampTag : public Tag
+{
+public:
+    static TypeId GetTypeId(void);
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(TagBuffer i) const;
+    virtual void Deserialize(TagBuffer i);
+    virtual void Print(std::ostream &os) const;
+
+    TaskTimestampTag();
+
+    /**
+     * @param created 任务在生产者处到达（生成）的时刻
+     * @param sent 任务第一个包开始发送的时刻
+     */
+    void SetTimestamps(Time created, Time sent);
+    Time GetCreated(void) const;
+    Time GetSent(void) const;
+
+private:
+    int64_t m_created; //!< 任务到达时刻 (时间步)
+    int64_t m_sent;    //!< 开始发送时刻 (时间步)
+};
+
 
 // --- 1. 自定义消费者应用 (MySink) 声明 ---
 class MySink : public Application
 {
 public:
+    /**
+     * 任务处理（服务）模型
+     */
+    enum ServiceModel
+    {
+        SERVICE_STEPPED, //!< 旧行为：每个 m_simulationStep 按处理速率累积处理额度
+        SERVICE_EXACT    //!< 精确服务：只为服务中任务的完成时刻调度事件，队列空时不唤醒
+    };
+
     static TypeId GetTypeId(void);
     MySink();
     virtual ~MySink();
 
     void Setup(double tasksPerSecond, Time simulationStep);
 
+    // 当前正在重组（未收全）的任务数
+    uint32_t GetPendingTasks(void) const;
+    // 因超时或超出容量被淘汰的未完成任务总数
+    uint32_t GetTasksEvicted(void) const;
+    // 等待处理的任务数（不含服务中的任务）
+    uint32_t GetQueueLength(void) const;
+    // 正在服务的任务数 (仅 Exact 模式)
+    uint32_t GetBusyServers(void) const;
+    // 因队列已满被丢弃的任务总数
+    uint32_t GetTasksDropped(void) const;
+
+    /**
+     * 为服务时间随机变量分配固定的随机流编号
+     * @param stream 第一个随机流编号
+     * @return 使用的随机流个数
+     */
+    int64_t AssignStreams(int64_t stream);
+
     // TracedCallback: nodeId, producerId, taskId, totalCompleted
     // 当一个任务处理完成时触发
     TracedCallback<uint32_t, uint32_t, uint32_t, uint32_t> m_taskCompletedTrace;
 
+    // TracedCallback: nodeId, producerId, taskId, rxBytes
+    // 当一个未收全的任务被淘汰时触发
+    TracedCallback<uint32_t, uint32_t, uint32_t, uint32_t> m_taskEvictedTrace;
+
+    // TracedCallback: nodeId, producerId, taskId, queueLength
+    // 当一个收全的任务因队列已满被丢弃时触发
+    TracedCallback<uint32_t, uint32_t, uint32_t, uint32_t> m_taskDroppedTrace;
+
+    // TracedCallback: nodeId, producerId, taskId, queueing, transfer, service
+    // 当一个任务处理完成时触发，给出该任务时延的各组成部分
+    TracedCallback<uint32_t, uint32_t, uint32_t, Time, Time, Time> m_taskLatencyTrace;
+
 private:
     virtual void StartApplication(void);
     virtual void StopApplication(void);
@@ -62,21 +136,73 @@ private:
     void HandleRead(Ptr<Socket> socket);
     void ProcessTasks();
 
+    // 队列中的任务及其时间戳
+    struct QueuedTask
+    {
+        uint32_t producerId;
+        uint32_t taskId;
+        Time created;      //!< 在生产者处到达的时刻
+        Time sent;         //!< 开始发送的时刻
+        Time received;     //!< 收全（入队）的时刻
+        Time serviceStart; //!< 开始服务的时刻
+    };
+
+    // 收全的任务入队（队列满时丢弃），Exact 模式下尝试开始服务
+    void EnqueueTask(const QueuedTask& task);
+    // Exact 模式：为空闲服务台从队列头取任务并调度其完成事件
+    void StartService();
+    // Exact 模式：服务台 server 上的任务完成
+    void ServiceCompleted(uint32_t server);
+    // 记录一个任务处理完成（日志与 Trace）
+    void TaskCompleted(const QueuedTask& task);
+
+    // 正在重组的任务
+    struct PendingTask
+    {
+        uint32_t rxBytes;                      //!< 已收到的字节数
+        Time lastRx;                           //!< 最近一次收包时间
+        Time created;                          //!< 时间戳标签中的任务到达时刻
+        Time sent;                             //!< 时间戳标签中的开始发送时刻
+        std::list<uint64_t>::iterator age;     //!< 在 m_pendingAge 中的位置
+    };
+
+    // (producerId, taskId) 压缩为 64 位键
+    static uint64_t TaskKey(uint32_t producerId, uint32_t taskId);
+    void EvictTask(std::unordered_map<uint64_t, PendingTask>::iterator it);
+    void EvictExpiredTasks();
+    void ScheduleEviction();
+
     Ptr<Socket> m_socket;
     uint16_t    m_port;
     uint32_t    m_taskSize;
 
-    // 按 (producerId, taskId) 跟踪接收字节数
-    std::map<std::pair<uint32_t, uint32_t>, uint32_t> m_currentRxBytesPerTask;
+    // 按 (producerId, taskId) 跟踪接收字节数；m_pendingAge 按最近收包时间排序，最旧在前
+    std::unordered_map<uint64_t, PendingTask> m_pendingTasks;
+    std::list<uint64_t> m_pendingAge;
+    Time        m_reassemblyTimeout;
+    uint32_t    m_maxPendingTasks;
+    uint32_t    m_tasksEvicted;
+    EventId     m_evictEvent;
 
     Time        m_simulationStep;
     uint32_t    m_tasksCompleted;
-    // 队列存储 (producerId, taskId)
-    std::queue<std::pair<uint32_t, uint32_t>> m_taskQueue;
+    std::queue<QueuedTask> m_taskQueue;
 
     double      m_tasksPerSecond;
     double      m_processingCredit;
     bool        m_running;
+
+    // --- 服务模型 ---
+    ServiceModel m_serviceModel;     //!< Stepped 或 Exact
+    uint32_t    m_servers;           //!< 服务台数量 (Exact 模式)
+    bool        m_exponentialService; //!< 服务时间服从指数分布 (否则为确定的 1/rate)
+    uint32_t    m_queueCapacity;     //!< 等待队列容量，0 表示不限
+    uint32_t    m_tasksDropped;      //!< 因队列已满丢弃的任务数
+    Ptr<ExponentialRandomVariable> m_serviceTimeGenerator;
+    // 每个服务台上的任务及其完成事件
+    std::vector<QueuedTask> m_inService;
+    std::vector<EventId> m_serviceEvents;
+    uint32_t    m_busyServers;
 };
 
 
@@ -84,12 +210,44 @@ private:
 class MyProducer : public Application
 {
 public:
+    /**
+     * 任务发送模式
+     */
+    enum SendMode
+    {
+        SEND_BURST,   //!< 旧行为：同一时刻用 ScheduleNow 把整个任务的包全部压入 socket
+        SEND_PACED,   //!< 按出口链路速率（或 PacingRate）均匀发送
+        SEND_WRITABLE //!< 出口队列有空间时才写入，队列降到低水位后再唤醒
+    };
+
+    /**
+     * 任务到达模型
+     */
+    enum ArrivalModel
+    {
+        ARRIVAL_STEPPED, //!< 旧行为：每个 m_simulationStep 内抽取指数间隔，丢弃跨步的剩余间隔
+        ARRIVAL_EXACT    //!< 由 ArrivalProcess 给出下一个到达间隔，直接在到达时刻调度
+    };
+
     static TypeId GetTypeId(void);
     MyProducer();
     virtual ~MyProducer();
 
     void Setup(const std::vector<Address>& sinkAddresses, double lambda, uint32_t taskSize, uint32_t packetSize, Time simulationStep);
 
+    // 任务分发策略，可在 Setup 之后进一步配置（如权重、负载反馈）
+    Ptr<TaskDispatchPolicy> GetDispatchPolicy(void) const;
+    /// socket 拒绝发送（SendTo 返回 -1）的次数，失败的包会重试
+    uint32_t GetSendFailures(void) const;
+
+    /**
+     * 为到达间隔、到达过程和分发策略的随机变量分配固定的随机流编号，
+     * 应在设置 ArrivalProcess 和 DispatchPolicy 之后调用
+     * @param stream 第一个随机流编号
+     * @return 使用的随机流个数
+     */
+    int64_t AssignStreams(int64_t stream);
+
     // TracedCallback: nodeId, taskId (totalSent), targetAddress
     // 当一个新任务开始发送时触发
     TracedCallback<uint32_t, uint32_t, Address> m_taskSentTrace;
@@ -102,6 +260,23 @@ private:
     void SendNextTask();
     void GenerateTasks();
 
+    // Exact 到达模型：一个任务到达并调度下一次到达
+    void TaskArrival();
+    void ScheduleNextArrival();
+
+    // 发送单个数据包（带 TaskHeader）；socket 拒绝时记一次失败并返回 false，
+    // 此时当前任务不前进，由调用者在 SendRetryDelay 后重试
+    bool SendOnePacket();
+    // 解析到当前目标的出口设备，确定 pacing 间隔与出口队列
+    void ResolveEgress();
+    // 出口队列是否还能再放下一个包
+    bool IsEgressWritable() const;
+    // 出口队列出队回调（WRITABLE 模式下用于唤醒发送）
+    void HandleEgressDequeue(Ptr<const Packet> packet);
+    // socket 发送缓冲可写回调
+    void HandleSend(Ptr<Socket> socket, uint32_t available);
+    void DisconnectEgressQueue();
+
     Ptr<Socket> m_socket;
     std::vector<Address> m_sinkAddresses;
     Address     m_currentTarget;
@@ -109,18 +284,39 @@ private:
     uint32_t    m_packetSize;
     uint32_t    m_packetsSentForCurrentTask;
     uint32_t    m_totalTasksSent;
+    uint32_t    m_sendFailures; //!< socket 拒绝发送的次数
     bool        m_isSending;
 
     // 用于添加到包头的当前任务信息
     uint32_t    m_currentSendingProducerId;
     uint32_t    m_currentSendingTaskId;
+    Time        m_currentTaskCreated; //!< 当前任务在生产者处到达的时刻
+    Time        m_currentTaskSent;    //!< 当前任务开始发送的时刻
 
     Time m_simulationStep;
     double m_lambda;
     Ptr<ExponentialRandomVariable> m_interTaskTimeGenerator;
-    std::queue<bool> m_taskQueue;
-    Ptr<UniformRandomVariable> m_sinkSelector;
+    std::queue<Time> m_taskQueue; //!< 积压任务的到达时刻
+    Ptr<TaskDispatchPolicy> m_dispatchPolicy; //!< 选择每个任务的目标消费者
     bool m_running;
+
+    // --- 到达过程 ---
+    ArrivalModel m_arrivalModel;             //!< Stepped 或 Exact
+    Ptr<TaskArrivalProcess> m_arrivalProcess; //!< Exact 模型下的到达过程
+    EventId m_arrivalEvent;                  //!< 下一次任务到达事件
+
+    // --- 发送节奏控制 ---
+    SendMode m_sendMode;              //!< 任务发送模式
+    DataRate m_pacingRate;            //!< 显式 pacing 速率，0 表示使用出口设备速率
+    uint32_t m_pacingBurst;           //!< 每个 pacing 事件发送的包数
+    uint32_t m_pacingOverhead;        //!< 每包额外的协议开销 (UDP/IPv4/PPP)
+    Time m_pacingInterval;            //!< 当前目标的单包发送间隔
+    Ptr<Queue<Packet>> m_egressQueue; //!< 当前目标的出口设备发送队列
+    EventId m_sendEvent;              //!< 下一次发送事件
+    Time m_sendRetryDelay;            //!< socket 拒绝发送后重试的间隔
+    bool m_writing;                   //!< 正在 WRITABLE 写循环中（防止回调重入）
+    bool m_waitingForWritable;        //!< 等待出口队列/socket 变为可写
+    bool m_lightweightPackets;        //!< 任务数据包不记录元数据（保留字节标签）
 };
 
 } // namespace ns3
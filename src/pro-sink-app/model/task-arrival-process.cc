@@ -0,0 +1,344 @@
+#include "task-arrival-process.h"
+
+#include "ns3/abort.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+
+#include <cstdlib>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("TaskArrivalProcess");
+
+NS_OBJECT_ENSURE_REGISTERED(TaskArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(PoissonArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(DeterministicArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(MmppArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(TraceArrivalProcess);
+
+// --- TaskArrivalProcess ---
+
+TypeId TaskArrivalProcess::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::TaskArrivalProcess")
+        .SetParent<Object>()
+        .SetGroupName("Applications")
+    ;
+    return tid;
+}
+
+TaskArrivalProcess::TaskArrivalProcess()
+    : m_lambda(0.0)
+{
+}
+
+TaskArrivalProcess::~TaskArrivalProcess()
+{
+}
+
+void
+TaskArrivalProcess::SetRate(double lambda)
+{
+    m_lambda = lambda;
+}
+
+double
+TaskArrivalProcess::GetRate(void) const
+{
+    return m_lambda;
+}
+
+int64_t
+TaskArrivalProcess::AssignStreams(int64_t stream)
+{
+    return 0;
+}
+
+// --- PoissonArrivalProcess ---
+
+TypeId PoissonArrivalProcess::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::PoissonArrivalProcess")
+        .SetParent<TaskArrivalProcess>()
+        .SetGroupName("Applications")
+        .AddConstructor<PoissonArrivalProcess>()
+    ;
+    return tid;
+}
+
+PoissonArrivalProcess::PoissonArrivalProcess()
+    : m_interval(CreateObject<ExponentialRandomVariable>())
+{
+}
+
+PoissonArrivalProcess::~PoissonArrivalProcess()
+{
+}
+
+void
+PoissonArrivalProcess::SetRate(double lambda)
+{
+    TaskArrivalProcess::SetRate(lambda);
+    if (lambda > 0.0)
+    {
+        m_interval->SetAttribute("Mean", DoubleValue(1.0 / lambda));
+        // 默认 Bound=0 即不截断，保证均值精确为 1/lambda
+    }
+}
+
+Time
+PoissonArrivalProcess::GetNextInterval(void)
+{
+    if (m_lambda <= 0.0)
+    {
+        return Time::Max();
+    }
+    return Seconds(m_interval->GetValue());
+}
+
+int64_t
+PoissonArrivalProcess::AssignStreams(int64_t stream)
+{
+    m_interval->SetStream(stream);
+    return 1;
+}
+
+// --- DeterministicArrivalProcess ---
+
+TypeId DeterministicArrivalProcess::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::DeterministicArrivalProcess")
+        .SetParent<TaskArrivalProcess>()
+        .SetGroupName("Applications")
+        .AddConstructor<DeterministicArrivalProcess>()
+    ;
+    return tid;
+}
+
+DeterministicArrivalProcess::DeterministicArrivalProcess()
+{
+}
+
+DeterministicArrivalProcess::~DeterministicArrivalProcess()
+{
+}
+
+Time
+DeterministicArrivalProcess::GetNextInterval(void)
+{
+    if (m_lambda <= 0.0)
+    {
+        return Time::Max();
+    }
+    return Seconds(1.0 / m_lambda);
+}
+
+// --- MmppArrivalProcess ---
+
+TypeId MmppArrivalProcess::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::MmppArrivalProcess")
+        .SetParent<TaskArrivalProcess>()
+        .SetGroupName("Applications")
+        .AddConstructor<MmppArrivalProcess>()
+        .AddAttribute("HighRateFactor",
+                      "Relative arrival rate in the high state. "
+                      "At least one of the two rate factors must be positive.",
+                      DoubleValue(4.0),
+                      MakeDoubleAccessor(&MmppArrivalProcess::m_highFactor),
+                      MakeDoubleChecker<double>(0.0))
+        .AddAttribute("LowRateFactor",
+                      "Relative arrival rate in the low state.",
+                      DoubleValue(1.0),
+                      MakeDoubleAccessor(&MmppArrivalProcess::m_lowFactor),
+                      MakeDoubleChecker<double>(0.0))
+        .AddAttribute("MeanHighDuration",
+                      "Mean sojourn time in the high state.",
+                      TimeValue(MilliSeconds(100)),
+                      MakeTimeAccessor(&MmppArrivalProcess::m_meanHighDuration),
+                      MakeTimeChecker(TimeStep(1)))
+        .AddAttribute("MeanLowDuration",
+                      "Mean sojourn time in the low state.",
+                      TimeValue(MilliSeconds(400)),
+                      MakeTimeAccessor(&MmppArrivalProcess::m_meanLowDuration),
+                      MakeTimeChecker(TimeStep(1)))
+    ;
+    return tid;
+}
+
+MmppArrivalProcess::MmppArrivalProcess()
+    : m_highFactor(4.0),
+      m_lowFactor(1.0),
+      m_high(false),
+      m_stateLeft(0.0),
+      m_unitExp(CreateObject<ExponentialRandomVariable>()),
+      m_initialState(CreateObject<UniformRandomVariable>()),
+      m_started(false)
+{
+    m_unitExp->SetAttribute("Mean", DoubleValue(1.0));
+}
+
+MmppArrivalProcess::~MmppArrivalProcess()
+{
+}
+
+void
+MmppArrivalProcess::SetRate(double lambda)
+{
+    TaskArrivalProcess::SetRate(lambda);
+    m_started = false;
+}
+
+double
+MmppArrivalProcess::GetStateRate(bool high) const
+{
+    double th = m_meanHighDuration.GetSeconds();
+    double tl = m_meanLowDuration.GetSeconds();
+    double meanFactor = (m_highFactor * th + m_lowFactor * tl) / (th + tl);
+    if (meanFactor <= 0.0)
+    {
+        return 0.0;
+    }
+    return m_lambda * (high ? m_highFactor : m_lowFactor) / meanFactor;
+}
+
+Time
+MmppArrivalProcess::GetNextInterval(void)
+{
+    if (m_lambda <= 0.0)
+    {
+        return Time::Max();
+    }
+    double th = m_meanHighDuration.GetSeconds();
+    double tl = m_meanLowDuration.GetSeconds();
+    if (!m_started)
+    {
+        // 两个状态的到达率都为 0 时下面的循环不会结束；驻留时间由属性检查保证为正
+        NS_ABORT_MSG_IF(m_highFactor <= 0.0 && m_lowFactor <= 0.0,
+                        "MMPP arrivals need a positive HighRateFactor or LowRateFactor");
+        // 初始状态按稳态概率选取
+        m_high = m_initialState->GetValue() < th / (th + tl);
+        m_stateLeft = m_unitExp->GetValue() * (m_high ? th : tl);
+        m_started = true;
+    }
+
+    // 指数分布无记忆：在当前状态内抽取到达，若超出剩余驻留时间则切换状态后重抽
+    double elapsed = 0.0;
+    while (true)
+    {
+        double rate = GetStateRate(m_high);
+        double next = rate > 0.0 ? m_unitExp->GetValue() / rate : m_stateLeft + 1.0;
+        if (next <= m_stateLeft)
+        {
+            m_stateLeft -= next;
+            return Seconds(elapsed + next);
+        }
+        elapsed += m_stateLeft;
+        m_high = !m_high;
+        m_stateLeft = m_unitExp->GetValue() * (m_high ? th : tl);
+    }
+}
+
+int64_t
+MmppArrivalProcess::AssignStreams(int64_t stream)
+{
+    m_unitExp->SetStream(stream);
+    m_initialState->SetStream(stream + 1);
+    return 2;
+}
+
+// --- TraceArrivalProcess ---
+
+TypeId TraceArrivalProcess::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::TraceArrivalProcess")
+        .SetParent<TaskArrivalProcess>()
+        .SetGroupName("Applications")
+        .AddConstructor<TraceArrivalProcess>()
+        .AddAttribute("FileName",
+                      "File with one arrival time (seconds since application start) per line.",
+                      StringValue(""),
+                      MakeStringAccessor(&TraceArrivalProcess::m_fileName),
+                      MakeStringChecker())
+    ;
+    return tid;
+}
+
+TraceArrivalProcess::TraceArrivalProcess()
+    : m_loaded(false),
+      m_next(0),
+      m_last(Seconds(0))
+{
+}
+
+TraceArrivalProcess::~TraceArrivalProcess()
+{
+}
+
+void
+TraceArrivalProcess::SetArrivals(const std::vector<Time>& arrivals)
+{
+    m_arrivals = arrivals;
+    m_loaded = true;
+    m_next = 0;
+    m_last = Seconds(0);
+}
+
+void
+TraceArrivalProcess::Load(void)
+{
+    m_loaded = true;
+    m_arrivals.clear();
+    std::ifstream fin(m_fileName.c_str());
+    if (!fin.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open arrival trace file: " << m_fileName);
+    }
+    std::string line;
+    uint32_t ln = 0;
+    while (std::getline(fin, line))
+    {
+        ++ln;
+        std::size_t b = line.find_first_not_of(" \t\r");
+        if (b == std::string::npos || line[b] == '#')
+        {
+            continue;
+        }
+        char* end = nullptr;
+        double t = std::strtod(line.c_str() + b, &end);
+        if (end == line.c_str() + b || t < 0.0)
+        {
+            NS_LOG_WARN("Skip invalid arrival trace line " << ln << ": " << line);
+            continue;
+        }
+        Time arrival = Seconds(t);
+        if (!m_arrivals.empty() && arrival < m_arrivals.back())
+        {
+            NS_LOG_WARN("Skip out-of-order arrival trace line " << ln << ": " << line);
+            continue;
+        }
+        m_arrivals.push_back(arrival);
+    }
+    NS_LOG_INFO("Loaded " << m_arrivals.size() << " arrivals from " << m_fileName);
+}
+
+Time
+TraceArrivalProcess::GetNextInterval(void)
+{
+    if (!m_loaded)
+    {
+        Load();
+    }
+    if (m_next >= m_arrivals.size())
+    {
+        return Time::Max();
+    }
+    Time interval = m_arrivals[m_next] - m_last;
+    m_last = m_arrivals[m_next];
+    ++m_next;
+    return interval;
+}
+
+} // namespace ns3
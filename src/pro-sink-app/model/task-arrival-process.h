@@ -0,0 +1,149 @@
+#ifndef TASK_ARRIVAL_PROCESS_H
+#define TASK_ARRIVAL_PROCESS_H
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/random-variable-stream.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * 任务到达过程的基类。
+ *
+ * MyProducer 在 Exact 到达模型下，每个任务到达时向到达过程要下一个到达间隔，
+ * 并直接在该时刻调度下一次到达，不再按固定步长轮询。
+ */
+class TaskArrivalProcess : public Object
+{
+public:
+    static TypeId GetTypeId(void);
+    TaskArrivalProcess();
+    virtual ~TaskArrivalProcess();
+
+    /**
+     * 设置长期平均到达率
+     * @param lambda 平均到达率 (tasks/s)
+     */
+    virtual void SetRate(double lambda);
+    double GetRate(void) const;
+
+    /**
+     * @return 距下一个任务到达的时间间隔；Time::Max() 表示不再有任务到达
+     */
+    virtual Time GetNextInterval(void) = 0;
+
+    /**
+     * 为使用的随机变量分配固定的随机流编号
+     * @param stream 第一个随机流编号
+     * @return 使用的随机流个数
+     */
+    virtual int64_t AssignStreams(int64_t stream);
+
+protected:
+    double m_lambda; //!< 平均到达率 (tasks/s)
+};
+
+/**
+ * 泊松到达：到达间隔服从均值为 1/lambda 的指数分布
+ */
+class PoissonArrivalProcess : public TaskArrivalProcess
+{
+public:
+    static TypeId GetTypeId(void);
+    PoissonArrivalProcess();
+    virtual ~PoissonArrivalProcess();
+
+    virtual void SetRate(double lambda);
+    virtual Time GetNextInterval(void);
+    virtual int64_t AssignStreams(int64_t stream);
+
+private:
+    Ptr<ExponentialRandomVariable> m_interval;
+};
+
+/**
+ * 确定性到达：到达间隔恒为 1/lambda
+ */
+class DeterministicArrivalProcess : public TaskArrivalProcess
+{
+public:
+    static TypeId GetTypeId(void);
+    DeterministicArrivalProcess();
+    virtual ~DeterministicArrivalProcess();
+
+    virtual Time GetNextInterval(void);
+};
+
+/**
+ * 两状态马尔可夫调制泊松过程 (MMPP-2)。
+ *
+ * 高/低两个状态的驻留时间服从指数分布，各状态内按泊松到达。
+ * 两个状态的到达率之比为 HighRateFactor:LowRateFactor，并整体缩放，
+ * 使长期平均到达率等于 lambda。
+ */
+class MmppArrivalProcess : public TaskArrivalProcess
+{
+public:
+    static TypeId GetTypeId(void);
+    MmppArrivalProcess();
+    virtual ~MmppArrivalProcess();
+
+    virtual void SetRate(double lambda);
+    virtual Time GetNextInterval(void);
+    virtual int64_t AssignStreams(int64_t stream);
+
+    /**
+     * @param high true 取高状态，false 取低状态
+     * @return 该状态下的到达率 (tasks/s)
+     */
+    double GetStateRate(bool high) const;
+
+private:
+    double m_highFactor;    //!< 高状态相对到达率
+    double m_lowFactor;     //!< 低状态相对到达率
+    Time m_meanHighDuration; //!< 高状态平均驻留时间
+    Time m_meanLowDuration;  //!< 低状态平均驻留时间
+    bool m_high;             //!< 当前是否处于高状态
+    double m_stateLeft;      //!< 当前状态剩余驻留时间 (s)
+    Ptr<ExponentialRandomVariable> m_unitExp; //!< 均值为 1 的指数分布
+    Ptr<UniformRandomVariable> m_initialState;
+    bool m_started;
+};
+
+/**
+ * 按文件回放到达时刻。
+ *
+ * 文件每行一个到达时刻（秒，相对于应用启动时刻，非递减），
+ * 空行和以 '#' 开头的行被忽略。回放完后不再产生任务。lambda 不起作用。
+ */
+class TraceArrivalProcess : public TaskArrivalProcess
+{
+public:
+    static TypeId GetTypeId(void);
+    TraceArrivalProcess();
+    virtual ~TraceArrivalProcess();
+
+    virtual Time GetNextInterval(void);
+
+    /**
+     * 直接给出到达时刻序列（替代 FileName）
+     * @param arrivals 相对于启动时刻的到达时刻，非递减
+     */
+    void SetArrivals(const std::vector<Time>& arrivals);
+
+private:
+    void Load(void);
+
+    std::string m_fileName;
+    bool m_loaded;
+    std::vector<Time> m_arrivals;
+    std::size_t m_next;
+    Time m_last;
+};
+
+} // namespace ns3
+
+#endif // TASK_ARRIVAL_PROCESS_H
@@ -0,0 +1,431 @@
+#include "task-dispatch-policy.h"
+
+#include "pro-sink-app.h"
+
+#include "ns3/channel.h"
+#include "ns3/enum.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/udp-l4-protocol.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("TaskDispatchPolicy");
+
+NS_OBJECT_ENSURE_REGISTERED(TaskDispatchPolicy);
+NS_OBJECT_ENSURE_REGISTERED(UniformDispatchPolicy);
+NS_OBJECT_ENSURE_REGISTERED(RoundRobinDispatchPolicy);
+NS_OBJECT_ENSURE_REGISTERED(WeightedDispatchPolicy);
+NS_OBJECT_ENSURE_REGISTERED(PowerOfTwoDispatchPolicy);
+NS_OBJECT_ENSURE_REGISTERED(NearestDispatchPolicy);
+
+// --- TaskDispatchPolicy ---
+
+TypeId TaskDispatchPolicy::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::TaskDispatchPolicy")
+        .SetParent<Object>()
+        .SetGroupName("Applications")
+    ;
+    return tid;
+}
+
+TaskDispatchPolicy::TaskDispatchPolicy()
+{
+}
+
+TaskDispatchPolicy::~TaskDispatchPolicy()
+{
+}
+
+void
+TaskDispatchPolicy::SetSinks(const std::vector<Address>& sinks)
+{
+    m_sinks = sinks;
+}
+
+const std::vector<Address>&
+TaskDispatchPolicy::GetSinks(void) const
+{
+    return m_sinks;
+}
+
+int64_t
+TaskDispatchPolicy::AssignStreams(int64_t stream)
+{
+    return 0;
+}
+
+// --- UniformDispatchPolicy ---
+
+TypeId UniformDispatchPolicy::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::UniformDispatchPolicy")
+        .SetParent<TaskDispatchPolicy>()
+        .SetGroupName("Applications")
+        .AddConstructor<UniformDispatchPolicy>()
+    ;
+    return tid;
+}
+
+UniformDispatchPolicy::UniformDispatchPolicy()
+    : m_rng(CreateObject<UniformRandomVariable>())
+{
+}
+
+UniformDispatchPolicy::~UniformDispatchPolicy()
+{
+}
+
+uint32_t
+UniformDispatchPolicy::SelectSink(Ptr<Node> producer)
+{
+    NS_ASSERT(!m_sinks.empty());
+    // GetInteger(min, max) 两端都包含，每个下标概率相同
+    return m_rng->GetInteger(0, m_sinks.size() - 1);
+}
+
+int64_t
+UniformDispatchPolicy::AssignStreams(int64_t stream)
+{
+    m_rng->SetStream(stream);
+    return 1;
+}
+
+// --- RoundRobinDispatchPolicy ---
+
+TypeId RoundRobinDispatchPolicy::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::RoundRobinDispatchPolicy")
+        .SetParent<TaskDispatchPolicy>()
+        .SetGroupName("Applications")
+        .AddConstructor<RoundRobinDispatchPolicy>()
+    ;
+    return tid;
+}
+
+RoundRobinDispatchPolicy::RoundRobinDispatchPolicy()
+    : m_next(0)
+{
+}
+
+RoundRobinDispatchPolicy::~RoundRobinDispatchPolicy()
+{
+}
+
+void
+RoundRobinDispatchPolicy::SetSinks(const std::vector<Address>& sinks)
+{
+    TaskDispatchPolicy::SetSinks(sinks);
+    m_next = 0;
+}
+
+uint32_t
+RoundRobinDispatchPolicy::SelectSink(Ptr<Node> producer)
+{
+    NS_ASSERT(!m_sinks.empty());
+    uint32_t idx = m_next;
+    m_next = (m_next + 1) % m_sinks.size();
+    return idx;
+}
+
+// --- WeightedDispatchPolicy ---
+
+TypeId WeightedDispatchPolicy::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::WeightedDispatchPolicy")
+        .SetParent<TaskDispatchPolicy>()
+        .SetGroupName("Applications")
+        .AddConstructor<WeightedDispatchPolicy>()
+    ;
+    return tid;
+}
+
+WeightedDispatchPolicy::WeightedDispatchPolicy()
+    : m_rng(CreateObject<UniformRandomVariable>())
+{
+}
+
+WeightedDispatchPolicy::~WeightedDispatchPolicy()
+{
+}
+
+void
+WeightedDispatchPolicy::SetWeights(const std::vector<double>& weights)
+{
+    m_cumulative.resize(weights.size());
+    double sum = 0.0;
+    for (std::size_t i = 0; i < weights.size(); ++i)
+    {
+        NS_ABORT_MSG_IF(weights[i] < 0.0, "Dispatch weights must be non-negative");
+        sum += weights[i];
+        m_cumulative[i] = sum;
+    }
+    NS_ABORT_MSG_IF(!weights.empty() && sum <= 0.0, "At least one dispatch weight must be positive");
+}
+
+uint32_t
+WeightedDispatchPolicy::SelectSink(Ptr<Node> producer)
+{
+    NS_ASSERT(!m_sinks.empty());
+    if (m_cumulative.size() != m_sinks.size())
+    {
+        return m_rng->GetInteger(0, m_sinks.size() - 1);
+    }
+    double u = m_rng->GetValue(0.0, m_cumulative.back());
+    auto it = std::upper_bound(m_cumulative.begin(), m_cumulative.end(), u);
+    if (it == m_cumulative.end())
+    {
+        --it;
+    }
+    return static_cast<uint32_t>(it - m_cumulative.begin());
+}
+
+int64_t
+WeightedDispatchPolicy::AssignStreams(int64_t stream)
+{
+    m_rng->SetStream(stream);
+    return 1;
+}
+
+// --- PowerOfTwoDispatchPolicy ---
+
+TypeId PowerOfTwoDispatchPolicy::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::PowerOfTwoDispatchPolicy")
+        .SetParent<TaskDispatchPolicy>()
+        .SetGroupName("Applications")
+        .AddConstructor<PowerOfTwoDispatchPolicy>()
+    ;
+    return tid;
+}
+
+PowerOfTwoDispatchPolicy::PowerOfTwoDispatchPolicy()
+    : m_rng(CreateObject<UniformRandomVariable>())
+{
+}
+
+PowerOfTwoDispatchPolicy::~PowerOfTwoDispatchPolicy()
+{
+}
+
+void
+PowerOfTwoDispatchPolicy::SetLoadCallback(LoadCallback load)
+{
+    m_load = load;
+}
+
+void
+PowerOfTwoDispatchPolicy::SetSinkApplications(const std::vector<Ptr<MySink>>& apps)
+{
+    m_apps = apps;
+    m_bySink.clear();
+}
+
+uint32_t
+PowerOfTwoDispatchPolicy::GetSinkLoad(uint32_t index)
+{
+    if (!m_load.IsNull())
+    {
+        return m_load(index);
+    }
+    if (m_bySink.size() != m_sinks.size())
+    {
+        // 按 IP 地址把消费者应用与候选地址对应起来
+        m_bySink.assign(m_sinks.size(), nullptr);
+        for (std::size_t i = 0; i < m_sinks.size(); ++i)
+        {
+            Ipv4Address ip = InetSocketAddress::ConvertFrom(m_sinks[i]).GetIpv4();
+            for (const auto& app : m_apps)
+            {
+                Ptr<Ipv4> ipv4 = app->GetNode()->GetObject<Ipv4>();
+                if (ipv4 && ipv4->GetInterfaceForAddress(ip) >= 0)
+                {
+                    m_bySink[i] = app;
+                    break;
+                }
+            }
+        }
+    }
+    Ptr<MySink> app = m_bySink[index];
+    if (!app)
+    {
+        return 0;
+    }
+    return app->GetQueueLength() + app->GetBusyServers();
+}
+
+uint32_t
+PowerOfTwoDispatchPolicy::SelectSink(Ptr<Node> producer)
+{
+    NS_ASSERT(!m_sinks.empty());
+    uint32_t n = m_sinks.size();
+    uint32_t a = m_rng->GetInteger(0, n - 1);
+    if (n == 1)
+    {
+        return a;
+    }
+    // 第二个候选与第一个不同
+    uint32_t b = (a + 1 + m_rng->GetInteger(0, n - 2)) % n;
+    return GetSinkLoad(b) < GetSinkLoad(a) ? b : a;
+}
+
+int64_t
+PowerOfTwoDispatchPolicy::AssignStreams(int64_t stream)
+{
+    m_rng->SetStream(stream);
+    return 1;
+}
+
+// --- NearestDispatchPolicy ---
+
+TypeId NearestDispatchPolicy::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::NearestDispatchPolicy")
+        .SetParent<TaskDispatchPolicy>()
+        .SetGroupName("Applications")
+        .AddConstructor<NearestDispatchPolicy>()
+        .AddAttribute("Metric",
+                      "Distance metric: Hops or Latency (sum of channel Delay along the route).",
+                      EnumValue(NearestDispatchPolicy::HOPS),
+                      MakeEnumAccessor(&NearestDispatchPolicy::m_metric),
+                      MakeEnumChecker(NearestDispatchPolicy::HOPS, "Hops",
+                                      NearestDispatchPolicy::LATENCY, "Latency"))
+    ;
+    return tid;
+}
+
+NearestDispatchPolicy::NearestDispatchPolicy()
+    : m_metric(HOPS),
+      m_next(0)
+{
+}
+
+NearestDispatchPolicy::~NearestDispatchPolicy()
+{
+}
+
+void
+NearestDispatchPolicy::SetSinks(const std::vector<Address>& sinks)
+{
+    TaskDispatchPolicy::SetSinks(sinks);
+    m_nearest.clear();
+    m_next = 0;
+}
+
+double
+NearestDispatchPolicy::GetDistance(Ptr<Node> producer, const Address& sink) const
+{
+    const double unreachable = std::numeric_limits<double>::infinity();
+    if (!InetSocketAddress::IsMatchingType(sink))
+    {
+        return unreachable;
+    }
+    Ipv4Address dest = InetSocketAddress::ConvertFrom(sink).GetIpv4();
+
+    Ptr<Node> cur = producer;
+    double hops = 0.0;
+    double delay = 0.0;
+    // 沿各节点路由表的下一跳前进，最多经过全部节点
+    for (uint32_t step = 0; step <= NodeList::GetNNodes(); ++step)
+    {
+        Ptr<Ipv4> ipv4 = cur->GetObject<Ipv4>();
+        if (!ipv4)
+        {
+            return unreachable;
+        }
+        if (ipv4->GetInterfaceForAddress(dest) >= 0)
+        {
+            return m_metric == HOPS ? hops : delay;
+        }
+        if (!ipv4->GetRoutingProtocol())
+        {
+            return unreachable;
+        }
+        Ipv4Header header;
+        header.SetDestination(dest);
+        header.SetProtocol(UdpL4Protocol::PROT_NUMBER);
+        Socket::SocketErrno err;
+        Ptr<Ipv4Route> route = ipv4->GetRoutingProtocol()->RouteOutput(nullptr, header, nullptr, err);
+        if (!route || !route->GetOutputDevice() || !route->GetOutputDevice()->GetChannel())
+        {
+            return unreachable;
+        }
+        Ptr<NetDevice> dev = route->GetOutputDevice();
+        Ptr<Channel> channel = dev->GetChannel();
+        Ipv4Address next = route->GetGateway() == Ipv4Address::GetZero() ? dest : route->GetGateway();
+
+        // 在信道另一端找到拥有下一跳地址的设备
+        Ptr<Node> peer = nullptr;
+        for (std::size_t d = 0; d < channel->GetNDevices() && !peer; ++d)
+        {
+            Ptr<NetDevice> candidate = channel->GetDevice(d);
+            if (candidate == dev)
+            {
+                continue;
+            }
+            Ptr<Ipv4> candidateIpv4 = candidate->GetNode()->GetObject<Ipv4>();
+            if (candidateIpv4 && candidateIpv4->GetInterfaceForAddress(next) >= 0)
+            {
+                peer = candidate->GetNode();
+            }
+        }
+        if (!peer)
+        {
+            return unreachable;
+        }
+        TimeValue channelDelay;
+        if (channel->GetAttributeFailSafe("Delay", channelDelay))
+        {
+            delay += channelDelay.Get().GetSeconds();
+        }
+        hops += 1.0;
+        cur = peer;
+    }
+    return unreachable;
+}
+
+uint32_t
+NearestDispatchPolicy::SelectSink(Ptr<Node> producer)
+{
+    NS_ASSERT(!m_sinks.empty());
+    if (m_nearest.empty())
+    {
+        // 拓扑与路由在运行中不变，第一次选择时计算一次
+        double best = std::numeric_limits<double>::infinity();
+        for (uint32_t i = 0; i < m_sinks.size(); ++i)
+        {
+            double d = GetDistance(producer, m_sinks[i]);
+            NS_LOG_DEBUG("Node " << producer->GetId() << " -> sink " << i << " distance " << d);
+            if (d < best)
+            {
+                best = d;
+                m_nearest.assign(1, i);
+            }
+            else if (d == best)
+            {
+                m_nearest.push_back(i);
+            }
+        }
+        if (m_nearest.empty())
+        {
+            NS_LOG_WARN("Node " << producer->GetId() << " cannot reach any sink; using all");
+            m_nearest.resize(m_sinks.size());
+            std::iota(m_nearest.begin(), m_nearest.end(), 0);
+        }
+    }
+    uint32_t idx = m_nearest[m_next % m_nearest.size()];
+    ++m_next;
+    return idx;
+}
+
+} // namespace ns3
@@ -0,0 +1,180 @@
+#ifndef TASK_DISPATCH_POLICY_H
+#define TASK_DISPATCH_POLICY_H
+
+#include "ns3/address.h"
+#include "ns3/callback.h"
+#include "ns3/node.h"
+#include "ns3/object.h"
+#include "ns3/random-variable-stream.h"
+
+#include <vector>
+
+namespace ns3 {
+
+class MySink;
+
+/**
+ * 任务分发策略的基类：MyProducer 每发送一个任务，向策略询问目标消费者。
+ */
+class TaskDispatchPolicy : public Object
+{
+public:
+    static TypeId GetTypeId(void);
+    TaskDispatchPolicy();
+    virtual ~TaskDispatchPolicy();
+
+    /**
+     * 设置候选消费者地址（由 MyProducer 在启动时调用）
+     * @param sinks 候选消费者地址
+     */
+    virtual void SetSinks(const std::vector<Address>& sinks);
+    const std::vector<Address>& GetSinks(void) const;
+
+    /**
+     * 为一个新任务选择目标
+     * @param producer 生产者所在节点
+     * @return 目标在 GetSinks() 中的下标
+     */
+    virtual uint32_t SelectSink(Ptr<Node> producer) = 0;
+
+    /**
+     * 为使用的随机变量分配固定的随机流编号
+     * @param stream 第一个随机流编号
+     * @return 使用的随机流个数
+     */
+    virtual int64_t AssignStreams(int64_t stream);
+
+protected:
+    std::vector<Address> m_sinks; //!< 候选消费者地址
+};
+
+/**
+ * 在所有消费者中等概率随机选择
+ */
+class UniformDispatchPolicy : public TaskDispatchPolicy
+{
+public:
+    static TypeId GetTypeId(void);
+    UniformDispatchPolicy();
+    virtual ~UniformDispatchPolicy();
+
+    virtual uint32_t SelectSink(Ptr<Node> producer);
+    virtual int64_t AssignStreams(int64_t stream);
+
+private:
+    Ptr<UniformRandomVariable> m_rng;
+};
+
+/**
+ * 依次轮流选择各个消费者
+ */
+class RoundRobinDispatchPolicy : public TaskDispatchPolicy
+{
+public:
+    static TypeId GetTypeId(void);
+    RoundRobinDispatchPolicy();
+    virtual ~RoundRobinDispatchPolicy();
+
+    virtual void SetSinks(const std::vector<Address>& sinks);
+    virtual uint32_t SelectSink(Ptr<Node> producer);
+
+private:
+    uint32_t m_next;
+};
+
+/**
+ * 按权重（如 nodes.csv 中消费者的处理速率）随机选择；未设置权重时等概率
+ */
+class WeightedDispatchPolicy : public TaskDispatchPolicy
+{
+public:
+    static TypeId GetTypeId(void);
+    WeightedDispatchPolicy();
+    virtual ~WeightedDispatchPolicy();
+
+    /**
+     * @param weights 与 GetSinks() 一一对应的非负权重
+     */
+    void SetWeights(const std::vector<double>& weights);
+
+    virtual uint32_t SelectSink(Ptr<Node> producer);
+    virtual int64_t AssignStreams(int64_t stream);
+
+private:
+    std::vector<double> m_cumulative; //!< 累积权重
+    Ptr<UniformRandomVariable> m_rng;
+};
+
+/**
+ * 二选一 (power-of-two-choices)：随机取两个不同的消费者，选负载较小者。
+ *
+ * 负载由回调给出；SetSinkApplications() 直接以 MySink 的等待队列长度加服务中
+ * 任务数作为负载（仿真中的即时反馈）。
+ */
+class PowerOfTwoDispatchPolicy : public TaskDispatchPolicy
+{
+public:
+    /// 负载回调：参数为消费者下标，返回其当前负载
+    typedef Callback<uint32_t, uint32_t> LoadCallback;
+
+    static TypeId GetTypeId(void);
+    PowerOfTwoDispatchPolicy();
+    virtual ~PowerOfTwoDispatchPolicy();
+
+    void SetLoadCallback(LoadCallback load);
+    /**
+     * 以 MySink 的队列长度作为负载；按地址与 GetSinks() 对应，无需顺序一致
+     * @param apps 消费者应用
+     */
+    void SetSinkApplications(const std::vector<Ptr<MySink>>& apps);
+
+    virtual uint32_t SelectSink(Ptr<Node> producer);
+    virtual int64_t AssignStreams(int64_t stream);
+
+private:
+    uint32_t GetSinkLoad(uint32_t index);
+
+    LoadCallback m_load;
+    std::vector<Ptr<MySink>> m_apps;   //!< 候选的消费者应用
+    std::vector<Ptr<MySink>> m_bySink; //!< 与 m_sinks 对齐的消费者应用
+    Ptr<UniformRandomVariable> m_rng;
+};
+
+/**
+ * 选择路由上最近的消费者（跳数或累计链路时延），按全局路由表沿下一跳逐跳计算。
+ * 距离在第一次选择时计算并缓存；并列最近者之间轮流选择。
+ */
+class NearestDispatchPolicy : public TaskDispatchPolicy
+{
+public:
+    /// 距离度量
+    enum Metric
+    {
+        HOPS,   //!< 跳数
+        LATENCY //!< 沿路径累计的信道 Delay
+    };
+
+    static TypeId GetTypeId(void);
+    NearestDispatchPolicy();
+    virtual ~NearestDispatchPolicy();
+
+    virtual void SetSinks(const std::vector<Address>& sinks);
+    virtual uint32_t SelectSink(Ptr<Node> producer);
+
+    /**
+     * 沿路由表计算 producer 到 sink 的距离
+     * @param producer 起点
+     * @param sink 目的地址
+     * @return 按 Metric 的距离（跳数或秒）；不可达时为 +inf
+     */
+    double GetDistance(Ptr<Node> producer, const Address& sink) const;
+
+private:
+    Metric m_metric;
+    std::vector<uint32_t> m_nearest; //!< 并列最近的消费者下标
+    uint32_t m_next;
+};
+
+} // namespace ns3
+
+#endif // TASK_DISPATCH_POLICY_H
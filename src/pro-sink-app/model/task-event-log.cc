@@ -0,0 +1,417 @@
+#include "task-event-log.h"
+
+#include "ns3/ipv4-address.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("TaskEventLog");
+
+namespace {
+
+const char EVLOG_MAGIC[8] = {'D', 'S', 'W', 'E', 'V', 'L', 'O', 'G'};
+const uint32_t EVLOG_VERSION = 1;
+const uint32_t EVLOG_ENDIAN = 0x01020304;
+const uint32_t EVLOG_HEADER_SIZE = 32;
+const uint32_t EVLOG_TRAILER_SIZE = 48;
+const uint32_t EVLOG_INDEX_ENTRY_SIZE = 32;
+
+/// 文件头
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t endian;
+    uint32_t reserved[3];
+};
+
+/// 文件尾部，位于文件最后 48 字节
+struct FileTrailer
+{
+    uint64_t blockCount;
+    uint64_t indexOffset;
+    uint64_t recordCount;
+    uint64_t prologueLength;
+    uint64_t epilogueLength;
+    char magic[8];
+};
+
+static_assert(sizeof(TaskEventLog::Record) == TaskEventLog::RECORD_SIZE, "Record must be 32 bytes");
+static_assert(sizeof(FileHeader) == EVLOG_HEADER_SIZE, "Header must be 32 bytes");
+static_assert(sizeof(FileTrailer) == EVLOG_TRAILER_SIZE, "Trailer must be 48 bytes");
+
+} // namespace
+
+// --- TaskEventLog ---
+
+TaskEventLog::TaskEventLog()
+    : m_file(nullptr),
+      m_blockRecords(0),
+      m_current(nullptr),
+      m_fill(0),
+      m_records(0),
+      m_stop(false),
+      m_writeError(false)
+{
+}
+
+TaskEventLog::~TaskEventLog()
+{
+    Close();
+}
+
+bool
+TaskEventLog::Open(const std::string& fileName, uint32_t blockRecords)
+{
+    Close();
+    m_file = std::fopen(fileName.c_str(), "wb");
+    if (m_file == nullptr)
+    {
+        NS_LOG_ERROR("Cannot open event log " << fileName);
+        return false;
+    }
+    // 写线程使用自己的用户态块，关闭 stdio 的缓冲以免多拷贝一次
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, EVLOG_MAGIC, sizeof(header.magic));
+    header.version = EVLOG_VERSION;
+    header.recordSize = RECORD_SIZE;
+    header.endian = EVLOG_ENDIAN;
+    if (std::fwrite(&header, sizeof(header), 1, m_file) != 1)
+    {
+        NS_LOG_ERROR("Cannot write the header of event log " << fileName);
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_writeError = false;
+
+    // 三个块：一个在填充，一个在写盘，一个备用
+    m_blockRecords = std::max<uint32_t>(blockRecords, 1);
+    m_buffers.assign(3, std::vector<Record>(m_blockRecords));
+    m_free.clear();
+    for (std::size_t i = 1; i < m_buffers.size(); ++i)
+    {
+        m_free.push_back(m_buffers[i].data());
+    }
+    m_current = m_buffers[0].data();
+    m_fill = 0;
+    m_records = 0;
+    m_index.clear();
+    m_full.clear();
+    m_stop = false;
+    m_writer = std::thread(&TaskEventLog::WriterLoop, this);
+    return true;
+}
+
+bool
+TaskEventLog::IsOpen() const
+{
+    return m_file != nullptr;
+}
+
+void
+TaskEventLog::Append(EventType type,
+                     Time time,
+                     uint32_t node,
+                     uint32_t producer,
+                     uint32_t task,
+                     uint32_t value)
+{
+    if (m_fill == m_blockRecords)
+    {
+        SubmitBlock();
+    }
+    Record& r = m_current[m_fill++];
+    r.time = time.GetTimeStep();
+    r.node = node;
+    r.producer = producer;
+    r.task = task;
+    r.value = value;
+    r.type = static_cast<uint8_t>(type);
+    std::memset(r.reserved, 0, sizeof(r.reserved));
+}
+
+void
+TaskEventLog::SubmitBlock()
+{
+    if (m_fill == 0)
+    {
+        return;
+    }
+    BlockIndex entry;
+    entry.offset = EVLOG_HEADER_SIZE + m_records * RECORD_SIZE;
+    entry.count = m_fill;
+    entry.reserved = 0;
+    entry.firstTime = m_current[0].time;
+    entry.lastTime = m_current[m_fill - 1].time;
+    m_index.push_back(entry);
+    m_records += m_fill;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_full.push_back(Block{m_current, m_fill});
+    m_fullCv.notify_one();
+    // 写线程跟不上时在这里等待一个空闲块（背压）
+    m_freeCv.wait(lock, [this] { return !m_free.empty(); });
+    m_current = m_free.back();
+    m_free.pop_back();
+    m_fill = 0;
+}
+
+void
+TaskEventLog::WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_fullCv.wait(lock, [this] { return !m_full.empty() || m_stop; });
+        if (m_full.empty())
+        {
+            break;
+        }
+        Block block = m_full.front();
+        m_full.pop_front();
+        lock.unlock();
+        bool ok = std::fwrite(block.data, RECORD_SIZE, block.count, m_file) == block.count;
+        lock.lock();
+        m_writeError = m_writeError || !ok;
+        m_free.push_back(block.data);
+        m_freeCv.notify_one();
+    }
+}
+
+void
+TaskEventLog::SetPrologue(const std::string& text)
+{
+    m_prologue = text;
+}
+
+void
+TaskEventLog::SetEpilogue(const std::string& text)
+{
+    m_epilogue = text;
+}
+
+bool
+TaskEventLog::Close()
+{
+    if (m_file == nullptr)
+    {
+        return true;
+    }
+    SubmitBlock();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_fullCv.notify_one();
+    }
+    m_writer.join();
+
+    FileTrailer trailer;
+    std::memset(&trailer, 0, sizeof(trailer));
+    static_assert(sizeof(BlockIndex) == EVLOG_INDEX_ENTRY_SIZE, "Index entry must be 32 bytes");
+    trailer.blockCount = m_index.size();
+    trailer.indexOffset = EVLOG_HEADER_SIZE + m_records * RECORD_SIZE;
+    trailer.recordCount = m_records;
+    trailer.prologueLength = m_prologue.size();
+    trailer.epilogueLength = m_epilogue.size();
+    std::memcpy(trailer.magic, EVLOG_MAGIC, sizeof(trailer.magic));
+
+    bool ok = !m_writeError;
+    if (!m_index.empty())
+    {
+        ok = ok && std::fwrite(m_index.data(), sizeof(BlockIndex), m_index.size(), m_file) ==
+                       m_index.size();
+    }
+    ok = ok && std::fwrite(m_prologue.data(), 1, m_prologue.size(), m_file) == m_prologue.size();
+    ok = ok && std::fwrite(m_epilogue.data(), 1, m_epilogue.size(), m_file) == m_epilogue.size();
+    ok = ok && std::fwrite(&trailer, sizeof(trailer), 1, m_file) == 1;
+    ok = (std::fclose(m_file) == 0) && ok;
+    if (!ok)
+    {
+        NS_LOG_ERROR("Error while writing the event log");
+    }
+    m_file = nullptr;
+    m_buffers.clear();
+    m_free.clear();
+    m_current = nullptr;
+    return ok;
+}
+
+uint64_t
+TaskEventLog::GetNRecords() const
+{
+    return m_records + m_fill;
+}
+
+void
+TaskEventLog::WriteXml(std::ostream& os, const Record& record)
+{
+    double seconds = TimeStep(record.time).GetSeconds();
+    switch (record.type)
+    {
+    case EDGE_SEND:
+        os << "  <Event type=\"EdgeSend\""
+           << " Time=\"" << seconds << "\""
+           << " Edge-Id=\"Edge-" << record.node << "\""
+           << " Task-Id=\"" << record.producer << "-" << record.task << "\""
+           << " TargetIp=\"" << Ipv4Address(record.value) << "\"/>\n";
+        break;
+    case CORE_COMPLETE:
+        os << "  <Event type=\"CoreComp\""
+           << " Time=\"" << seconds << "\""
+           << " Core-Id=\"Core-" << record.node << "\""
+           << " Edge-Id=\"Edge-" << record.producer << "\""
+           << " Task-Id=\"" << record.producer << "-" << record.task << "\""
+           << " TotalCompleted=\"" << record.value << "\"/>\n";
+        break;
+    case CORE_EVICT:
+        os << "  <Event type=\"CoreEvict\""
+           << " Time=\"" << seconds << "\""
+           << " Core-Id=\"Core-" << record.node << "\""
+           << " Edge-Id=\"Edge-" << record.producer << "\""
+           << " Task-Id=\"" << record.producer << "-" << record.task << "\""
+           << " RxBytes=\"" << record.value << "\"/>\n";
+        break;
+    case CORE_DROP:
+        os << "  <Event type=\"CoreDrop\""
+           << " Time=\"" << seconds << "\""
+           << " Core-Id=\"Core-" << record.node << "\""
+           << " Edge-Id=\"Edge-" << record.producer << "\""
+           << " Task-Id=\"" << record.producer << "-" << record.task << "\""
+           << " QueueLength=\"" << record.value << "\"/>\n";
+        break;
+    default:
+        NS_LOG_WARN("Unknown event type " << static_cast<uint32_t>(record.type));
+        break;
+    }
+}
+
+// --- TaskEventLogReader ---
+
+TaskEventLogReader::TaskEventLogReader()
+    : m_file(nullptr),
+      m_records(0),
+      m_read(0),
+      m_bufferPos(0),
+      m_bufferFill(0)
+{
+}
+
+TaskEventLogReader::~TaskEventLogReader()
+{
+    Close();
+}
+
+bool
+TaskEventLogReader::Open(const std::string& fileName)
+{
+    Close();
+    m_file = std::fopen(fileName.c_str(), "rb");
+    if (m_file == nullptr)
+    {
+        NS_LOG_ERROR("Cannot open event log " << fileName);
+        return false;
+    }
+
+    FileHeader header;
+    FileTrailer trailer;
+    bool ok = std::fread(&header, sizeof(header), 1, m_file) == 1 &&
+              std::memcmp(header.magic, EVLOG_MAGIC, sizeof(header.magic)) == 0 &&
+              header.version == EVLOG_VERSION && header.recordSize == TaskEventLog::RECORD_SIZE &&
+              header.endian == EVLOG_ENDIAN;
+    ok = ok && std::fseek(m_file, -static_cast<long>(sizeof(trailer)), SEEK_END) == 0 &&
+         std::fread(&trailer, sizeof(trailer), 1, m_file) == 1 &&
+         std::memcmp(trailer.magic, EVLOG_MAGIC, sizeof(trailer.magic)) == 0;
+    if (ok)
+    {
+        // 前言与后记紧跟在块索引之后
+        long textOffset = static_cast<long>(trailer.indexOffset + trailer.blockCount * EVLOG_INDEX_ENTRY_SIZE);
+        m_prologue.resize(trailer.prologueLength);
+        m_epilogue.resize(trailer.epilogueLength);
+        ok = std::fseek(m_file, textOffset, SEEK_SET) == 0 &&
+             std::fread(&m_prologue[0], 1, m_prologue.size(), m_file) == m_prologue.size() &&
+             std::fread(&m_epilogue[0], 1, m_epilogue.size(), m_file) == m_epilogue.size() &&
+             std::fseek(m_file, EVLOG_HEADER_SIZE, SEEK_SET) == 0;
+    }
+    if (!ok)
+    {
+        NS_LOG_ERROR("Invalid or truncated event log " << fileName);
+        Close();
+        return false;
+    }
+    m_records = trailer.recordCount;
+    m_read = 0;
+    m_buffer.resize(65536);
+    m_bufferPos = 0;
+    m_bufferFill = 0;
+    return true;
+}
+
+void
+TaskEventLogReader::Close()
+{
+    if (m_file != nullptr)
+    {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_records = 0;
+    m_read = 0;
+    m_bufferPos = 0;
+    m_bufferFill = 0;
+}
+
+const std::string&
+TaskEventLogReader::GetPrologue() const
+{
+    return m_prologue;
+}
+
+const std::string&
+TaskEventLogReader::GetEpilogue() const
+{
+    return m_epilogue;
+}
+
+uint64_t
+TaskEventLogReader::GetNRecords() const
+{
+    return m_records;
+}
+
+bool
+TaskEventLogReader::Next(TaskEventLog::Record& record)
+{
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+    if (m_bufferPos == m_bufferFill)
+    {
+        uint64_t left = m_records - m_read;
+        if (left == 0)
+        {
+            return false;
+        }
+        std::size_t want = static_cast<std::size_t>(std::min<uint64_t>(left, m_buffer.size()));
+        m_bufferFill = std::fread(m_buffer.data(), TaskEventLog::RECORD_SIZE, want, m_file);
+        m_bufferPos = 0;
+        if (m_bufferFill == 0)
+        {
+            NS_LOG_WARN("Event log ended after " << m_read << " of " << m_records << " records");
+            return false;
+        }
+    }
+    record = m_buffer[m_bufferPos++];
+    m_read++;
+    return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,178 @@
+#ifndef TASK_EVENT_LOG_H
+#define TASK_EVENT_LOG_H
+
+#include "ns3/nstime.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * 任务事件的二进制日志（写端）。
+ *
+ * 每个事件是 32 字节的定长记录，先写入用户态缓冲块，块满后交给后台写线程
+ * 顺序写盘，仿真线程不做格式化也不 flush。文件布局：
+ *
+ *   文件头 (32 B) | 数据块 ... | 块索引 (每块 32 B) | 前言 | 后记 | 尾部 (48 B)
+ *
+ * 块索引记录每块的偏移、记录数与首末时间，便于按时间跳读；前言/后记是任意
+ * 文本（如 XML 的开头和结尾），由 TaskEventLogReader 原样取回。
+ */
+class TaskEventLog
+{
+public:
+    /// 事件类型，与 Pro-Sink XML 的 Event type 一一对应
+    enum EventType
+    {
+        EDGE_SEND = 0,     //!< EdgeSend：生产者开始发送任务
+        CORE_COMPLETE = 1, //!< CoreComp：消费者处理完成
+        CORE_EVICT = 2,    //!< CoreEvict：未收全的任务被淘汰
+        CORE_DROP = 3      //!< CoreDrop：任务因队列已满被丢弃
+    };
+
+    /// 定长事件记录（主机字节序）
+    struct Record
+    {
+        int64_t time;      //!< 事件时刻 (时间步)
+        uint32_t node;     //!< 产生事件的节点
+        uint32_t producer; //!< 任务来源的生产者
+        uint32_t task;     //!< 任务 ID
+        uint32_t value;    //!< 与类型相关：累计完成数 / 已收字节 / 队列长度 / 目标 IPv4
+        uint8_t type;      //!< EventType
+        uint8_t reserved[7];
+    };
+
+    TaskEventLog();
+    ~TaskEventLog();
+
+    /**
+     * 打开日志文件、写出文件头并启动写线程
+     * @param fileName 输出文件
+     * @param blockRecords 每个缓冲块的记录数
+     * @return 是否成功；文件无法打开或文件头写入失败时为 false
+     */
+    bool Open(const std::string& fileName, uint32_t blockRecords = 65536);
+    bool IsOpen(void) const;
+
+    /**
+     * 追加一个事件（只做一次拷贝；块满时交给写线程）
+     */
+    void Append(EventType type,
+                Time time,
+                uint32_t node,
+                uint32_t producer,
+                uint32_t task,
+                uint32_t value);
+
+    /// 转换时放在所有事件之前的文本
+    void SetPrologue(const std::string& text);
+    /// 转换时放在所有事件之后的文本
+    void SetEpilogue(const std::string& text);
+
+    /**
+     * 写出剩余记录、块索引和尾部，等待写线程结束并关闭文件
+     * @return 是否所有内容都已写出；任何一次写入失败（如磁盘已满）都使文件
+     *         不完整，此时返回 false。未打开时返回 true
+     */
+    bool Close(void);
+
+    uint64_t GetNRecords(void) const;
+
+    /**
+     * 按 Pro-Sink XML 的格式输出一个事件（一行 &lt;Event .../&gt;）
+     * @param os 输出流
+     * @param record 事件记录
+     */
+    static void WriteXml(std::ostream& os, const Record& record);
+
+    static const uint32_t RECORD_SIZE = 32;
+
+private:
+    /// 一个交给写线程的数据块
+    struct Block
+    {
+        Record* data;
+        uint32_t count;
+    };
+
+    /// 块索引项
+    struct BlockIndex
+    {
+        uint64_t offset;
+        uint32_t count;
+        uint32_t reserved;
+        int64_t firstTime;
+        int64_t lastTime;
+    };
+
+    void SubmitBlock(void);
+    void WriterLoop(void);
+
+    std::FILE* m_file;
+    uint32_t m_blockRecords;
+    std::vector<std::vector<Record>> m_buffers; //!< 缓冲块存储
+    Record* m_current;                          //!< 正在填充的块
+    uint32_t m_fill;                            //!< 当前块已填充的记录数
+    uint64_t m_records;                         //!< 已追加的记录总数
+    std::vector<BlockIndex> m_index;
+    std::string m_prologue;
+    std::string m_epilogue;
+
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_fullCv; //!< 有满块待写或需要停止
+    std::condition_variable m_freeCv; //!< 有空闲块可用
+    std::deque<Block> m_full;
+    std::vector<Record*> m_free;
+    bool m_stop;
+    bool m_writeError;
+};
+
+/**
+ * 任务事件二进制日志的读端，按块流式读取，内存占用与记录数无关。
+ */
+class TaskEventLogReader
+{
+public:
+    TaskEventLogReader();
+    ~TaskEventLogReader();
+
+    /**
+     * @param fileName TaskEventLog 写出的文件
+     * @return 文件格式是否有效
+     */
+    bool Open(const std::string& fileName);
+    void Close(void);
+
+    const std::string& GetPrologue(void) const;
+    const std::string& GetEpilogue(void) const;
+    uint64_t GetNRecords(void) const;
+
+    /**
+     * 读取下一个事件
+     * @param record 输出记录
+     * @return false 表示已读完
+     */
+    bool Next(TaskEventLog::Record& record);
+
+private:
+    std::FILE* m_file;
+    uint64_t m_records;
+    uint64_t m_read;
+    std::string m_prologue;
+    std::string m_epilogue;
+    std::vector<TaskEventLog::Record> m_buffer;
+    std::size_t m_bufferPos;
+    std::size_t m_bufferFill;
+};
+
+} // namespace ns3
+
+#endif // TASK_EVENT_LOG_H
@@ -0,0 +1,250 @@
+#include "task-latency-monitor.h"
+
+#include "pro-sink-app.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("TaskLatencyMonitor");
+
+NS_OBJECT_ENSURE_REGISTERED(TaskLatencyMonitor);
+
+// --- TaskLatencyMonitor ---
+
+TaskLatencyMonitor::Histograms::Histograms(uint32_t subBucketBits)
+    : component(N_COMPONENTS, LogLinearHistogram(TimeStep(1).GetSeconds(), subBucketBits))
+{
+}
+
+TypeId TaskLatencyMonitor::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::TaskLatencyMonitor")
+        .SetParent<Object>()
+        .SetGroupName("Applications")
+        .AddConstructor<TaskLatencyMonitor>()
+        .AddAttribute("SubBucketBits",
+                      "Each power-of-two latency range is split into 2^SubBucketBits "
+                      "buckets; the relative error of a percentile is at most "
+                      "2^-SubBucketBits.",
+                      UintegerValue(6),
+                      MakeUintegerAccessor(&TaskLatencyMonitor::m_subBucketBits),
+                      MakeUintegerChecker<uint32_t>(1, 16))
+        .AddAttribute("ReportInterval",
+                      "Interval of the periodic (cumulative) percentile report. Zero "
+                      "disables it; Report() can still be called at the end of the run.",
+                      TimeValue(Seconds(0)),
+                      MakeTimeAccessor(&TaskLatencyMonitor::m_reportInterval),
+                      MakeTimeChecker())
+    ;
+    return tid;
+}
+
+TaskLatencyMonitor::TaskLatencyMonitor()
+    : m_subBucketBits(6),
+      m_reportInterval(Seconds(0))
+{
+}
+
+TaskLatencyMonitor::~TaskLatencyMonitor()
+{
+}
+
+void
+TaskLatencyMonitor::NotifyConstructionCompleted()
+{
+    Object::NotifyConstructionCompleted();
+    m_overall = Histograms(m_subBucketBits);
+    m_empty = Histograms(m_subBucketBits);
+}
+
+void
+TaskLatencyMonitor::DoDispose()
+{
+    Simulator::Cancel(m_reportEvent);
+    m_bySink.clear();
+    m_byProducer.clear();
+    Object::DoDispose();
+}
+
+void
+TaskLatencyMonitor::AddSink(Ptr<MySink> sink)
+{
+    sink->TraceConnectWithoutContext("TaskLatency",
+                                     MakeCallback(&TaskLatencyMonitor::RecordTask, this));
+    if (!m_reportInterval.IsZero() && !m_reportEvent.IsRunning())
+    {
+        m_reportEvent =
+            Simulator::Schedule(m_reportInterval, &TaskLatencyMonitor::PeriodicReport, this);
+    }
+}
+
+TaskLatencyMonitor::Histograms&
+TaskLatencyMonitor::Lookup(std::map<uint32_t, Histograms>& table, uint32_t id)
+{
+    auto it = table.find(id);
+    if (it == table.end())
+    {
+        it = table.emplace(id, Histograms(m_subBucketBits)).first;
+    }
+    return it->second;
+}
+
+void
+TaskLatencyMonitor::RecordTask(uint32_t sinkId,
+                               uint32_t producerId,
+                               uint32_t taskId,
+                               Time queueing,
+                               Time transfer,
+                               Time service)
+{
+    Time parts[N_COMPONENTS] = {queueing, transfer, service, queueing + transfer + service};
+#ifdef NS3_MTP
+    std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+    Histograms& bySink = Lookup(m_bySink, sinkId);
+    Histograms& byProducer = Lookup(m_byProducer, producerId);
+    for (uint32_t c = 0; c < N_COMPONENTS; ++c)
+    {
+        double seconds = std::max(parts[c], Time(0)).GetSeconds();
+        m_overall.component[c].AddValue(seconds);
+        bySink.component[c].AddValue(seconds);
+        byProducer.component[c].AddValue(seconds);
+    }
+}
+
+const TaskLatencyMonitor::Histograms&
+TaskLatencyMonitor::GetOverall() const
+{
+    return m_overall;
+}
+
+const TaskLatencyMonitor::Histograms&
+TaskLatencyMonitor::GetSinkHistograms(uint32_t sinkId) const
+{
+    auto it = m_bySink.find(sinkId);
+    return it == m_bySink.end() ? m_empty : it->second;
+}
+
+const TaskLatencyMonitor::Histograms&
+TaskLatencyMonitor::GetProducerHistograms(uint32_t producerId) const
+{
+    auto it = m_byProducer.find(producerId);
+    return it == m_byProducer.end() ? m_empty : it->second;
+}
+
+const char*
+TaskLatencyMonitor::GetComponentName(Component component)
+{
+    switch (component)
+    {
+    case QUEUEING:
+        return "Queueing";
+    case TRANSFER:
+        return "Transfer";
+    case SERVICE:
+        return "Service";
+    case TOTAL:
+        return "Total";
+    default:
+        return "Unknown";
+    }
+}
+
+void
+TaskLatencyMonitor::ReportLine(std::ostream& os, const std::string& label, const Histograms& h)
+{
+    for (uint32_t c = 0; c < N_COMPONENTS; ++c)
+    {
+        const LogLinearHistogram& hist = h.component[c];
+        os << std::left << std::setw(14) << (c == 0 ? label : "") << std::setw(10)
+           << GetComponentName(static_cast<Component>(c)) << std::right << std::fixed
+           << std::setprecision(3) << " n=" << std::setw(7) << hist.GetCount()
+           << "  p50=" << std::setw(9) << hist.GetQuantile(0.5) * 1000
+           << "  p90=" << std::setw(9) << hist.GetQuantile(0.9) * 1000
+           << "  p99=" << std::setw(9) << hist.GetQuantile(0.99) * 1000
+           << "  p999=" << std::setw(9) << hist.GetQuantile(0.999) * 1000
+           << "  max=" << std::setw(9) << hist.GetMax() * 1000 << " ms"
+           << std::endl;
+    }
+}
+
+void
+TaskLatencyMonitor::Report(std::ostream& os) const
+{
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << "--- Task latency at " << Simulator::Now().GetSeconds() << "s (ms) ---" << std::endl;
+    ReportLine(os, "All", m_overall);
+    for (const auto& entry : m_bySink)
+    {
+        ReportLine(os, "Sink " + std::to_string(entry.first), entry.second);
+    }
+    for (const auto& entry : m_byProducer)
+    {
+        ReportLine(os, "Producer " + std::to_string(entry.first), entry.second);
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void
+TaskLatencyMonitor::XmlLine(std::ostream& os,
+                            uint16_t indent,
+                            const std::string& element,
+                            int64_t id,
+                            const Histograms& h)
+{
+    for (uint32_t c = 0; c < N_COMPONENTS; ++c)
+    {
+        const LogLinearHistogram& hist = h.component[c];
+        os << std::string(indent, ' ') << "<" << element;
+        if (id >= 0)
+        {
+            os << " Id=\"" << id << "\"";
+        }
+        os << " Component=\"" << GetComponentName(static_cast<Component>(c)) << "\""
+           << " Count=\"" << hist.GetCount() << "\""
+           << " Mean=\"" << hist.GetMean() << "\""
+           << " P50=\"" << hist.GetQuantile(0.5) << "\""
+           << " P90=\"" << hist.GetQuantile(0.9) << "\""
+           << " P99=\"" << hist.GetQuantile(0.99) << "\""
+           << " P999=\"" << hist.GetQuantile(0.999) << "\""
+           << " Max=\"" << hist.GetMax() << "\" />" << std::endl;
+    }
+}
+
+void
+TaskLatencyMonitor::SerializeToXmlStream(std::ostream& os, uint16_t indent) const
+{
+    os << std::string(indent, ' ') << "<TaskLatency unit=\"s\" time=\""
+       << Simulator::Now().GetSeconds() << "\">" << std::endl;
+    XmlLine(os, indent + 2, "Overall", -1, m_overall);
+    for (const auto& entry : m_bySink)
+    {
+        XmlLine(os, indent + 2, "Sink", entry.first, entry.second);
+    }
+    for (const auto& entry : m_byProducer)
+    {
+        XmlLine(os, indent + 2, "Producer", entry.first, entry.second);
+    }
+    os << std::string(indent, ' ') << "</TaskLatency>" << std::endl;
+}
+
+void
+TaskLatencyMonitor::PeriodicReport()
+{
+    std::ostringstream oss;
+    Report(oss);
+    NS_LOG_UNCOND(oss.str());
+    m_reportEvent =
+        Simulator::Schedule(m_reportInterval, &TaskLatencyMonitor::PeriodicReport, this);
+}
+
+} // namespace ns3
@@ -0,0 +1,120 @@
+#ifndef TASK_LATENCY_MONITOR_H
+#define TASK_LATENCY_MONITOR_H
+
+#include "ns3/event-id.h"
+#include "ns3/log-linear-histogram.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <map>
+#ifdef NS3_MTP
+#include <mutex>
+#endif
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class MySink;
+
+/**
+ * 收集 MySink 的 TaskLatency Trace，按消费者和生产者分别统计任务时延分位数。
+ *
+ * 每个任务的时延分为排队（生产者积压 + 消费者等待队列）、传输（第一个包发出
+ * 到收全）和服务三部分，再加上端到端总时延，每部分各一个 LogLinearHistogram：
+ * 以秒为单位、最小桶宽为一个时间步，每个 2 的幂区间再等分为 2^SubBucketBits 个桶，
+ * 桶只分配到记录过的最大值，内存随最大时延的对数增长，与任务数无关。
+ *
+ * 以 NS3_MTP 构建时 RecordTask 加锁，多线程仿真器各分区的消费者可以共用一个
+ * 监视器；此时均值的最后几位可能随记录顺序变化，计数与分位数不变。
+ */
+class TaskLatencyMonitor : public Object
+{
+public:
+    /// 时延组成部分
+    enum Component
+    {
+        QUEUEING = 0, //!< 生产者积压 + 消费者队列等待
+        TRANSFER,     //!< 第一个包发出到任务收全
+        SERVICE,      //!< 消费者服务时间
+        TOTAL,        //!< 任务到达生产者到处理完成
+        N_COMPONENTS
+    };
+
+    /// 一组（各组成部分的）直方图
+    struct Histograms
+    {
+        Histograms(uint32_t subBucketBits = 6);
+        std::vector<LogLinearHistogram> component; //!< 按 Component 下标，单位为秒
+    };
+
+    static TypeId GetTypeId(void);
+    TaskLatencyMonitor();
+    virtual ~TaskLatencyMonitor();
+
+    /**
+     * 连接消费者的 TaskLatency Trace
+     * @param sink 消费者应用
+     */
+    void AddSink(Ptr<MySink> sink);
+
+    /**
+     * 记录一个完成的任务（也可直接作为 Trace 回调使用）
+     */
+    void RecordTask(uint32_t sinkId,
+                    uint32_t producerId,
+                    uint32_t taskId,
+                    Time queueing,
+                    Time transfer,
+                    Time service);
+
+    const Histograms& GetOverall(void) const;
+    /// @return 消费者节点 sinkId 的直方图；无记录时为空直方图
+    const Histograms& GetSinkHistograms(uint32_t sinkId) const;
+    /// @return 生产者节点 producerId 的直方图；无记录时为空直方图
+    const Histograms& GetProducerHistograms(uint32_t producerId) const;
+
+    /**
+     * 输出 p50/p90/p99/p999 文本报告（全部、每个消费者、每个生产者）
+     * @param os 输出流
+     */
+    void Report(std::ostream& os) const;
+    /**
+     * 以 XML 元素输出分位数
+     * @param os 输出流
+     * @param indent 缩进空格数
+     */
+    void SerializeToXmlStream(std::ostream& os, uint16_t indent) const;
+
+    static const char* GetComponentName(Component component);
+
+protected:
+    virtual void NotifyConstructionCompleted(void);
+    virtual void DoDispose(void);
+
+private:
+    void PeriodicReport(void);
+    Histograms& Lookup(std::map<uint32_t, Histograms>& table, uint32_t id);
+    static void ReportLine(std::ostream& os, const std::string& label, const Histograms& h);
+    static void XmlLine(std::ostream& os,
+                        uint16_t indent,
+                        const std::string& element,
+                        int64_t id,
+                        const Histograms& h);
+
+    uint32_t m_subBucketBits;
+    Time m_reportInterval;
+    EventId m_reportEvent;
+    Histograms m_overall;
+    Histograms m_empty;
+    std::map<uint32_t, Histograms> m_bySink;
+    std::map<uint32_t, Histograms> m_byProducer;
+#ifdef NS3_MTP
+    std::mutex m_mutex; //!< 保护各直方图，消费者可能在不同线程完成任务
+#endif
+};
+
+} // namespace ns3
+
+#endif // TASK_LATENCY_MONITOR_H
@@ -4,6 +4,23 @@
 // An essential include is test.h
 #include "ns3/test.h"
 
+#include "ns3/default-simulator-impl.h"
+#include "ns3/double.h"
+#include "ns3/error-model.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/pointer.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/string.h"
+#include "ns3/task-event-log.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+
 // Do not put your test classes in namespace ns3.  You may find it useful
 // to use the using directive to access the ns3 namespace directly
 using namespace ns3;
@@ -56,6 +73,1047 @@ ProSinkAppTestCase1::DoRun()
     NS_TEST_ASSERT_MSG_EQ_TOL(0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
 }
 
+/**
+ * 在两个节点之间安装 100 Mbps、1 ms、100p 队列的点到点 SimpleNetDevice 链路，
+ * 安装协议栈并分配 10.1.1.0/24 地址
+ * @param nodes 两个节点
+ * @param devices 输出：安装的设备
+ * @return 分配的接口地址
+ */
+static Ipv4InterfaceContainer
+InstallTestLink(NodeContainer nodes, NetDeviceContainer& devices)
+{
+    SimpleNetDeviceHelper link;
+    link.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Mbps")));
+    link.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1)));
+    link.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("100p"));
+    link.SetNetDevicePointToPointMode(true);
+    devices = link.Install(nodes);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer ifc = address.Assign(devices);
+    // 去掉默认 qdisc，使设备的 100p 队列成为唯一的缓冲；
+    // 设备队列停止时 TrafficControlLayer 直接丢包 (TcDrop)
+    TrafficControlHelper::Default().Uninstall(devices);
+    return ifc;
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * 在 100 Mbps / 100p 出口队列上检查各发送模式的丢包与任务完成数
+ */
+class ProSinkAppSendModeTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param mode MyProducer::SendMode 的名字 (Burst|Paced|Writable)
+     * @param expectDrops 是否预期出口队列溢出
+     */
+    ProSinkAppSendModeTestCase(std::string mode, bool expectDrops);
+
+  private:
+    void DoRun() override;
+    void TaskSent(uint32_t nodeId, uint32_t taskId, Address target);
+    void TaskCompleted(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t total);
+    void QueueDrop(Ptr<const Packet> packet);
+
+    std::string m_mode;
+    bool m_expectDrops;
+    uint32_t m_sent;
+    uint32_t m_completed;
+    uint32_t m_drops;
+};
+
+ProSinkAppSendModeTestCase::ProSinkAppSendModeTestCase(std::string mode, bool expectDrops)
+    : TestCase("MyProducer SendMode=" + mode),
+      m_mode(mode),
+      m_expectDrops(expectDrops),
+      m_sent(0),
+      m_completed(0),
+      m_drops(0)
+{
+}
+
+void
+ProSinkAppSendModeTestCase::TaskSent(uint32_t nodeId, uint32_t taskId, Address target)
+{
+    m_sent++;
+}
+
+void
+ProSinkAppSendModeTestCase::TaskCompleted(uint32_t nodeId,
+                                          uint32_t producerId,
+                                          uint32_t taskId,
+                                          uint32_t total)
+{
+    m_completed++;
+}
+
+void
+ProSinkAppSendModeTestCase::QueueDrop(Ptr<const Packet> packet)
+{
+    m_drops++;
+}
+
+void
+ProSinkAppSendModeTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    NetDeviceContainer devices;
+    Ipv4InterfaceContainer ifc = InstallTestLink(nodes, devices);
+
+    PointerValue txQueue;
+    devices.Get(0)->GetAttribute("TxQueue", txQueue);
+    txQueue.Get<Queue<Packet>>()->TraceConnectWithoutContext(
+        "Drop",
+        MakeCallback(&ProSinkAppSendModeTestCase::QueueDrop, this));
+    nodes.Get(0)->GetObject<TrafficControlLayer>()->TraceConnectWithoutContext(
+        "TcDrop",
+        MakeCallback(&ProSinkAppSendModeTestCase::QueueDrop, this));
+
+    Ptr<MySink> sink = CreateObject<MySink>();
+    sink->Setup(10000.0, MilliSeconds(1));
+    nodes.Get(1)->AddApplication(sink);
+    sink->SetStartTime(Seconds(0));
+    sink->SetStopTime(Seconds(1));
+    sink->TraceConnectWithoutContext(
+        "TaskCompleted",
+        MakeCallback(&ProSinkAppSendModeTestCase::TaskCompleted, this));
+
+    // 20 tasks/s * 256 KB ~= 42 Mbps，低于链路速率，只有突发发送才会溢出队列
+    Ptr<MyProducer> producer = CreateObject<MyProducer>();
+    producer->SetAttribute("SendMode", StringValue(m_mode));
+    std::vector<Address> sinks = {InetSocketAddress(ifc.GetAddress(1), 8080)};
+    producer->Setup(sinks, 20.0, 256 * 1024, 1024, MilliSeconds(1));
+    nodes.Get(0)->AddApplication(producer);
+    producer->SetStartTime(Seconds(0));
+    producer->SetStopTime(Seconds(0.5));
+    producer->TraceConnectWithoutContext(
+        "TaskSent",
+        MakeCallback(&ProSinkAppSendModeTestCase::TaskSent, this));
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_sent, 0, "No task was sent");
+    if (m_expectDrops)
+    {
+        NS_TEST_ASSERT_MSG_GT(m_drops, 0, "Burst sending should overflow the 100p queue");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_drops, 0, "Egress queue overflowed in " << m_mode << " mode");
+        // 停止时最多有一个任务只发出了一部分
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(m_completed + 1, m_sent, "Tasks lost in " << m_mode << " mode");
+    }
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * 生产者出口接口短暂关闭时 socket 拒绝发送：失败被计数，任务不前进，
+ * 接口恢复后重试并发完剩余的包
+ */
+class ProSinkAppSendFailureTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param mode MyProducer::SendMode 的名字 (Paced|Writable)
+     */
+    ProSinkAppSendFailureTestCase(std::string mode);
+
+  private:
+    void DoRun() override;
+    void TaskSent(uint32_t nodeId, uint32_t taskId, Address target);
+    void TaskCompleted(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t total);
+
+    std::string m_mode;
+    uint32_t m_sent;
+    uint32_t m_completed;
+};
+
+ProSinkAppSendFailureTestCase::ProSinkAppSendFailureTestCase(std::string mode)
+    : TestCase("MyProducer retries refused packets, SendMode=" + mode),
+      m_mode(mode),
+      m_sent(0),
+      m_completed(0)
+{
+}
+
+void
+ProSinkAppSendFailureTestCase::TaskSent(uint32_t nodeId, uint32_t taskId, Address target)
+{
+    m_sent++;
+}
+
+void
+ProSinkAppSendFailureTestCase::TaskCompleted(uint32_t nodeId,
+                                             uint32_t producerId,
+                                             uint32_t taskId,
+                                             uint32_t total)
+{
+    m_completed++;
+}
+
+void
+ProSinkAppSendFailureTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    NetDeviceContainer devices;
+    Ipv4InterfaceContainer ifc = InstallTestLink(nodes, devices);
+
+    Ptr<MySink> sink = CreateObject<MySink>();
+    sink->Setup(10000.0, MilliSeconds(1));
+    nodes.Get(1)->AddApplication(sink);
+    sink->SetStartTime(Seconds(0));
+    sink->SetStopTime(Seconds(1));
+    sink->TraceConnectWithoutContext(
+        "TaskCompleted",
+        MakeCallback(&ProSinkAppSendFailureTestCase::TaskCompleted, this));
+
+    // 任务在 50、100、150 ms 到达，每个约需 22 ms；60-70 ms 之间第一个任务正在发送
+    Ptr<MyProducer> producer = CreateObject<MyProducer>();
+    producer->SetAttribute("ArrivalProcess", StringValue("ns3::DeterministicArrivalProcess"));
+    producer->SetAttribute("SendMode", StringValue(m_mode));
+    std::vector<Address> sinks = {InetSocketAddress(ifc.GetAddress(1), 8080)};
+    producer->Setup(sinks, 20.0, 256 * 1024, 1024, MilliSeconds(1));
+    nodes.Get(0)->AddApplication(producer);
+    producer->SetStartTime(Seconds(0));
+    producer->SetStopTime(Seconds(0.2));
+    producer->TraceConnectWithoutContext(
+        "TaskSent",
+        MakeCallback(&ProSinkAppSendFailureTestCase::TaskSent, this));
+
+    // 关闭接口会删除到 10.1.1.0/24 的路由，SendTo 返回 ERROR_NOROUTETOHOST
+    Ptr<Ipv4> ipv4 = nodes.Get(0)->GetObject<Ipv4>();
+    uint32_t interface = ifc.Get(0).second;
+    Simulator::Schedule(MilliSeconds(60), &Ipv4::SetDown, ipv4, interface);
+    Simulator::Schedule(MilliSeconds(70), &Ipv4::SetUp, ipv4, interface);
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // 10 ms 的中断内每 SendRetryDelay (1 ms) 最多重试一次
+    NS_TEST_EXPECT_MSG_GT(producer->GetSendFailures(), 0, "No packet was refused");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(producer->GetSendFailures(),
+                                11,
+                                "Refused packets were not retried every SendRetryDelay");
+    NS_TEST_EXPECT_MSG_EQ(m_sent, 3, "Wrong number of tasks sent");
+    NS_TEST_EXPECT_MSG_EQ(m_completed, 3, "A task lost the packets refused by the socket");
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * 有丢包时，未收全的任务必须超时淘汰，重组表不得无限增长
+ */
+class ProSinkAppReassemblyTestCase : public TestCase
+{
+  public:
+    ProSinkAppReassemblyTestCase();
+
+  private:
+    void DoRun() override;
+    void TaskSent(uint32_t nodeId, uint32_t taskId, Address target);
+    void TaskCompleted(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t total);
+    void TaskEvicted(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t rxBytes);
+
+    uint32_t m_sent;
+    uint32_t m_completed;
+    uint32_t m_evicted;
+};
+
+ProSinkAppReassemblyTestCase::ProSinkAppReassemblyTestCase()
+    : TestCase("MySink evicts incomplete tasks after ReassemblyTimeout"),
+      m_sent(0),
+      m_completed(0),
+      m_evicted(0)
+{
+}
+
+void
+ProSinkAppReassemblyTestCase::TaskSent(uint32_t nodeId, uint32_t taskId, Address target)
+{
+    m_sent++;
+}
+
+void
+ProSinkAppReassemblyTestCase::TaskCompleted(uint32_t nodeId,
+                                            uint32_t producerId,
+                                            uint32_t taskId,
+                                            uint32_t total)
+{
+    m_completed++;
+}
+
+void
+ProSinkAppReassemblyTestCase::TaskEvicted(uint32_t nodeId,
+                                          uint32_t producerId,
+                                          uint32_t taskId,
+                                          uint32_t rxBytes)
+{
+    NS_TEST_EXPECT_MSG_LT(rxBytes, 256 * 1024, "A complete task was evicted");
+    m_evicted++;
+}
+
+void
+ProSinkAppReassemblyTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    NetDeviceContainer devices;
+    Ipv4InterfaceContainer ifc = InstallTestLink(nodes, devices);
+
+    // 接收端 0.5% 丢包：大部分 256 包的任务都会缺包
+    Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+    em->SetAttribute("ErrorRate", DoubleValue(0.005));
+    em->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
+    em->AssignStreams(1);
+    devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(em));
+
+    Ptr<MySink> sink = CreateObject<MySink>();
+    sink->SetAttribute("ReassemblyTimeout", TimeValue(MilliSeconds(50)));
+    sink->Setup(10000.0, MilliSeconds(1));
+    nodes.Get(1)->AddApplication(sink);
+    sink->SetStartTime(Seconds(0));
+    sink->SetStopTime(Seconds(1));
+    sink->TraceConnectWithoutContext(
+        "TaskCompleted",
+        MakeCallback(&ProSinkAppReassemblyTestCase::TaskCompleted, this));
+    sink->TraceConnectWithoutContext(
+        "TaskEvicted",
+        MakeCallback(&ProSinkAppReassemblyTestCase::TaskEvicted, this));
+
+    Ptr<MyProducer> producer = CreateObject<MyProducer>();
+    producer->SetAttribute("SendMode", StringValue("Paced"));
+    std::vector<Address> sinks = {InetSocketAddress(ifc.GetAddress(1), 8080)};
+    producer->Setup(sinks, 20.0, 256 * 1024, 1024, MilliSeconds(1));
+    nodes.Get(0)->AddApplication(producer);
+    producer->SetStartTime(Seconds(0));
+    producer->SetStopTime(Seconds(0.5));
+    producer->TraceConnectWithoutContext(
+        "TaskSent",
+        MakeCallback(&ProSinkAppReassemblyTestCase::TaskSent, this));
+
+    uint32_t pendingAtEnd = 0;
+    Simulator::Schedule(Seconds(0.9), [&]() { pendingAtEnd = sink->GetPendingTasks(); });
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_evicted, 0, "Lossy run should produce incomplete tasks");
+    NS_TEST_ASSERT_MSG_EQ(pendingAtEnd, 0, "Incomplete tasks were not evicted");
+    NS_TEST_ASSERT_MSG_EQ(m_completed + m_evicted,
+                          m_sent,
+                          "Every task must end up either completed or evicted");
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * Exact 服务模型：积压时任务完成间隔严格等于 1/rate，队列满时丢弃任务
+ */
+class ProSinkAppExactServiceTestCase : public TestCase
+{
+  public:
+    ProSinkAppExactServiceTestCase();
+
+  private:
+    void DoRun() override;
+    void TaskSent(uint32_t nodeId, uint32_t taskId, Address target);
+    void TaskCompleted(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t total);
+    void TaskDropped(uint32_t nodeId, uint32_t producerId, uint32_t taskId, uint32_t queueLength);
+
+    uint32_t m_sent;
+    uint32_t m_dropped;
+    std::vector<Time> m_completions;
+};
+
+ProSinkAppExactServiceTestCase::ProSinkAppExactServiceTestCase()
+    : TestCase("MySink exact service model with finite queue"),
+      m_sent(0),
+      m_dropped(0)
+{
+}
+
+void
+ProSinkAppExactServiceTestCase::TaskSent(uint32_t nodeId, uint32_t taskId, Address target)
+{
+    m_sent++;
+}
+
+void
+ProSinkAppExactServiceTestCase::TaskCompleted(uint32_t nodeId,
+                                              uint32_t producerId,
+                                              uint32_t taskId,
+                                              uint32_t total)
+{
+    m_completions.push_back(Simulator::Now());
+}
+
+void
+ProSinkAppExactServiceTestCase::TaskDropped(uint32_t nodeId,
+                                            uint32_t producerId,
+                                            uint32_t taskId,
+                                            uint32_t queueLength)
+{
+    NS_TEST_EXPECT_MSG_EQ(queueLength, 3, "Task dropped while the queue was not full");
+    m_dropped++;
+}
+
+void
+ProSinkAppExactServiceTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    NetDeviceContainer devices;
+    Ipv4InterfaceContainer ifc = InstallTestLink(nodes, devices);
+
+    // 10 tasks/s 单服务台，最多 3 个任务等待；到达约 40 tasks/s
+    Ptr<MySink> sink = CreateObject<MySink>();
+    sink->SetAttribute("ServiceModel", StringValue("Exact"));
+    sink->SetAttribute("QueueCapacity", UintegerValue(3));
+    sink->Setup(10.0, MilliSeconds(1));
+    nodes.Get(1)->AddApplication(sink);
+    sink->SetStartTime(Seconds(0));
+    sink->SetStopTime(Seconds(3));
+    sink->TraceConnectWithoutContext(
+        "TaskCompleted",
+        MakeCallback(&ProSinkAppExactServiceTestCase::TaskCompleted, this));
+    sink->TraceConnectWithoutContext(
+        "TaskDropped",
+        MakeCallback(&ProSinkAppExactServiceTestCase::TaskDropped, this));
+
+    Ptr<MyProducer> producer = CreateObject<MyProducer>();
+    producer->SetAttribute("SendMode", StringValue("Paced"));
+    std::vector<Address> sinks = {InetSocketAddress(ifc.GetAddress(1), 8080)};
+    producer->Setup(sinks, 40.0, 256 * 1024, 1024, MilliSeconds(1));
+    nodes.Get(0)->AddApplication(producer);
+    producer->SetStartTime(Seconds(0));
+    producer->SetStopTime(Seconds(0.5));
+    producer->TraceConnectWithoutContext(
+        "TaskSent",
+        MakeCallback(&ProSinkAppExactServiceTestCase::TaskSent, this));
+
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_dropped, 0, "Finite queue should drop tasks under overload");
+    // 停止时最多有一个任务只发出了一部分
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(m_completions.size() + m_dropped + 1,
+                                m_sent,
+                                "Received tasks must be either completed or dropped");
+    NS_TEST_ASSERT_MSG_GT(m_completions.size(), 4, "Too few tasks completed");
+    // 前 4 个任务之后队列一直积压，完成时刻严格相隔 100 ms
+    for (std::size_t i = 2; i < 5; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_completions[i] - m_completions[i - 1],
+                              MilliSeconds(100),
+                              "Service time differs from 1/rate");
+    }
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * 各到达过程的平均到达率与回放正确性
+ */
+class ProSinkAppArrivalProcessTestCase : public TestCase
+{
+  public:
+    ProSinkAppArrivalProcessTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ProSinkAppArrivalProcessTestCase::ProSinkAppArrivalProcessTestCase()
+    : TestCase("TaskArrivalProcess mean rate and trace replay")
+{
+}
+
+void
+ProSinkAppArrivalProcessTestCase::DoRun()
+{
+    const double lambda = 50.0;
+    const uint32_t n = 20000;
+
+    Ptr<PoissonArrivalProcess> poisson = CreateObject<PoissonArrivalProcess>();
+    poisson->AssignStreams(1);
+    poisson->SetRate(lambda);
+    double sum = 0.0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += poisson->GetNextInterval().GetSeconds();
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(n / sum, lambda, 0.03 * lambda, "Poisson rate is biased");
+
+    Ptr<DeterministicArrivalProcess> det = CreateObject<DeterministicArrivalProcess>();
+    det->SetRate(lambda);
+    NS_TEST_EXPECT_MSG_EQ(det->GetNextInterval(), MilliSeconds(20), "Wrong deterministic interval");
+
+    Ptr<MmppArrivalProcess> mmpp = CreateObject<MmppArrivalProcess>();
+    mmpp->AssignStreams(3);
+    mmpp->SetRate(lambda);
+    NS_TEST_EXPECT_MSG_GT(mmpp->GetStateRate(true), mmpp->GetStateRate(false), "No burst state");
+    sum = 0.0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += mmpp->GetNextInterval().GetSeconds();
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(n / sum, lambda, 0.1 * lambda, "MMPP long-run rate is biased");
+    NS_TEST_EXPECT_MSG_EQ(mmpp->SetAttributeFailSafe("MeanHighDuration", TimeValue(Seconds(0))),
+                          false,
+                          "Zero MMPP sojourn times must be rejected");
+
+    std::string traceFile = CreateTempDirFilename("arrivals.txt");
+    std::ofstream out(traceFile.c_str());
+    out << "# arrival times\n0.010\n0.015\n\n0.100\n";
+    out.close();
+    Ptr<TraceArrivalProcess> trace = CreateObject<TraceArrivalProcess>();
+    trace->SetAttribute("FileName", StringValue(traceFile));
+    NS_TEST_EXPECT_MSG_EQ(trace->GetNextInterval(), MilliSeconds(10), "Wrong first arrival");
+    NS_TEST_EXPECT_MSG_EQ(trace->GetNextInterval(), MilliSeconds(5), "Wrong second arrival");
+    NS_TEST_EXPECT_MSG_EQ(trace->GetNextInterval(), MilliSeconds(85), "Wrong third arrival");
+    NS_TEST_EXPECT_MSG_EQ(trace->GetNextInterval(), Time::Max(), "Trace should be exhausted");
+
+    // MyProducer 把随机流转交给到达过程：到达间隔只取决于分配的流编号
+    Ptr<MmppArrivalProcess> forwarded = CreateObject<MmppArrivalProcess>();
+    Ptr<MyProducer> producer = CreateObject<MyProducer>();
+    producer->SetAttribute("ArrivalProcess", PointerValue(forwarded));
+    NS_TEST_EXPECT_MSG_EQ(producer->AssignStreams(10), 4, "Wrong number of producer streams");
+    Ptr<MmppArrivalProcess> direct = CreateObject<MmppArrivalProcess>();
+    direct->AssignStreams(11);
+    forwarded->SetRate(lambda);
+    direct->SetRate(lambda);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(forwarded->GetNextInterval(),
+                              direct->GetNextInterval(),
+                              "Arrival process stream not assigned by MyProducer");
+    }
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * Exact 到达模型下，确定性到达的任务数与时刻精确
+ */
+class ProSinkAppExactArrivalTestCase : public TestCase
+{
+  public:
+    ProSinkAppExactArrivalTestCase();
+
+  private:
+    void DoRun() override;
+    void TaskSent(uint32_t nodeId, uint32_t taskId, Address target);
+
+    std::vector<Time> m_sent;
+};
+
+ProSinkAppExactArrivalTestCase::ProSinkAppExactArrivalTestCase()
+    : TestCase("MyProducer exact arrivals")
+{
+}
+
+void
+ProSinkAppExactArrivalTestCase::TaskSent(uint32_t nodeId, uint32_t taskId, Address target)
+{
+    m_sent.push_back(Simulator::Now());
+}
+
+void
+ProSinkAppExactArrivalTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    NetDeviceContainer devices;
+    Ipv4InterfaceContainer ifc = InstallTestLink(nodes, devices);
+
+    // 20 tasks/s，每个任务约 21 ms 发完，到达时链路总是空闲的
+    Ptr<MyProducer> producer = CreateObject<MyProducer>();
+    producer->SetAttribute("ArrivalModel", StringValue("Exact"));
+    producer->SetAttribute("ArrivalProcess", StringValue("ns3::DeterministicArrivalProcess"));
+    producer->SetAttribute("SendMode", StringValue("Paced"));
+    std::vector<Address> sinks = {InetSocketAddress(ifc.GetAddress(1), 8080)};
+    producer->Setup(sinks, 20.0, 256 * 1024, 1024, MilliSeconds(1));
+    nodes.Get(0)->AddApplication(producer);
+    producer->SetStartTime(Seconds(0));
+    producer->SetStopTime(Seconds(0.52));
+    producer->TraceConnectWithoutContext(
+        "TaskSent",
+        MakeCallback(&ProSinkAppExactArrivalTestCase::TaskSent, this));
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent.size(), 10, "Wrong number of deterministic arrivals");
+    for (std::size_t i = 0; i < m_sent.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sent[i], MilliSeconds(50) * (i + 1), "Arrival not at k/lambda");
+    }
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * 随机、轮询、加权与二选一分发策略的选择结果
+ */
+class ProSinkAppDispatchPolicyTestCase : public TestCase
+{
+  public:
+    ProSinkAppDispatchPolicyTestCase();
+
+  private:
+    void DoRun() override;
+    uint32_t GetLoad(uint32_t index);
+
+    std::vector<uint32_t> m_loads;
+};
+
+ProSinkAppDispatchPolicyTestCase::ProSinkAppDispatchPolicyTestCase()
+    : TestCase("TaskDispatchPolicy selection")
+{
+}
+
+uint32_t
+ProSinkAppDispatchPolicyTestCase::GetLoad(uint32_t index)
+{
+    return m_loads[index];
+}
+
+void
+ProSinkAppDispatchPolicyTestCase::DoRun()
+{
+    std::vector<Address> sinks;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        sinks.push_back(InetSocketAddress(Ipv4Address(0x0a000001 + i), 8080));
+    }
+    const uint32_t n = 30000;
+
+    Ptr<UniformDispatchPolicy> uniform = CreateObject<UniformDispatchPolicy>();
+    uniform->AssignStreams(1);
+    uniform->SetSinks(sinks);
+    std::vector<uint32_t> counts(3, 0);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        counts[uniform->SelectSink(nullptr)]++;
+    }
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(counts[i], n / 3, n / 30, "Uniform policy is biased");
+    }
+
+    Ptr<RoundRobinDispatchPolicy> rr = CreateObject<RoundRobinDispatchPolicy>();
+    rr->SetSinks(sinks);
+    for (uint32_t i = 0; i < 7; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rr->SelectSink(nullptr), i % 3, "Wrong round-robin order");
+    }
+
+    Ptr<WeightedDispatchPolicy> weighted = CreateObject<WeightedDispatchPolicy>();
+    weighted->AssignStreams(2);
+    weighted->SetSinks(sinks);
+    weighted->SetWeights({1.0, 3.0, 0.0});
+    counts.assign(3, 0);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        counts[weighted->SelectSink(nullptr)]++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(counts[2], 0, "Zero-weight sink selected");
+    NS_TEST_EXPECT_MSG_EQ_TOL(counts[1], 3 * n / 4, n / 50, "Weighted policy ignores weights");
+
+    // 负载 5/0/9：任意两个候选中取较小者，因此负载最大的消费者永远不会被选中
+    m_loads = {5, 0, 9};
+    Ptr<PowerOfTwoDispatchPolicy> p2c = CreateObject<PowerOfTwoDispatchPolicy>();
+    p2c->AssignStreams(3);
+    p2c->SetSinks(sinks);
+    p2c->SetLoadCallback(MakeCallback(&ProSinkAppDispatchPolicyTestCase::GetLoad, this));
+    counts.assign(3, 0);
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        counts[p2c->SelectSink(nullptr)]++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(counts[2], 0, "Most loaded sink selected");
+    NS_TEST_EXPECT_MSG_EQ_TOL(counts[1], 2000, 150, "Least loaded sink not preferred");
+
+    // MyProducer 把随机流转交给分发策略，排在到达间隔和到达过程的流之后
+    Ptr<MyProducer> producer = CreateObject<MyProducer>();
+    producer->SetAttribute("DispatchPolicy", StringValue("ns3::UniformDispatchPolicy"));
+    producer->Setup(sinks, 10.0, 1024, 512, MilliSeconds(1));
+    NS_TEST_EXPECT_MSG_EQ(producer->AssignStreams(20), 3, "Wrong number of producer streams");
+    Ptr<UniformDispatchPolicy> direct = CreateObject<UniformDispatchPolicy>();
+    direct->AssignStreams(22);
+    direct->SetSinks(sinks);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(producer->GetDispatchPolicy()->SelectSink(nullptr),
+                              direct->SelectSink(nullptr),
+                              "Dispatch policy stream not assigned by MyProducer");
+    }
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * 最近消费者策略：在 n0 - n1 - n2 链路上，按跳数与时延选择距离更近的消费者
+ */
+class ProSinkAppNearestDispatchTestCase : public TestCase
+{
+  public:
+    ProSinkAppNearestDispatchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ProSinkAppNearestDispatchTestCase::ProSinkAppNearestDispatchTestCase()
+    : TestCase("NearestDispatchPolicy picks the closest sink")
+{
+}
+
+void
+ProSinkAppNearestDispatchTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(3);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    SimpleNetDeviceHelper link;
+    link.SetNetDevicePointToPointMode(true);
+    link.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1)));
+    NetDeviceContainer d01 = link.Install(NodeContainer(nodes.Get(0), nodes.Get(1)));
+    link.SetChannelAttribute("Delay", TimeValue(MilliSeconds(5)));
+    NetDeviceContainer d12 = link.Install(NodeContainer(nodes.Get(1), nodes.Get(2)));
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(d01);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    Ipv4InterfaceContainer i12 = address.Assign(d12);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    // 远端消费者放在前面，确保不是按下标选择
+    std::vector<Address> sinks = {InetSocketAddress(i12.GetAddress(1), 8080),
+                                  InetSocketAddress(i12.GetAddress(0), 8080)};
+
+    Ptr<NearestDispatchPolicy> hops = CreateObject<NearestDispatchPolicy>();
+    hops->SetSinks(sinks);
+    NS_TEST_EXPECT_MSG_EQ(hops->GetDistance(nodes.Get(0), sinks[0]), 2.0, "Wrong hop count");
+    NS_TEST_EXPECT_MSG_EQ(hops->GetDistance(nodes.Get(0), sinks[1]), 1.0, "Wrong hop count");
+    NS_TEST_EXPECT_MSG_EQ(hops->SelectSink(nodes.Get(0)), 1, "Nearest sink not selected");
+    NS_TEST_EXPECT_MSG_EQ(hops->SelectSink(nodes.Get(0)), 1, "Nearest sink not selected");
+
+    Ptr<NearestDispatchPolicy> latency = CreateObject<NearestDispatchPolicy>();
+    latency->SetAttribute("Metric", StringValue("Latency"));
+    latency->SetSinks(sinks);
+    NS_TEST_EXPECT_MSG_EQ_TOL(latency->GetDistance(nodes.Get(0), sinks[0]),
+                              0.006,
+                              1e-9,
+                              "Wrong path delay");
+    NS_TEST_EXPECT_MSG_EQ(latency->SelectSink(nodes.Get(0)), 1, "Nearest sink not selected");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup pro-sink-app-tests
+ * 无排队时，任务时延分解为传输时间与 1/rate 的服务时间
+ */
+class ProSinkAppTaskLatencyTestCase : public TestCase
+{
+  public:
+    ProSinkAppTaskLatencyTestCase();
+
+  private:
+    void DoRun() override;
+    void TaskLatency(uint32_t nodeId,
+                     uint32_t producerId,
+                     uint32_t taskId,
+                     Time queueing,
+                     Time transfer,
+                     Time service);
+
+    uint32_t m_tasks;
+};
+
+ProSinkAppTaskLatencyTestCase::ProSinkAppTaskLatencyTestCase()
+    : TestCase("MySink per-task latency trace and TaskLatencyMonitor"),
+      m_tasks(0)
+{
+}
+
+void
+ProSinkAppTaskLatencyTestCase::TaskLatency(uint32_t nodeId,
+                                           uint32_t producerId,
+                                           uint32_t taskId,
+                                           Time queueing,
+                                           Time transfer,
+                                           Time service)
+{
+    m_tasks++;
+    NS_TEST_EXPECT_MSG_EQ(queueing, Time(0), "Unexpected queueing");
+    NS_TEST_EXPECT_MSG_EQ(service, MilliSeconds(50), "Service time differs from 1/rate");
+    // 256 个 1 KiB 包在 100 Mbps 上约 22 ms，加 1 ms 传播时延
+    NS_TEST_EXPECT_MSG_GT(transfer, MilliSeconds(21), "Transfer too short");
+    NS_TEST_EXPECT_MSG_LT(transfer, MilliSeconds(25), "Transfer too long");
+}
+
+void
+ProSinkAppTaskLatencyTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    NetDeviceContainer devices;
+    Ipv4InterfaceContainer ifc = InstallTestLink(nodes, devices);
+
+    Ptr<MySink> sink = CreateObject<MySink>();
+    sink->SetAttribute("ServiceModel", StringValue("Exact"));
+    sink->Setup(20.0, MilliSeconds(1));
+    nodes.Get(1)->AddApplication(sink);
+    sink->SetStartTime(Seconds(0));
+    sink->SetStopTime(Seconds(2));
+    sink->TraceConnectWithoutContext(
+        "TaskLatency",
+        MakeCallback(&ProSinkAppTaskLatencyTestCase::TaskLatency, this));
+
+    Ptr<TaskLatencyMonitor> monitor = CreateObject<TaskLatencyMonitor>();
+    monitor->AddSink(sink);
+
+    Ptr<MyProducer> producer = CreateObject<MyProducer>();
+    producer->SetAttribute("ArrivalProcess", StringValue("ns3::DeterministicArrivalProcess"));
+    producer->SetAttribute("SendMode", StringValue("Paced"));
+    std::vector<Address> sinks = {InetSocketAddress(ifc.GetAddress(1), 8080)};
+    producer->Setup(sinks, 10.0, 256 * 1024, 1024, MilliSeconds(1));
+    nodes.Get(0)->AddApplication(producer);
+    producer->SetStartTime(Seconds(0));
+    producer->SetStopTime(Seconds(1.05));
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_tasks, 10, "Wrong number of completed tasks");
+    const TaskLatencyMonitor::Histograms& all = monitor->GetOverall();
+    NS_TEST_EXPECT_MSG_EQ(all.component[TaskLatencyMonitor::TOTAL].GetCount(), 10, "Wrong count");
+    NS_TEST_EXPECT_MSG_EQ_TOL(all.component[TaskLatencyMonitor::SERVICE].GetQuantile(0.99),
+                              0.05,
+                              1e-9,
+                              "Wrong service percentile");
+    NS_TEST_EXPECT_MSG_EQ(
+        monitor->GetProducerHistograms(nodes.Get(0)->GetId()).component[TaskLatencyMonitor::TOTAL].GetCount(),
+        10,
+        "Producer histogram missing");
+    NS_TEST_EXPECT_MSG_EQ(
+        monitor->GetSinkHistograms(nodes.Get(1)->GetId()).component[TaskLatencyMonitor::TOTAL].GetCount(),
+        10,
+        "Sink histogram missing");
+    double total = all.component[TaskLatencyMonitor::TOTAL].GetMax();
+    NS_TEST_EXPECT_MSG_GT(total, 0.071, "Total latency too short");
+    NS_TEST_EXPECT_MSG_LT(total, 0.075, "Total latency too long");
+    // 时间戳由包标签携带，线路上的包头仍只有任务标识
+    NS_TEST_EXPECT_MSG_EQ(TaskHeader().GetSerializedSize(), 8, "Timestamps added to the wire");
+
+    Simulator::Destroy();
+}
+
+#ifdef NS3_MTP
+/**
+ * @ingroup pro-sink-app-tests
+ * 在多线程仿真器上运行两个生产者、两个消费者与共享的 TaskLatencyMonitor，
+ * 完成的任务与时延统计必须与默认仿真器相同
+ */
+class ProSinkAppMultithreadedTestCase : public TestCase
+{
+  public:
+    ProSinkAppMultithreadedTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * 在链 sink - producer - producer - sink 上运行 1 s
+     * @param impl 仿真器实现
+     * @return 时延监视器
+     */
+    Ptr<TaskLatencyMonitor> RunChain(Ptr<SimulatorImpl> impl);
+};
+
+ProSinkAppMultithreadedTestCase::ProSinkAppMultithreadedTestCase()
+    : TestCase("Pro-Sink tasks and latencies on ns3::MultithreadedSimulatorImpl")
+{
+}
+
+Ptr<TaskLatencyMonitor>
+ProSinkAppMultithreadedTestCase::RunChain(Ptr<SimulatorImpl> impl)
+{
+    Simulator::SetImplementation(impl);
+    NodeContainer nodes;
+    nodes.Create(4);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("5ms"));
+    NetDeviceContainer devices[3];
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        devices[i] = p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+    }
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer first = address.Assign(devices[0]);
+    address.NewNetwork();
+    address.Assign(devices[1]);
+    address.NewNetwork();
+    Ipv4InterfaceContainer last = address.Assign(devices[2]);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    // 两个消费者在链的两端，由各自的线程同时记入同一个监视器
+    Ptr<TaskLatencyMonitor> monitor = CreateObject<TaskLatencyMonitor>();
+    uint32_t sinkNodes[] = {0, 3};
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        Ptr<MySink> sink = CreateObject<MySink>();
+        sink->SetAttribute("ServiceModel", StringValue("Exact"));
+        sink->Setup(200.0, MilliSeconds(1));
+        sink->AssignStreams(10 * i);
+        nodes.Get(sinkNodes[i])->AddApplication(sink);
+        sink->SetStartTime(Seconds(0));
+        sink->SetStopTime(Seconds(2));
+        monitor->AddSink(sink);
+    }
+    std::vector<Address> sinks = {InetSocketAddress(first.GetAddress(0), 8080),
+                                  InetSocketAddress(last.GetAddress(1), 8080)};
+    for (uint32_t i = 1; i < 3; ++i)
+    {
+        Ptr<MyProducer> producer = CreateObject<MyProducer>();
+        producer->SetAttribute("ArrivalProcess", StringValue("ns3::DeterministicArrivalProcess"));
+        producer->SetAttribute("SendMode", StringValue("Paced"));
+        producer->Setup(sinks, 50.0, 256 * 1024, 1024, MilliSeconds(1));
+        producer->AssignStreams(100 * i);
+        nodes.Get(i)->AddApplication(producer);
+        producer->SetStartTime(Seconds(0));
+        producer->SetStopTime(Seconds(1));
+    }
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    return monitor;
+}
+
+void
+ProSinkAppMultithreadedTestCase::DoRun()
+{
+    Ptr<TaskLatencyMonitor> reference = RunChain(CreateObject<DefaultSimulatorImpl>());
+    Simulator::Destroy();
+
+    ObjectFactory factory;
+    factory.SetTypeId("ns3::MultithreadedSimulatorImpl");
+    factory.Set("MaxThreads", UintegerValue(2));
+    Ptr<TaskLatencyMonitor> monitor = RunChain(factory.Create<SimulatorImpl>());
+    Simulator::Destroy();
+
+    const LogLinearHistogram& refTotal =
+        reference->GetOverall().component[TaskLatencyMonitor::TOTAL];
+    const LogLinearHistogram& total = monitor->GetOverall().component[TaskLatencyMonitor::TOTAL];
+    NS_TEST_EXPECT_MSG_GT(refTotal.GetCount(), 80, "Too few tasks to compare");
+    NS_TEST_EXPECT_MSG_EQ(total.GetCount(), refTotal.GetCount(), "Different number of tasks");
+    NS_TEST_EXPECT_MSG_EQ(total.GetQuantile(0.5), refTotal.GetQuantile(0.5), "Different median");
+    NS_TEST_EXPECT_MSG_EQ(total.GetQuantile(0.99), refTotal.GetQuantile(0.99), "Different p99");
+    NS_TEST_EXPECT_MSG_EQ(total.GetMax(), refTotal.GetMax(), "Different maximum");
+}
+#endif // NS3_MTP
+
+/**
+ * @ingroup pro-sink-app-tests
+ * 二进制事件日志跨多个缓冲块写入后能完整读回，并还原为 XML；写入失败时报告错误
+ */
+class ProSinkAppEventLogTestCase : public TestCase
+{
+  public:
+    ProSinkAppEventLogTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ProSinkAppEventLogTestCase::ProSinkAppEventLogTestCase()
+    : TestCase("TaskEventLog binary round trip")
+{
+}
+
+void
+ProSinkAppEventLogTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("events.evlog");
+    const uint32_t n = 1000;
+    {
+        TaskEventLog log;
+        // 每块 7 条记录，迫使写线程处理大量块和一个不满的尾块
+        NS_TEST_ASSERT_MSG_EQ(log.Open(fileName, 7), true, "Cannot open event log");
+        log.SetPrologue("<head>\n");
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            log.Append(static_cast<TaskEventLog::EventType>(i % 4),
+                       MicroSeconds(i),
+                       i,
+                       i + 1,
+                       i + 2,
+                       i * 3);
+        }
+        log.SetEpilogue("</head>\n");
+        NS_TEST_EXPECT_MSG_EQ(log.GetNRecords(), n, "Wrong record count");
+        NS_TEST_EXPECT_MSG_EQ(log.Close(), true, "Write error reported on a complete log");
+    }
+
+    TaskEventLogReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(fileName), true, "Cannot read event log");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetNRecords(), n, "Wrong record count in trailer");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetPrologue(), "<head>\n", "Wrong prologue");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetEpilogue(), "</head>\n", "Wrong epilogue");
+    TaskEventLog::Record record;
+    uint32_t i = 0;
+    while (reader.Next(record))
+    {
+        NS_TEST_EXPECT_MSG_EQ(TimeStep(record.time), MicroSeconds(i), "Wrong time");
+        NS_TEST_EXPECT_MSG_EQ(record.type, i % 4, "Wrong type");
+        NS_TEST_EXPECT_MSG_EQ(record.node, i, "Wrong node");
+        NS_TEST_EXPECT_MSG_EQ(record.producer, i + 1, "Wrong producer");
+        NS_TEST_EXPECT_MSG_EQ(record.task, i + 2, "Wrong task");
+        NS_TEST_EXPECT_MSG_EQ(record.value, i * 3, "Wrong value");
+        ++i;
+    }
+    NS_TEST_EXPECT_MSG_EQ(i, n, "Records lost");
+
+    // 写不出文件头的日志打开失败（/dev/full 的每次写入都因空间不足失败）
+    if (std::FILE* full = std::fopen("/dev/full", "wb"))
+    {
+        std::fclose(full);
+        TaskEventLog log;
+        NS_TEST_EXPECT_MSG_EQ(log.Open("/dev/full"), false, "Header write error not reported");
+        NS_TEST_EXPECT_MSG_EQ(log.IsOpen(), false, "Log left open after a header write error");
+    }
+
+    TaskEventLog::Record send{MilliSeconds(1500).GetTimeStep(),
+                              3,
+                              3,
+                              7,
+                              Ipv4Address("10.0.1.2").Get(),
+                              TaskEventLog::EDGE_SEND,
+                              {}};
+    std::ostringstream oss;
+    TaskEventLog::WriteXml(oss, send);
+    NS_TEST_EXPECT_MSG_EQ(oss.str(),
+                          "  <Event type=\"EdgeSend\" Time=\"1.5\" Edge-Id=\"Edge-3\" "
+                          "Task-Id=\"3-7\" TargetIp=\"10.0.1.2\"/>\n",
+                          "Wrong XML event");
+}
+
 // The TestSuite class names the TestSuite, identifies what type of TestSuite,
 // and enables the TestCases to be run.  Typically, only the constructor for
 // this class must be defined
@@ -72,10 +1130,26 @@ class ProSinkAppTestSuite : public TestSuite
 
 // Type for TestSuite can be UNIT, SYSTEM, EXAMPLE, or PERFORMANCE
 ProSinkAppTestSuite::ProSinkAppTestSuite()
-    : TestSuite("pro-sink-app", Type::UNIT)
+    : TestSuite("pro-sink-app", UNIT)
 {
     // Duration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
-    AddTestCase(new ProSinkAppTestCase1, TestCase::Duration::QUICK);
+    AddTestCase(new ProSinkAppTestCase1, TestCase::QUICK);
+    AddTestCase(new ProSinkAppSendModeTestCase("Burst", true), TestCase::QUICK);
+    AddTestCase(new ProSinkAppSendModeTestCase("Paced", false), TestCase::QUICK);
+    AddTestCase(new ProSinkAppSendModeTestCase("Writable", false), TestCase::QUICK);
+    AddTestCase(new ProSinkAppSendFailureTestCase("Paced"), TestCase::QUICK);
+    AddTestCase(new ProSinkAppSendFailureTestCase("Writable"), TestCase::QUICK);
+    AddTestCase(new ProSinkAppReassemblyTestCase, TestCase::QUICK);
+    AddTestCase(new ProSinkAppExactServiceTestCase, TestCase::QUICK);
+    AddTestCase(new ProSinkAppArrivalProcessTestCase, TestCase::QUICK);
+    AddTestCase(new ProSinkAppExactArrivalTestCase, TestCase::QUICK);
+    AddTestCase(new ProSinkAppDispatchPolicyTestCase, TestCase::QUICK);
+    AddTestCase(new ProSinkAppNearestDispatchTestCase, TestCase::QUICK);
+    AddTestCase(new ProSinkAppTaskLatencyTestCase, TestCase::QUICK);
+    AddTestCase(new ProSinkAppEventLogTestCase, TestCase::QUICK);
+#ifdef NS3_MTP
+    AddTestCase(new ProSinkAppMultithreadedTestCase, TestCase::QUICK);
+#endif
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "log-linear-histogram.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define DEFAULT_RESOLUTION 1
+#define DEFAULT_SIGNIFICANT_BITS 7
+#define MAX_SIGNIFICANT_BITS 20
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LogLinearHistogram");
+
+LogLinearHistogram::LogLinearHistogram(double resolution, uint8_t significantBits)
+    : m_count(0),
+      m_min(0),
+      m_max(0),
+      m_sum(0)
+{
+    SetResolution(resolution, significantBits);
+}
+
+LogLinearHistogram::LogLinearHistogram()
+    : LogLinearHistogram(DEFAULT_RESOLUTION, DEFAULT_SIGNIFICANT_BITS)
+{
+}
+
+void
+LogLinearHistogram::SetResolution(double resolution, uint8_t significantBits)
+{
+    NS_ASSERT(m_count == 0); // we can only change the bins if no values were added
+    NS_ABORT_MSG_UNLESS(resolution > 0, "The resolution must be positive");
+    NS_ABORT_MSG_IF(significantBits > MAX_SIGNIFICANT_BITS,
+                    "At most " << MAX_SIGNIFICANT_BITS << " significant bits are supported");
+    m_resolution = resolution;
+    m_significantBits = significantBits;
+}
+
+double
+LogLinearHistogram::GetResolution() const
+{
+    return m_resolution;
+}
+
+uint8_t
+LogLinearHistogram::GetSignificantBits() const
+{
+    return m_significantBits;
+}
+
+uint32_t
+LogLinearHistogram::GetNBins() const
+{
+    return m_histogram.size();
+}
+
+double
+LogLinearHistogram::GetBinStart(uint32_t index) const
+{
+    uint32_t nSubBins = 1U << m_significantBits;
+    if (index < nSubBins)
+    {
+        return index * m_resolution;
+    }
+    // index / nSubBins - 1 is the number of halvings of the bin width
+    // since the linear bins
+    uint32_t shift = index / nSubBins - 1;
+    uint32_t subBin = index % nSubBins;
+    return std::ldexp(double(nSubBins + subBin), shift) * m_resolution;
+}
+
+double
+LogLinearHistogram::GetBinEnd(uint32_t index) const
+{
+    return GetBinStart(index) + GetBinWidth(index);
+}
+
+double
+LogLinearHistogram::GetBinWidth(uint32_t index) const
+{
+    uint32_t nSubBins = 1U << m_significantBits;
+    if (index < nSubBins)
+    {
+        return m_resolution;
+    }
+    return std::ldexp(m_resolution, index / nSubBins - 1);
+}
+
+uint32_t
+LogLinearHistogram::GetBinCount(uint32_t index) const
+{
+    NS_ASSERT(index < m_histogram.size());
+    return m_histogram[index];
+}
+
+uint32_t
+LogLinearHistogram::GetBinIndex(double value) const
+{
+    NS_ASSERT_MSG(value >= 0, "Negative values are not supported");
+    double units = std::floor(value / m_resolution);
+    uint64_t u = (units < std::ldexp(1.0, 63)) ? static_cast<uint64_t>(units) : ~0ULL >> 1;
+
+    uint32_t nSubBins = 1U << m_significantBits;
+    if (u < nSubBins)
+    {
+        return u;
+    }
+    // u is in [2^k, 2^(k+1)), which has nSubBins bins of 2^(k - significantBits) units
+    uint32_t k = m_significantBits;
+    while ((u >> (k + 1)) != 0)
+    {
+        k++;
+    }
+    uint32_t shift = k - m_significantBits;
+    return (shift + 1) * nSubBins + static_cast<uint32_t>((u >> shift) - nSubBins);
+}
+
+void
+LogLinearHistogram::AddValue(double value)
+{
+    uint32_t index = GetBinIndex(value);
+
+    NS_LOG_DEBUG("AddValue: index=" << index << ", m_histogram.size()=" << m_histogram.size());
+
+    if (index >= m_histogram.size())
+    {
+        m_histogram.resize(index + 1, 0);
+    }
+    m_histogram[index]++;
+
+    if (m_count == 0)
+    {
+        m_min = value;
+        m_max = value;
+    }
+    else
+    {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    m_count++;
+    m_sum += value;
+}
+
+void
+LogLinearHistogram::Merge(const LogLinearHistogram& other)
+{
+    NS_ABORT_MSG_UNLESS(m_resolution == other.m_resolution &&
+                            m_significantBits == other.m_significantBits,
+                        "Only histograms with the same bins can be merged");
+    if (other.m_count == 0)
+    {
+        return;
+    }
+    if (other.m_histogram.size() > m_histogram.size())
+    {
+        m_histogram.resize(other.m_histogram.size(), 0);
+    }
+    for (uint32_t index = 0; index < other.m_histogram.size(); index++)
+    {
+        m_histogram[index] += other.m_histogram[index];
+    }
+
+    if (m_count == 0)
+    {
+        m_min = other.m_min;
+        m_max = other.m_max;
+    }
+    else
+    {
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+}
+
+uint64_t
+LogLinearHistogram::GetCount() const
+{
+    return m_count;
+}
+
+double
+LogLinearHistogram::GetMin() const
+{
+    return m_min;
+}
+
+double
+LogLinearHistogram::GetMax() const
+{
+    return m_max;
+}
+
+double
+LogLinearHistogram::GetMean() const
+{
+    return m_count > 0 ? m_sum / m_count : 0;
+}
+
+double
+LogLinearHistogram::GetQuantile(double quantile) const
+{
+    NS_ASSERT(quantile >= 0 && quantile <= 1);
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    // rank of the value of the quantile, from 1 to m_count
+    uint64_t rank = std::max<uint64_t>(1, std::ceil(quantile * m_count));
+    uint64_t seen = 0;
+    for (uint32_t index = 0; index < m_histogram.size(); index++)
+    {
+        seen += m_histogram[index];
+        if (seen >= rank)
+        {
+            double middle = GetBinStart(index) + GetBinWidth(index) / 2;
+            return std::min(std::max(middle, m_min), m_max);
+        }
+    }
+    return m_max;
+}
+
+void
+LogLinearHistogram::Clear()
+{
+    m_histogram.clear();
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+    m_sum = 0;
+}
+
+void
+LogLinearHistogram::SerializeBins(std::ostream& os) const
+{
+    bool first = true;
+    for (uint32_t index = 0; index < m_histogram.size(); index++)
+    {
+        if (m_histogram[index])
+        {
+            if (!first)
+            {
+                os << " ";
+            }
+            os << index << ":" << m_histogram[index];
+            first = false;
+        }
+    }
+}
+
+void
+LogLinearHistogram::SerializeToXmlStream(std::ostream& os,
+                                         uint16_t indent,
+                                         std::string elementName) const
+{
+    os << std::string(indent, ' ') << "<" << elementName << " type=\"logLinear\""
+       << " resolution=\"" << m_resolution << "\""
+       << " significantBits=\"" << +m_significantBits << "\""
+       << " count=\"" << m_count << "\""
+       << " min=\"" << m_min << "\""
+       << " max=\"" << m_max << "\""
+       << " bins=\"";
+    SerializeBins(os);
+    os << "\" />\n";
+}
+
+} // namespace ns3
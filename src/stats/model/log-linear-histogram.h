@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_LOG_LINEAR_HISTOGRAM_H
+#define NS3_LOG_LINEAR_HISTOGRAM_H
+
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Histogram with bins whose width grows with the values, so that the
+ * relative error on any value is bounded.
+ *
+ * The values are counted in units of the resolution.  With \f$S =
+ * 2^{significantBits}\f$, the values below \f$S\f$ units have bins of one
+ * unit, and each range \f$[2^k, 2^{k+1})\f$ units above is split into
+ * \f$S\f$ bins of the same width.  The values are thus known to within the
+ * resolution below \f$S\f$ units, and to within \f$2^{-significantBits}\f$
+ * of their value above.  The number of bins grows with the logarithm of the
+ * largest value, instead of linearly as with the fixed-width Histogram: with
+ * a resolution of one microsecond and 7 significant bits, delays up to 100 s
+ * take less than 2700 bins.
+ *
+ * The bins are only allocated up to the largest value added.  Histograms
+ * with the same resolution and significant bits can be merged, e.g. to
+ * aggregate flows or nodes.
+ *
+ * Like Histogram, this class does not handle negative values.
+ */
+class LogLinearHistogram
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param resolution width of the smallest bins
+     * \param significantBits above the smallest bins, the bins are at most
+     *        2^-significantBits of their start wide
+     */
+    LogLinearHistogram(double resolution, uint8_t significantBits);
+    LogLinearHistogram();
+
+    /**
+     * \brief Set the resolution and the significant bits.
+     *
+     * Note that they can be changed only if the histogram is empty.
+     *
+     * \param resolution width of the smallest bins
+     * \param significantBits above the smallest bins, the bins are at most
+     *        2^-significantBits of their start wide
+     */
+    void SetResolution(double resolution, uint8_t significantBits);
+    /**
+     * \brief Returns the width of the smallest bins.
+     * \return the resolution
+     */
+    double GetResolution() const;
+    /**
+     * \brief Returns the number of significant bits.
+     * \return the number of significant bits
+     */
+    uint8_t GetSignificantBits() const;
+
+    /**
+     * \brief Returns the number of bins in the histogram, up to the last
+     * non-empty one.
+     * \return the number of bins in the histogram
+     */
+    uint32_t GetNBins() const;
+    /**
+     * \brief Returns the bin start.
+     * \param index the bin index
+     * \return the bin start
+     */
+    double GetBinStart(uint32_t index) const;
+    /**
+     * \brief Returns the bin end.
+     * \param index the bin index
+     * \return the bin end
+     */
+    double GetBinEnd(uint32_t index) const;
+    /**
+     * \brief Returns the bin width.
+     * \param index the bin index
+     * \return the bin width
+     */
+    double GetBinWidth(uint32_t index) const;
+    /**
+     * \brief Get the number of data added to the bin.
+     * \param index the bin index
+     * \return the number of data added to the bin
+     */
+    uint32_t GetBinCount(uint32_t index) const;
+    /**
+     * \brief Returns the bin of a value.
+     * \param value the value
+     * \return the index of the bin of the value
+     */
+    uint32_t GetBinIndex(double value) const;
+
+    /**
+     * \brief Add a value to the histogram
+     * \param value the value to add
+     */
+    void AddValue(double value);
+
+    /**
+     * \brief Add the data of another histogram to this one.
+     *
+     * Both histograms must have the same resolution and significant bits.
+     *
+     * \param other the histogram to add
+     */
+    void Merge(const LogLinearHistogram& other);
+
+    /**
+     * \brief Returns the number of values added.
+     * \return the number of values added
+     */
+    uint64_t GetCount() const;
+    /**
+     * \brief Returns the smallest value added, or 0 if there is none.
+     * \return the smallest value added
+     */
+    double GetMin() const;
+    /**
+     * \brief Returns the largest value added, or 0 if there is none.
+     * \return the largest value added
+     */
+    double GetMax() const;
+    /**
+     * \brief Returns the mean of the values added, or 0 if there is none.
+     * \return the mean of the values added
+     */
+    double GetMean() const;
+    /**
+     * \brief Estimate a quantile of the values added.
+     *
+     * The estimate is the middle of the bin of the quantile, bounded by the
+     * smallest and largest values added.
+     *
+     * \param quantile the quantile, between 0 and 1
+     * \return the estimate, or 0 if the histogram is empty
+     */
+    double GetQuantile(double quantile) const;
+
+    /**
+     * Clear the histogram content.
+     */
+    void Clear();
+
+    /**
+     * \brief Serializes the non-empty bins to an std::ostream, as a space
+     * separated list of "index:count" pairs.
+     * \param os the output stream
+     */
+    void SerializeBins(std::ostream& os) const;
+
+    /**
+     * \brief Serializes the results to an std::ostream in XML format.
+     *
+     * The histogram is a single element, whose attributes are the
+     * parameters, the number of values, the smallest and largest values,
+     * and the non-empty bins as in SerializeBins().
+     *
+     * \param os the output stream
+     * \param indent number of spaces to use as base indentation level
+     * \param elementName name of the element to serialize.
+     */
+    void SerializeToXmlStream(std::ostream& os, uint16_t indent, std::string elementName) const;
+
+  private:
+    std::vector<uint32_t> m_histogram; //!< Histogram data
+    double m_resolution;               //!< Width of the smallest bins
+    uint8_t m_significantBits;         //!< Significant bits of the bins
+    uint64_t m_count;                  //!< Number of values
+    double m_min;                      //!< Smallest value
+    double m_max;                      //!< Largest value
+    double m_sum;                      //!< Sum of the values
+};
+
+} // namespace ns3
+
+#endif /* NS3_LOG_LINEAR_HISTOGRAM_H */
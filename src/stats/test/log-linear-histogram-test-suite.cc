@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log-linear-histogram.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief LogLinearHistogram bins test
+ */
+class LogLinearHistogramBinsTestCase : public ns3::TestCase
+{
+  public:
+    LogLinearHistogramBinsTestCase();
+    void DoRun() override;
+};
+
+LogLinearHistogramBinsTestCase::LogLinearHistogramBinsTestCase()
+    : ns3::TestCase("LogLinearHistogram bins")
+{
+}
+
+void
+LogLinearHistogramBinsTestCase::DoRun()
+{
+    // 4 significant bits: 16 bins of 0.5 below 8, then 16 bins per octave
+    LogLinearHistogram h(0.5, 4);
+
+    NS_TEST_EXPECT_MSG_EQ(h.GetBinIndex(0), 0, "");
+    NS_TEST_EXPECT_MSG_EQ(h.GetBinIndex(7.9), 15, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(h.GetBinWidth(15), 0.5, 1e-12, "");
+    NS_TEST_EXPECT_MSG_EQ(h.GetBinIndex(8), 16, "");
+    NS_TEST_EXPECT_MSG_EQ(h.GetBinIndex(16), 32, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(h.GetBinWidth(32), 1, 1e-12, "");
+    NS_TEST_EXPECT_MSG_EQ(h.GetBinIndex(1000), 127, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(h.GetBinStart(127), 992, 1e-9, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(h.GetBinEnd(127), 1024, 1e-9, "");
+
+    // the bins are contiguous, and each value is in its bin
+    for (uint32_t index = 0; index < 200; index++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(h.GetBinEnd(index),
+                                  h.GetBinStart(index + 1),
+                                  1e-9,
+                                  "Gap after bin " << index);
+        NS_TEST_EXPECT_MSG_EQ(h.GetBinIndex(h.GetBinStart(index)), index, "");
+    }
+
+    // above the linear bins, the relative error is bounded by 2^-significantBits
+    LogLinearHistogram d(1e-6, 7);
+    for (double value = 1.3e-4; value < 100; value *= 1.01)
+    {
+        uint32_t index = d.GetBinIndex(value);
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(d.GetBinStart(index), value, "");
+        NS_TEST_EXPECT_MSG_GT(d.GetBinEnd(index), value, "");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(d.GetBinWidth(index) / d.GetBinStart(index),
+                                    1.0 / 128,
+                                    "Bin too wide for " << value);
+    }
+
+    // the memory grows with the logarithm of the largest value
+    d.AddValue(1e-6);
+    d.AddValue(100);
+    NS_TEST_EXPECT_MSG_LT(d.GetNBins(), 2700, "");
+    NS_TEST_EXPECT_MSG_EQ(d.GetCount(), 2, "");
+    NS_TEST_EXPECT_MSG_EQ(d.GetBinCount(d.GetBinIndex(100)), 1, "");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief LogLinearHistogram quantile, merge and serialization test
+ */
+class LogLinearHistogramMergeTestCase : public ns3::TestCase
+{
+  public:
+    LogLinearHistogramMergeTestCase();
+    void DoRun() override;
+};
+
+LogLinearHistogramMergeTestCase::LogLinearHistogramMergeTestCase()
+    : ns3::TestCase("LogLinearHistogram merge")
+{
+}
+
+void
+LogLinearHistogramMergeTestCase::DoRun()
+{
+    LogLinearHistogram a(1e-3, 7);
+    LogLinearHistogram b(1e-3, 7);
+    LogLinearHistogram all(1e-3, 7);
+    for (uint32_t i = 1; i <= 1000; i++)
+    {
+        double value = i * 0.01;
+        ((i % 2) ? a : b).AddValue(value);
+        all.AddValue(value);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(all.GetQuantile(0.5), 5, 5.0 / 128, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(all.GetQuantile(0.99), 9.9, 9.9 / 128, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(all.GetQuantile(0), 0.01, 1e-3, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(all.GetQuantile(1), 10, 1e-12, "");
+
+    a.Merge(b);
+    NS_TEST_EXPECT_MSG_EQ(a.GetCount(), 1000, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(a.GetMin(), 0.01, 1e-12, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(a.GetMax(), 10, 1e-12, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(a.GetMean(), 5.005, 1e-9, "");
+    NS_TEST_ASSERT_MSG_EQ(a.GetNBins(), all.GetNBins(), "");
+    for (uint32_t index = 0; index < all.GetNBins(); index++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(a.GetBinCount(index), all.GetBinCount(index), "");
+    }
+
+    LogLinearHistogram c(1, 2);
+    c.AddValue(1);
+    c.AddValue(1);
+    c.AddValue(6);
+    std::ostringstream os;
+    c.SerializeToXmlStream(os, 2, "delayHistogram");
+    NS_TEST_EXPECT_MSG_EQ(os.str(),
+                          "  <delayHistogram type=\"logLinear\" resolution=\"1\" "
+                          "significantBits=\"2\" count=\"3\" min=\"1\" max=\"6\" "
+                          "bins=\"1:2 6:1\" />\n",
+                          "");
+
+    c.Clear();
+    NS_TEST_EXPECT_MSG_EQ(c.GetNBins(), 0, "");
+    NS_TEST_EXPECT_MSG_EQ(c.GetCount(), 0, "");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief LogLinearHistogram TestSuite
+ */
+class LogLinearHistogramTestSuite : public TestSuite
+{
+  public:
+    LogLinearHistogramTestSuite();
+};
+
+LogLinearHistogramTestSuite::LogLinearHistogramTestSuite()
+    : TestSuite("log-linear-histogram", UNIT)
+{
+    AddTestCase(new LogLinearHistogramBinsTestCase, TestCase::QUICK);
+    AddTestCase(new LogLinearHistogramMergeTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LogLinearHistogramTestSuite g_logLinearHistogramTestSuite;
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 The ns3-dsw authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the time taken by
+// Ipv4GlobalRoutingHelper::PopulateRoutingTables on square grids of
+// point-to-point links, for increasing numbers of nodes.
+// Sample usage:  ./ns3 run 'bench-global-routing --sides=10,20,40 --threads=4'
+
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/ipv4-global-routing.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Build a side x side grid of point-to-point links and time the
+ * computation of the global routes.
+ *
+ * \param [in] side The number of nodes on a side of the grid.
+ */
+static void
+BenchGrid(uint32_t side)
+{
+    NodeContainer nodes;
+    nodes.Create(side * side);
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper globalRouting;
+    internet.SetRoutingHelper(globalRouting);
+    internet.Install(nodes);
+
+    SimpleNetDeviceHelper simple;
+    simple.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.252");
+    uint32_t links = 0;
+    for (uint32_t r = 0; r < side; ++r)
+    {
+        for (uint32_t c = 0; c < side; ++c)
+        {
+            const uint32_t n = r * side + c;
+            std::vector<uint32_t> peers;
+            if (c + 1 < side)
+            {
+                peers.push_back(n + 1);
+            }
+            if (r + 1 < side)
+            {
+                peers.push_back(n + side);
+            }
+            for (uint32_t peer : peers)
+            {
+                Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+                NetDeviceContainer devices = simple.Install(nodes.Get(n), channel);
+                devices.Add(simple.Install(nodes.Get(peer), channel));
+                ipv4.Assign(devices);
+                ipv4.NewNetwork();
+                ++links;
+            }
+        }
+    }
+
+    SystemWallClockMs clock;
+    clock.Start();
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    const int64_t ms = clock.End();
+
+    uint64_t routes = 0;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        routes += nodes.Get(i)
+                      ->GetObject<Ipv4L3Protocol>()
+                      ->GetRoutingProtocol()
+                      ->GetObject<Ipv4GlobalRouting>()
+                      ->GetNRoutes();
+    }
+    std::cout << std::setw(8) << nodes.GetN() << std::setw(8) << links << std::setw(12) << routes
+              << std::setw(10) << ms << std::endl;
+
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string sides = "5,10,20,30";
+    uint32_t threads = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark Ipv4GlobalRoutingHelper::PopulateRoutingTables on grids.");
+    cmd.AddValue("sides", "comma-separated grid side lengths", sides);
+    cmd.AddValue("threads", "value of the GlobalRoutingThreads global value", threads);
+    cmd.Parse(argc, argv);
+
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(threads));
+
+    std::cout << "bench-global-routing: PopulateRoutingTables on square grids, " << threads
+              << " thread(s)" << std::endl;
+    std::cout << std::setw(8) << "nodes" << std::setw(8) << "links" << std::setw(12) << "routes"
+              << std::setw(10) << "ms" << std::endl;
+
+    std::istringstream is(sides);
+    std::string side;
+    while (std::getline(is, side, ','))
+    {
+        BenchGrid(std::stoul(side));
+    }
+    return 0;
+}
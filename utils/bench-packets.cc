@@ -20,6 +20,12 @@
 // This program can be used to benchmark packet serialization/deserialization
 // operations using Headers and Tags, for various numbers of packets 'n'
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
+//
+// With --enable-printing, the packets record their metadata.  --packets selects
+// whether the benchmarked packets are "normal", "lightweight" (no metadata, see
+// Packet::CreateLightweight), or "mixed" (every other packet is lightweight),
+// to compare the cost of the metadata:
+//   ./ns3 run 'bench-packets --n=10000 --enable-printing=1 --packets=mixed'
 
 #include "ns3/command-line.h"
 #include "ns3/packet-metadata.h"
@@ -214,6 +220,33 @@ class BenchTag : public Tag
     }
 };
 
+/// Kinds of packets created by the benchmarks
+enum BenchPackets
+{
+    NORMAL_PACKETS,      //!< Packets created by Create<Packet>
+    LIGHTWEIGHT_PACKETS, //!< Packets created by Packet::CreateLightweight
+    MIXED_PACKETS,       //!< Every other packet is lightweight
+};
+
+/// Kind of packets created by the benchmarks
+static BenchPackets g_benchPackets = NORMAL_PACKETS;
+
+/**
+ * Create a packet of the kind selected on the command line
+ * \param size the packet size
+ * \param i the packet number in the benchmark
+ * \returns the packet
+ */
+static Ptr<Packet>
+CreateBenchPacket(uint32_t size, uint32_t i)
+{
+    if (g_benchPackets == LIGHTWEIGHT_PACKETS || (g_benchPackets == MIXED_PACKETS && (i % 2)))
+    {
+        return Packet::CreateLightweight(size);
+    }
+    return Create<Packet>(size);
+}
+
 static void
 benchD(uint32_t n)
 {
@@ -224,7 +257,7 @@ benchD(uint32_t n)
 
     for (uint32_t i = 0; i < n; i++)
     {
-        Ptr<Packet> p = Create<Packet>(2000);
+        Ptr<Packet> p = CreateBenchPacket(2000, i);
         p->AddPacketTag(tag1);
         p->AddHeader(udp);
         p->RemovePacketTag(tag1);
@@ -248,7 +281,7 @@ benchA(uint32_t n)
     NS_ASSERT_MSG(ipv4.IsOk() == false, "IsOk() should be false before deserialization");
     for (uint32_t i = 0; i < n; i++)
     {
-        Ptr<Packet> p = Create<Packet>(2000);
+        Ptr<Packet> p = CreateBenchPacket(2000, i);
         p->AddHeader(udp);
         p->AddHeader(ipv4);
         Ptr<Packet> o = p->Copy();
@@ -266,7 +299,7 @@ benchB(uint32_t n)
 
     for (uint32_t i = 0; i < n; i++)
     {
-        Ptr<Packet> p = Create<Packet>(2000);
+        Ptr<Packet> p = CreateBenchPacket(2000, i);
         p->AddHeader(udp);
         p->AddHeader(ipv4);
     }
@@ -296,7 +329,7 @@ benchC(uint32_t n)
 
     for (uint32_t i = 0; i < n; i++)
     {
-        Ptr<Packet> p = Create<Packet>(2000);
+        Ptr<Packet> p = CreateBenchPacket(2000, i);
         p->AddHeader(udp);
         p->AddHeader(ipv4);
         C1(p);
@@ -311,7 +344,7 @@ benchFragment(uint32_t n)
 
     for (uint32_t i = 0; i < n; i++)
     {
-        Ptr<Packet> p = Create<Packet>(2000);
+        Ptr<Packet> p = CreateBenchPacket(2000, i);
         p->AddHeader(udp);
         p->AddHeader(ipv4);
 
@@ -337,7 +370,7 @@ benchByteTags(uint32_t n)
 {
     for (uint32_t i = 0; i < n; i++)
     {
-        Ptr<Packet> p = Create<Packet>(2000);
+        Ptr<Packet> p = CreateBenchPacket(2000, i);
         for (uint32_t j = 0; j < 100; j++)
         {
             BenchTag<0> tag;
@@ -382,6 +415,7 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    std::string packets = "normal";
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -390,6 +424,7 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("packets", "kind of packets: normal, lightweight or mixed", packets);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -398,7 +433,25 @@ main(int argc, char* argv[])
                   << "by command-line argument --n=(number of packets)" << std::endl;
         exit(1);
     }
-    std::cout << "Running bench-packets with n=" << n << std::endl;
+    if (packets == "lightweight")
+    {
+        g_benchPackets = LIGHTWEIGHT_PACKETS;
+    }
+    else if (packets == "mixed")
+    {
+        g_benchPackets = MIXED_PACKETS;
+    }
+    else if (packets != "normal")
+    {
+        std::cerr << "Error-- unknown kind of packets: " << packets << std::endl;
+        exit(1);
+    }
+    if (enablePrinting)
+    {
+        Packet::EnablePrinting();
+    }
+    std::cout << "Running bench-packets with n=" << n << ", " << packets << " packets"
+              << (enablePrinting ? ", printing enabled" : "") << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
     runBench(&benchA, n, minIterations, "Copy packet, remove headers");
@@ -456,7 +456,9 @@ main(int argc, char* argv[])
 {
     bool allSched = false;
     bool schedCal = false;
+    bool schedDary = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -466,6 +468,7 @@ main(int argc, char* argv[])
     uint64_t runs = 1;
     std::string filename = "";
     bool calRev = false;
+    uint32_t arity = 4;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark the simulator scheduler.\n"
@@ -481,7 +484,10 @@ main(int argc, char* argv[])
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarSheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
+    cmd.AddValue("dary", "use DaryHeapScheduler", schedDary);
+    cmd.AddValue("arity", "arity of the DaryHeapScheduler", arity);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListSheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -501,14 +507,19 @@ main(int argc, char* argv[])
     LOG("  Event population size:        " << pop);
     LOG("  Total events per run:         " << total);
     LOG("  Number of runs per scheduler: " << runs);
+#ifdef ENABLE_EVENT_POOL
+    LOG("  Event object pool:            enabled");
+#else
+    LOG("  Event object pool:            disabled (NS3_EVENT_POOL=OFF)");
+#endif
     DEB("debugging is ON");
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedDary = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedDary || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
@@ -527,11 +538,23 @@ main(int argc, char* argv[])
             BenchSuite(factory, pop, total, runs, eventStream, !calRev).Log();
         }
     }
+    if (schedDary)
+    {
+        factory.SetTypeId("ns3::DaryHeapScheduler");
+        factory.Set("Arity", UintegerValue(arity));
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        factory = ObjectFactory("ns3::MapScheduler");
+    }
     if (schedHeap)
     {
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");